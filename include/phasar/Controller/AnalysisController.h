@@ -10,12 +10,17 @@
 #ifndef PHASAR_CONTROLLER_ANALYSISCONTROLLER_H
 #define PHASAR_CONTROLLER_ANALYSISCONTROLLER_H
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
 #include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/DemandDrivenAnalysis.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/IncrementalUpdateAnalysis.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/ModuleWiseAnalysis.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/Strategies.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/VariationalAnalysis.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/WholeProgramAnalysis.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
@@ -27,10 +32,13 @@
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/TaintConfig/TaintConfig.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
 #include "phasar/Utils/EnumFlags.h"
 #include "phasar/Utils/Soundness.h"
 
+#include "llvm/Support/MemoryBuffer.h"
+
 namespace psr {
 
 enum class AnalysisControllerEmitterOptions : uint32_t {
@@ -49,6 +57,7 @@ enum class AnalysisControllerEmitterOptions : uint32_t {
   EmitPTAAsText = (1 << 11),
   EmitPTAAsDot = (1 << 12),
   EmitPTAAsJson = (1 << 13),
+  EmitPTAAsBinary = (1 << 14),
 };
 
 class AnalysisController {
@@ -60,7 +69,13 @@ private:
   std::vector<DataFlowAnalysisType> DataFlowAnalyses;
   std::vector<std::string> AnalysisConfigs;
   std::set<std::string> EntryPoints;
-  [[maybe_unused]] AnalysisStrategy Strategy;
+  // the previous version of the program for the incremental analysis
+  std::vector<std::string> BaseModules;
+  std::unique_ptr<ProjectIRDB> BaseIRDB;
+  // the configurations analyzed by the variational analysis, each given as a
+  // comma-separated list of enabled features
+  std::vector<std::string> Configurations;
+  AnalysisStrategy Strategy;
   AnalysisControllerEmitterOptions EmitterOptions =
       AnalysisControllerEmitterOptions::None;
   std::string ProjectID;
@@ -85,6 +100,8 @@ private:
 
   void executeWholeProgram();
 
+  void executeDataFlowAnalyses();
+
   void emitRequestedHelperAnalysisResults();
 
   void executeIFDSUninitVar();
@@ -107,33 +124,97 @@ private:
 
   template <typename AnalysisTy, bool WithConfig = false>
   void executeIntraMonoAnalysis() {
+    if (Strategy != AnalysisStrategy::WholeProgram) {
+      reportUnsupportedStrategy();
+      return;
+    }
     executeAnalysis<IntraMonoSolver_P<AnalysisTy>, AnalysisTy, WithConfig>();
   }
 
   template <typename AnalysisTy, bool WithConfig = false>
   void executeInterMonoAnalysis() {
+    if (Strategy != AnalysisStrategy::WholeProgram) {
+      reportUnsupportedStrategy();
+      return;
+    }
     executeAnalysis<InterMonoSolver_P<AnalysisTy, 3>, AnalysisTy, WithConfig>();
   }
 
   template <typename AnalysisTy, bool WithConfig = false>
   void executeIFDSAnalysis() {
-    executeAnalysis<IFDSSolver_P<AnalysisTy>, AnalysisTy, WithConfig>();
+    executeIFDSIDEAnalysis<IFDSSolver_P<AnalysisTy>, AnalysisTy, WithConfig>();
   }
 
   template <typename AnalysisTy, bool WithConfig = false>
   void executeIDEAnalysis() {
-    executeAnalysis<IDESolver_P<AnalysisTy>, AnalysisTy, WithConfig>();
+    executeIFDSIDEAnalysis<IDESolver_P<AnalysisTy>, AnalysisTy, WithConfig>();
+  }
+
+  template <class Solver_P, typename AnalysisTy, bool WithConfig>
+  void executeIFDSIDEAnalysis() {
+    switch (Strategy) {
+    case AnalysisStrategy::DemandDriven:
+      executeDemandDrivenAnalysis<Solver_P, AnalysisTy, WithConfig>();
+      break;
+    case AnalysisStrategy::Incremental:
+      executeIncrementalAnalysis<Solver_P, AnalysisTy, WithConfig>();
+      break;
+    case AnalysisStrategy::ModuleWise:
+      executeModuleWiseAnalysis<Solver_P, AnalysisTy, WithConfig>();
+      break;
+    case AnalysisStrategy::Variational:
+      executeVariationalAnalysis<Solver_P, AnalysisTy, WithConfig>();
+      break;
+    default:
+      executeAnalysis<Solver_P, AnalysisTy, WithConfig>();
+      break;
+    }
+  }
+
+  /// Executes an IDE analysis with a configuration that does not depend on
+  /// the IR, e.g., a type state description.
+  template <typename AnalysisTy>
+  void executeIDEAnalysis(typename AnalysisTy::ConfigurationTy &Config) {
+    using Solver_P = IDESolver_P<AnalysisTy>;
+    switch (Strategy) {
+    case AnalysisStrategy::DemandDriven: {
+      DemandDrivenAnalysis<Solver_P, AnalysisTy> DDA(
+          SolverConfig, IRDB, &Config, EntryPoints, &PT, &ICF, &TH);
+      answerQueries(DDA);
+    } break;
+    case AnalysisStrategy::Incremental: {
+      if (!loadBaseIRDB()) {
+        return;
+      }
+      IncrementalUpdateAnalysis<Solver_P, AnalysisTy> IUA(
+          SolverConfig, *BaseIRDB, &Config, EntryPoints);
+      IUA.solve();
+      IUA.update(IRDB, &Config, &PT, &ICF, &TH);
+      emitRequestedDataFlowResults(IUA);
+    } break;
+    case AnalysisStrategy::ModuleWise: {
+      ModuleWiseAnalysis<Solver_P, AnalysisTy> MWA(SolverConfig, IRDB, &Config,
+                                                   &TH);
+      MWA.solve();
+      emitRequestedDataFlowResults(MWA);
+    } break;
+    case AnalysisStrategy::Variational:
+      reportUnsupportedStrategy();
+      break;
+    default: {
+      WholeProgramAnalysis<Solver_P, AnalysisTy> WPA(
+          SolverConfig, IRDB, &Config, EntryPoints, &PT, &ICF, &TH);
+      WPA.solve();
+      emitRequestedDataFlowResults(WPA);
+      WPA.releaseAllHelperAnalyses();
+    } break;
+    }
   }
 
   template <class Solver_P, typename AnalysisTy, bool WithConfig>
   void executeAnalysis() {
     if constexpr (WithConfig) {
-      std::string AnalysisConfigPath =
-          (0 < AnalysisConfigs.size()) ? AnalysisConfigs[0] : "";
-      auto Config =
-          !AnalysisConfigPath.empty()
-              ? TaintConfig(IRDB, parseTaintConfig(AnalysisConfigPath))
-              : TaintConfig(IRDB);
+      auto Config = loadTaintConfig(IRDB);
       WholeProgramAnalysis<Solver_P, AnalysisTy> WPA(
           SolverConfig, IRDB, &Config, EntryPoints, &PT, &ICF, &TH);
       WPA.solve();
@@ -148,6 +229,120 @@ private:
     }
   }
 
+  template <class Solver_P, typename AnalysisTy, bool WithConfig>
+  void executeModuleWiseAnalysis() {
+    if constexpr (WithConfig) {
+      auto Config = loadTaintConfig(IRDB);
+      ModuleWiseAnalysis<Solver_P, AnalysisTy> MWA(SolverConfig, IRDB,
+                                                   &Config, &TH);
+      MWA.solve();
+      emitRequestedDataFlowResults(MWA);
+    } else {
+      ModuleWiseAnalysis<Solver_P, AnalysisTy> MWA(SolverConfig, IRDB, &TH);
+      MWA.solve();
+      emitRequestedDataFlowResults(MWA);
+    }
+  }
+
+  /// Answers the queries returned by getQueryLocations(), exploring only the
+  /// parts of the program that are relevant to them.
+  template <class Solver_P, typename AnalysisTy, bool WithConfig>
+  void executeDemandDrivenAnalysis() {
+    if constexpr (WithConfig) {
+      auto Config = loadTaintConfig(IRDB);
+      DemandDrivenAnalysis<Solver_P, AnalysisTy> DDA(
+          SolverConfig, IRDB, &Config, EntryPoints, &PT, &ICF, &TH);
+      answerQueries(DDA);
+    } else {
+      DemandDrivenAnalysis<Solver_P, AnalysisTy> DDA(SolverConfig, IRDB,
+                                                     EntryPoints, &PT, &ICF,
+                                                     &TH);
+      answerQueries(DDA);
+    }
+  }
+
+  template <typename T> void answerQueries(T &DDA) {
+    for (const auto *Stmt : getQueryLocations()) {
+      auto Results = DDA.query(Stmt, /*StripZero*/ true);
+      llvm::outs() << "Facts holding at "
+                   << DDA.getProblem().NtoString(Stmt) << ":\n";
+      for (const auto &Result : Results) {
+        llvm::outs() << "\t" << DDA.getProblem().DtoString(Result.first)
+                     << '\n';
+      }
+    }
+    llvm::outs() << "Answered " << DDA.getNumberOfQueries()
+                 << " queries, explored "
+                 << DDA.getNumberOfRelevantFunctions() << " function(s)\n";
+  }
+
+  /// Returns the locations queried by the demand-driven analysis, i.e., the
+  /// exit points of the entry points.
+  std::vector<const llvm::Instruction *> getQueryLocations() const;
+
+  /// Analyzes the previous version of the program given by BaseModules
+  /// first and then updates the results for IRDB.
+  template <class Solver_P, typename AnalysisTy, bool WithConfig>
+  void executeIncrementalAnalysis() {
+    if (!loadBaseIRDB()) {
+      return;
+    }
+    if constexpr (WithConfig) {
+      // The configurations refer to the functions of their versions
+      auto BaseConfig = loadTaintConfig(*BaseIRDB);
+      auto Config = loadTaintConfig(IRDB);
+      IncrementalUpdateAnalysis<Solver_P, AnalysisTy> IUA(
+          SolverConfig, *BaseIRDB, &BaseConfig, EntryPoints);
+      IUA.solve();
+      IUA.update(IRDB, &Config, &PT, &ICF, &TH);
+      emitRequestedDataFlowResults(IUA);
+    } else {
+      IncrementalUpdateAnalysis<Solver_P, AnalysisTy> IUA(
+          SolverConfig, *BaseIRDB, EntryPoints);
+      IUA.solve();
+      IUA.update(IRDB, &PT, &ICF, &TH);
+      emitRequestedDataFlowResults(IUA);
+    }
+  }
+
+  /// Analyzes all configurations given by Configurations in a single solver
+  /// run. Only IFDS analyses can be lifted to presence conditions.
+  template <class Solver_P, typename AnalysisTy, bool WithConfig>
+  void executeVariationalAnalysis() {
+    if constexpr (!std::is_same_v<typename AnalysisTy::l_t, BinaryDomain>) {
+      reportUnsupportedStrategy();
+    } else {
+      if (Configurations.empty()) {
+        llvm::errs() << "The variational analysis requires at least one "
+                        "configuration!\n";
+        return;
+      }
+      auto Configs = FeatureModel::parseConfigurations(Configurations);
+      if constexpr (WithConfig) {
+        auto Config = loadTaintConfig(IRDB);
+        VariationalAnalysis<Solver_P, AnalysisTy> VA(
+            SolverConfig, IRDB, std::move(Configs), &Config, EntryPoints, &PT,
+            &ICF, &TH);
+        VA.solve();
+        emitRequestedDataFlowResults(VA);
+      } else {
+        VariationalAnalysis<Solver_P, AnalysisTy> VA(
+            SolverConfig, IRDB, std::move(Configs), EntryPoints, &PT, &ICF,
+            &TH);
+        VA.solve();
+        emitRequestedDataFlowResults(VA);
+      }
+    }
+  }
+
+  TaintConfig loadTaintConfig(ProjectIRDB &DB);
+
+  /// Loads the previous version of the program for the incremental analysis
+  /// once; returns false if none has been specified.
+  bool loadBaseIRDB();
+
+  void reportUnsupportedStrategy();
+
   std::unique_ptr<llvm::raw_fd_ostream>
   openFileStream(llvm::StringRef Filename);
 
@@ -198,7 +393,11 @@ public:
                      IFDSIDESolverConfig SolverConfig,
                      const std::string &ProjectID = "default-phasar-project",
                      const std::string &OutDirectory = "",
-                     const nlohmann::json &PrecomputedPointsToInfo = {});
+                     const nlohmann::json &PrecomputedPointsToInfo = {},
+                     const llvm::MemoryBuffer *PrecomputedPointsToBinary =
+                         nullptr,
+                     std::vector<std::string> BaseModules = {},
+                     std::vector<std::string> Configurations = {});
 
   ~AnalysisController() = default;
 
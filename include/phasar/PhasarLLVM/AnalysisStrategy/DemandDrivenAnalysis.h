@@ -10,9 +10,296 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_DEMANDDRIVENANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_DEMANDDRIVENANALYSIS_H_
 
+#include <cassert>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/TypeTraits.h"
+
 namespace psr {
 
-class DemandDrivenAnalysis {};
+/// Answers queries for the data-flow facts that hold at single statements by
+/// solving only the part of the exploded super graph that is relevant to
+/// them.
+///
+/// A statement S can only be influenced by the nodes from which it is
+/// reachable in the interprocedural control-flow graph. query() thus computes
+/// the backward-relevant region of S: the nodes of S's function that reach S,
+/// the nodes of its transitive callers that reach the call sites leading to
+/// it, and the entire bodies of all functions called in between, whose
+/// summaries are needed to step over their call sites. Phase I of the solver
+/// is restricted to that region by a path-edge filter; path edges leaving the
+/// region are deferred. The regions, the jump functions and the deferred path
+/// edges are kept across queries, such that a later query only resumes the
+/// deferred path edges that have become relevant. The values are then
+/// computed at the start points and call sites of the explored region and at
+/// S only; the values computed by earlier queries are kept, such that only
+/// the jump functions added since then are evaluated.
+///
+/// All ProjectIRDBs and helper analyses passed to the analysis must outlive
+/// it.
+template <typename Solver, typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class DemandDrivenAnalysis {
+  // Check if the solver is able to solve the given problem description
+  static_assert(
+      std::is_base_of_v<typename Solver::ProblemTy, ProblemDescription>,
+      "Problem description does not match solver type!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+
+public:
+  using n_t = typename Solver::n_t;
+  using d_t = typename Solver::d_t;
+  using f_t = typename Solver::f_t;
+  using l_t = typename Solver::l_t;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  IFDSIDESolverConfig SolverConfig;
+  std::unique_ptr<TypeHierarchyTy> OwnedTypeHierarchy;
+  std::unique_ptr<PointerAnalysisTy> OwnedPointerInfo;
+  std::unique_ptr<CallGraphAnalysisTy> OwnedCallGraph;
+  std::unique_ptr<ProblemDescription> ProblemDesc;
+  std::unique_ptr<Solver> DataFlowSolver;
+  const CallGraphAnalysisTy *ICF = nullptr;
+  bool Started = false;
+  size_t NumQueries = 0;
+
+  // functions that are relevant in their entirety
+  std::unordered_set<f_t> RelevantFunctions;
+  // relevant nodes of the other functions
+  std::unordered_set<n_t> RelevantNodes;
+  // nodes whose predecessors have been added to the region
+  std::unordered_set<n_t> VisitedNodes;
+  // call sites through which the region has been entered from a caller
+  std::unordered_set<n_t> VisitedCallSites;
+
+public:
+  DemandDrivenAnalysis(IFDSIDESolverConfig SolverConfig, ProjectIRDB &IRDB,
+                       std::set<std::string> EntryPoints = {},
+                       PointerAnalysisTy *PointerInfo = nullptr,
+                       CallGraphAnalysisTy *CallGraph = nullptr,
+                       TypeHierarchyTy *TypeHierarchy = nullptr)
+      : SolverConfig(SolverConfig) {
+    initialize(IRDB, nullptr, std::move(EntryPoints), PointerInfo, CallGraph,
+               TypeHierarchy);
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  DemandDrivenAnalysis(IFDSIDESolverConfig SolverConfig, ProjectIRDB &IRDB,
+                       ConfigurationTy *Config,
+                       std::set<std::string> EntryPoints = {},
+                       PointerAnalysisTy *PointerInfo = nullptr,
+                       CallGraphAnalysisTy *CallGraph = nullptr,
+                       TypeHierarchyTy *TypeHierarchy = nullptr)
+      : SolverConfig(SolverConfig) {
+    initialize(IRDB, Config, std::move(EntryPoints), PointerInfo, CallGraph,
+               TypeHierarchy);
+  }
+
+  DemandDrivenAnalysis(const DemandDrivenAnalysis &) = delete;
+  DemandDrivenAnalysis(DemandDrivenAnalysis &&) = delete;
+  DemandDrivenAnalysis &operator=(const DemandDrivenAnalysis &) = delete;
+  DemandDrivenAnalysis &operator=(DemandDrivenAnalysis &&) = delete;
+
+  ~DemandDrivenAnalysis() = default;
+
+  /// Returns the data-flow facts that hold at Stmt and their values. The
+  /// artificial zero value can be automatically stripped.
+  std::unordered_map<d_t, l_t> query(n_t Stmt, bool StripZero = false) {
+    solveFor(Stmt);
+    return DataFlowSolver->resultsAt(Stmt, StripZero);
+  }
+
+  /// Returns the value of Fact at Stmt.
+  l_t query(n_t Stmt, d_t Fact) {
+    solveFor(Stmt);
+    return DataFlowSolver->resultAt(Stmt, Fact);
+  }
+
+  /// Returns true if Fact reaches Stmt, e.g., whether a tainted value reaches
+  /// a sink.
+  bool holds(n_t Stmt, d_t Fact) { return query(Stmt).count(Fact); }
+
+  /// Returns the number of queries answered so far.
+  [[nodiscard]] size_t getNumberOfQueries() const noexcept {
+    return NumQueries;
+  }
+
+  /// Returns the number of functions that are part of the explored region,
+  /// either entirely or partially.
+  [[nodiscard]] size_t getNumberOfRelevantFunctions() const {
+    std::unordered_set<f_t> Functions = RelevantFunctions;
+    for (n_t Node : RelevantNodes) {
+      Functions.insert(ICF->getFunctionOf(Node));
+    }
+    return Functions.size();
+  }
+
+  [[nodiscard]] Solver &getSolver() { return *DataFlowSolver; }
+
+  [[nodiscard]] ProblemDescription &getProblem() { return *ProblemDesc; }
+
+  /// Dumps the results computed by the latest query.
+  void dumpResults(llvm::raw_ostream &OS = llvm::outs()) {
+    DataFlowSolver->dumpResults(OS);
+  }
+
+  void emitTextReport(llvm::raw_ostream &OS = llvm::outs()) {
+    DataFlowSolver->emitTextReport(OS);
+  }
+
+  void emitGraphicalReport(llvm::raw_ostream &OS = llvm::outs()) {
+    DataFlowSolver->emitGraphicalReport(OS);
+  }
+
+private:
+  void initialize(ProjectIRDB &IRDB, ConfigurationTy *Config,
+                  std::set<std::string> EntryPoints,
+                  PointerAnalysisTy *PointerInfo,
+                  CallGraphAnalysisTy *CallGraph,
+                  TypeHierarchyTy *TypeHierarchy) {
+    // The path-edge filter is only supported by the sequential solver and
+    // the values are computed on demand
+    SolverConfig.setNumThreads(1);
+    SolverConfig.setComputeValues(false);
+    if (!TypeHierarchy) {
+      OwnedTypeHierarchy = std::make_unique<TypeHierarchyTy>(IRDB);
+      TypeHierarchy = OwnedTypeHierarchy.get();
+    }
+    if (!PointerInfo) {
+      OwnedPointerInfo = std::make_unique<PointerAnalysisTy>(IRDB);
+      PointerInfo = OwnedPointerInfo.get();
+    }
+    if (!CallGraph) {
+      OwnedCallGraph = std::make_unique<CallGraphAnalysisTy>(
+          IRDB, CallGraphAnalysisType::OTF, EntryPoints, TypeHierarchy,
+          PointerInfo);
+      CallGraph = OwnedCallGraph.get();
+    }
+    ICF = CallGraph;
+    if constexpr (std::is_same_v<ConfigurationTy, HasNoConfigurationType>) {
+      ProblemDesc = std::make_unique<ProblemDescription>(
+          &IRDB, TypeHierarchy, CallGraph, PointerInfo, EntryPoints);
+    } else {
+      assert(Config && "The problem requires a configuration!");
+      ProblemDesc = std::make_unique<ProblemDescription>(
+          &IRDB, TypeHierarchy, CallGraph, PointerInfo, *Config, EntryPoints);
+    }
+    if constexpr (has_setIFDSIDESolverConfig_v<ProblemDescription>) {
+      ProblemDesc->setIFDSIDESolverConfig(SolverConfig);
+    }
+    DataFlowSolver = std::make_unique<Solver>(*ProblemDesc);
+    DataFlowSolver->setPathEdgeFilter([this](n_t Node) {
+      return RelevantNodes.count(Node) ||
+             RelevantFunctions.count(ICF->getFunctionOf(Node));
+    });
+  }
+
+  /// Widens the explored region by the backward-relevant region of Stmt,
+  /// resumes Phase I and computes the values at Stmt.
+  void solveFor(n_t Stmt) {
+    ++NumQueries;
+    addRelevantRegion(Stmt);
+    if (!Started) {
+      Started = true;
+      DataFlowSolver->solvePhaseI();
+    } else {
+      DataFlowSolver->resumeDeferredPathEdges();
+    }
+    DataFlowSolver->computeValuesAt({Stmt});
+  }
+
+  void addRelevantRegion(n_t Stmt) {
+    // the targets whose backward-reachable nodes are not yet part of the
+    // region; the value at a target depends on all callers of its function,
+    // even if the function is relevant in its entirety
+    std::vector<n_t> Targets = {Stmt};
+    while (!Targets.empty()) {
+      n_t Target = Targets.back();
+      Targets.pop_back();
+      f_t Fun = ICF->getFunctionOf(Target);
+      if (!RelevantFunctions.count(Fun)) {
+        RelevantNodes.insert(Target);
+        addBackwardReachableNodes(Target);
+      }
+      for (n_t CallSite : ICF->getCallersOf(Fun)) {
+        if (VisitedCallSites.insert(CallSite).second) {
+          Targets.push_back(CallSite);
+        }
+      }
+    }
+    PHASAR_LOG_LEVEL(DEBUG, "Relevant region after query "
+                                << NumQueries << ": "
+                                << RelevantFunctions.size()
+                                << " entire function(s), "
+                                << RelevantNodes.size() << " node(s)");
+  }
+
+  /// Adds the nodes from which Target is reachable within its function to the
+  /// region. Target itself is only entered, but the callees of call sites
+  /// that precede it have to be summarized.
+  void addBackwardReachableNodes(n_t Target) {
+    std::vector<n_t> Stack;
+    if (VisitedNodes.insert(Target).second) {
+      Stack.push_back(Target);
+    }
+    while (!Stack.empty()) {
+      n_t Node = Stack.back();
+      Stack.pop_back();
+      for (n_t Pred : ICF->getPredsOf(Node)) {
+        RelevantNodes.insert(Pred);
+        if (ICF->isCallSite(Pred)) {
+          addRelevantCallees(Pred);
+        }
+        if (VisitedNodes.insert(Pred).second) {
+          Stack.push_back(Pred);
+        }
+      }
+    }
+  }
+
+  /// Adds the transitive callees of CallSite to the region in their entirety.
+  void addRelevantCallees(n_t CallSite) {
+    std::vector<f_t> Stack;
+    for (f_t Callee : ICF->getCalleesOfCallAt(CallSite)) {
+      if (RelevantFunctions.insert(Callee).second) {
+        Stack.push_back(Callee);
+      }
+    }
+    while (!Stack.empty()) {
+      f_t Fun = Stack.back();
+      Stack.pop_back();
+      for (n_t Call : ICF->getCallsFromWithin(Fun)) {
+        for (f_t Callee : ICF->getCalleesOfCallAt(Call)) {
+          if (RelevantFunctions.insert(Callee).second) {
+            Stack.push_back(Callee);
+          }
+        }
+      }
+    }
+  }
+};
 
 } // namespace psr
 
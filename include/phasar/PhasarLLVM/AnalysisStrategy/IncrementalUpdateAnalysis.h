@@ -10,9 +10,392 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_INCREMENTALUPDATEANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_INCREMENTALUPDATEANALYSIS_H_
 
+#include <cassert>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/IR/Argument.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalValue.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ExternalSummaries.h"
+#include "phasar/PhasarLLVM/Utils/FunctionHashes.h"
+#include "phasar/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/TypeTraits.h"
+
 namespace psr {
 
-class IncrementalUpdateAnalysis {};
+/// Analyzes successive versions of a program and re-analyzes only the code
+/// that has changed between them.
+///
+/// solve() analyzes the first version. update() diffs the functions of the
+/// next version against the previous one using their closure hashes (see
+/// FunctionHashes): a function whose own code and transitive callees are
+/// unchanged, and that does not access mutable global variables, is not
+/// analyzed again. Calls to such a function are resolved by the solver of
+/// the version that analyzed it last, which provides its end summaries, and
+/// thus, its jump functions, on demand. A summary is only valid for the
+/// points-to information it has been computed with, so a function whose
+/// pointer arguments may point to different objects in the new version is
+/// treated as changed as well. All other functions, i.e., the changed
+/// functions and their transitive callers, are analyzed from the entry points
+/// with a fresh type hierarchy, points-to information and call graph for the
+/// new version. Problems whose flow functions record side effects (see
+/// IFDSTabulationProblem::canReuseSummaries()), e.g., the taint analysis,
+/// reuse no summaries, as the side effects would be missing for the reused
+/// functions; update() analyzes all of their functions again.
+///
+/// The solver state of a version is kept alive as long as a later version
+/// reuses its summaries. All ProjectIRDBs and helper analyses passed to the
+/// analysis must outlive it. Results, e.g., resultsAt(), refer to the latest
+/// version; for reused functions they are available from the solver that
+/// analyzed them.
+template <typename Solver, typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class IncrementalUpdateAnalysis {
+  // Check if the solver is able to solve the given problem description
+  static_assert(
+      std::is_base_of_v<typename Solver::ProblemTy, ProblemDescription>,
+      "Problem description does not match solver type!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+
+public:
+  using n_t = typename Solver::n_t;
+  using d_t = typename Solver::d_t;
+  using f_t = typename Solver::f_t;
+  using l_t = typename Solver::l_t;
+  using EndSummaryTy =
+      typename ExternalSummaries<n_t, d_t, f_t, l_t>::EndSummaryTy;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  struct Version;
+
+  /// Resolves calls to functions that a version reuses to the solvers of the
+  /// versions that analyzed them.
+  class ReusedSummaries : public ExternalSummaries<n_t, d_t, f_t, l_t> {
+  public:
+    ReusedSummaries(Version &V) : V(V) {}
+
+    [[nodiscard]] f_t getDefinition(f_t Callee) override {
+      if (auto Search = V.ReusedDefinitions.find(Callee);
+          Search != V.ReusedDefinitions.end()) {
+        return Search->second;
+      }
+      f_t Definition = nullptr;
+      if (auto Search = V.Origins.find(Callee->getName());
+          !Callee->isDeclaration() && Search != V.Origins.end()) {
+        Definition =
+            Search->second->IRDB.getFunctionDefinition(Callee->getName());
+        V.DefinitionOrigins[Definition] = Search->second.get();
+      }
+      V.ReusedDefinitions[Callee] = Definition;
+      return Definition;
+    }
+
+    [[nodiscard]] std::vector<EndSummaryTy> getEndSummaries(n_t SP,
+                                                            d_t Fact) override {
+      auto Search = V.DefinitionOrigins.find(SP->getFunction());
+      assert(Search != V.DefinitionOrigins.end() &&
+             "SP must belong to a definition returned by getDefinition()!");
+      return Search->second->DataFlowSolver->summarize(SP, Fact);
+    }
+
+  private:
+    Version &V;
+  };
+
+  struct Version {
+    Version(ProjectIRDB &IRDB, ConfigurationTy *Config)
+        : IRDB(IRDB), Config(Config), Hashes(IRDB), Summaries(*this) {}
+
+    ProjectIRDB &IRDB;
+    ConfigurationTy *Config;
+    FunctionHashes Hashes;
+    std::unique_ptr<TypeHierarchyTy> OwnedTypeHierarchy;
+    std::unique_ptr<PointerAnalysisTy> OwnedPointerInfo;
+    std::unique_ptr<CallGraphAnalysisTy> OwnedCallGraph;
+    // the points-to information the version has been analyzed with
+    PointerAnalysisTy *PointerInfo = nullptr;
+    std::unique_ptr<ProblemDescription> ProblemDesc;
+    std::unique_ptr<Solver> DataFlowSolver;
+    // the versions that analyzed the functions this version reuses, by name
+    llvm::StringMap<std::shared_ptr<Version>> Origins;
+    llvm::DenseMap<f_t, f_t> ReusedDefinitions;
+    llvm::DenseMap<f_t, Version *> DefinitionOrigins;
+    ReusedSummaries Summaries;
+  };
+
+  IFDSIDESolverConfig SolverConfig;
+  std::set<std::string> EntryPoints;
+  std::shared_ptr<Version> Current;
+  std::vector<std::string> ChangedFunctions;
+  size_t NumReusedFunctions = 0;
+
+public:
+  IncrementalUpdateAnalysis(IFDSIDESolverConfig SolverConfig, ProjectIRDB &IRDB,
+                            std::set<std::string> EntryPoints = {},
+                            PointerAnalysisTy *PointerInfo = nullptr,
+                            CallGraphAnalysisTy *CallGraph = nullptr,
+                            TypeHierarchyTy *TypeHierarchy = nullptr)
+      : SolverConfig(SolverConfig), EntryPoints(std::move(EntryPoints)) {
+    Current = createVersion(IRDB, nullptr, PointerInfo, CallGraph,
+                            TypeHierarchy, /*Reuse*/ false);
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  IncrementalUpdateAnalysis(IFDSIDESolverConfig SolverConfig, ProjectIRDB &IRDB,
+                            ConfigurationTy *Config,
+                            std::set<std::string> EntryPoints = {},
+                            PointerAnalysisTy *PointerInfo = nullptr,
+                            CallGraphAnalysisTy *CallGraph = nullptr,
+                            TypeHierarchyTy *TypeHierarchy = nullptr)
+      : SolverConfig(SolverConfig), EntryPoints(std::move(EntryPoints)) {
+    Current = createVersion(IRDB, Config, PointerInfo, CallGraph,
+                            TypeHierarchy, /*Reuse*/ false);
+  }
+
+  IncrementalUpdateAnalysis(const IncrementalUpdateAnalysis &) = delete;
+  IncrementalUpdateAnalysis(IncrementalUpdateAnalysis &&) = delete;
+  IncrementalUpdateAnalysis &
+  operator=(const IncrementalUpdateAnalysis &) = delete;
+  IncrementalUpdateAnalysis &operator=(IncrementalUpdateAnalysis &&) = delete;
+
+  ~IncrementalUpdateAnalysis() = default;
+
+  /// Analyzes the first version of the program.
+  void solve() { Current->DataFlowSolver->solve(); }
+
+  void operator()() { solve(); }
+
+  /// Analyzes NewIRDB, the next version of the program, reusing the
+  /// summaries of all functions that have not changed. The helper analyses
+  /// are not taken ownership of and are constructed if not provided.
+  void update(ProjectIRDB &NewIRDB, PointerAnalysisTy *PointerInfo = nullptr,
+              CallGraphAnalysisTy *CallGraph = nullptr,
+              TypeHierarchyTy *TypeHierarchy = nullptr) {
+    Current = createVersion(NewIRDB, Current->Config, PointerInfo, CallGraph,
+                            TypeHierarchy, /*Reuse*/ true);
+    Current->DataFlowSolver->solve();
+  }
+
+  /// Like update(), but uses Config for the new version, e.g., because it
+  /// refers to the functions of NewIRDB.
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  void update(ProjectIRDB &NewIRDB, ConfigurationTy *Config,
+              PointerAnalysisTy *PointerInfo = nullptr,
+              CallGraphAnalysisTy *CallGraph = nullptr,
+              TypeHierarchyTy *TypeHierarchy = nullptr) {
+    Current = createVersion(NewIRDB, Config, PointerInfo, CallGraph,
+                            TypeHierarchy, /*Reuse*/ true);
+    Current->DataFlowSolver->solve();
+  }
+
+  /// Returns the names of the functions whose closure hashes have changed in
+  /// the latest update().
+  [[nodiscard]] const std::vector<std::string> &
+  getChangedFunctions() const noexcept {
+    return ChangedFunctions;
+  }
+
+  /// Returns the number of functions whose summaries the latest update()
+  /// reuses from previous versions.
+  [[nodiscard]] size_t getNumReusedFunctions() const noexcept {
+    return NumReusedFunctions;
+  }
+
+  /// Returns the solver of the latest version.
+  [[nodiscard]] Solver &getSolver() { return *Current->DataFlowSolver; }
+
+  /// Returns the problem of the latest version.
+  [[nodiscard]] ProblemDescription &getProblem() {
+    return *Current->ProblemDesc;
+  }
+
+  [[nodiscard]] const FunctionHashes &getFunctionHashes() const {
+    return Current->Hashes;
+  }
+
+  void dumpResults(llvm::raw_ostream &OS = llvm::outs()) {
+    Current->DataFlowSolver->dumpResults(OS);
+  }
+
+  void emitTextReport(llvm::raw_ostream &OS = llvm::outs()) {
+    Current->DataFlowSolver->emitTextReport(OS);
+  }
+
+  void emitGraphicalReport(llvm::raw_ostream &OS = llvm::outs()) {
+    Current->DataFlowSolver->emitGraphicalReport(OS);
+  }
+
+private:
+  /// Describes V by its position in the program rather than by its address,
+  /// such that the values of two versions can be compared. Positions inside
+  /// of functions are conservative: inserting an instruction changes the
+  /// descriptions of all subsequent ones.
+  static std::string describeValue(const llvm::Value *V) {
+    if (const auto *G = llvm::dyn_cast<llvm::GlobalValue>(V)) {
+      return "@" + G->getName().str();
+    }
+    if (const auto *A = llvm::dyn_cast<llvm::Argument>(V)) {
+      return A->getParent()->getName().str() + "%" +
+             std::to_string(A->getArgNo());
+    }
+    if (const auto *I = llvm::dyn_cast<llvm::Instruction>(V)) {
+      size_t Idx = 0;
+      for (const auto &Inst : llvm::instructions(I->getFunction())) {
+        if (&Inst == I) {
+          break;
+        }
+        ++Idx;
+      }
+      return I->getFunction()->getName().str() + "#" + std::to_string(Idx);
+    }
+    return llvmIRToStableString(V);
+  }
+
+  /// Describes the points-to sets of F's pointer arguments as computed by the
+  /// points-to information of V.
+  static std::set<std::string> describeArgumentPointsToSets(Version &V,
+                                                            f_t F) {
+    std::set<std::string> Desc;
+    for (const auto &Arg : F->args()) {
+      if (!Arg.getType()->isPointerTy()) {
+        continue;
+      }
+      for (const auto *Pointee : *V.PointerInfo->getPointsToSet(&Arg)) {
+        Desc.insert(std::to_string(Arg.getArgNo()) + ":" +
+                    describeValue(Pointee));
+      }
+    }
+    return Desc;
+  }
+
+  std::shared_ptr<Version> createVersion(ProjectIRDB &IRDB,
+                                         ConfigurationTy *Config,
+                                         PointerAnalysisTy *PointerInfo,
+                                         CallGraphAnalysisTy *CallGraph,
+                                         TypeHierarchyTy *TypeHierarchy,
+                                         bool Reuse) {
+    auto V = std::make_shared<Version>(IRDB, Config);
+    IFDSIDESolverConfig VersionConfig = SolverConfig;
+    if (!TypeHierarchy) {
+      V->OwnedTypeHierarchy = std::make_unique<TypeHierarchyTy>(IRDB);
+      TypeHierarchy = V->OwnedTypeHierarchy.get();
+    }
+    if (!PointerInfo) {
+      V->OwnedPointerInfo = std::make_unique<PointerAnalysisTy>(IRDB);
+      PointerInfo = V->OwnedPointerInfo.get();
+    }
+    V->PointerInfo = PointerInfo;
+    if (!CallGraph) {
+      V->OwnedCallGraph = std::make_unique<CallGraphAnalysisTy>(
+          IRDB, CallGraphAnalysisType::OTF, EntryPoints, TypeHierarchy,
+          PointerInfo);
+      CallGraph = V->OwnedCallGraph.get();
+    }
+    if constexpr (std::is_same_v<ConfigurationTy, HasNoConfigurationType>) {
+      V->ProblemDesc = std::make_unique<ProblemDescription>(
+          &IRDB, TypeHierarchy, CallGraph, PointerInfo, EntryPoints);
+    } else {
+      assert(Config && "The problem requires a configuration!");
+      V->ProblemDesc = std::make_unique<ProblemDescription>(
+          &IRDB, TypeHierarchy, CallGraph, PointerInfo, *Config, EntryPoints);
+    }
+    if (Reuse) {
+      ChangedFunctions = V->Hashes.getChangedFunctions(Current->Hashes);
+      if (!V->ProblemDesc->canReuseSummaries()) {
+        // Reusing summaries would skip the side effects the flow functions
+        // record for the reused functions
+        PHASAR_LOG_LEVEL(WARNING, "The problem does not support reusing "
+                                  "summaries, analyze all functions again");
+        NumReusedFunctions = 0;
+        Reuse = false;
+      }
+    }
+    if (Reuse) {
+      llvm::SmallVector<f_t, 0> PointsToChanged;
+      for (const auto *M : IRDB.getAllModules()) {
+        for (const auto &F : *M) {
+          auto Name = F.getName();
+          if (F.isDeclaration() ||
+              V->Hashes.getClosureHash(Name) !=
+                  Current->Hashes.getClosureHash(Name) ||
+              V->Hashes.mayAccessMutableGlobals(Name)) {
+            continue;
+          }
+          // Reuse the version that has analyzed F last
+          auto Origin = Current->Origins.lookup(Name);
+          if (!Origin) {
+            Origin = Current;
+          }
+          const auto *OriginF = Origin->IRDB.getFunctionDefinition(Name);
+          if (!OriginF || describeArgumentPointsToSets(*V, &F) !=
+                              describeArgumentPointsToSets(*Origin, OriginF)) {
+            PointsToChanged.push_back(&F);
+            continue;
+          }
+          V->Origins[Name] = std::move(Origin);
+        }
+      }
+      // The callers of a function that is analyzed again cannot reuse their
+      // summaries, as these depend on the callee's summaries
+      llvm::DenseSet<f_t> Visited(PointsToChanged.begin(),
+                                  PointsToChanged.end());
+      while (!PointsToChanged.empty()) {
+        f_t F = PointsToChanged.pop_back_val();
+        V->Origins.erase(F->getName());
+        for (const auto *CS : CallGraph->getCallersOf(F)) {
+          if (f_t Caller = CS->getFunction(); Visited.insert(Caller).second) {
+            PointsToChanged.push_back(Caller);
+          }
+        }
+      }
+      NumReusedFunctions = V->Origins.size();
+      PHASAR_LOG_LEVEL(INFO, ChangedFunctions.size()
+                                 << " function(s) changed, "
+                                 << Visited.size()
+                                 << " function(s) affected by changed "
+                                    "points-to information, reuse the "
+                                    "summaries of "
+                                 << NumReusedFunctions << " function(s)");
+      // External summaries are only supported by the sequential solver
+      VersionConfig.setNumThreads(1);
+    }
+    if constexpr (has_setIFDSIDESolverConfig_v<ProblemDescription>) {
+      V->ProblemDesc->setIFDSIDESolverConfig(VersionConfig);
+    }
+    V->DataFlowSolver = std::make_unique<Solver>(*V->ProblemDesc);
+    if (Reuse) {
+      V->DataFlowSolver->setExternalSummaries(&V->Summaries);
+    }
+    return V;
+  }
+};
 
 } // namespace psr
 
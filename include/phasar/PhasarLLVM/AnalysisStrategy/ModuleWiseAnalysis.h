@@ -10,9 +10,501 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_MODULEWISEANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_MODULEWISEANALYSIS_H_
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ExternalSummaries.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/TypeTraits.h"
+
 namespace psr {
 
-class ModuleWiseAnalysis {};
+/// Analyzes the modules of a ProjectIRDB that have not been linked into a
+/// single WPA module one by one, each with its own call graph, points-to
+/// information, problem and IFDS/IDE solver. The call graph and points-to
+/// information of a module only cover the module itself.
+///
+/// The functions with external linkage that a module defines are its
+/// boundary: they are the entry points of the module's analysis. Calls to
+/// boundary functions of other modules are resolved at link time by applying
+/// the end summaries of their definitions, which the solver of the defining
+/// module computes on demand for the facts that actually flow into the call.
+///
+/// The modules are solved bottom-up along the dependencies between them,
+/// independent modules in parallel if the problem declares itself thread-safe
+/// (see IFDSTabulationProblem::isThreadSafe()). Modules that depend on each
+/// other cyclically are solved together until their summaries do not change
+/// anymore. Values in IDE problems that enter a module through a boundary
+/// function from another module are not tracked across the boundary; such
+/// entry facts start with the problem's bottom element.
+template <typename Solver, typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class ModuleWiseAnalysis {
+  // Check if the solver is able to solve the given problem description
+  static_assert(
+      std::is_base_of_v<typename Solver::ProblemTy, ProblemDescription>,
+      "Problem description does not match solver type!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+
+public:
+  using n_t = typename Solver::n_t;
+  using d_t = typename Solver::d_t;
+  using f_t = typename Solver::f_t;
+  using l_t = typename Solver::l_t;
+  using EndSummaryTy =
+      typename ExternalSummaries<n_t, d_t, f_t, l_t>::EndSummaryTy;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  /// Hands the summaries of the boundary functions of other modules to the
+  /// solver of a module.
+  class ModuleSummaries : public ExternalSummaries<n_t, d_t, f_t, l_t> {
+  public:
+    ModuleSummaries(ModuleWiseAnalysis &MWA) : MWA(MWA) {}
+
+    [[nodiscard]] f_t getDefinition(f_t Callee) override {
+      return MWA.getDefinition(Callee);
+    }
+
+    [[nodiscard]] std::vector<EndSummaryTy> getEndSummaries(n_t SP,
+                                                            d_t Fact) override {
+      return MWA.summarize(SP, Fact);
+    }
+
+  private:
+    ModuleWiseAnalysis &MWA;
+  };
+
+  struct ModuleAnalysis {
+    llvm::Module *M = nullptr;
+    std::set<std::string> EntryPoints;
+    std::unique_ptr<PointerAnalysisTy> PointerInfo;
+    std::unique_ptr<CallGraphAnalysisTy> CallGraph;
+    std::unique_ptr<ProblemDescription> ProblemDesc;
+    std::unique_ptr<Solver> DataFlowSolver;
+    // the modules that define boundary functions this module declares
+    std::set<size_t> Dependencies;
+    size_t Component = 0;
+    bool Solved = false;
+    // set while the module's solver processes its worklist
+    bool Busy = false;
+    // summaries that have been queried while the module was busy
+    std::vector<std::pair<n_t, d_t>> PendingSeeds;
+  };
+
+  /// A strongly connected component of the module dependency graph.
+  struct ModuleComponent {
+    std::vector<size_t> Members;
+    size_t Level = 0;
+    std::mutex Mtx;
+    // the thread that currently solves the component
+    std::atomic<std::thread::id> Owner{};
+  };
+
+  ProjectIRDB &IRDB;
+  IFDSIDESolverConfig SolverConfig;
+  std::unique_ptr<TypeHierarchyTy> OwnedTypeHierarchy;
+  TypeHierarchyTy *TypeHierarchy;
+  ConfigurationTy *Config = nullptr;
+  unsigned NumThreads;
+  ModuleSummaries Summaries;
+  std::vector<ModuleAnalysis> Modules;
+  std::vector<std::unique_ptr<ModuleComponent>> Components;
+  // the boundary functions by name and the modules defining them
+  llvm::StringMap<f_t> BoundaryFunctions;
+  std::unordered_map<f_t, size_t> DefiningModule;
+
+public:
+  ModuleWiseAnalysis(IFDSIDESolverConfig SolverConfig, ProjectIRDB &IRDB,
+                     TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB), SolverConfig(SolverConfig),
+        OwnedTypeHierarchy(TypeHierarchy == nullptr
+                               ? std::make_unique<TypeHierarchyTy>(IRDB)
+                               : nullptr),
+        TypeHierarchy(TypeHierarchy == nullptr ? OwnedTypeHierarchy.get()
+                                               : TypeHierarchy),
+        NumThreads(std::max(SolverConfig.numThreads(), 1U)), Summaries(*this) {
+    // The modules are solved in parallel instead
+    this->SolverConfig.setNumThreads(1);
+    initialize();
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  ModuleWiseAnalysis(IFDSIDESolverConfig SolverConfig, ProjectIRDB &IRDB,
+                     ConfigurationTy *Config,
+                     TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB), SolverConfig(SolverConfig),
+        OwnedTypeHierarchy(TypeHierarchy == nullptr
+                               ? std::make_unique<TypeHierarchyTy>(IRDB)
+                               : nullptr),
+        TypeHierarchy(TypeHierarchy == nullptr ? OwnedTypeHierarchy.get()
+                                               : TypeHierarchy),
+        Config(Config), NumThreads(std::max(SolverConfig.numThreads(), 1U)),
+        Summaries(*this) {
+    this->SolverConfig.setNumThreads(1);
+    initialize();
+  }
+
+  ModuleWiseAnalysis(const ModuleWiseAnalysis &) = delete;
+  ModuleWiseAnalysis(ModuleWiseAnalysis &&) = delete;
+  ModuleWiseAnalysis &operator=(const ModuleWiseAnalysis &) = delete;
+  ModuleWiseAnalysis &operator=(ModuleWiseAnalysis &&) = delete;
+
+  ~ModuleWiseAnalysis() = default;
+
+  /// Runs Phase I on all modules, bottom-up along their dependencies, and
+  /// afterwards Phase II on all modules.
+  void solve() {
+    size_t MaxLevel = 0;
+    for (const auto &C : Components) {
+      MaxLevel = std::max(MaxLevel, C->Level);
+    }
+    for (size_t Level = 0; Level <= MaxLevel && !Components.empty(); ++Level) {
+      std::vector<ModuleComponent *> Current;
+      for (const auto &C : Components) {
+        if (C->Level == Level) {
+          Current.push_back(C.get());
+        }
+      }
+      PHASAR_LOG_LEVEL(INFO, "Solve " << Current.size()
+                                      << " module component(s) of level "
+                                      << Level);
+      forEachInParallel(Current.size(), [this, &Current](size_t Idx) {
+        ModuleComponent &C = *Current[Idx];
+        std::lock_guard<std::mutex> Lock(C.Mtx);
+        C.Owner = std::this_thread::get_id();
+        solveComponent(C);
+        C.Owner = std::thread::id();
+      });
+    }
+    if (SolverConfig.computeValues()) {
+      forEachInParallel(Modules.size(), [this](size_t Idx) {
+        Modules[Idx].DataFlowSolver->solvePhaseII();
+      });
+    }
+  }
+
+  void operator()() { solve(); }
+
+  /// Returns the end summaries of the boundary function starting at SP for
+  /// Fact holding at SP; the summaries are computed if necessary.
+  [[nodiscard]] std::vector<EndSummaryTy> summarize(n_t SP, d_t Fact) {
+    auto Search = DefiningModule.find(SP->getFunction());
+    if (Search == DefiningModule.end()) {
+      return {};
+    }
+    ModuleAnalysis &Unit = Modules[Search->second];
+    ModuleComponent &C = *Components[Unit.Component];
+    if (C.Owner == std::this_thread::get_id()) {
+      // The component is being solved on this thread, the query stems from
+      // one of its modules or from a component that depends on it
+      if (Unit.Busy) {
+        // avoid re-entering the solver, solveComponent() comes back to it
+        Unit.PendingSeeds.emplace_back(SP, Fact);
+        return Unit.DataFlowSolver->getEndSummaries(SP, Fact);
+      }
+      Unit.Busy = true;
+      auto Result = Unit.DataFlowSolver->summarize(SP, Fact);
+      Unit.Busy = false;
+      return Result;
+    }
+    std::lock_guard<std::mutex> Lock(C.Mtx);
+    C.Owner = std::this_thread::get_id();
+    Unit.PendingSeeds.emplace_back(SP, Fact);
+    solveComponent(C);
+    C.Owner = std::thread::id();
+    return Unit.DataFlowSolver->getEndSummaries(SP, Fact);
+  }
+
+  /// Returns the boundary function of another module that defines the
+  /// declaration Callee, or nullptr.
+  [[nodiscard]] f_t getDefinition(f_t Callee) const {
+    if (!Callee->isDeclaration()) {
+      return nullptr;
+    }
+    auto Search = BoundaryFunctions.find(Callee->getName());
+    return Search != BoundaryFunctions.end() ? Search->second : nullptr;
+  }
+
+  /// Returns the solver of M or nullptr if M has no boundary functions.
+  [[nodiscard]] Solver *getSolver(const llvm::Module *M) {
+    auto *Unit = getModuleAnalysis(M);
+    return Unit ? Unit->DataFlowSolver.get() : nullptr;
+  }
+
+  /// Returns the points-to information of M or nullptr if M has no boundary
+  /// functions.
+  [[nodiscard]] PointerAnalysisTy *getPointerInfo(const llvm::Module *M) {
+    auto *Unit = getModuleAnalysis(M);
+    return Unit ? Unit->PointerInfo.get() : nullptr;
+  }
+
+  /// Returns the call graph of M or nullptr if M has no boundary functions.
+  [[nodiscard]] CallGraphAnalysisTy *getCallGraph(const llvm::Module *M) {
+    auto *Unit = getModuleAnalysis(M);
+    return Unit ? Unit->CallGraph.get() : nullptr;
+  }
+
+  [[nodiscard]] size_t getNumberOfAnalyzedModules() const {
+    return Modules.size();
+  }
+
+  /// Returns the number of threads that solve the modules.
+  [[nodiscard]] unsigned getNumThreads() const noexcept { return NumThreads; }
+
+  void dumpResults(llvm::raw_ostream &OS = llvm::outs()) {
+    for (auto &Unit : Modules) {
+      OS << "Module: " << Unit.M->getModuleIdentifier() << '\n';
+      Unit.DataFlowSolver->dumpResults(OS);
+    }
+  }
+
+  void emitTextReport(llvm::raw_ostream &OS = llvm::outs()) {
+    for (auto &Unit : Modules) {
+      OS << "Module: " << Unit.M->getModuleIdentifier() << '\n';
+      Unit.DataFlowSolver->emitTextReport(OS);
+    }
+  }
+
+  void emitGraphicalReport(llvm::raw_ostream &OS = llvm::outs()) {
+    for (auto &Unit : Modules) {
+      OS << "Module: " << Unit.M->getModuleIdentifier() << '\n';
+      Unit.DataFlowSolver->emitGraphicalReport(OS);
+    }
+  }
+
+private:
+  [[nodiscard]] ModuleAnalysis *getModuleAnalysis(const llvm::Module *M) {
+    for (auto &Unit : Modules) {
+      if (Unit.M == M) {
+        return &Unit;
+      }
+    }
+    return nullptr;
+  }
+
+  void initialize() {
+    auto AllModules = IRDB.getAllModules();
+    std::vector<llvm::Module *> SortedModules(AllModules.begin(),
+                                              AllModules.end());
+    std::sort(SortedModules.begin(), SortedModules.end(),
+              [](const llvm::Module *LHS, const llvm::Module *RHS) {
+                return LHS->getModuleIdentifier() < RHS->getModuleIdentifier();
+              });
+    // collect the boundary functions, i.e., the unique definitions with
+    // external linkage
+    for (auto *M : SortedModules) {
+      ModuleAnalysis Unit;
+      Unit.M = M;
+      for (const auto &F : *M) {
+        if (F.isDeclaration() || !F.hasExternalLinkage() ||
+            IRDB.getFunctionDefinition(F.getName()) != &F) {
+          continue;
+        }
+        Unit.EntryPoints.insert(F.getName().str());
+        BoundaryFunctions[F.getName()] = &F;
+        DefiningModule[&F] = Modules.size();
+      }
+      if (Unit.EntryPoints.empty()) {
+        PHASAR_LOG_LEVEL(INFO, "Skip module without boundary functions: "
+                                   << M->getModuleIdentifier());
+        continue;
+      }
+      Modules.push_back(std::move(Unit));
+    }
+    for (size_t Idx = 0; Idx < Modules.size(); ++Idx) {
+      auto &Unit = Modules[Idx];
+      for (const auto &F : *Unit.M) {
+        if (!F.isDeclaration()) {
+          continue;
+        }
+        if (f_t Def = getDefinition(&F)) {
+          Unit.Dependencies.insert(DefiningModule[Def]);
+        }
+      }
+      Unit.Dependencies.erase(Idx);
+    }
+    computeComponents();
+    // The helper analyses are constructed sequentially, since they use the
+    // IRDB, the type hierarchy and possibly a shared LLVMContext, none of
+    // which are thread-safe
+    for (auto &Unit : Modules) {
+      Unit.PointerInfo = std::make_unique<PointerAnalysisTy>(IRDB, *Unit.M);
+      Unit.CallGraph = std::make_unique<CallGraphAnalysisTy>(
+          IRDB, CallGraphAnalysisType::OTF, Unit.EntryPoints, TypeHierarchy,
+          Unit.PointerInfo.get(), Soundness::Soundy,
+          /*IncludeGlobals*/ false);
+      if constexpr (std::is_same_v<ConfigurationTy, HasNoConfigurationType>) {
+        Unit.ProblemDesc = std::make_unique<ProblemDescription>(
+            &IRDB, TypeHierarchy, Unit.CallGraph.get(), Unit.PointerInfo.get(),
+            Unit.EntryPoints);
+      } else {
+        assert(Config && "The problem requires a configuration!");
+        Unit.ProblemDesc = std::make_unique<ProblemDescription>(
+            &IRDB, TypeHierarchy, Unit.CallGraph.get(), Unit.PointerInfo.get(),
+            *Config, Unit.EntryPoints);
+      }
+      if constexpr (has_setIFDSIDESolverConfig_v<ProblemDescription>) {
+        Unit.ProblemDesc->setIFDSIDESolverConfig(SolverConfig);
+      }
+      Unit.DataFlowSolver = std::make_unique<Solver>(*Unit.ProblemDesc);
+      Unit.DataFlowSolver->setExternalSummaries(&Summaries);
+    }
+    // The problems of the modules may share state, e.g., PAMM counters or
+    // the type hierarchy, unless they declare themselves thread-safe
+    if (NumThreads > 1 && !Modules.empty() &&
+        !Modules.front().ProblemDesc->isThreadSafe()) {
+      PHASAR_LOG_LEVEL(WARNING, "The analysis problem is not thread-safe, "
+                                "solve the modules sequentially");
+      NumThreads = 1;
+    }
+  }
+
+  /// Computes the strongly connected components of the module dependency
+  /// graph (Tarjan's algorithm, iteratively) and assigns each component a
+  /// level greater than the levels of all components it depends on.
+  void computeComponents() {
+    struct Frame {
+      size_t Idx;
+      std::vector<size_t> Deps;
+    };
+    constexpr size_t Unvisited = ~size_t(0);
+    std::vector<size_t> Index(Modules.size(), Unvisited);
+    std::vector<size_t> LowLink(Modules.size(), 0);
+    std::vector<bool> OnStack(Modules.size(), false);
+    std::vector<size_t> SCCStack;
+    std::vector<Frame> CallStack;
+    size_t NextIndex = 0;
+
+    auto Visit = [&](size_t Idx) {
+      Index[Idx] = LowLink[Idx] = NextIndex++;
+      SCCStack.push_back(Idx);
+      OnStack[Idx] = true;
+      CallStack.push_back({Idx, {Modules[Idx].Dependencies.begin(),
+                                 Modules[Idx].Dependencies.end()}});
+    };
+
+    for (size_t Root = 0; Root < Modules.size(); ++Root) {
+      if (Index[Root] != Unvisited) {
+        continue;
+      }
+      Visit(Root);
+      while (!CallStack.empty()) {
+        auto &Top = CallStack.back();
+        if (!Top.Deps.empty()) {
+          size_t Dep = Top.Deps.back();
+          Top.Deps.pop_back();
+          if (Index[Dep] == Unvisited) {
+            Visit(Dep);
+          } else if (OnStack[Dep]) {
+            LowLink[Top.Idx] = std::min(LowLink[Top.Idx], Index[Dep]);
+          }
+          continue;
+        }
+        size_t Idx = Top.Idx;
+        CallStack.pop_back();
+        if (!CallStack.empty()) {
+          size_t Parent = CallStack.back().Idx;
+          LowLink[Parent] = std::min(LowLink[Parent], LowLink[Idx]);
+        }
+        if (LowLink[Idx] != Index[Idx]) {
+          continue;
+        }
+        // Tarjan completes a component after all components it depends on
+        auto C = std::make_unique<ModuleComponent>();
+        size_t Member;
+        do {
+          Member = SCCStack.back();
+          SCCStack.pop_back();
+          OnStack[Member] = false;
+          Modules[Member].Component = Components.size();
+          C->Members.push_back(Member);
+        } while (Member != Idx);
+        for (size_t M : C->Members) {
+          for (size_t Dep : Modules[M].Dependencies) {
+            if (Modules[Dep].Component != Components.size()) {
+              C->Level = std::max(
+                  C->Level, Components[Modules[Dep].Component]->Level + 1);
+            }
+          }
+        }
+        std::sort(C->Members.begin(), C->Members.end());
+        Components.push_back(std::move(C));
+      }
+    }
+  }
+
+  /// Solves the modules of C until none of them discovers new path edges;
+  /// the calling thread must own C.
+  void solveComponent(ModuleComponent &C) {
+    bool Changed;
+    do {
+      Changed = false;
+      for (size_t Idx : C.Members) {
+        auto &Unit = Modules[Idx];
+        Unit.Busy = true;
+        if (!Unit.Solved) {
+          Unit.DataFlowSolver->solvePhaseI();
+          Unit.Solved = true;
+          Changed = true;
+        }
+        while (!Unit.PendingSeeds.empty()) {
+          auto [SP, Fact] = Unit.PendingSeeds.back();
+          Unit.PendingSeeds.pop_back();
+          Unit.DataFlowSolver->summarize(SP, Fact);
+          Changed = true;
+        }
+        Changed |= Unit.DataFlowSolver->reprocessExternalCalls();
+        Unit.Busy = false;
+      }
+    } while (Changed && C.Members.size() > 1);
+  }
+
+  /// Calls Fn for the indices [0, N) on up to NumThreads threads.
+  template <typename FnTy> void forEachInParallel(size_t N, FnTy Fn) {
+    std::atomic<size_t> Next{0};
+    auto Worker = [&]() {
+      for (size_t Idx = Next++; Idx < N; Idx = Next++) {
+        Fn(Idx);
+      }
+    };
+    std::vector<std::thread> Workers;
+    unsigned NumWorkers =
+        static_cast<unsigned>(std::min<size_t>(NumThreads, N));
+    for (unsigned I = 1; I < NumWorkers; ++I) {
+      Workers.emplace_back(Worker);
+    }
+    Worker();
+    for (auto &W : Workers) {
+      W.join();
+    }
+  }
+};
 
 } // namespace psr
 
@@ -10,22 +10,214 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_VARIATIONALANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_VARIATIONALANALYSIS_H_
 
+#include <cassert>
+#include <memory>
+#include <set>
+#include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
-#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/IntraMonoSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSToVariationalTabulationProblem.h"
+#include "phasar/PhasarLLVM/Utils/FeatureModel.h"
+#include "phasar/Utils/TypeTraits.h"
 
 namespace psr {
 
+/// Analyzes all configurations of a variability-encoded program (see
+/// FeatureModel) in a single solver run.
+///
+/// The IFDS problem ProblemDescription is lifted to an IDE problem over
+/// presence conditions (see IFDSToVariationalTabulationProblem): the value of
+/// a fact at a statement is the set of configurations in which the fact holds
+/// there. All code that does not depend on features, e.g., every function that
+/// does not branch on a feature, is analyzed once for all configurations
+/// rather than once per configuration.
+///
+/// Solver is the solver that solves ProblemDescription for a single
+/// configuration; the lifted problem is solved by an IDESolver. Only IFDS
+/// problems can be lifted, yet.
 template <typename Solver, typename ProblemDescription,
           typename Setup = psr::DefaultAnalysisSetup>
 class VariationalAnalysis {
+  // Check if the solver is able to solve the given problem description
+  static_assert(
+      std::is_base_of_v<typename Solver::ProblemTy, ProblemDescription>,
+      "Problem description does not match solver type!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
   static_assert(
-      std::is_base_of_v<typename Solver::ProblemType, ProblemDescription>,
-      "ProblemDesciption does not match SolverType");
+      std::is_same_v<typename ProblemDescription::l_t, BinaryDomain>,
+      "Only IFDS problems can be analyzed variationally, yet!");
+
+public:
+  using AnalysisDomainTy = typename ProblemDescription::ProblemAnalysisDomain;
+  using LiftedProblemTy = IFDSToVariationalTabulationProblem<AnalysisDomainTy>;
+  using LiftedSolverTy = IDESolver<VariationalAnalysisDomain<AnalysisDomainTy>>;
+  using n_t = typename LiftedSolverTy::n_t;
+  using d_t = typename LiftedSolverTy::d_t;
+  using f_t = typename LiftedSolverTy::f_t;
+  using l_t = typename LiftedSolverTy::l_t;
 
 private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  IFDSIDESolverConfig SolverConfig;
+  FeatureModel Features;
+  std::unique_ptr<TypeHierarchyTy> OwnedTypeHierarchy;
+  std::unique_ptr<PointerAnalysisTy> OwnedPointerInfo;
+  std::unique_ptr<CallGraphAnalysisTy> OwnedCallGraph;
+  std::unique_ptr<ProblemDescription> ProblemDesc;
+  std::unique_ptr<LiftedProblemTy> LiftedProblem;
+  std::unique_ptr<LiftedSolverTy> DataFlowSolver;
+
 public:
+  VariationalAnalysis(IFDSIDESolverConfig SolverConfig, ProjectIRDB &IRDB,
+                      std::vector<std::set<std::string>> Configurations,
+                      std::set<std::string> EntryPoints = {},
+                      PointerAnalysisTy *PointerInfo = nullptr,
+                      CallGraphAnalysisTy *CallGraph = nullptr,
+                      TypeHierarchyTy *TypeHierarchy = nullptr)
+      : SolverConfig(SolverConfig), Features(IRDB, std::move(Configurations)) {
+    initialize(IRDB, nullptr, std::move(EntryPoints), PointerInfo, CallGraph,
+               TypeHierarchy);
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  VariationalAnalysis(IFDSIDESolverConfig SolverConfig, ProjectIRDB &IRDB,
+                      std::vector<std::set<std::string>> Configurations,
+                      ConfigurationTy *Config,
+                      std::set<std::string> EntryPoints = {},
+                      PointerAnalysisTy *PointerInfo = nullptr,
+                      CallGraphAnalysisTy *CallGraph = nullptr,
+                      TypeHierarchyTy *TypeHierarchy = nullptr)
+      : SolverConfig(SolverConfig), Features(IRDB, std::move(Configurations)) {
+    initialize(IRDB, Config, std::move(EntryPoints), PointerInfo, CallGraph,
+               TypeHierarchy);
+  }
+
+  VariationalAnalysis(const VariationalAnalysis &) = delete;
+  VariationalAnalysis(VariationalAnalysis &&) = delete;
+  VariationalAnalysis &operator=(const VariationalAnalysis &) = delete;
+  VariationalAnalysis &operator=(VariationalAnalysis &&) = delete;
+
+  ~VariationalAnalysis() = default;
+
+  void solve() { DataFlowSolver->solve(); }
+
+  void operator()() { solve(); }
+
+  /// Returns the configurations in which Fact holds at Stmt.
+  [[nodiscard]] PresenceCondition resultAt(n_t Stmt, d_t Fact) {
+    auto PC = DataFlowSolver->resultAt(Stmt, Fact);
+    // facts that have never been reached have no presence condition at all
+    return PC.empty() ? Features.getFalse() : PC;
+  }
+
+  /// Returns the facts that hold at Stmt in at least one configuration
+  /// together with their presence conditions.
+  [[nodiscard]] std::unordered_map<d_t, PresenceCondition>
+  resultsAt(n_t Stmt, bool StripZero = false) {
+    auto Results = DataFlowSolver->resultsAt(Stmt, StripZero);
+    for (auto It = Results.begin(); It != Results.end();) {
+      if (It->second.none()) {
+        It = Results.erase(It);
+      } else {
+        ++It;
+      }
+    }
+    return Results;
+  }
+
+  /// Returns the facts that hold at Stmt in the given configuration, i.e.,
+  /// the results of the original problem for that configuration.
+  [[nodiscard]] std::set<d_t> resultsAt(n_t Stmt, size_t Configuration,
+                                        bool StripZero = false) {
+    assert(Configuration < Features.getNumConfigurations());
+    std::set<d_t> Facts;
+    for (const auto &[Fact, PC] : DataFlowSolver->resultsAt(Stmt, StripZero)) {
+      if (Configuration < PC.size() && PC.test(Configuration)) {
+        Facts.insert(Fact);
+      }
+    }
+    return Facts;
+  }
+
+  [[nodiscard]] const FeatureModel &getFeatureModel() const noexcept {
+    return Features;
+  }
+
+  [[nodiscard]] LiftedSolverTy &getSolver() { return *DataFlowSolver; }
+
+  /// Returns the original problem. Note that the state it records while being
+  /// solved, e.g., the leaks of a taint analysis, is not restricted to the
+  /// configurations in which it occurs; use resultsAt() or emitTextReport()
+  /// for that.
+  [[nodiscard]] ProblemDescription &getProblem() { return *ProblemDesc; }
+
+  [[nodiscard]] LiftedProblemTy &getLiftedProblem() { return *LiftedProblem; }
+
+  void dumpResults(llvm::raw_ostream &OS = llvm::outs()) {
+    Features.print(OS);
+    DataFlowSolver->dumpResults(OS);
+  }
+
+  /// Emits the report of the original problem for each configuration.
+  void emitTextReport(llvm::raw_ostream &OS = llvm::outs()) {
+    DataFlowSolver->emitTextReport(OS);
+  }
+
+  void emitGraphicalReport(llvm::raw_ostream &OS = llvm::outs()) {
+    DataFlowSolver->emitGraphicalReport(OS);
+  }
+
+private:
+  void initialize(ProjectIRDB &IRDB, ConfigurationTy *Config,
+                  std::set<std::string> EntryPoints,
+                  PointerAnalysisTy *PointerInfo,
+                  CallGraphAnalysisTy *CallGraph,
+                  TypeHierarchyTy *TypeHierarchy) {
+    if (!TypeHierarchy) {
+      OwnedTypeHierarchy = std::make_unique<TypeHierarchyTy>(IRDB);
+      TypeHierarchy = OwnedTypeHierarchy.get();
+    }
+    if (!PointerInfo) {
+      OwnedPointerInfo = std::make_unique<PointerAnalysisTy>(IRDB);
+      PointerInfo = OwnedPointerInfo.get();
+    }
+    if (!CallGraph) {
+      OwnedCallGraph = std::make_unique<CallGraphAnalysisTy>(
+          IRDB, CallGraphAnalysisType::OTF, EntryPoints, TypeHierarchy,
+          PointerInfo);
+      CallGraph = OwnedCallGraph.get();
+    }
+    if constexpr (std::is_same_v<ConfigurationTy, HasNoConfigurationType>) {
+      ProblemDesc = std::make_unique<ProblemDescription>(
+          &IRDB, TypeHierarchy, CallGraph, PointerInfo, EntryPoints);
+    } else {
+      assert(Config && "The problem requires a configuration!");
+      ProblemDesc = std::make_unique<ProblemDescription>(
+          &IRDB, TypeHierarchy, CallGraph, PointerInfo, *Config, EntryPoints);
+    }
+    if constexpr (has_setIFDSIDESolverConfig_v<ProblemDescription>) {
+      ProblemDesc->setIFDSIDESolverConfig(SolverConfig);
+    }
+    LiftedProblem = std::make_unique<LiftedProblemTy>(*ProblemDesc, Features);
+    DataFlowSolver = std::make_unique<LiftedSolverTy>(*LiftedProblem);
+  }
 };
 
 } // namespace psr
@@ -10,6 +10,7 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_WHOLEPROGRAMANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_WHOLEPROGRAMANALYSIS_H_
 
+#include <filesystem>
 #include <iosfwd>
 #include <memory>
 #include <set>
@@ -20,7 +21,15 @@
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/JoinLattice.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/LLVMPersistedSummaries.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryPack.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryStore.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
+#include "phasar/PhasarLLVM/Utils/FunctionHashes.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/TypeTraits.h"
 
 namespace psr {
 
@@ -41,6 +50,11 @@ private:
   using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
   using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
 
+  // Summary packs only hold the summaries of IFDS problems on LLVM IR
+  static constexpr bool SupportsSummaryPacks =
+      std::is_same_v<typename ProblemDescription::d_t, const llvm::Value *> &&
+      std::is_same_v<typename Solver::l_t, BinaryDomain>;
+
   ProjectIRDB &IRDB;
   std::unique_ptr<TypeHierarchyTy> TypeHierarchy;
   std::unique_ptr<PointerAnalysisTy> PointerInfo;
@@ -49,6 +63,7 @@ private:
   ConfigurationTy *Config = nullptr;
   bool OwnsConfig = false;
   std::string ConfigPath;
+  std::unique_ptr<SummaryPack> Pack;
   ProblemDescription ProblemDesc;
   Solver DataFlowSolver;
 
@@ -71,7 +86,8 @@ public:
                             this->TypeHierarchy.get(), this->PointerInfo.get())
                       : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
         EntryPoints(EntryPoints),
-        ProblemDesc(&IRDB, TypeHierarchy, CallGraph, PointerInfo, EntryPoints),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), EntryPoints),
         DataFlowSolver(ProblemDesc) {
     if constexpr (has_setIFDSIDESolverConfig_v<ProblemDescription>) {
       ProblemDesc.setIFDSIDESolverConfig(SolverConfig);
@@ -100,8 +116,8 @@ public:
                             this->TypeHierarchy.get(), this->PointerInfo.get())
                       : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
         EntryPoints(EntryPoints), Config(Config),
-        ProblemDesc(&IRDB, TypeHierarchy, CallGraph, PointerInfo, *Config,
-                    EntryPoints),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), *Config, EntryPoints),
         DataFlowSolver(ProblemDesc) {
     if constexpr (has_setIFDSIDESolverConfig_v<ProblemDescription>) {
       ProblemDesc.setIFDSIDESolverConfig(SolverConfig);
@@ -131,8 +147,8 @@ public:
                       : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
         EntryPoints(EntryPoints), Config(new ConfigurationTy(ConfigPath)),
         OwnsConfig(true), ConfigPath(ConfigPath),
-        ProblemDesc(&IRDB, TypeHierarchy, CallGraph, PointerInfo, *Config,
-                    EntryPoints),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), *Config, EntryPoints),
         DataFlowSolver(ProblemDesc) {
     if constexpr (has_setIFDSIDESolverConfig_v<ProblemDescription>) {
       ProblemDesc.setIFDSIDESolverConfig(SolverConfig);
@@ -151,7 +167,46 @@ public:
     }
   }
 
-  void solve() { DataFlowSolver.solve(); }
+  void solve() {
+    if constexpr (has_setIFDSIDESolverConfig_v<ProblemDescription>) {
+      const auto &SolverConfig = ProblemDesc.getIFDSIDESolverConfig();
+      if ((SolverConfig.generateSummaryPack() ||
+           SolverConfig.computePersistedSummaries()) &&
+          !ProblemDesc.canPersistSummaries()) {
+        // The summaries would miss the side effects of the flow functions
+        PHASAR_LOG_LEVEL(WARNING, "The problem does not support persisted "
+                                  "summaries, solve it without them");
+        DataFlowSolver.solve();
+        return;
+      }
+      if (SolverConfig.generateSummaryPack() ||
+          !SolverConfig.summaryPacks().empty()) {
+        if constexpr (SupportsSummaryPacks) {
+          if (SolverConfig.generateSummaryPack()) {
+            generateSummaryPack();
+            return;
+          }
+          loadSummaryPacks();
+        } else {
+          PHASAR_LOG_LEVEL(WARNING, "Summary packs are only supported for "
+                                    "IFDS problems with data-flow facts of "
+                                    "type 'const llvm::Value *'");
+        }
+      }
+      if (SolverConfig.computePersistedSummaries()) {
+        if constexpr (std::is_same_v<typename ProblemDescription::d_t,
+                                     const llvm::Value *>) {
+          solveWithPersistedSummaries();
+          return;
+        } else {
+          PHASAR_LOG_LEVEL(WARNING, "Persisted summaries are only supported "
+                                    "for data-flow facts of type "
+                                    "'const llvm::Value *'");
+        }
+      }
+    }
+    DataFlowSolver.solve();
+  }
 
   void operator()() { solve(); }
 
@@ -186,6 +241,91 @@ public:
   CallGraphAnalysisTy *releaseCallGraph() { return CallGraph.release(); }
 
   TypeHierarchyTy *releaseTypeHierarchy() { return TypeHierarchy.release(); }
+
+private:
+  /// Solves the problem reusing the summaries persisted in the summary store
+  /// of the problem and adds the summaries computed by this run to the store.
+  void solveWithPersistedSummaries() {
+    using l_t = typename Solver::l_t;
+    const auto &SolverConfig = ProblemDesc.getIFDSIDESolverConfig();
+    auto Path =
+        std::filesystem::path(SolverConfig.persistedSummariesDirectory()) /
+        (SolverConfig.persistedSummariesID() + ".psum");
+    SummaryStore Store(SolverConfig.persistedSummariesID());
+    Store.readFromFile(Path.string());
+    FunctionHashes Hashes(IRDB);
+    l_t Bottom = [this]() -> l_t {
+      if constexpr (std::is_base_of_v<
+                        JoinLattice<
+                            typename ProblemDescription::ProblemAnalysisDomain>,
+                        ProblemDescription>) {
+        return ProblemDesc.bottomElement();
+      } else {
+        return BinaryDomain::BOTTOM;
+      }
+    }();
+    LLVMPersistedSummaries<l_t> Summaries(Store, Hashes,
+                                          ProblemDesc.getZeroValue(), Bottom);
+    DataFlowSolver.setPersistedSummaries(&Summaries);
+    DataFlowSolver.solve();
+    DataFlowSolver.exportPersistedSummaries();
+    DataFlowSolver.setPersistedSummaries(nullptr);
+    PHASAR_LOG_LEVEL(INFO, "Reused " << Summaries.getNumReused()
+                                     << " and computed "
+                                     << Summaries.getNumAdded()
+                                     << " persisted summaries");
+    std::error_code EC;
+    std::filesystem::create_directories(Path.parent_path(), EC);
+    Store.writeToFile(Path.string());
+  }
+
+  /// Loads the summary packs of the problem, such that the solver applies
+  /// them to calls of the functions they summarize.
+  void loadSummaryPacks() {
+    const auto &SolverConfig = ProblemDesc.getIFDSIDESolverConfig();
+    Pack = std::make_unique<SummaryPack>(SolverConfig.persistedSummariesID());
+    for (const auto &Path : SolverConfig.summaryPacks()) {
+      Pack->load(Path);
+    }
+    Pack->index(IRDB);
+    DataFlowSolver.setSummaryPack(Pack.get());
+  }
+
+  /// Computes the end summaries of all function definitions that do not
+  /// access mutable global variables for the zero value and each of their
+  /// arguments and writes them as the summary pack of the problem. Library
+  /// bitcode should be analyzed with all functions as entry points, such that
+  /// the call graph covers all of them.
+  void generateSummaryPack() {
+    const auto &SolverConfig = ProblemDesc.getIFDSIDESolverConfig();
+    auto Path =
+        std::filesystem::path(SolverConfig.persistedSummariesDirectory()) /
+        (SolverConfig.persistedSummariesID() + ".pack");
+    SummaryStore Store(SolverConfig.persistedSummariesID());
+    FunctionHashes Hashes(IRDB);
+    const auto *ICF = ProblemDesc.getICFG();
+    for (const auto *F : IRDB.getAllFunctions()) {
+      if (F->isDeclaration() || Hashes.mayAccessMutableGlobals(F->getName())) {
+        continue;
+      }
+      for (const auto *SP : ICF->getStartPointsOf(F)) {
+        DataFlowSolver.summarize(SP, ProblemDesc.getZeroValue());
+        for (const auto &Arg : F->args()) {
+          DataFlowSolver.summarize(SP, &Arg);
+        }
+      }
+    }
+    LLVMPersistedSummaries<BinaryDomain> Summaries(
+        Store, Hashes, ProblemDesc.getZeroValue(), BinaryDomain::BOTTOM);
+    DataFlowSolver.setPersistedSummaries(&Summaries);
+    DataFlowSolver.exportPersistedSummaries();
+    DataFlowSolver.setPersistedSummaries(nullptr);
+    PHASAR_LOG_LEVEL(INFO, "Computed the summaries of " << Store.size()
+                                                         << " functions");
+    std::error_code EC;
+    std::filesystem::create_directories(Path.parent_path(), EC);
+    Store.writeToFile(Path.string());
+  }
 };
 
 } // namespace psr
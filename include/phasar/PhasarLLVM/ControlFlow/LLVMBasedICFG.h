@@ -17,8 +17,10 @@
 #ifndef PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDICFG_H_
 #define PHASAR_PHASARLLVM_CONTROLFLOW_LLVMBASEDICFG_H_
 
+#include <algorithm>
 #include <iosfwd>
 #include <memory>
+#include <optional>
 #include <set>
 #include <stack>
 #include <string>
@@ -29,6 +31,8 @@
 #include "boost/container/flat_set.hpp"
 #include "boost/graph/adjacency_list.hpp"
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/IR/Constants.h"
@@ -38,6 +42,7 @@
 
 #include "phasar/PhasarLLVM/ControlFlow/ICFG.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedCFG.h"
+#include "phasar/PhasarLLVM/ControlFlow/Resolver/Resolver.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
 #include "phasar/Utils/Soundness.h"
 
@@ -51,7 +56,6 @@ class BitCastInst;
 
 namespace psr {
 
-class Resolver;
 class ProjectIRDB;
 class LLVMTypeHierarchy;
 
@@ -72,6 +76,7 @@ private:
   LLVMTypeHierarchy *TH;
   LLVMPointsToInfo *PT;
   std::unique_ptr<Resolver> Res;
+  unsigned NumThreads = 1;
   llvm::DenseSet<const llvm::Function *> VisitedFunctions;
   std::unordered_set<llvm::Function *> UserEntryPoints;
 
@@ -86,9 +91,16 @@ private:
   // The worklist for direct callee resolution.
   std::vector<const llvm::Function *> FunctionWL;
 
-  // Map indirect calls to the number of possible targets found for it. Fixpoint
-  // is not reached when more targets are found.
-  llvm::DenseMap<const llvm::Instruction *, unsigned> IndirectCalls;
+  struct IndirectCallInfo {
+    // The number of possible targets found so far. Fixpoint is not reached
+    // when more targets are found.
+    unsigned NumTargets = 0;
+    // The resolver's version of the information the targets have been
+    // resolved with. The call does not need to be resolved again unless the
+    // version changes.
+    std::optional<size_t> ResolvedVersion;
+  };
+  llvm::DenseMap<const llvm::Instruction *, IndirectCallInfo> IndirectCalls;
   // The VertexProperties for our call-graph.
   struct VertexProperties {
     const llvm::Function *F = nullptr;
@@ -124,13 +136,69 @@ private:
   /// Maps functions to the corresponding vertex id.
   std::unordered_map<const llvm::Function *, vertex_t> FunctionVertexMap;
 
+  /// Frozen adjacency index in compressed sparse row format: the values
+  /// associated with a key are stored contiguously in sorted order.
+  template <typename KeyT, typename ValueT> class CallGraphIndex {
+  public:
+    void build(llvm::DenseMap<KeyT, std::vector<ValueT>> &&Adjacency) {
+      Ranges.clear();
+      Values.clear();
+      Ranges.reserve(Adjacency.size());
+      for (auto &[Key, Adjacent] : Adjacency) {
+        std::sort(Adjacent.begin(), Adjacent.end());
+        Adjacent.erase(std::unique(Adjacent.begin(), Adjacent.end()),
+                       Adjacent.end());
+        Ranges[Key] = {Values.size(), Values.size() + Adjacent.size()};
+        Values.insert(Values.end(), Adjacent.begin(), Adjacent.end());
+      }
+    }
+
+    [[nodiscard]] llvm::ArrayRef<ValueT> lookup(KeyT Key) const {
+      auto Search = Ranges.find(Key);
+      if (Search == Ranges.end()) {
+        return {};
+      }
+      return llvm::makeArrayRef(Values).slice(
+          Search->second.first, Search->second.second - Search->second.first);
+    }
+
+  private:
+    llvm::DenseMap<KeyT, std::pair<size_t, size_t>> Ranges;
+    std::vector<ValueT> Values;
+  };
+
+  /// Call-site -> possible callees
+  CallGraphIndex<const llvm::Instruction *, const llvm::Function *>
+      CalleeIndex;
+  /// Function -> call-sites that may call it
+  CallGraphIndex<const llvm::Function *, const llvm::Instruction *>
+      CallerIndex;
+
+  /// (Re-)builds CalleeIndex and CallerIndex from the call graph. Must be
+  /// called whenever the call graph's edges have been modified.
+  void buildCallGraphIndex();
+
   void processFunction(const llvm::Function *F, Resolver &Resolver,
                        bool &FixpointReached);
 
   bool constructDynamicCall(const llvm::Instruction *I, Resolver &Resolver);
 
+  /// Adds the PossibleTargets of the indirect CallSite that have not been
+  /// found before to the call graph.
+  bool addDynamicCallTargets(const llvm::CallBase *CallSite, Resolver &Resolver,
+                             Resolver::FunctionSetTy PossibleTargets);
+
+  /// Resolves all indirect calls whose resolution may have changed since they
+  /// have been resolved the last time. The calls are resolved in parallel if
+  /// multiple threads are requested and the resolver supports it.
+  /// \return true iff new targets have been found.
+  bool resolveIndirectCalls(Resolver &Resolver);
+
+  Resolver::FunctionSetTy resolveIndirectCall(const llvm::CallBase *CallSite,
+                                              Resolver &Resolver) const;
+
   std::unique_ptr<Resolver>
-  makeResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH, LLVMPointsToInfo &PT);
+  makeResolver(ProjectIRDB &IRDB, LLVMTypeHierarchy &TH, LLVMPointsToInfo *PT);
 
   template <typename MapTy>
   static void insertGlobalCtorsDtorsImpl(MapTy &Into, const llvm::Module *M,
@@ -176,10 +244,18 @@ public:
   using OutEdgesAndTargets = std::unordered_multimap<const llvm::Instruction *,
                                                      const llvm::Function *>;
 
+  /**
+   * Constructs the call graph starting at the given entry points. If
+   * NumThreads is greater than one, indirect calls are resolved in parallel
+   * if the resolver for CGType supports it. PT is only used by the OTF
+   * resolver and may be nullptr otherwise; for OTF, a LLVMPointsToSet is
+   * constructed if PT is nullptr.
+   */
   LLVMBasedICFG(ProjectIRDB &IRDB, CallGraphAnalysisType CGType,
                 const std::set<std::string> &EntryPoints = {},
                 LLVMTypeHierarchy *TH = nullptr, LLVMPointsToInfo *PT = nullptr,
-                Soundness S = Soundness::Soundy, bool IncludeGlobals = true);
+                Soundness S = Soundness::Soundy, bool IncludeGlobals = true,
+                unsigned NumThreads = 1);
 
   LLVMBasedICFG(const LLVMBasedICFG &ICF);
 
@@ -259,6 +335,14 @@ public:
   [[nodiscard]] std::set<const llvm::Function *>
   getCalleesOfCallAt(const llvm::Instruction *N) const override;
 
+  /**
+   * \return all callee methods for a given call that might be called in
+   * ascending order without allocating. The returned reference is
+   * invalidated if the call graph is modified.
+   */
+  [[nodiscard]] llvm::ArrayRef<const llvm::Function *>
+  getCalleesOfCallAtRef(const llvm::Instruction *N) const;
+
   void forEachCalleeOfCallAt(
       const llvm::Instruction *I,
       llvm::function_ref<void(const llvm::Function *)> Callback) const;
@@ -269,6 +353,14 @@ public:
   [[nodiscard]] std::set<const llvm::Instruction *>
   getCallersOf(const llvm::Function *Fun) const override;
 
+  /**
+   * \return all caller statements/nodes of a given method in ascending order
+   * without allocating. The returned reference is invalidated if the call
+   * graph is modified.
+   */
+  [[nodiscard]] llvm::ArrayRef<const llvm::Instruction *>
+  getCallersOfRef(const llvm::Function *Fun) const;
+
   /**
    * \return all call sites within a given method.
    */
@@ -34,6 +34,8 @@ public:
   ~CHAResolver() override = default;
 
   FunctionSetTy resolveVirtualCall(const llvm::CallBase *CallSite) override;
+
+  [[nodiscard]] bool isResolutionThreadSafe() const override;
 };
 } // namespace psr
 
@@ -41,6 +41,8 @@ public:
 
 protected:
   TypeGraph_t TypeGraph;
+  // incremented whenever TypeGraph changes
+  size_t TypeGraphVersion = 0;
 
   /**
    * An heuristic that return true if the bitcast instruction is interesting to
@@ -64,6 +66,11 @@ public:
   FunctionSetTy resolveVirtualCall(const llvm::CallBase *CallSite) override;
 
   void otherInst(const llvm::Instruction *Inst) override;
+
+  [[nodiscard]] size_t
+  getResolutionVersion(const llvm::CallBase *CallSite) override;
+
+  [[nodiscard]] bool isResolutionThreadSafe() const override;
 };
 } // namespace psr
 
@@ -65,6 +65,11 @@ public:
 
   FunctionSetTy resolveFunctionPointer(const llvm::CallBase *CallSite) override;
 
+  [[nodiscard]] size_t
+  getResolutionVersion(const llvm::CallBase *CallSite) override;
+
+  [[nodiscard]] bool isResolutionThreadSafe() const override;
+
   static std::set<const llvm::Type *>
   getReachableTypes(const LLVMPointsToInfo::PointsToSetTy &Values);
 
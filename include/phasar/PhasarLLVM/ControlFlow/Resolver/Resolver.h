@@ -17,6 +17,7 @@
 #ifndef PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_RESOLVER_H_
 #define PHASAR_PHASARLLVM_CONTROLFLOW_RESOLVER_RESOLVER_H_
 
+#include <cstddef>
 #include <optional>
 #include <set>
 #include <string>
@@ -70,6 +71,18 @@ public:
   virtual FunctionSetTy resolveFunctionPointer(const llvm::CallBase *CallSite);
 
   virtual void otherInst(const llvm::Instruction *Inst);
+
+  /// Returns the version of the information the resolution of CallSite is
+  /// based on. Resolving CallSite again can only yield new targets if its
+  /// version has changed since it has been resolved the last time. The
+  /// default implementation is suitable for resolvers whose results do not
+  /// depend on the parts of the call-graph that have been constructed so far.
+  [[nodiscard]] virtual size_t
+  getResolutionVersion(const llvm::CallBase *CallSite);
+
+  /// Returns true if resolveVirtualCall() and resolveFunctionPointer() may be
+  /// called concurrently and preCall() and postCall() do nothing.
+  [[nodiscard]] virtual bool isResolutionThreadSafe() const;
 };
 } // namespace psr
 
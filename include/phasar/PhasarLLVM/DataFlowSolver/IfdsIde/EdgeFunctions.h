@@ -17,6 +17,7 @@
 #ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_EDGEFUNCTIONS_H_
 #define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_EDGEFUNCTIONS_H_
 
+#include "llvm/ADT/Hashing.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -30,6 +31,7 @@
 #include <sstream>
 #include <string>
 #include <thread>
+#include <typeinfo>
 #include <utility>
 
 namespace psr {
@@ -83,6 +85,22 @@ public:
       equal_to // NOLINT - would break too many client analyses
       (EdgeFunctionPtrType OtherFunction) const = 0;
 
+  //
+  // Edge functions that return true are interned by the IDESolver, i.e. all
+  // functions that are equal_to each other are represented by a single
+  // canonical object (see EdgeFunctionArena). This requires equal_to to be an
+  // equivalence relation that implies equal results of computeTarget.
+  //
+  [[nodiscard]] virtual bool isInternable() const { return false; }
+
+  //
+  // Returns a hash code that is equal for all functions that are equal_to each
+  // other. Only used for internable edge functions.
+  //
+  [[nodiscard]] virtual llvm::hash_code getHashCode() const {
+    return llvm::hash_value(this);
+  }
+
   virtual void print(llvm::raw_ostream &OS,
                      [[maybe_unused]] bool IsForDebug = false) const {
     OS << "EdgeFunction";
@@ -142,6 +160,12 @@ public:
     return false;
   }
 
+  [[nodiscard]] bool isInternable() const override { return true; }
+
+  [[nodiscard]] llvm::hash_code getHashCode() const override {
+    return typeid(AllTop<L>).hash_code();
+  }
+
   void print(llvm::raw_ostream &OS,
              [[maybe_unused]] bool IsForDebug = false) const override {
     OS << "AllTop";
@@ -198,6 +222,12 @@ public:
     return false;
   }
 
+  [[nodiscard]] bool isInternable() const override { return true; }
+
+  [[nodiscard]] llvm::hash_code getHashCode() const override {
+    return typeid(AllBottom<L>).hash_code();
+  }
+
   void print(llvm::raw_ostream &OS,
              bool /*IsForDebug = false*/) const override {
     OS << "AllBottom";
@@ -246,6 +276,8 @@ public:
     return this == Other.get();
   }
 
+  [[nodiscard]] bool isInternable() const override { return true; }
+
   static EdgeFunctionPtrType getInstance() {
     // implement singleton C++11 thread-safe (see Scott Meyers)
     static EdgeFunctionPtrType Instance(new EdgeIdentity<L>());
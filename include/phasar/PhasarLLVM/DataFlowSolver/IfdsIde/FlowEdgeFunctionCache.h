@@ -11,21 +11,28 @@
 #define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_FLOWEDGEFUNCTIONCACHE_H_
 
 #include <algorithm>
+#include <cstdint>
+#include <list>
 #include <map>
 #include <memory>
 #include <set>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFact.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryPack.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
 #include "phasar/Utils/EquivalenceClassMap.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/PAMMMacros.h"
+#include "phasar/Utils/TypeTraits.h"
 
 namespace psr {
 template <typename KeyT> class DefaultMapKeyCompressor {
@@ -58,11 +65,134 @@ private:
   llvm::DenseMap<KeyType, CompressedType> Map{};
 };
 
+/// Compresses keys of any hashable type to consecutive integer ids.
+template <typename KeyT, typename HashT = std::hash<KeyT>>
+class HashedMapKeyCompressor {
+public:
+  using KeyType = KeyT;
+  using CompressedType = uint32_t;
+
+  [[nodiscard]] inline CompressedType getCompressedID(const KeyT &Key) {
+    return Map.try_emplace(Key, Map.size() + 1).first->second;
+  }
+
+private:
+  std::unordered_map<KeyType, CompressedType, HashT> Map{};
+};
+
+/// Hashes a set of hashable elements, e.g., the callees of a call site.
+template <typename T> struct SetHash {
+  size_t operator()(const std::set<T> &Set) const {
+    llvm::hash_code Hash = llvm::hash_value(Set.size());
+    for (const auto &Elem : Set) {
+      Hash = llvm::hash_combine(Hash, std::hash<T>{}(Elem));
+    }
+    return Hash;
+  }
+};
+
+/// Compresses keys of any type that provides an ordering to consecutive
+/// integer ids. Only used for keys that cannot be hashed.
+template <typename KeyT> class OrderedMapKeyCompressor {
+public:
+  using KeyType = KeyT;
+  using CompressedType = uint32_t;
+
+  [[nodiscard]] inline CompressedType getCompressedID(const KeyT &Key) {
+    return Map.try_emplace(Key, Map.size() + 1).first->second;
+  }
+
+private:
+  std::map<KeyType, CompressedType> Map{};
+};
+
+/// Maps compressed keys to cached flow or edge functions using an
+/// open-addressing hash map. If a maximum size is given, the least recently
+/// used entry is evicted whenever an insertion would exceed it.
+template <typename KeyT, typename ValueT> class FunctionCacheMap {
+public:
+  explicit FunctionCacheMap(size_t MaxSize = 0) : MaxSize(MaxSize) {}
+
+  ~FunctionCacheMap() = default;
+
+  FunctionCacheMap(const FunctionCacheMap &Other)
+      : MaxSize(Other.MaxSize), NumEvicted(Other.NumEvicted),
+        Values(Other.Values), Items(Other.Items) {
+    for (auto It = Items.begin(); It != Items.end(); ++It) {
+      Index[It->first] = It;
+    }
+  }
+  FunctionCacheMap &operator=(const FunctionCacheMap &Other) {
+    if (this != &Other) {
+      FunctionCacheMap Copy(Other);
+      *this = std::move(Copy);
+    }
+    return *this;
+  }
+  FunctionCacheMap(FunctionCacheMap &&) noexcept = default;
+  FunctionCacheMap &operator=(FunctionCacheMap &&) noexcept = default;
+
+  /// Returns the value cached for Key or nullptr. The pointer is invalidated
+  /// by the next insertion.
+  [[nodiscard]] ValueT *find(const KeyT &Key) {
+    if (MaxSize == 0) {
+      auto Search = Values.find(Key);
+      return Search == Values.end() ? nullptr : &Search->second;
+    }
+    auto Search = Index.find(Key);
+    if (Search == Index.end()) {
+      return nullptr;
+    }
+    // Mark the entry as the most recently used one.
+    Items.splice(Items.begin(), Items, Search->second);
+    return &Search->second->second;
+  }
+
+  /// Caches Val for Key, which must not have been cached yet.
+  ValueT &insert(const KeyT &Key, ValueT Val) {
+    if (MaxSize == 0) {
+      return Values.try_emplace(Key, std::move(Val)).first->second;
+    }
+    if (Index.size() >= MaxSize) {
+      Index.erase(Items.back().first);
+      Items.pop_back();
+      ++NumEvicted;
+    }
+    Items.emplace_front(Key, std::move(Val));
+    Index[Key] = Items.begin();
+    return Items.front().second;
+  }
+
+  [[nodiscard]] size_t size() const {
+    return MaxSize == 0 ? Values.size() : Index.size();
+  }
+
+  /// Returns the number of entries that have been evicted so far.
+  [[nodiscard]] size_t getNumEvicted() const { return NumEvicted; }
+
+private:
+  using ItemListTy = std::list<std::pair<KeyT, ValueT>>;
+
+  size_t MaxSize;
+  size_t NumEvicted = 0;
+  // used if the size is not bounded
+  llvm::DenseMap<KeyT, ValueT> Values;
+  // used if the size is bounded; the most recently used item comes first
+  ItemListTy Items;
+  llvm::DenseMap<KeyT, typename ItemListTy::iterator> Index;
+};
+
 /**
  * This class caches flow and edge functions to avoid their reconstruction.
  * When a flow or edge function must be applied to multiple times, a cached
  * version is used if existend, otherwise a new one is created and inserted
  * into the cache.
+ *
+ * All caches are keyed by the addresses of the IR entities (and the memo of
+ * composed and joined edge functions by the addresses of its operands), so a
+ * cache must not be kept across modifications of the IR it was built for.
+ * Nothing detects such modifications; clients that reuse edge functions after
+ * changing the IR have to call clearEdgeFunctionMemo() themselves.
  */
 template <typename AnalysisDomainTy,
           typename Container = std::set<typename AnalysisDomainTy::d_t>>
@@ -75,28 +205,43 @@ class FlowEdgeFunctionCache {
   using d_t = typename AnalysisDomainTy::d_t;
   using f_t = typename AnalysisDomainTy::f_t;
   using t_t = typename AnalysisDomainTy::t_t;
-
-  using DTKeyCompressorType = std::conditional_t<
-      std::is_base_of_v<llvm::Value, std::remove_pointer_t<d_t>>,
-      LLVMMapKeyCompressor, DefaultMapKeyCompressor<d_t>>;
-  using NTKeyCompressorType = std::conditional_t<
-      std::is_base_of_v<llvm::Value, std::remove_pointer_t<n_t>>,
-      LLVMMapKeyCompressor, DefaultMapKeyCompressor<n_t>>;
-
-  using MapKeyCompressorType = std::conditional_t<
-      std::is_same_v<NTKeyCompressorType, DTKeyCompressorType>,
-      NTKeyCompressorType,
-      MapKeyCompressorCombinator<NTKeyCompressorType, DTKeyCompressorType>>;
+  using l_t = typename AnalysisDomainTy::l_t;
+
+  // Summary packs only hold the summaries of IFDS problems on LLVM IR
+  static constexpr bool SupportsSummaryPacks =
+      std::is_same_v<n_t, const llvm::Instruction *> &&
+      std::is_same_v<d_t, const llvm::Value *> &&
+      std::is_same_v<f_t, const llvm::Function *> &&
+      std::is_same_v<l_t, BinaryDomain>;
+
+  template <typename T>
+  using KeyCompressorType = std::conditional_t<
+      std::is_base_of_v<llvm::Value, std::remove_pointer_t<T>>,
+      LLVMMapKeyCompressor,
+      std::conditional_t<is_std_hashable_v<T>, HashedMapKeyCompressor<T>,
+                         OrderedMapKeyCompressor<T>>>;
+  using CalleeSetCompressorType = std::conditional_t<
+      is_std_hashable_v<f_t>,
+      HashedMapKeyCompressor<std::set<f_t>, SetHash<f_t>>,
+      OrderedMapKeyCompressor<std::set<f_t>>>;
 
 private:
-  MapKeyCompressorType KeyCompressor;
+  // All keys are made up of the compressed ids of nodes, facts, functions and
+  // sets of callees.
+  KeyCompressorType<n_t> NodeCompressor;
+  KeyCompressorType<d_t> FactCompressor;
+  KeyCompressorType<f_t> FunctionCompressor;
+  CalleeSetCompressorType CalleeSetCompressor;
 
   using EdgeFuncInstKey = uint64_t;
-  using EdgeFuncNodeKey = std::conditional_t<
-      std::is_base_of_v<llvm::Value, std::remove_pointer_t<d_t>>, uint64_t,
-      std::pair<d_t, d_t>>;
+  using EdgeFuncNodeKey = uint64_t;
   using InnerEdgeFunctionMapType =
       EquivalenceClassMap<EdgeFuncNodeKey, EdgeFunctionPtrType>;
+  using Key2 = std::tuple<uint32_t, uint32_t>;
+  using Key3 = std::tuple<uint32_t, uint32_t, uint32_t>;
+  using Key4 = std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>;
+  using Key6 = std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t,
+                          uint32_t>;
 
   IDETabulationProblem<AnalysisDomainTy, Container> &Problem;
   // Auto add zero
@@ -114,23 +259,37 @@ private:
   };
 
   // Caches for the flow/edge functions
-  std::map<EdgeFuncInstKey, NormalEdgeFlowData> NormalFunctionCache;
+  FunctionCacheMap<EdgeFuncInstKey, NormalEdgeFlowData> NormalFunctionCache;
 
   // Caches for the flow functions
-  std::map<std::tuple<n_t, f_t>, FlowFunctionPtrType> CallFlowFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, n_t>, FlowFunctionPtrType>
-      ReturnFlowFunctionCache;
-  std::map<std::tuple<n_t, n_t, std::set<f_t>>, FlowFunctionPtrType>
-      CallToRetFlowFunctionCache;
+  FunctionCacheMap<Key2, FlowFunctionPtrType> CallFlowFunctionCache;
+  FunctionCacheMap<Key4, FlowFunctionPtrType> ReturnFlowFunctionCache;
+  FunctionCacheMap<Key3, FlowFunctionPtrType> CallToRetFlowFunctionCache;
+  FunctionCacheMap<Key2, FlowFunctionPtrType> SummaryFlowFunctionCache;
   // Caches for the edge functions
-  std::map<std::tuple<n_t, d_t, f_t, d_t>, EdgeFunctionPtrType>
-      CallEdgeFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
-      ReturnEdgeFunctionCache;
-  std::map<EdgeFuncInstKey, InnerEdgeFunctionMapType>
+  FunctionCacheMap<Key4, EdgeFunctionPtrType> CallEdgeFunctionCache;
+  FunctionCacheMap<Key6, EdgeFunctionPtrType> ReturnEdgeFunctionCache;
+  FunctionCacheMap<EdgeFuncInstKey, InnerEdgeFunctionMapType>
       CallToRetEdgeFunctionCache;
-  std::map<std::tuple<n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
-      SummaryEdgeFunctionCache;
+  FunctionCacheMap<Key4, EdgeFunctionPtrType> SummaryEdgeFunctionCache;
+
+  // Memoized results of EdgeFunction::composeWith() and
+  // EdgeFunction::joinWith(), keyed by the identities of the two operands. An
+  // entry keeps its operands alive, hence their addresses cannot be reused by
+  // other edge functions as long as the entry exists. The entries are only
+  // valid as long as the IR the edge functions were built for is unchanged.
+  struct MemoizedEdgeFunction {
+    EdgeFunctionPtrType First;
+    EdgeFunctionPtrType Second;
+    EdgeFunctionPtrType Result;
+  };
+  using EdgeFunctionMemoType =
+      llvm::DenseMap<std::pair<const void *, const void *>,
+                     MemoizedEdgeFunction>;
+  EdgeFunctionMemoType ComposeMemo;
+  EdgeFunctionMemoType JoinMemo;
+  size_t MaxMemoSize;
+  SummaryPack *Pack = nullptr;
 
 public:
   // Ctor allows access to the IDEProblem in order to get access to flow and
@@ -139,7 +298,17 @@ public:
       IDETabulationProblem<AnalysisDomainTy, Container> &Problem)
       : Problem(Problem),
         AutoAddZero(Problem.getIFDSIDESolverConfig().autoAddZero()),
-        ZV(Problem.getZeroValue()) {
+        ZV(Problem.getZeroValue()),
+        NormalFunctionCache(getMaxCacheSize()),
+        CallFlowFunctionCache(getMaxCacheSize()),
+        ReturnFlowFunctionCache(getMaxCacheSize()),
+        CallToRetFlowFunctionCache(getMaxCacheSize()),
+        SummaryFlowFunctionCache(getMaxCacheSize()),
+        CallEdgeFunctionCache(getMaxCacheSize()),
+        ReturnEdgeFunctionCache(getMaxCacheSize()),
+        CallToRetEdgeFunctionCache(getMaxCacheSize()),
+        SummaryEdgeFunctionCache(getMaxCacheSize()),
+        MaxMemoSize(Problem.getIFDSIDESolverConfig().edgeFunctionMemoSize()) {
     PAMM_GET_INSTANCE;
     REG_COUNTER("Normal-FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Normal-FF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
@@ -170,6 +339,11 @@ public:
     // Counters for the summary edge functions
     REG_COUNTER("Summary-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Summary-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    // Counters for the memoized compositions and joins of edge functions
+    REG_COUNTER("Compose-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Compose-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Join-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Join-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
   }
 
   ~FlowEdgeFunctionCache() = default;
@@ -188,18 +362,17 @@ public:
         PHASAR_LOG_LEVEL(DEBUG, "(N) Curr Inst : " << Problem.NtoString(Curr));
         PHASAR_LOG_LEVEL(DEBUG, "(N) Succ Inst : " << Problem.NtoString(Succ)));
     auto Key = createEdgeFunctionInstKey(Curr, Succ);
-    auto SearchNormalFlowFunction = NormalFunctionCache.find(Key);
-    if (SearchNormalFlowFunction != NormalFunctionCache.end()) {
+    if (auto *SearchNormalFlowFunction = NormalFunctionCache.find(Key)) {
       PHASAR_LOG_LEVEL(DEBUG, "Flow function fetched from cache");
       INC_COUNTER("Normal-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      if (SearchNormalFlowFunction->second.FlowFuncPtr != nullptr) {
-        return SearchNormalFlowFunction->second.FlowFuncPtr;
+      if (SearchNormalFlowFunction->FlowFuncPtr != nullptr) {
+        return SearchNormalFlowFunction->FlowFuncPtr;
       }
       auto FF = (AutoAddZero)
                     ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
                           Problem.getNormalFlowFunction(Curr, Succ), ZV)
                     : Problem.getNormalFlowFunction(Curr, Succ);
-      SearchNormalFlowFunction->second.FlowFuncPtr = FF;
+      SearchNormalFlowFunction->FlowFuncPtr = FF;
       return FF;
     }
     INC_COUNTER("Normal-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
@@ -207,7 +380,7 @@ public:
                   ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
                         Problem.getNormalFlowFunction(Curr, Succ), ZV)
                   : Problem.getNormalFlowFunction(Curr, Succ);
-    NormalFunctionCache.insert(std::make_pair(Key, NormalEdgeFlowData(FF)));
+    NormalFunctionCache.insert(Key, NormalEdgeFlowData(FF));
     PHASAR_LOG_LEVEL(DEBUG, "Flow function constructed");
 
     return FF;
@@ -220,19 +393,19 @@ public:
                                                << Problem.NtoString(CallSite));
                    PHASAR_LOG_LEVEL(
                        DEBUG, "(F) Dest Fun : " << Problem.FtoString(DestFun)));
-    auto Key = std::tie(CallSite, DestFun);
-    auto SearchCallFlowFunction = CallFlowFunctionCache.find(Key);
-    if (SearchCallFlowFunction != CallFlowFunctionCache.end()) {
+    Key2 Key(NodeCompressor.getCompressedID(CallSite),
+             FunctionCompressor.getCompressedID(DestFun));
+    if (auto *SearchCallFlowFunction = CallFlowFunctionCache.find(Key)) {
       PHASAR_LOG_LEVEL(DEBUG, "Flow function fetched from cache");
       INC_COUNTER("Call-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return SearchCallFlowFunction->second;
+      return *SearchCallFlowFunction;
     }
     INC_COUNTER("Call-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
     auto FF = (AutoAddZero)
                   ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
                         Problem.getCallFlowFunction(CallSite, DestFun), ZV)
                   : Problem.getCallFlowFunction(CallSite, DestFun);
-    CallFlowFunctionCache.insert(std::make_pair(Key, FF));
+    CallFlowFunctionCache.insert(Key, FF);
     PHASAR_LOG_LEVEL(DEBUG, "Flow function constructed");
     return FF;
   }
@@ -250,12 +423,14 @@ public:
                          "(N) Exit Stmt : " << Problem.NtoString(ExitInst));
         PHASAR_LOG_LEVEL(DEBUG,
                          "(N) Ret Site  : " << Problem.NtoString(RetSite)));
-    auto Key = std::tie(CallSite, CalleeFun, ExitInst, RetSite);
-    auto SearchReturnFlowFunction = ReturnFlowFunctionCache.find(Key);
-    if (SearchReturnFlowFunction != ReturnFlowFunctionCache.end()) {
+    Key4 Key(NodeCompressor.getCompressedID(CallSite),
+             FunctionCompressor.getCompressedID(CalleeFun),
+             NodeCompressor.getCompressedID(ExitInst),
+             NodeCompressor.getCompressedID(RetSite));
+    if (auto *SearchReturnFlowFunction = ReturnFlowFunctionCache.find(Key)) {
       PHASAR_LOG_LEVEL(DEBUG, "Flow function fetched from cache");
       INC_COUNTER("Return-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return SearchReturnFlowFunction->second;
+      return *SearchReturnFlowFunction;
     }
     INC_COUNTER("Return-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
     auto FF = (AutoAddZero)
@@ -265,7 +440,7 @@ public:
                         ZV)
                   : Problem.getRetFlowFunction(CallSite, CalleeFun, ExitInst,
                                                RetSite);
-    ReturnFlowFunctionCache.insert(std::make_pair(Key, FF));
+    ReturnFlowFunctionCache.insert(Key, FF);
     PHASAR_LOG_LEVEL(DEBUG, "Flow function constructed");
     return FF;
   }
@@ -284,12 +459,14 @@ public:
                                                           : Callees) {
           PHASAR_LOG_LEVEL(DEBUG, "  " << Problem.FtoString(callee));
         };)
-    auto Key = std::tie(CallSite, RetSite, Callees);
-    auto SearchCallToRetFlowFunction = CallToRetFlowFunctionCache.find(Key);
-    if (SearchCallToRetFlowFunction != CallToRetFlowFunctionCache.end()) {
+    Key3 Key(NodeCompressor.getCompressedID(CallSite),
+             NodeCompressor.getCompressedID(RetSite),
+             CalleeSetCompressor.getCompressedID(Callees));
+    if (auto *SearchCallToRetFlowFunction =
+            CallToRetFlowFunctionCache.find(Key)) {
       PHASAR_LOG_LEVEL(DEBUG, "Flow function fetched from cache");
       INC_COUNTER("CallToRet-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return SearchCallToRetFlowFunction->second;
+      return *SearchCallToRetFlowFunction;
     }
     INC_COUNTER("CallToRet-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
     auto FF =
@@ -298,7 +475,7 @@ public:
                   Problem.getCallToRetFlowFunction(CallSite, RetSite, Callees),
                   ZV)
             : Problem.getCallToRetFlowFunction(CallSite, RetSite, Callees);
-    CallToRetFlowFunctionCache.insert(std::make_pair(Key, FF));
+    CallToRetFlowFunctionCache.insert(Key, FF);
     PHASAR_LOG_LEVEL(DEBUG, "Flow function constructed");
     return FF;
   }
@@ -314,9 +491,28 @@ public:
                          "(F) Dest Mthd : " << Problem.FtoString(DestFun));
         PHASAR_LOG_LEVEL(DEBUG, ' '));
     auto FF = Problem.getSummaryFlowFunction(CallSite, DestFun);
+    if constexpr (SupportsSummaryPacks) {
+      if (!FF && Pack) {
+        FF = getSummaryPackFlowFunction(CallSite, DestFun);
+      }
+    }
     return FF;
   }
 
+  /// Lets getSummaryFlowFunction() fall back to the summaries of Pack for
+  /// callees the problem does not provide a summary flow function for. Pack
+  /// must be indexed for the program under analysis and outlive this cache.
+  void setSummaryPack(SummaryPack *Pack) {
+    static_assert(SupportsSummaryPacks,
+                  "Summary packs are only supported for IFDS problems on LLVM "
+                  "IR");
+    this->Pack = Pack;
+    SummaryFlowFunctionCache =
+        FunctionCacheMap<Key2, FlowFunctionPtrType>(getMaxCacheSize());
+  }
+
+  [[nodiscard]] SummaryPack *getSummaryPack() const noexcept { return Pack; }
+
   EdgeFunctionPtrType getNormalEdgeFunction(n_t Curr, d_t CurrNode, n_t Succ,
                                             d_t SuccNode) {
     PAMM_GET_INSTANCE;
@@ -330,11 +526,10 @@ public:
                          "(D) Succ Node : " << Problem.DtoString(SuccNode)));
 
     EdgeFuncInstKey OuterMapKey = createEdgeFunctionInstKey(Curr, Succ);
-    auto SearchInnerMap = NormalFunctionCache.find(OuterMapKey);
-    if (SearchInnerMap != NormalFunctionCache.end()) {
-      auto SearchEdgeFunc = SearchInnerMap->second.EdgeFunctionMap.find(
+    if (auto *SearchInnerMap = NormalFunctionCache.find(OuterMapKey)) {
+      auto SearchEdgeFunc = SearchInnerMap->EdgeFunctionMap.find(
           createEdgeFunctionNodeKey(CurrNode, SuccNode));
-      if (SearchEdgeFunc != SearchInnerMap->second.EdgeFunctionMap.end()) {
+      if (SearchEdgeFunc != SearchInnerMap->EdgeFunctionMap.end()) {
         INC_COUNTER("Normal-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
         PHASAR_LOG_LEVEL(DEBUG, "Edge function fetched from cache");
         PHASAR_LOG_LEVEL(
@@ -344,7 +539,7 @@ public:
       INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto EF = Problem.getNormalEdgeFunction(Curr, CurrNode, Succ, SuccNode);
 
-      SearchInnerMap->second.EdgeFunctionMap.insert(
+      SearchInnerMap->EdgeFunctionMap.insert(
           createEdgeFunctionNodeKey(CurrNode, SuccNode), EF);
 
       PHASAR_LOG_LEVEL(DEBUG, "Edge function constructed");
@@ -354,7 +549,7 @@ public:
     INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
     auto EF = Problem.getNormalEdgeFunction(Curr, CurrNode, Succ, SuccNode);
 
-    NormalFunctionCache.try_emplace(
+    NormalFunctionCache.insert(
         OuterMapKey, NormalEdgeFlowData(InnerEdgeFunctionMapType{std::make_pair(
                          createEdgeFunctionNodeKey(CurrNode, SuccNode), EF)}));
 
@@ -378,19 +573,21 @@ public:
             DEBUG, "(F) Dest Fun : " << Problem.FtoString(DestinationFunction));
         PHASAR_LOG_LEVEL(DEBUG,
                          "(D) Dest Node : " << Problem.DtoString(DestNode)));
-    auto Key = std::tie(CallSite, SrcNode, DestinationFunction, DestNode);
-    auto SearchCallEdgeFunction = CallEdgeFunctionCache.find(Key);
-    if (SearchCallEdgeFunction != CallEdgeFunctionCache.end()) {
+    Key4 Key(NodeCompressor.getCompressedID(CallSite),
+             FactCompressor.getCompressedID(SrcNode),
+             FunctionCompressor.getCompressedID(DestinationFunction),
+             FactCompressor.getCompressedID(DestNode));
+    if (auto *SearchCallEdgeFunction = CallEdgeFunctionCache.find(Key)) {
       INC_COUNTER("Call-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       PHASAR_LOG_LEVEL(DEBUG, "Edge function fetched from cache");
       PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: "
-                                  << SearchCallEdgeFunction->second->str());
-      return SearchCallEdgeFunction->second;
+                                  << (*SearchCallEdgeFunction)->str());
+      return *SearchCallEdgeFunction;
     }
     INC_COUNTER("Call-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
     auto EF = Problem.getCallEdgeFunction(CallSite, SrcNode,
                                           DestinationFunction, DestNode);
-    CallEdgeFunctionCache.insert(std::make_pair(Key, EF));
+    CallEdgeFunctionCache.insert(Key, EF);
     PHASAR_LOG_LEVEL(DEBUG, "Edge function constructed");
     PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: " << EF->str());
     return EF;
@@ -414,20 +611,23 @@ public:
                          "(N) Ret Site  : " << Problem.NtoString(RetSite));
         PHASAR_LOG_LEVEL(DEBUG,
                          "(D) Ret Node  : " << Problem.DtoString(RetNode)));
-    auto Key = std::tie(CallSite, CalleeFunction, ExitInst, ExitNode, RetSite,
-                        RetNode);
-    auto SearchReturnEdgeFunction = ReturnEdgeFunctionCache.find(Key);
-    if (SearchReturnEdgeFunction != ReturnEdgeFunctionCache.end()) {
+    Key6 Key(NodeCompressor.getCompressedID(CallSite),
+             FunctionCompressor.getCompressedID(CalleeFunction),
+             NodeCompressor.getCompressedID(ExitInst),
+             FactCompressor.getCompressedID(ExitNode),
+             NodeCompressor.getCompressedID(RetSite),
+             FactCompressor.getCompressedID(RetNode));
+    if (auto *SearchReturnEdgeFunction = ReturnEdgeFunctionCache.find(Key)) {
       INC_COUNTER("Return-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       PHASAR_LOG_LEVEL(DEBUG, "Edge function fetched from cache");
       PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: "
-                                  << SearchReturnEdgeFunction->second->str());
-      return SearchReturnEdgeFunction->second;
+                                  << (*SearchReturnEdgeFunction)->str());
+      return *SearchReturnEdgeFunction;
     }
     INC_COUNTER("Return-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
     auto EF = Problem.getReturnEdgeFunction(CallSite, CalleeFunction, ExitInst,
                                             ExitNode, RetSite, RetNode);
-    ReturnEdgeFunctionCache.insert(std::make_pair(Key, EF));
+    ReturnEdgeFunctionCache.insert(Key, EF);
     PHASAR_LOG_LEVEL(DEBUG, "Edge function constructed");
     PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: " << EF->str());
     return EF;
@@ -455,11 +655,10 @@ public:
         });
 
     EdgeFuncInstKey OuterMapKey = createEdgeFunctionInstKey(CallSite, RetSite);
-    auto SearchInnerMap = CallToRetEdgeFunctionCache.find(OuterMapKey);
-    if (SearchInnerMap != CallToRetEdgeFunctionCache.end()) {
-      auto SearchEdgeFunc = SearchInnerMap->second.find(
+    if (auto *SearchInnerMap = CallToRetEdgeFunctionCache.find(OuterMapKey)) {
+      auto SearchEdgeFunc = SearchInnerMap->find(
           createEdgeFunctionNodeKey(CallNode, RetSiteNode));
-      if (SearchEdgeFunc != SearchInnerMap->second.end()) {
+      if (SearchEdgeFunc != SearchInnerMap->end()) {
         INC_COUNTER("CallToRet-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
         PHASAR_LOG_LEVEL(DEBUG, "Edge function fetched from cache");
         PHASAR_LOG_LEVEL(
@@ -470,8 +669,8 @@ public:
       auto EF = Problem.getCallToRetEdgeFunction(CallSite, CallNode, RetSite,
                                                  RetSiteNode, Callees);
 
-      SearchInnerMap->second.insert(
-          createEdgeFunctionNodeKey(CallNode, RetSiteNode), EF);
+      SearchInnerMap->insert(createEdgeFunctionNodeKey(CallNode, RetSiteNode),
+                             EF);
 
       PHASAR_LOG_LEVEL(DEBUG, "Edge function constructed");
       PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: " << EF->str());
@@ -482,7 +681,7 @@ public:
     auto EF = Problem.getCallToRetEdgeFunction(CallSite, CallNode, RetSite,
                                                RetSiteNode, Callees);
 
-    CallToRetEdgeFunctionCache.emplace(
+    CallToRetEdgeFunctionCache.insert(
         OuterMapKey,
         InnerEdgeFunctionMapType{std::make_pair(
             createEdgeFunctionNodeKey(CallNode, RetSiteNode), EF)});
@@ -505,24 +704,63 @@ public:
         PHASAR_LOG_LEVEL(DEBUG,
                          "(D) Ret Node  : " << Problem.DtoString(RetSiteNode));
         PHASAR_LOG_LEVEL(DEBUG, ' '));
-    auto Key = std::tie(CallSite, CallNode, RetSite, RetSiteNode);
-    auto SearchSummaryEdgeFunction = SummaryEdgeFunctionCache.find(Key);
-    if (SearchSummaryEdgeFunction != SummaryEdgeFunctionCache.end()) {
+    Key4 Key(NodeCompressor.getCompressedID(CallSite),
+             FactCompressor.getCompressedID(CallNode),
+             NodeCompressor.getCompressedID(RetSite),
+             FactCompressor.getCompressedID(RetSiteNode));
+    if (auto *SearchSummaryEdgeFunction = SummaryEdgeFunctionCache.find(Key)) {
       INC_COUNTER("Summary-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       PHASAR_LOG_LEVEL(DEBUG, "Edge function fetched from cache");
       PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: "
-                                  << SearchSummaryEdgeFunction->second->str());
-      return SearchSummaryEdgeFunction->second;
+                                  << (*SearchSummaryEdgeFunction)->str());
+      return *SearchSummaryEdgeFunction;
     }
     INC_COUNTER("Summary-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
     auto EF = Problem.getSummaryEdgeFunction(CallSite, CallNode, RetSite,
                                              RetSiteNode);
-    SummaryEdgeFunctionCache.insert(std::make_pair(Key, EF));
+    SummaryEdgeFunctionCache.insert(Key, EF);
     PHASAR_LOG_LEVEL(DEBUG, "Edge function constructed");
     PHASAR_LOG_LEVEL(DEBUG, "Provide Edge Function: " << EF->str());
     return EF;
   }
 
+  /// Returns First->composeWith(Second); the result is memoized.
+  EdgeFunctionPtrType composeEdgeFunctions(const EdgeFunctionPtrType &First,
+                                           const EdgeFunctionPtrType &Second) {
+    PAMM_GET_INSTANCE;
+    if (auto Search = ComposeMemo.find({First.get(), Second.get()});
+        Search != ComposeMemo.end()) {
+      INC_COUNTER("Compose-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
+      return Search->second.Result;
+    }
+    INC_COUNTER("Compose-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto EF = First->composeWith(Second);
+    memoize(ComposeMemo, First, Second, EF);
+    return EF;
+  }
+
+  /// Returns First->joinWith(Second); the result is memoized.
+  EdgeFunctionPtrType joinEdgeFunctions(const EdgeFunctionPtrType &First,
+                                        const EdgeFunctionPtrType &Second) {
+    PAMM_GET_INSTANCE;
+    if (auto Search = JoinMemo.find({First.get(), Second.get()});
+        Search != JoinMemo.end()) {
+      INC_COUNTER("Join-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
+      return Search->second.Result;
+    }
+    INC_COUNTER("Join-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto EF = First->joinWith(Second);
+    memoize(JoinMemo, First, Second, EF);
+    return EF;
+  }
+
+  /// Drops all memoized compositions and joins, e.g. after the IR has been
+  /// modified.
+  void clearEdgeFunctionMemo() {
+    ComposeMemo.clear();
+    JoinMemo.clear();
+  }
+
   void print() {
     if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
       PAMM_GET_INSTANCE;
@@ -588,6 +826,17 @@ public:
                     {"Normal-EF Construction", "Call-EF Construction",
                      "Return-EF Construction", "CallToRet-EF Construction",
                      "Summary-EF Construction"}));
+      PHASAR_LOG_LEVEL(INFO, "Evicted flow and edge function cache entries: "
+                                 << getNumEvicted());
+      PHASAR_LOG_LEVEL(INFO, ' ');
+      PHASAR_LOG_LEVEL(INFO, "Edge function composition cache hits: "
+                                 << GET_COUNTER("Compose-EF Cache Hit"));
+      PHASAR_LOG_LEVEL(INFO, "Edge function compositions: "
+                                 << GET_COUNTER("Compose-EF Construction"));
+      PHASAR_LOG_LEVEL(INFO, "Edge function join cache hits: "
+                                 << GET_COUNTER("Join-EF Cache Hit"));
+      PHASAR_LOG_LEVEL(INFO, "Edge function joins: "
+                                 << GET_COUNTER("Join-EF Construction"));
       PHASAR_LOG_LEVEL(INFO, "----------------------------------------------");
     } else {
       PHASAR_LOG_LEVEL(
@@ -595,25 +844,86 @@ public:
     }
   }
 
+  /// Returns the number of entries that have been evicted from the flow and
+  /// edge function caches due to the configured size bound.
+  [[nodiscard]] size_t getNumEvicted() const {
+    return NormalFunctionCache.getNumEvicted() +
+           CallFlowFunctionCache.getNumEvicted() +
+           ReturnFlowFunctionCache.getNumEvicted() +
+           CallToRetFlowFunctionCache.getNumEvicted() +
+           SummaryFlowFunctionCache.getNumEvicted() +
+           CallEdgeFunctionCache.getNumEvicted() +
+           ReturnEdgeFunctionCache.getNumEvicted() +
+           CallToRetEdgeFunctionCache.getNumEvicted() +
+           SummaryEdgeFunctionCache.getNumEvicted();
+  }
+
 private:
+  FlowFunctionPtrType getSummaryPackFlowFunction(n_t CallSite, f_t DestFun) {
+    PAMM_GET_INSTANCE;
+    const auto *Summary = Pack->lookup(DestFun);
+    if (!Summary) {
+      return nullptr;
+    }
+    Key2 Key(NodeCompressor.getCompressedID(CallSite),
+             FunctionCompressor.getCompressedID(DestFun));
+    if (auto *SearchSummaryFlowFunction = SummaryFlowFunctionCache.find(Key)) {
+      INC_COUNTER("Summary-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
+      return *SearchSummaryFlowFunction;
+    }
+    INC_COUNTER("Summary-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+    typename SummaryPackFlowFunction<Container>::ReturnFlowFunctionsTy
+        ReturnFlowFunctions;
+    const auto *ICF = Problem.getICFG();
+    for (n_t ExitInst : ICF->getExitPointsOf(DestFun)) {
+      for (n_t RetSite : ICF->getReturnSitesOfCallAt(CallSite)) {
+        ReturnFlowFunctions.emplace_back(
+            ExitInst, getRetFlowFunction(CallSite, DestFun, ExitInst, RetSite));
+      }
+    }
+    FlowFunctionPtrType FF =
+        std::make_shared<SummaryPackFlowFunction<Container>>(
+            Pack->getStore(), *DestFun, *Summary, ZV,
+            getCallFlowFunction(CallSite, DestFun),
+            std::move(ReturnFlowFunctions));
+    SummaryFlowFunctionCache.insert(Key, FF);
+    PHASAR_LOG_LEVEL(DEBUG, "Summary pack flow function constructed");
+    return FF;
+  }
+
+  size_t getMaxCacheSize() const {
+    return Problem.getIFDSIDESolverConfig().flowEdgeFunctionCacheSize();
+  }
+
+  void memoize(EdgeFunctionMemoType &Memo, const EdgeFunctionPtrType &First,
+               const EdgeFunctionPtrType &Second,
+               const EdgeFunctionPtrType &Result) {
+    if (MaxMemoSize == 0) {
+      return;
+    }
+    if (Memo.size() >= MaxMemoSize) {
+      // Start over instead of tracking the recency of all entries; the entries
+      // that are hot will be recomputed right away.
+      Memo.clear();
+    }
+    Memo.try_emplace({First.get(), Second.get()},
+                     MemoizedEdgeFunction{First, Second, Result});
+  }
+
   inline EdgeFuncInstKey createEdgeFunctionInstKey(n_t Lhs, n_t Rhs) {
     uint64_t Val = 0;
-    Val |= KeyCompressor.getCompressedID(Lhs);
+    Val |= NodeCompressor.getCompressedID(Lhs);
     Val <<= 32;
-    Val |= KeyCompressor.getCompressedID(Rhs);
+    Val |= NodeCompressor.getCompressedID(Rhs);
     return Val;
   }
 
   inline EdgeFuncNodeKey createEdgeFunctionNodeKey(d_t Lhs, d_t Rhs) {
-    if constexpr (std::is_base_of_v<llvm::Value, std::remove_pointer_t<d_t>>) {
-      uint64_t Val = 0;
-      Val |= KeyCompressor.getCompressedID(Lhs);
-      Val <<= 32;
-      Val |= KeyCompressor.getCompressedID(Rhs);
-      return Val;
-    } else {
-      return std::make_pair(Lhs, Rhs);
-    }
+    uint64_t Val = 0;
+    Val |= FactCompressor.getCompressedID(Lhs);
+    Val <<= 32;
+    Val |= FactCompressor.getCompressedID(Rhs);
+    return Val;
   }
 };
 
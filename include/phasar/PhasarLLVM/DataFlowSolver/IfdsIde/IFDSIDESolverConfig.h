@@ -17,6 +17,10 @@
 #ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_IFDSIDESOLVERCONFIG_H_
 #define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_IFDSIDESOLVERCONFIG_H_
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 #include "phasar/Config/Configuration.h"
 #include "phasar/Utils/EnumFlags.h"
 #include "phasar/Utils/Logger.h"
@@ -35,10 +39,26 @@ enum class SolverConfigOptions : uint32_t {
   RecordEdges = 8,
   EmitESG = 16,
   ComputePersistedSummaries = 32,
+  GenerateSummaryPack = 64,
 
   All = ~0U
 };
 
+/// Determines the order in which the IDESolver processes the path edges that
+/// are pending in its Phase I worklist.
+enum class PathEdgeSchedulingPolicy {
+#define PATH_EDGE_SCHEDULING_POLICY(NAME, CMDFLAG, TYPE) TYPE,
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/PathEdgeSchedulingPolicy.def"
+  Invalid
+};
+
+std::string toString(const PathEdgeSchedulingPolicy &P);
+
+PathEdgeSchedulingPolicy toPathEdgeSchedulingPolicy(const std::string &S);
+
+llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
+                              const PathEdgeSchedulingPolicy &P);
+
 struct IFDSIDESolverConfig {
   IFDSIDESolverConfig() noexcept = default;
   IFDSIDESolverConfig(SolverConfigOptions Options) noexcept;
@@ -55,6 +75,14 @@ struct IFDSIDESolverConfig {
   [[nodiscard]] bool recordEdges() const;
   [[nodiscard]] bool emitESG() const;
   [[nodiscard]] bool computePersistedSummaries() const;
+  [[nodiscard]] bool generateSummaryPack() const;
+  [[nodiscard]] PathEdgeSchedulingPolicy schedulingPolicy() const;
+  [[nodiscard]] unsigned numThreads() const;
+  [[nodiscard]] size_t edgeFunctionMemoSize() const;
+  [[nodiscard]] size_t flowEdgeFunctionCacheSize() const;
+  [[nodiscard]] const std::string &persistedSummariesDirectory() const;
+  [[nodiscard]] const std::string &persistedSummariesID() const;
+  [[nodiscard]] const std::vector<std::string> &summaryPacks() const;
 
   void setFollowReturnsPastSeeds(bool Set = true);
   void setAutoAddZero(bool Set = true);
@@ -62,6 +90,36 @@ struct IFDSIDESolverConfig {
   void setRecordEdges(bool Set = true);
   void setEmitESG(bool Set = true);
   void setComputePersistedSummaries(bool Set = true);
+  /// Lets the whole-program analysis compute the summaries of all function
+  /// definitions of the analyzed module(s), e.g., of a library, and write
+  /// them as a summary pack to <persisted summaries directory>/<id>.pack
+  /// instead of solving the problem for its entry points.
+  void setGenerateSummaryPack(bool Set = true);
+  void setSchedulingPolicy(PathEdgeSchedulingPolicy Policy);
+  /// Sets the number of worker threads used by the IDESolver. Any value
+  /// greater than one makes the solver use its shared-memory parallel mode
+  /// for analysis problems that declare themselves thread-safe (see
+  /// IFDSTabulationProblem::isThreadSafe()); all other problems are solved
+  /// sequentially.
+  void setNumThreads(unsigned Threads);
+  /// Sets the maximum number of memoized results of composing and joining
+  /// edge functions that are kept per FlowEdgeFunctionCache. Zero disables
+  /// the memoization.
+  void setEdgeFunctionMemoSize(size_t Size);
+  /// Sets the maximum number of entries of each of the flow and edge function
+  /// caches of a FlowEdgeFunctionCache. The least recently used entries are
+  /// evicted if a cache is full. Zero leaves the caches unbounded.
+  void setFlowEdgeFunctionCacheSize(size_t Size);
+  /// Sets the directory containing the summary stores that are read and
+  /// written if persisted summaries are computed.
+  void setPersistedSummariesDirectory(std::string Directory);
+  /// Sets the id of the analysis problem whose summaries are persisted. The
+  /// summaries of different problems, or of the same problem with different
+  /// analysis configurations, must use different ids.
+  void setPersistedSummariesID(std::string ID);
+  /// Sets the summary packs whose summaries are applied to calls of library
+  /// functions instead of analyzing them (IFDS problems only).
+  void setSummaryPacks(std::vector<std::string> Paths);
 
   void setConfig(SolverConfigOptions Opt);
 
@@ -72,6 +130,13 @@ private:
   SolverConfigOptions Options = SolverConfigOptions::AutoAddZero |
                                 SolverConfigOptions::ComputeValues |
                                 SolverConfigOptions::RecordEdges;
+  PathEdgeSchedulingPolicy SchedulingPolicy = PathEdgeSchedulingPolicy::FIFO;
+  unsigned NumThreads = 1;
+  size_t EdgeFunctionMemoSize = 1U << 16U;
+  size_t FlowEdgeFunctionCacheSize = 0;
+  std::string PersistedSummariesDirectory = ".";
+  std::string PersistedSummariesID = "default";
+  std::vector<std::string> SummaryPacks;
 };
 
 } // namespace psr
@@ -124,6 +124,34 @@ public:
     return SolverConfig;
   }
 
+  /// Returns true if the flow and edge functions of this problem may be
+  /// created and applied concurrently. This requires that they neither modify
+  /// shared state, e.g., a lazily computed points-to information or PAMM
+  /// counters, nor record side effects, e.g., reported leaks. The IDESolver
+  /// solves problems that do not declare themselves thread-safe sequentially,
+  /// regardless of the configured number of threads.
+  [[nodiscard]] virtual bool isThreadSafe() const { return false; }
+
+  /// Returns true if the end summaries of a function fully describe the
+  /// effects of analyzing it, such that another solver of the same run may
+  /// apply them instead of analyzing the function. This does not hold if the
+  /// flow functions record side effects, e.g., reported leaks, as these would
+  /// be missing for the summarized functions. The IncrementalUpdateAnalysis
+  /// analyzes all functions of problems that do not opt in again. By default,
+  /// problems whose summaries can be persisted can be reused as well.
+  [[nodiscard]] virtual bool canReuseSummaries() const {
+    return canPersistSummaries();
+  }
+
+  /// Returns true if the end summaries of a function can be persisted and
+  /// applied in later runs instead of analyzing the function. This requires
+  /// that the flow and edge functions record no side effects, e.g., reported
+  /// leaks, as later runs would miss them for the summarized functions, and
+  /// that the facts and edge functions are identified alike in every run.
+  /// The IDESolver neither applies nor collects persisted summaries or
+  /// summary packs for problems that do not opt in.
+  [[nodiscard]] virtual bool canPersistSummaries() const { return false; }
+
   /// Generates a text report of the results that is written to the specified
   /// output stream.
   virtual void
@@ -45,7 +45,7 @@ public:
   /// The actualy kind of this edge function. Can be used in a type-switch.
   [[nodiscard]] inline EFKind getKind() const { return Kind; }
 
-  virtual llvm::hash_code getHashCode() const = 0;
+  llvm::hash_code getHashCode() const override = 0;
 };
 } // namespace psr::XTaint
 #endif
@@ -48,6 +48,8 @@
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 #include "phasar/PhasarLLVM/Utils/LatticeDomain.h"
 #include "phasar/Utils/BitVectorSet.h"
+#include "phasar/Utils/InternedBitSet.h"
+#include "phasar/Utils/Interner.h"
 #include "phasar/Utils/LLVMIRToSrc.h"
 #include "phasar/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
@@ -80,9 +82,29 @@ template <typename EdgeFactType>
 struct IDEInstInteractionAnalysisDomain : public LLVMAnalysisDomainDefault {
   // type of the element contained in the sets of edge functions
   using e_t = EdgeFactType;
-  using l_t = LatticeDomain<BitVectorSet<e_t>>;
+  // type of the sets of edge facts
+  using EdgeFactSetTy = BitVectorSet<e_t>;
+  using l_t = LatticeDomain<EdgeFactSetTy>;
 };
 
+/// Edge facts that have been interned by an Interner<EdgeFactType>, which must
+/// outlive the analysis and its results. The user-provided edge fact generator
+/// returns handles rather than copies of the facts and the value lattice is a
+/// plain dense bit vector over the interned ids.
+template <typename EdgeFactType>
+struct IDEInstInteractionAnalysisDomain<Interned<EdgeFactType>>
+    : public LLVMAnalysisDomainDefault {
+  // type of the element contained in the sets of edge functions
+  using e_t = Interned<EdgeFactType>;
+  // type of the sets of edge facts
+  using EdgeFactSetTy = InternedBitSet<EdgeFactType>;
+  using l_t = LatticeDomain<EdgeFactSetTy>;
+};
+
+///
+/// EdgeFactType: Type of the edge facts that are generated by the user-provided
+/// edge fact generator. Use Interned<T> to avoid copying and hashing the facts
+/// during the analysis (see IDEInternedInstInteractionAnalysis).
 ///
 /// SyntacticAnalysisOnly: Can be set if a syntactic-only analysis is desired
 /// (without using points-to information)
@@ -108,6 +130,7 @@ public:
   using v_t = typename AnalysisDomainTy::v_t;
   // type of the element contained in the sets of edge functions
   using e_t = typename AnalysisDomainTy::e_t;
+  using EdgeFactSetTy = typename AnalysisDomainTy::EdgeFactSetTy;
   using l_t = typename AnalysisDomainTy::l_t;
   using i_t = typename AnalysisDomainTy::i_t;
 
@@ -271,14 +294,14 @@ public:
           IIAFlowFunction(IDEInstInteractionAnalysisT &Problem,
                           const llvm::StoreInst *Store)
               : Store(Store), ValuePTS([&]() {
+                  // Otherwise, X only consists of x itself, which
+                  // computeTargets() checks for explicitly
                   if (isInterestingPointer(Store->getValueOperand())) {
                     return Problem.PT->getReachableAllocationSites(
                         Store->getValueOperand(),
                         Problem.OnlyConsiderLocalAliases);
                   }
-                  return std::make_unique<LLVMPointsToInfo::PointsToSetTy>(
-                      LLVMPointsToInfo::PointsToSetTy{
-                          Store->getValueOperand()});
+                  return LLVMPointsToInfo::AllocationSiteSetPtrTy{};
                 }()),
                 PointerPTS(Problem.PT->getReachableAllocationSites(
                     Store->getPointerOperand(),
@@ -295,7 +318,8 @@ public:
             // y/Y now obtains its new value(s) from x/X
             // If a value is stored that holds we must generate all potential
             // memory locations the store might write to.
-            if (Store->getValueOperand() == Src || ValuePTS->count(Src)) {
+            if (Store->getValueOperand() == Src ||
+                (ValuePTS && ValuePTS->count(Src))) {
               Facts.insert(Store->getValueOperand());
               Facts.insert(Store->getPointerOperand());
               Facts.insert(PointerPTS->begin(), PointerPTS->end());
@@ -631,13 +655,13 @@ public:
       for (const auto *M : this->IRDB->getAllModules()) {
         for (const auto &G : M->globals()) {
           if (const auto *GV = llvm::dyn_cast<llvm::GlobalVariable>(&G)) {
-            l_t InitialValues = BitVectorSet<e_t>();
+            l_t InitialValues = EdgeFactSetTy();
             std::set<e_t> EdgeFacts;
             if (EdgeFactGen) {
               EdgeFacts = EdgeFactGen(GV);
               // fill BitVectorSet
               InitialValues =
-                  BitVectorSet<e_t>(EdgeFacts.begin(), EdgeFacts.end());
+                  makeEdgeFactSet(EdgeFacts.begin(), EdgeFacts.end());
             }
             Seeds.addSeed(&EntryPointFun->front().front(), GV, InitialValues);
           }
@@ -678,12 +702,12 @@ public:
       return std::make_shared<AllBottom<l_t>>(bottomElement());
     }
     // check if the user has registered a fact generator function
-    l_t UserEdgeFacts = BitVectorSet<e_t>();
+    l_t UserEdgeFacts = EdgeFactSetTy();
     std::set<e_t> EdgeFacts;
     if (EdgeFactGen) {
       EdgeFacts = EdgeFactGen(Curr);
       // fill BitVectorSet
-      UserEdgeFacts = BitVectorSet<e_t>(EdgeFacts.begin(), EdgeFacts.end());
+      UserEdgeFacts = makeEdgeFactSet(EdgeFacts.begin(), EdgeFacts.end());
     }
     //
     // Zero --> Alloca edges
@@ -792,7 +816,7 @@ public:
           }
           // obtain the label
           if (OrigAlloca) {
-            if (auto *UEF = std::get_if<BitVectorSet<e_t>>(&UserEdgeFacts)) {
+            if (auto *UEF = std::get_if<EdgeFactSetTy>(&UserEdgeFacts)) {
               UEF->insert(edgeFactGenToBitVectorSet(OrigAlloca));
             }
           }
@@ -862,7 +886,7 @@ public:
         if (CurrNode == SuccNode && this->PT->isInReachableAllocationSites(
                                         Store->getPointerOperand(), CurrNode,
                                         OnlyConsiderLocalAliases)) {
-          return IIAAKillOrReplaceEF::createEdgeFunction(BitVectorSet<e_t>());
+          return IIAAKillOrReplaceEF::createEdgeFunction(EdgeFactSetTy());
         }
         // Overriding edge: obtain labels from value to be stored (and may add
         // UserEdgeFacts, if any).
@@ -982,7 +1006,7 @@ public:
       }
     }
     if (isZeroValue(SrcNode) && SRetParams.count(DestNode)) {
-      return IIAAAddLabelsEF::createEdgeFunction(BitVectorSet<e_t>());
+      return IIAAAddLabelsEF::createEdgeFunction(EdgeFactSetTy());
     }
     // Everything else can be passed as identity.
     return EdgeIdentity<l_t>::getInstance();
@@ -1010,12 +1034,12 @@ public:
       if (const auto *CD =
               llvm::dyn_cast<llvm::ConstantData>(Ret->getReturnValue())) {
         // Check if the user has registered a fact generator function
-        l_t UserEdgeFacts = BitVectorSet<e_t>();
+        l_t UserEdgeFacts = EdgeFactSetTy();
         std::set<e_t> EdgeFacts;
         if (EdgeFactGen) {
           EdgeFacts = EdgeFactGen(ExitInst);
           // fill BitVectorSet
-          UserEdgeFacts = BitVectorSet<e_t>(EdgeFacts.begin(), EdgeFacts.end());
+          UserEdgeFacts = makeEdgeFactSet(EdgeFacts.begin(), EdgeFacts.end());
         }
         return IIAAAddLabelsEF::createEdgeFunction(UserEdgeFacts);
       }
@@ -1028,12 +1052,12 @@ public:
   getCallToRetEdgeFunction(n_t CallSite, d_t CallNode, n_t /* RetSite */,
                            d_t RetSiteNode, std::set<f_t> Callees) override {
     // Check if the user has registered a fact generator function
-    l_t UserEdgeFacts = BitVectorSet<e_t>();
+    l_t UserEdgeFacts = EdgeFactSetTy();
     std::set<e_t> EdgeFacts;
     if (EdgeFactGen) {
       EdgeFacts = EdgeFactGen(CallSite);
       // fill BitVectorSet
-      UserEdgeFacts = BitVectorSet<e_t>(EdgeFacts.begin(), EdgeFacts.end());
+      UserEdgeFacts = makeEdgeFactSet(EdgeFacts.begin(), EdgeFacts.end());
     }
     // Model call to heap allocating functions (new, new[], malloc, etc.) --
     // only model direct calls, though.
@@ -1108,7 +1132,7 @@ public:
   public:
     l_t Replacement;
 
-    explicit IIAAKillOrReplaceEF() : Replacement(BitVectorSet<e_t>()) {
+    explicit IIAAKillOrReplaceEF() : Replacement(EdgeFactSetTy()) {
       // PHASAR_LOG_LEVEL(DFADEBUG,
       //               << "IIAAKillOrReplaceEF");
     }
@@ -1206,7 +1230,7 @@ public:
     }
 
     [[nodiscard]] bool isKillAll() const {
-      if (auto *RSet = std::get_if<BitVectorSet<e_t>>(&Replacement)) {
+      if (auto *RSet = std::get_if<EdgeFactSetTy>(&Replacement)) {
         return RSet->empty();
       }
       return false;
@@ -1413,7 +1437,7 @@ protected:
     } else if (std::holds_alternative<Bottom>(EdgeFact)) {
       OS << std::get<Bottom>(EdgeFact);
     } else {
-      auto LSet = std::get<BitVectorSet<e_t>>(EdgeFact);
+      const auto &LSet = std::get<EdgeFactSetTy>(EdgeFact);
       OS << "(set size: " << LSet.size() << ") values: ";
       if constexpr (std::is_same_v<e_t, vara::Taint *>) {
         for (const auto &LElem : LSet) {
@@ -1431,15 +1455,15 @@ protected:
     }
   }
 
-  static inline l_t joinImpl(l_t Lhs, l_t Rhs) {
+  static inline l_t joinImpl(const l_t &Lhs, const l_t &Rhs) {
     if (Lhs == TopElement || Lhs == BottomElement) {
       return Rhs;
     }
     if (Rhs == TopElement || Rhs == BottomElement) {
       return Lhs;
     }
-    auto LhsSet = std::get<BitVectorSet<e_t>>(Lhs);
-    auto RhsSet = std::get<BitVectorSet<e_t>>(Rhs);
+    const auto &LhsSet = std::get<EdgeFactSetTy>(Lhs);
+    const auto &RhsSet = std::get<EdgeFactSetTy>(Rhs);
     return LhsSet.setUnion(RhsSet);
   }
 
@@ -1465,11 +1489,11 @@ private:
         continue;
       }
       // skip result entry if the computed value is not of type BitVectorSet
-      if (!std::holds_alternative<BitVectorSet<e_t>>(Value)) {
+      if (!std::holds_alternative<EdgeFactSetTy>(Value)) {
         continue;
       }
       // remove variable from result set if a non-empty that has been computed
-      auto &Values = std::get<BitVectorSet<e_t>>(Value);
+      auto &Values = std::get<EdgeFactSetTy>(Value);
       if (!Values.empty()) {
         Variables.erase(Variable);
       }
@@ -1481,12 +1505,24 @@ private:
   static inline const l_t BottomElement = Bottom{};
   static inline const l_t TopElement = Top{};
   const bool OnlyConsiderLocalAliases = true;
+  /// The indices of the edge facts of all BitVectorSets of this analysis
+  std::conditional_t<std::is_same_v<EdgeFactSetTy, BitVectorSet<e_t>>,
+                     BitVectorSetDomain<e_t>, std::monostate>
+      EdgeFactDomain;
+
+  template <typename InputIt>
+  EdgeFactSetTy makeEdgeFactSet(InputIt First, InputIt Last) {
+    if constexpr (std::is_same_v<EdgeFactSetTy, BitVectorSet<e_t>>) {
+      return EdgeFactSetTy(EdgeFactDomain, First, Last);
+    } else {
+      return EdgeFactSetTy(First, Last);
+    }
+  }
 
-  inline BitVectorSet<e_t> edgeFactGenToBitVectorSet(n_t CurrInst) {
+  inline EdgeFactSetTy edgeFactGenToBitVectorSet(n_t CurrInst) {
     if (EdgeFactGen) {
       auto Results = EdgeFactGen(CurrInst);
-      BitVectorSet<e_t> BVS(Results.begin(), Results.end());
-      return BVS;
+      return makeEdgeFactSet(Results.begin(), Results.end());
     }
     return {};
   }
@@ -1494,6 +1530,9 @@ private:
 
 using IDEInstInteractionAnalysis = IDEInstInteractionAnalysisT<>;
 
+using IDEInternedInstInteractionAnalysis =
+    IDEInstInteractionAnalysisT<Interned<std::string>>;
+
 } // namespace psr
 
 #endif
@@ -10,6 +10,7 @@
 #ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_PROBLEMS_IDELINEARCONSTANTANALYSIS_H
 #define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_PROBLEMS_IDELINEARCONSTANTANALYSIS_H
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -41,10 +42,11 @@ class LLVMPointsToInfo;
 class IDELinearConstantAnalysis
     : public IDETabulationProblem<IDELinearConstantAnalysisDomain> {
 private:
-  // For debug purpose only
-  static unsigned CurrGenConstantId; // NOLINT
-  static unsigned CurrLCAIDId;       // NOLINT
-  static unsigned CurrBinaryId;      // NOLINT
+  // For debug purpose only; atomic, as the edge functions may be created
+  // concurrently
+  static std::atomic<unsigned> CurrGenConstantId; // NOLINT
+  static std::atomic<unsigned> CurrLCAIDId;       // NOLINT
+  static std::atomic<unsigned> CurrBinaryId;      // NOLINT
 
 public:
   using IDETabProblemType =
@@ -65,7 +67,7 @@ public:
                             const LLVMBasedICFG *ICF, LLVMPointsToInfo *PT,
                             std::set<std::string> EntryPoints = {"main"});
 
-  ~IDELinearConstantAnalysis() override;
+  ~IDELinearConstantAnalysis() override = default;
 
   IDELinearConstantAnalysis(const IDELinearConstantAnalysis &) = delete;
   IDELinearConstantAnalysis &
@@ -128,6 +130,15 @@ public:
 
   [[nodiscard]] bool isZeroValue(d_t Fact) const override;
 
+  /// The flow and edge functions only share the atomic debug counters, the
+  /// problem can be solved in parallel.
+  [[nodiscard]] bool isThreadSafe() const override { return true; }
+
+  /// The flow and edge functions record no side effects, the summaries may be
+  /// reused within a run. They cannot be persisted, as the ids of the edge
+  /// functions are counters that differ across runs.
+  [[nodiscard]] bool canReuseSummaries() const override { return true; }
+
   // in addition provide specifications for the IDE parts
 
   std::shared_ptr<EdgeFunction<l_t>>
@@ -192,6 +203,10 @@ public:
 
     bool equal_to(std::shared_ptr<EdgeFunction<l_t>> Other) const override;
 
+    [[nodiscard]] bool isInternable() const override { return true; }
+
+    [[nodiscard]] llvm::hash_code getHashCode() const override;
+
     void print(llvm::raw_ostream &OS, bool IsForDebug = false) const override;
   };
 
@@ -16,9 +16,13 @@
 #include <string>
 #include <type_traits>
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/IR/InstrTypes.h"
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionComposer.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/TypeStateDescription.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
@@ -55,7 +59,19 @@ public:
   using ConfigurationTy = TypeStateDescription;
 
 private:
+  /// The properties of an API function that are relevant for the analysis.
+  /// They are computed once per function, such that the analysis neither
+  /// demangles function names nor queries the type state description by name
+  /// while solving.
+  struct APIFunctionInfo {
+    std::string Token;
+    bool IsFactory = false;
+    bool IsConsuming = false;
+    std::set<int> ConsumerParamIdx;
+  };
+
   const TypeStateDescription &TSD;
+  llvm::DenseMap<const llvm::Function *, APIFunctionInfo> APIFunctions;
   std::map<const llvm::Value *, LLVMPointsToInfo::PointsToSetTy> PointsToCache;
   std::map<const llvm::Value *, std::set<const llvm::Value *>>
       RelevantAllocaCache;
@@ -97,6 +113,13 @@ private:
    */
   bool hasMatchingType(d_t V);
 
+  /**
+   * @brief Returns the API function info of F, or nullptr if F is not part of
+   * the type state description's API.
+   */
+  [[nodiscard]] const APIFunctionInfo *
+  getAPIFunctionInfo(const llvm::Function *F) const;
+
 public:
   const l_t TOP;
   const l_t BOTTOM;
@@ -178,7 +201,50 @@ public:
   void emitTextReport(const SolverResults<n_t, d_t, l_t> &SR,
                       llvm::raw_ostream &OS = llvm::outs()) override;
 
-  // customize the edge function composer
+  /**
+   * A transfer function of the type state automaton that is represented by
+   * the successor of every state. The table has TSD.getNumStates() + 1
+   * entries; the last one is the successor of top(). Compositions and joins
+   * with other transfer functions are computed element-wise, so they take
+   * O(#states) time and never build up chains of edge functions.
+   */
+  class TSEdgeFunction : public EdgeFunction<l_t>,
+                         public std::enable_shared_from_this<TSEdgeFunction> {
+  public:
+    using TransferTableTy = llvm::SmallVector<l_t, 8>;
+
+  protected:
+    const TypeStateDescription &TSD;
+    TransferTableTy Table;
+
+    [[nodiscard]] size_t getIndex(l_t State) const;
+
+  public:
+    /// Tabulates the transitions of the API function Tok called at CB.
+    TSEdgeFunction(const TypeStateDescription &TSD, const std::string &Tok,
+                   const llvm::CallBase *CB);
+
+    TSEdgeFunction(const TypeStateDescription &TSD, TransferTableTy Table)
+        : TSD(TSD), Table(std::move(Table)) {}
+
+    l_t computeTarget(l_t Source) override;
+
+    std::shared_ptr<EdgeFunction<l_t>>
+    composeWith(std::shared_ptr<EdgeFunction<l_t>> SecondFunction) override;
+
+    std::shared_ptr<EdgeFunction<l_t>>
+    joinWith(std::shared_ptr<EdgeFunction<l_t>> OtherFunction) override;
+
+    bool equal_to(std::shared_ptr<EdgeFunction<l_t>> Other) const override;
+
+    [[nodiscard]] bool isInternable() const override { return true; }
+
+    [[nodiscard]] llvm::hash_code getHashCode() const override {
+      return llvm::hash_combine_range(Table.begin(), Table.end());
+    }
+
+    void print(llvm::raw_ostream &OS, bool IsForDebug = false) const override;
+  };
   class TSEdgeFunctionComposer : public EdgeFunctionComposer<l_t> {
   private:
     l_t BotElement;
@@ -192,8 +258,15 @@ public:
     joinWith(std::shared_ptr<EdgeFunction<l_t>> OtherFunction) override;
   };
 
-  class TSEdgeFunction : public EdgeFunction<l_t>,
-                         public std::enable_shared_from_this<TSEdgeFunction> {
+  /**
+   * The transfer function of the API function Token called at CallSite if
+   * the type state description does not number its states, see
+   * TypeStateDescription::getNumStates(). Queries the description on every
+   * application and composes by chaining.
+   */
+  class TSUntabulatedEdgeFunction
+      : public EdgeFunction<l_t>,
+        public std::enable_shared_from_this<TSUntabulatedEdgeFunction> {
   protected:
     const TypeStateDescription &TSD;
     // Do not use a reference here, since LLVM's StringRef's (obtained by str())
@@ -202,8 +275,8 @@ public:
     const llvm::CallBase *CallSite;
 
   public:
-    TSEdgeFunction(const TypeStateDescription &TSD, const std::string &Tok,
-                   const llvm::CallBase *CB)
+    TSUntabulatedEdgeFunction(const TypeStateDescription &TSD,
+                              const std::string &Tok, const llvm::CallBase *CB)
         : TSD(TSD), Token(Tok), CallSite(CB){};
 
     l_t computeTarget(l_t Source) override;
@@ -60,6 +60,8 @@ public:
 
   [[nodiscard]] bool isZeroValue(d_t Fact) const override;
 
+  [[nodiscard]] bool canPersistSummaries() const override { return true; }
+
   void printNode(llvm::raw_ostream &OS, n_t Stmt) const override;
 
   void printDataFlowFact(llvm::raw_ostream &OS, d_t Fact) const override;
@@ -67,6 +67,7 @@ public:
   getFactoryParamIdx(const std::string &F) const override;
   [[nodiscard]] std::string
   stateToString(TypeStateDescription::State S) const override;
+  [[nodiscard]] size_t getNumStates() const override;
   [[nodiscard]] TypeStateDescription::State bottom() const override;
   [[nodiscard]] TypeStateDescription::State top() const override;
   [[nodiscard]] TypeStateDescription::State uninit() const override;
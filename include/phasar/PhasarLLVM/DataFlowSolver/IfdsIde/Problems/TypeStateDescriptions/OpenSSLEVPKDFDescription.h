@@ -72,6 +72,7 @@ public:
   [[nodiscard]] std::string
   stateToString(TypeStateDescription::State S) const override;
 
+  [[nodiscard]] size_t getNumStates() const override;
   [[nodiscard]] TypeStateDescription::State bottom() const override;
 
   [[nodiscard]] TypeStateDescription::State top() const override;
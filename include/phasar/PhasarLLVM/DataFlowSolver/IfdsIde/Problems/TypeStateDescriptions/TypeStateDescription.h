@@ -10,6 +10,7 @@
 #ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_PROBLEMS_TYPESTATEDESCRIPTIONS_TYPESTATEDESCRIPTION_H
 #define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_PROBLEMS_TYPESTATEDESCRIPTIONS_TYPESTATEDESCRIPTION_H
 
+#include <cstddef>
 #include <set>
 #include <string>
 
@@ -56,6 +57,14 @@ struct TypeStateDescription {
   [[nodiscard]] virtual std::set<int>
   getFactoryParamIdx(const std::string &F) const = 0;
   [[nodiscard]] virtual std::string stateToString(State S) const = 0;
+  /**
+   * Returns the number of states of the finite state machine. All states but
+   * top() must be numbered from 0 to getNumStates() - 1, such that the
+   * transitions of a function can be tabulated. Returns 0 by default, in
+   * which case the transitions are not tabulated but computed by
+   * getNextState() on every application.
+   */
+  [[nodiscard]] virtual size_t getNumStates() const { return 0; }
   [[nodiscard]] virtual State bottom() const = 0;
   [[nodiscard]] virtual State top() const = 0;
 
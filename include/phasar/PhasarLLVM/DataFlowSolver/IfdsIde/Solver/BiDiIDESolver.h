@@ -17,4 +17,323 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BIDIIDESOLVER_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BIDIIDESOLVER_H_
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <set>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/ControlFlow/ICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/Utils/Logger.h"
+
+namespace psr {
+
+/// Performs the Phase I of a forward and a backward problem in lockstep, e.g.,
+/// of a forward taint analysis seeded at the sources and of a backward
+/// analysis seeded at the sinks, and records the nodes at which their
+/// frontiers meet. This is the common implementation of BiDiIDESolver and
+/// BiDiIFDSSolver, which differ in the solvers they use for the two problems.
+///
+/// Both searches are restricted to the functions containing their seeds and
+/// the functions these may transitively call. A search that leaves a function
+/// via an unbalanced return, which requires followReturnsPastSeeds() to be
+/// set in the solver configurations of both problems, leaks into the callers
+/// of that function. Leaked path edges are held back until both frontiers are
+/// exhausted; then the callers into which both searches have leaked are
+/// explored by both of them, such that the searches meet in their common
+/// callers first. Only if there are no such callers, all leaked path edges
+/// are followed, such that no meeting is missed.
+///
+/// A forward fact holding before a node N and a backward fact holding after
+/// N meet if the meet function returns true for them; the zero values never
+/// meet. By default, equal facts meet.
+template <typename FwdSolverTy, typename BwdSolverTy> class BiDiTabulation {
+public:
+  using n_t = typename FwdSolverTy::n_t;
+  using f_t = typename FwdSolverTy::f_t;
+  using fwd_d_t = typename FwdSolverTy::d_t;
+  using bwd_d_t = typename BwdSolverTy::d_t;
+
+  static_assert(std::is_same_v<n_t, typename BwdSolverTy::n_t> &&
+                    std::is_same_v<f_t, typename BwdSolverTy::f_t>,
+                "The forward and the backward problem must use the same "
+                "node and function types!");
+
+  using MeetFunctionTy = std::function<bool(n_t, fwd_d_t, bwd_d_t)>;
+
+  struct MeetingPoint {
+    n_t Node;
+    fwd_d_t FwdFact;
+    bwd_d_t BwdFact;
+  };
+
+  template <typename FwdProblemTy, typename BwdProblemTy>
+  BiDiTabulation(FwdProblemTy &FwdProblem, BwdProblemTy &BwdProblem,
+                 MeetFunctionTy Meet = nullptr)
+      : FwdSolver(FwdProblem), BwdSolver(BwdProblem),
+        FwdICF(FwdProblem.getICFG()), BwdICF(BwdProblem.getICFG()),
+        FwdZero(FwdProblem.getZeroValue()), BwdZero(BwdProblem.getZeroValue()),
+        FwdComputeValues(FwdProblem.getIFDSIDESolverConfig().computeValues()),
+        BwdComputeValues(BwdProblem.getIFDSIDESolverConfig().computeValues()),
+        Meet(std::move(Meet)) {
+    if constexpr (std::is_same_v<fwd_d_t, bwd_d_t>) {
+      if (!this->Meet) {
+        this->Meet = [](n_t /*Node*/, fwd_d_t FwdFact, bwd_d_t BwdFact) {
+          return FwdFact == BwdFact;
+        };
+      }
+    }
+    assert(this->Meet && "A meet function is required if the forward and the "
+                         "backward problem use different fact types!");
+    if (!FwdProblem.getIFDSIDESolverConfig().followReturnsPastSeeds() ||
+        !BwdProblem.getIFDSIDESolverConfig().followReturnsPastSeeds()) {
+      PHASAR_LOG_LEVEL(WARNING, "Bidirectional solving requires "
+                                "followReturnsPastSeeds to leave the "
+                                "functions containing the seeds");
+    }
+    for (const auto &Seed : FwdProblem.initialSeeds().getSeeds()) {
+      open(FwdICF->getFunctionOf(Seed.first));
+    }
+    for (const auto &Seed : BwdProblem.initialSeeds().getSeeds()) {
+      open(BwdICF->getFunctionOf(Seed.first));
+    }
+    FwdSolver.setPathEdgeFilter([this](n_t Node) {
+      return OpenFunctions.count(FwdICF->getFunctionOf(Node));
+    });
+    BwdSolver.setPathEdgeFilter([this](n_t Node) {
+      return OpenFunctions.count(BwdICF->getFunctionOf(Node));
+    });
+    FwdSolver.setPathEdgeListener([this](n_t Node, fwd_d_t Fact) {
+      ++NumFwdPathEdges;
+      if (Fact == FwdZero || !FwdReached[Node].insert(Fact).second) {
+        return;
+      }
+      if (auto Search = BwdReached.find(Node); Search != BwdReached.end()) {
+        for (const auto &BwdFact : Search->second) {
+          addMeetingPoint(Node, Fact, BwdFact);
+        }
+      }
+    });
+    BwdSolver.setPathEdgeListener([this](n_t Node, bwd_d_t Fact) {
+      ++NumBwdPathEdges;
+      if (Fact == BwdZero || !BwdReached[Node].insert(Fact).second) {
+        return;
+      }
+      if (auto Search = FwdReached.find(Node); Search != FwdReached.end()) {
+        for (const auto &FwdFact : Search->second) {
+          addMeetingPoint(Node, FwdFact, Fact);
+        }
+      }
+    });
+  }
+
+  // The solvers refer to this object
+  BiDiTabulation(const BiDiTabulation &) = delete;
+  BiDiTabulation(BiDiTabulation &&) = delete;
+  BiDiTabulation &operator=(const BiDiTabulation &) = delete;
+  BiDiTabulation &operator=(BiDiTabulation &&) = delete;
+
+  virtual ~BiDiTabulation() = default;
+
+  /// Runs both searches until their frontiers meet or, if
+  /// setStopAtFirstMeeting(false) has been called, until both are exhausted.
+  /// Phase II is only performed, for each problem that computes values, if
+  /// both searches have been exhausted: after stopping at the first meeting,
+  /// path edges are left unprocessed, hence, the jump functions are
+  /// incomplete and no values are computed.
+  void solve() {
+    PHASAR_LOG_LEVEL(INFO, "Bidirectional solver is solving the specified "
+                           "problems");
+    FwdSolver.submitInitialSeeds();
+    BwdSolver.submitInitialSeeds();
+    Exhausted = false;
+    while (!isDone()) {
+      bool FwdPending = FwdSolver.processPathEdges(StepSize);
+      if (isDone()) {
+        break;
+      }
+      bool BwdPending = BwdSolver.processPathEdges(StepSize);
+      if (!FwdPending && !BwdPending && !followLeaks()) {
+        Exhausted = true;
+        break;
+      }
+    }
+    PHASAR_LOG_LEVEL(INFO, "Frontiers met at " << MeetingPoints.size()
+                                               << " points after "
+                                               << NumFwdPathEdges << " + "
+                                               << NumBwdPathEdges
+                                               << " path edges");
+    if (!Exhausted) {
+      PHASAR_LOG_LEVEL(INFO, "Stopped at the first meeting, the values are "
+                             "not computed");
+      return;
+    }
+    if (FwdComputeValues) {
+      FwdSolver.solvePhaseII();
+    }
+    if (BwdComputeValues) {
+      BwdSolver.solvePhaseII();
+    }
+  }
+
+  /// Sets the number of path edges each search processes before the other
+  /// one takes its turn.
+  void setStepSize(size_t Size) noexcept { StepSize = Size == 0 ? 1 : Size; }
+
+  void setStopAtFirstMeeting(bool Stop = true) noexcept {
+    StopAtFirstMeeting = Stop;
+  }
+
+  /// Returns true if both searches have been exhausted by the last call to
+  /// solve(). Only then the values of the problems have been computed.
+  [[nodiscard]] bool isExhausted() const noexcept { return Exhausted; }
+
+  [[nodiscard]] bool frontiersMet() const noexcept {
+    return !MeetingPoints.empty();
+  }
+
+  [[nodiscard]] const std::vector<MeetingPoint> &
+  getMeetingPoints() const noexcept {
+    return MeetingPoints;
+  }
+
+  /// Returns the number of path edges processed by the forward search.
+  [[nodiscard]] size_t getNumFwdPathEdges() const noexcept {
+    return NumFwdPathEdges;
+  }
+
+  /// Returns the number of path edges processed by the backward search.
+  [[nodiscard]] size_t getNumBwdPathEdges() const noexcept {
+    return NumBwdPathEdges;
+  }
+
+  [[nodiscard]] FwdSolverTy &getForwardSolver() noexcept { return FwdSolver; }
+
+  [[nodiscard]] BwdSolverTy &getBackwardSolver() noexcept { return BwdSolver; }
+
+protected:
+  FwdSolverTy FwdSolver;
+  BwdSolverTy BwdSolver;
+
+private:
+  [[nodiscard]] bool isDone() const noexcept {
+    return StopAtFirstMeeting && !MeetingPoints.empty();
+  }
+
+  void addMeetingPoint(n_t Node, fwd_d_t FwdFact, bwd_d_t BwdFact) {
+    if (Meet(Node, FwdFact, BwdFact)) {
+      MeetingPoints.push_back({Node, FwdFact, BwdFact});
+    }
+  }
+
+  /// Adds Fun and all functions it may transitively call to the functions
+  /// both searches explore.
+  void open(f_t Fun) {
+    std::vector<f_t> Pending = {Fun};
+    while (!Pending.empty()) {
+      f_t Current = Pending.back();
+      Pending.pop_back();
+      if (!OpenFunctions.insert(Current).second) {
+        continue;
+      }
+      for (n_t Call : FwdICF->getCallsFromWithin(Current)) {
+        for (f_t Callee : FwdICF->getCalleesOfCallAt(Call)) {
+          Pending.push_back(Callee);
+        }
+      }
+    }
+  }
+
+  template <typename SolverTy, typename ICFTy>
+  static std::set<f_t> getLeakedFunctions(const SolverTy &Solver,
+                                          const ICFTy &ICF) {
+    std::set<f_t> Leaked;
+    for (n_t Target : Solver.getDeferredPathEdgeTargets()) {
+      Leaked.insert(ICF.getFunctionOf(Target));
+    }
+    return Leaked;
+  }
+
+  /// Opens the callers into which both searches have leaked or, if there are
+  /// none, all callers into which one of them has leaked, and schedules the
+  /// leaked path edges. Returns false if there are no leaked path edges.
+  bool followLeaks() {
+    auto FwdLeaked = getLeakedFunctions(FwdSolver, *FwdICF);
+    auto BwdLeaked = getLeakedFunctions(BwdSolver, *BwdICF);
+    std::vector<f_t> Callers;
+    std::set_intersection(FwdLeaked.begin(), FwdLeaked.end(),
+                          BwdLeaked.begin(), BwdLeaked.end(),
+                          std::back_inserter(Callers));
+    if (Callers.empty()) {
+      std::set_union(FwdLeaked.begin(), FwdLeaked.end(), BwdLeaked.begin(),
+                     BwdLeaked.end(), std::back_inserter(Callers));
+    }
+    if (Callers.empty()) {
+      return false;
+    }
+    for (f_t Caller : Callers) {
+      PHASAR_LOG_LEVEL(DEBUG, "Follow leaks into: " << FwdICF->getFunctionName(
+                                  Caller));
+      open(Caller);
+    }
+    FwdSolver.scheduleDeferredPathEdges();
+    BwdSolver.scheduleDeferredPathEdges();
+    return true;
+  }
+
+  const ICFG<n_t, f_t> *FwdICF;
+  const ICFG<n_t, f_t> *BwdICF;
+  fwd_d_t FwdZero;
+  bwd_d_t BwdZero;
+  bool FwdComputeValues;
+  bool BwdComputeValues;
+  MeetFunctionTy Meet;
+  size_t StepSize = 64;
+  bool StopAtFirstMeeting = true;
+  bool Exhausted = false;
+  std::unordered_set<f_t> OpenFunctions;
+  std::unordered_map<n_t, std::set<fwd_d_t>> FwdReached;
+  std::unordered_map<n_t, std::set<bwd_d_t>> BwdReached;
+  std::vector<MeetingPoint> MeetingPoints;
+  size_t NumFwdPathEdges = 0;
+  size_t NumBwdPathEdges = 0;
+};
+
+/// Solves a forward and a backward IDE problem bidirectionally, see
+/// BiDiTabulation.
+template <typename FwdAnalysisDomainTy, typename BwdAnalysisDomainTy,
+          typename FwdContainer = std::set<typename FwdAnalysisDomainTy::d_t>,
+          typename BwdContainer = std::set<typename BwdAnalysisDomainTy::d_t>>
+class BiDiIDESolver
+    : public BiDiTabulation<IDESolver<FwdAnalysisDomainTy, FwdContainer>,
+                            IDESolver<BwdAnalysisDomainTy, BwdContainer>> {
+  using Base = BiDiTabulation<IDESolver<FwdAnalysisDomainTy, FwdContainer>,
+                              IDESolver<BwdAnalysisDomainTy, BwdContainer>>;
+
+public:
+  BiDiIDESolver(
+      IDETabulationProblem<FwdAnalysisDomainTy, FwdContainer> &FwdProblem,
+      IDETabulationProblem<BwdAnalysisDomainTy, BwdContainer> &BwdProblem,
+      typename Base::MeetFunctionTy Meet = nullptr)
+      : Base(FwdProblem, BwdProblem, std::move(Meet)) {}
+
+  ~BiDiIDESolver() override = default;
+};
+
+template <typename FwdProblemTy, typename BwdProblemTy>
+BiDiIDESolver(FwdProblemTy &, BwdProblemTy &)
+    -> BiDiIDESolver<typename FwdProblemTy::ProblemAnalysisDomain,
+                     typename BwdProblemTy::ProblemAnalysisDomain,
+                     typename FwdProblemTy::container_type,
+                     typename BwdProblemTy::container_type>;
+
+} // namespace psr
+
 #endif
@@ -16,4 +16,55 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BIDIIFDSSOLVER_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_BIDIIFDSSOLVER_H_
 
+#include <set>
+#include <utility>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/BiDiIDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+
+namespace psr {
+
+/// Solves a forward and a backward IFDS problem bidirectionally, see
+/// BiDiTabulation. For a taint analysis, the forward problem is seeded at
+/// the sources, the backward problem at the sinks, and a source reaches a
+/// sink if the frontiers of both searches meet.
+template <typename FwdAnalysisDomainTy, typename BwdAnalysisDomainTy>
+class BiDiIFDSSolver : public BiDiTabulation<IFDSSolver<FwdAnalysisDomainTy>,
+                                             IFDSSolver<BwdAnalysisDomainTy>> {
+  using Base = BiDiTabulation<IFDSSolver<FwdAnalysisDomainTy>,
+                              IFDSSolver<BwdAnalysisDomainTy>>;
+
+public:
+  using typename Base::n_t;
+  using typename Base::fwd_d_t;
+  using typename Base::bwd_d_t;
+
+  BiDiIFDSSolver(IFDSTabulationProblem<FwdAnalysisDomainTy> &FwdProblem,
+                 IFDSTabulationProblem<BwdAnalysisDomainTy> &BwdProblem,
+                 typename Base::MeetFunctionTy Meet = nullptr)
+      : Base(FwdProblem, BwdProblem, std::move(Meet)) {}
+
+  ~BiDiIFDSSolver() override = default;
+
+  /// Returns the facts of the forward problem holding at Inst. These are only
+  /// computed if both searches have been exhausted, see isExhausted().
+  [[nodiscard]] std::set<fwd_d_t> fwdResultsAt(n_t Inst) {
+    return this->FwdSolver.ifdsResultsAt(Inst);
+  }
+
+  /// Returns the facts of the backward problem holding at Inst. These are only
+  /// computed if both searches have been exhausted, see isExhausted().
+  [[nodiscard]] std::set<bwd_d_t> bwdResultsAt(n_t Inst) {
+    return this->BwdSolver.ifdsResultsAt(Inst);
+  }
+};
+
+template <typename FwdProblemTy, typename BwdProblemTy>
+BiDiIFDSSolver(FwdProblemTy &, BwdProblemTy &)
+    -> BiDiIFDSSolver<typename FwdProblemTy::ProblemAnalysisDomain,
+                      typename BwdProblemTy::ProblemAnalysisDomain>;
+
+} // namespace psr
+
 #endif
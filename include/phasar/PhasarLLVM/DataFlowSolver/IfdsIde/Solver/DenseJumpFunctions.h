@@ -0,0 +1,418 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+/*
+ * DenseJumpFunctions.h
+ *
+ *  Created on: 18.10.2022
+ *      Author: pdschbrt
+ */
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_DENSEJUMPFUNCTIONS_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_DENSEJUMPFUNCTIONS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+
+namespace psr {
+
+// Forward declare the IDETabulationProblem as we require its toString
+// functionality.
+template <typename AnalysisDomainTy, typename Container>
+class IDETabulationProblem;
+
+/// Alternative storage backend for the jump functions of the IDESolver that
+/// can be selected using the solver's JumpFunctionsTy template parameter.
+///
+/// Nodes and facts are mapped to dense 32-bit ids once. Every jump function
+/// stores its edge function exactly once in a single vector. It is referenced
+/// by index from two lists of (fact id, edge function index) pairs, which are
+/// found through flat hash maps from the combined ids of (target node, target
+/// fact) and (target node, source fact), respectively. In contrast to
+/// JumpFunctions there is no third index that duplicates all edge functions
+/// per target node; lookups by target node use the per-node list of target
+/// facts instead. This considerably reduces the memory footprint for large
+/// analyses.
+///
+/// reverseLookup() and forwardLookup() return a FunctionListRef, which
+/// provides the (fact, edge function) pairs by value. It remains valid when
+/// new jump functions are added.
+template <typename AnalysisDomainTy, typename Container>
+class DenseJumpFunctions {
+public:
+  using l_t = typename AnalysisDomainTy::l_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using n_t = typename AnalysisDomainTy::n_t;
+
+  using EdgeFunctionType = EdgeFunction<l_t>;
+  using EdgeFunctionPtrType = std::shared_ptr<EdgeFunctionType>;
+
+private:
+  /// (fact id, index into EdgeFuncs)
+  using FunctionListTy = llvm::SmallVector<std::pair<uint32_t, uint32_t>, 1>;
+
+public:
+  /// A read-only view of the jump functions of one lookup. Mirrors the
+  /// interface of the std::reference_wrapper that JumpFunctions returns, such
+  /// that the solver can use both tables alike.
+  class FunctionListRef {
+  public:
+    using value_type = std::pair<d_t, EdgeFunctionPtrType>;
+
+    class iterator {
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type = FunctionListRef::value_type;
+      using difference_type = std::ptrdiff_t;
+      using reference = value_type;
+
+      struct pointer {
+        value_type Value;
+        const value_type *operator->() const { return &Value; }
+      };
+
+      iterator(const FunctionListRef *Ref, size_t Idx) : Ref(Ref), Idx(Idx) {}
+
+      reference operator*() const { return (*Ref)[Idx]; }
+      pointer operator->() const { return {(*Ref)[Idx]}; }
+      iterator &operator++() {
+        ++Idx;
+        return *this;
+      }
+      iterator operator++(int) {
+        auto Tmp = *this;
+        ++Idx;
+        return Tmp;
+      }
+      iterator &operator+=(difference_type N) {
+        Idx += N;
+        return *this;
+      }
+      iterator operator+(difference_type N) const {
+        return iterator(Ref, Idx + N);
+      }
+      difference_type operator-(const iterator &Other) const {
+        return static_cast<difference_type>(Idx) -
+               static_cast<difference_type>(Other.Idx);
+      }
+      bool operator==(const iterator &Other) const { return Idx == Other.Idx; }
+      bool operator!=(const iterator &Other) const { return Idx != Other.Idx; }
+
+    private:
+      const FunctionListRef *Ref;
+      size_t Idx;
+    };
+
+    FunctionListRef(const DenseJumpFunctions *JFs, const FunctionListTy *List)
+        : JFs(JFs), List(List) {}
+
+    [[nodiscard]] const FunctionListRef &get() const { return *this; }
+
+    [[nodiscard]] size_t size() const { return List->size(); }
+    [[nodiscard]] bool empty() const { return List->empty(); }
+
+    [[nodiscard]] value_type operator[](size_t Idx) const {
+      const auto &[FactId, EdgeFuncIdx] = (*List)[Idx];
+      return {JFs->Facts[FactId], JFs->EdgeFuncs[EdgeFuncIdx]};
+    }
+
+    [[nodiscard]] iterator begin() const { return iterator(this, 0); }
+    [[nodiscard]] iterator end() const { return iterator(this, size()); }
+
+  private:
+    const DenseJumpFunctions *JFs;
+    const FunctionListTy *List;
+  };
+
+private:
+  EdgeFunctionPtrType Alltop;
+  const IDETabulationProblem<AnalysisDomainTy, Container> &Problem;
+
+  llvm::DenseMap<n_t, uint32_t> NodeIds;
+  std::vector<n_t> Nodes;
+  llvm::DenseMap<d_t, uint32_t> FactIds;
+  std::vector<d_t> Facts;
+
+  // the edge function of every jump function; removed ones are reset
+  std::vector<EdgeFunctionPtrType> EdgeFuncs;
+  // a std::deque does not move its elements on insertion at the end
+  std::deque<FunctionListTy> FunctionLists;
+  // (target node, target fact) -> list of source facts and functions
+  llvm::DenseMap<uint64_t, uint32_t> ReverseLookup;
+  // (target node, source fact) -> list of target facts and functions
+  llvm::DenseMap<uint64_t, uint32_t> ForwardLookup;
+  // target node -> target facts that have a list in ReverseLookup
+  std::vector<llvm::SmallVector<uint32_t, 2>> TargetFactsOfNode;
+
+  static uint64_t combine(uint32_t NodeId, uint32_t FactId) {
+    return (static_cast<uint64_t>(NodeId) << 32) | FactId;
+  }
+
+  uint32_t getOrCreateNodeId(n_t Node) {
+    auto [It, Inserted] = NodeIds.try_emplace(Node, Nodes.size());
+    if (Inserted) {
+      Nodes.push_back(Node);
+      TargetFactsOfNode.emplace_back();
+    }
+    return It->second;
+  }
+
+  uint32_t getOrCreateFactId(d_t Fact) {
+    auto [It, Inserted] = FactIds.try_emplace(Fact, Facts.size());
+    if (Inserted) {
+      Facts.push_back(Fact);
+    }
+    return It->second;
+  }
+
+  std::optional<uint64_t> getKey(n_t Node, d_t Fact) const {
+    auto NodeIt = NodeIds.find(Node);
+    if (NodeIt == NodeIds.end()) {
+      return std::nullopt;
+    }
+    auto FactIt = FactIds.find(Fact);
+    if (FactIt == FactIds.end()) {
+      return std::nullopt;
+    }
+    return combine(NodeIt->second, FactIt->second);
+  }
+
+  FunctionListTy *getList(const llvm::DenseMap<uint64_t, uint32_t> &Index,
+                          n_t Node, d_t Fact) {
+    auto Key = getKey(Node, Fact);
+    if (!Key) {
+      return nullptr;
+    }
+    auto It = Index.find(*Key);
+    if (It == Index.end()) {
+      return nullptr;
+    }
+    return &FunctionLists[It->second];
+  }
+
+  std::optional<FunctionListRef>
+  lookup(const llvm::DenseMap<uint64_t, uint32_t> &Index, n_t Node,
+         d_t Fact) {
+    const auto *List = getList(Index, Node, Fact);
+    if (!List || List->empty()) {
+      return std::nullopt;
+    }
+    return FunctionListRef(this, List);
+  }
+
+  static uint32_t *find(FunctionListTy &List, uint32_t FactId) {
+    for (auto &[Id, EdgeFuncIdx] : List) {
+      if (Id == FactId) {
+        return &EdgeFuncIdx;
+      }
+    }
+    return nullptr;
+  }
+
+  static std::optional<uint32_t> erase(FunctionListTy &List, uint32_t FactId) {
+    for (auto *It = List.begin(); It != List.end(); ++It) {
+      if (It->first == FactId) {
+        uint32_t EdgeFuncIdx = It->second;
+        List.erase(It);
+        return EdgeFuncIdx;
+      }
+    }
+    return std::nullopt;
+  }
+
+  uint32_t &getOrCreateList(llvm::DenseMap<uint64_t, uint32_t> &Index,
+                            uint64_t Key, bool &Inserted) {
+    auto [It, New] = Index.try_emplace(Key, FunctionLists.size());
+    if (New) {
+      FunctionLists.emplace_back();
+    }
+    Inserted = New;
+    return It->second;
+  }
+
+public:
+  DenseJumpFunctions(
+      EdgeFunctionPtrType Alltop,
+      const IDETabulationProblem<AnalysisDomainTy, Container> &Problem)
+      : Alltop(std::move(Alltop)), Problem(Problem) {}
+
+  ~DenseJumpFunctions() = default;
+
+  // the lists refer to this table by index and the problem is held by
+  // reference, a copy would be of no use
+  DenseJumpFunctions(const DenseJumpFunctions &JFs) = delete;
+  DenseJumpFunctions &operator=(const DenseJumpFunctions &JFs) = delete;
+  DenseJumpFunctions(DenseJumpFunctions &&JFs) noexcept = default;
+  DenseJumpFunctions &operator=(DenseJumpFunctions &&JFs) noexcept = delete;
+
+  /**
+   * Records a jump function. The source statement is implicit.
+   * @see PathEdge
+   */
+  void addFunction(d_t SourceVal, n_t Target, d_t TargetVal,
+                   EdgeFunctionPtrType EdgeFunc) {
+    // we do not store the default function (all-top)
+    if (EdgeFunc->equal_to(Alltop)) {
+      return;
+    }
+    uint32_t TargetId = getOrCreateNodeId(Target);
+    uint32_t SourceValId = getOrCreateFactId(SourceVal);
+    uint32_t TargetValId = getOrCreateFactId(TargetVal);
+    bool RevInserted = false;
+    uint32_t RevIdx = getOrCreateList(
+        ReverseLookup, combine(TargetId, TargetValId), RevInserted);
+    if (RevInserted) {
+      TargetFactsOfNode[TargetId].push_back(TargetValId);
+    }
+    if (auto *EdgeFuncIdx = find(FunctionLists[RevIdx], SourceValId)) {
+      // it is important that existing values in JumpFunctions
+      // are overwritten; the forward list refers to the same slot
+      EdgeFuncs[*EdgeFuncIdx] = std::move(EdgeFunc);
+      return;
+    }
+    bool FwdInserted = false;
+    uint32_t FwdIdx = getOrCreateList(
+        ForwardLookup, combine(TargetId, SourceValId), FwdInserted);
+    uint32_t EdgeFuncIdx = EdgeFuncs.size();
+    EdgeFuncs.push_back(std::move(EdgeFunc));
+    FunctionLists[RevIdx].emplace_back(SourceValId, EdgeFuncIdx);
+    FunctionLists[FwdIdx].emplace_back(TargetValId, EdgeFuncIdx);
+  }
+
+  /**
+   * Returns, for a given target statement and value all associated
+   * source values, and for each the associated edge function.
+   */
+  std::optional<FunctionListRef> reverseLookup(n_t Target, d_t TargetVal) {
+    return lookup(ReverseLookup, Target, TargetVal);
+  }
+
+  /**
+   * Returns, for a given source value and target statement all
+   * associated target values, and for each the associated edge function.
+   */
+  std::optional<FunctionListRef> forwardLookup(d_t SourceVal, n_t Target) {
+    return lookup(ForwardLookup, Target, SourceVal);
+  }
+
+  /**
+   * Calls Handler(sourceVal, targetVal, edgeFunction) for all jump function
+   * records with the given target statement without allocating.
+   */
+  template <typename HandlerFn>
+  void forEachLookupByTarget(n_t Target, HandlerFn &&Handler) const {
+    auto NodeIt = NodeIds.find(Target);
+    if (NodeIt == NodeIds.end()) {
+      return;
+    }
+    for (uint32_t TargetValId : TargetFactsOfNode[NodeIt->second]) {
+      auto ListIdx =
+          ReverseLookup.find(combine(NodeIt->second, TargetValId))->second;
+      for (const auto &[SourceValId, EdgeFuncIdx] : FunctionLists[ListIdx]) {
+        Handler(Facts[SourceValId], Facts[TargetValId],
+                EdgeFuncs[EdgeFuncIdx]);
+      }
+    }
+  }
+
+  /**
+   * Calls Handler(sourceVal, target, targetVal, edgeFunction) for all jump
+   * functions.
+   */
+  template <typename HandlerFn>
+  void forEachFunction(HandlerFn &&Handler) const {
+    for (const auto &[Key, ListIdx] : ReverseLookup) {
+      n_t Target = Nodes[Key >> 32];
+      d_t TargetVal = Facts[Key & 0xFFFFFFFF];
+      for (const auto &[SourceValId, EdgeFuncIdx] : FunctionLists[ListIdx]) {
+        Handler(Facts[SourceValId], Target, TargetVal,
+                EdgeFuncs[EdgeFuncIdx]);
+      }
+    }
+  }
+
+  /**
+   * Removes a jump function. The source statement is implicit.
+   * @see PathEdge
+   * @return True if the function has actually been removed. False if it was not
+   * there anyway.
+   */
+  bool removeFunction(d_t SourceVal, n_t Target, d_t TargetVal) {
+    auto *RevList = getList(ReverseLookup, Target, TargetVal);
+    auto *FwdList = getList(ForwardLookup, Target, SourceVal);
+    if (!RevList || !FwdList) {
+      return false;
+    }
+    // both lists refer to the same edge function
+    auto EdgeFuncIdx = erase(*RevList, FactIds.find(SourceVal)->second);
+    if (!EdgeFuncIdx) {
+      return false;
+    }
+    erase(*FwdList, FactIds.find(TargetVal)->second);
+    EdgeFuncs[*EdgeFuncIdx] = nullptr;
+    return true;
+  }
+
+  /**
+   * Removes all jump functions
+   */
+  void clear() {
+    NodeIds.clear();
+    Nodes.clear();
+    FactIds.clear();
+    Facts.clear();
+    EdgeFuncs.clear();
+    FunctionLists.clear();
+    ReverseLookup.clear();
+    ForwardLookup.clear();
+    TargetFactsOfNode.clear();
+  }
+
+  /**
+   * Returns the number of distinct nodes and facts that have been assigned a
+   * dense id.
+   */
+  [[nodiscard]] std::pair<size_t, size_t> getNumIds() const {
+    return {Nodes.size(), Facts.size()};
+  }
+
+  void printJumpFunctions(llvm::raw_ostream &OS) {
+    OS << "\n******************************************************";
+    OS << "\n*              Print all Jump Functions              *";
+    OS << "\n******************************************************\n";
+    for (uint32_t NodeId = 0; NodeId < Nodes.size(); ++NodeId) {
+      std::string NLabel = Problem.NtoString(Nodes[NodeId]);
+      OS << "\nN: " << NLabel << "\n---" << std::string(NLabel.size(), '-')
+         << '\n';
+      forEachLookupByTarget(
+          Nodes[NodeId],
+          [&OS, this](d_t SourceVal, d_t TargetVal, const auto &EdgeFunc) {
+            OS << "D1: " << Problem.DtoString(SourceVal) << '\n'
+               << "\tD2: " << Problem.DtoString(TargetVal) << '\n'
+               << "\tEF: " << EdgeFunc->str() << "\n\n";
+          });
+    }
+  }
+};
+
+} // namespace psr
+
+#endif
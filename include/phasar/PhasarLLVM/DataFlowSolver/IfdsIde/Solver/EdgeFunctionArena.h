@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+/*
+ * EdgeFunctionArena.h
+ *
+ *  Created on: 18.10.2022
+ *      Author: pdschbrt
+ */
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_EDGEFUNCTIONARENA_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_EDGEFUNCTIONARENA_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+
+namespace psr {
+
+/// Hash-conses the internable edge functions (see
+/// EdgeFunction::isInternable()) that are stored by a solver: for each class
+/// of functions that are equal_to each other, the arena owns exactly one
+/// canonical object, which is handed out instead of all other members of the
+/// class. Identical jump functions hence cost a single pointer each and can
+/// be compared by pointer.
+///
+/// Edge functions that are not internable are passed through unchanged.
+///
+/// An arena is not thread-safe; concurrent solvers use one arena per thread
+/// or per shard.
+template <typename L> class EdgeFunctionArena {
+public:
+  using EdgeFunctionPtrType = typename EdgeFunction<L>::EdgeFunctionPtrType;
+
+  EdgeFunctionArena() = default;
+  ~EdgeFunctionArena() = default;
+
+  EdgeFunctionArena(const EdgeFunctionArena &) = delete;
+  EdgeFunctionArena &operator=(const EdgeFunctionArena &) = delete;
+  EdgeFunctionArena(EdgeFunctionArena &&) noexcept = default;
+  EdgeFunctionArena &operator=(EdgeFunctionArena &&) noexcept = default;
+
+  /// Returns the canonical representative of EdgeFunc's equivalence class.
+  /// EdgeFunc becomes the representative if its class has not been seen
+  /// before.
+  [[nodiscard]] EdgeFunctionPtrType intern(EdgeFunctionPtrType EdgeFunc) {
+    if (!EdgeFunc || !EdgeFunc->isInternable()) {
+      return EdgeFunc;
+    }
+    if (Canonical.count(EdgeFunc.get())) {
+      ++NumReused;
+      return EdgeFunc;
+    }
+    auto &Bucket = Buckets[EdgeFunc->getHashCode()];
+    for (const auto &Candidate : Bucket) {
+      if (Candidate->equal_to(EdgeFunc)) {
+        ++NumReused;
+        return Candidate;
+      }
+    }
+    Canonical.insert(EdgeFunc.get());
+    Bucket.push_back(EdgeFunc);
+    return EdgeFunc;
+  }
+
+  /// Returns the number of canonical edge functions owned by this arena.
+  [[nodiscard]] size_t size() const { return Canonical.size(); }
+
+  /// Returns how often intern() returned an already known canonical function.
+  [[nodiscard]] size_t getNumReused() const { return NumReused; }
+
+  void clear() {
+    Canonical.clear();
+    Buckets.clear();
+    NumReused = 0;
+  }
+
+private:
+  llvm::DenseSet<const EdgeFunction<L> *> Canonical;
+  std::unordered_map<size_t, llvm::SmallVector<EdgeFunctionPtrType, 1>>
+      Buckets;
+  size_t NumReused = 0;
+};
+
+} // namespace psr
+
+#endif
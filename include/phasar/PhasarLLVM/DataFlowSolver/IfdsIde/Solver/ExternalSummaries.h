@@ -0,0 +1,59 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+/*
+ * ExternalSummaries.h
+ *
+ *  Created on: 18.10.2022
+ *      Author: pdschbrt
+ */
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_EXTERNALSUMMARIES_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_EXTERNALSUMMARIES_H
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+
+namespace psr {
+
+/// Provides the end summaries of functions whose definitions are analyzed by
+/// another solver instead of the IDESolver that encounters calls to them,
+/// e.g., by the solver of another module in a ModuleWiseAnalysis or by the
+/// solver of a previous program version in an IncrementalUpdateAnalysis.
+///
+/// At a call to such a function the IDESolver maps the actual parameters to
+/// the formal parameters of the definition, looks up the end summaries of the
+/// definition for the resulting facts and returns the summarized facts to the
+/// caller using the problem's own call and return flow and edge functions.
+template <typename N, typename D, typename F, typename L>
+class ExternalSummaries {
+public:
+  using EdgeFunctionPtrType = std::shared_ptr<EdgeFunction<L>>;
+  /// An end summary: an exit statement of the summarized function, a fact
+  /// holding at that statement and the edge function from the start point.
+  using EndSummaryTy = std::tuple<N, D, EdgeFunctionPtrType>;
+
+  virtual ~ExternalSummaries() = default;
+
+  /// Returns the externally analyzed definition of Callee, which may be
+  /// Callee itself, or nullptr if Callee is not summarized externally.
+  [[nodiscard]] virtual F getDefinition(F Callee) = 0;
+
+  /// Returns the end summaries of the function starting at SP, which has been
+  /// returned by getDefinition(), for Fact holding at SP.
+  [[nodiscard]] virtual std::vector<EndSummaryTy> getEndSummaries(N SP,
+                                                                  D Fact) = 0;
+};
+
+} // namespace psr
+
+#endif
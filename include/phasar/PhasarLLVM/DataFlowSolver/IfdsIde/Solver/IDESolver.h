@@ -17,15 +17,22 @@
 #ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_IDESOLVER_H
 #define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_IDESOLVER_H
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "nlohmann/json.hpp"
 
@@ -42,11 +49,18 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/InitialSeeds.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/JoinLattice.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/DenseJumpFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/EdgeFunctionArena.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ExternalSummaries.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSToIDETabulationProblem.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JoinHandlingNode.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JumpFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/LinkedNode.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ParallelTabulation.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PersistedSummaries.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryPack.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
 #include "phasar/PhasarLLVM/Utils/DOTGraph.h"
 #include "phasar/Utils/LLVMShorthands.h"
@@ -78,8 +92,13 @@ template <typename AnalysisDomainTy, typename Container> struct IFDSExtension {
 /// Solves the given IDETabulationProblem as described in the 1996 paper by
 /// Sagiv, Horwitz and Reps. To solve the problem, call solve(). Results
 /// can then be queried by using resultAt() and resultsAt().
+///
+/// The jump functions are stored in a JumpFunctions by default. Large analyses
+/// may use DenseJumpFunctions as JumpFunctionsTy instead, which requires
+/// considerably less memory.
 template <typename AnalysisDomainTy,
           typename Container = std::set<typename AnalysisDomainTy::d_t>,
+          typename JumpFunctionsTy = JumpFunctions<AnalysisDomainTy, Container>,
           bool = is_analysis_domain_extensions<AnalysisDomainTy>::value>
 class IDESolver
     : protected std::conditional_t<
@@ -103,9 +122,9 @@ public:
       : IDEProblem(Problem), ZeroValue(Problem.getZeroValue()),
         ICF(Problem.getICFG()), SolverConfig(Problem.getIFDSIDESolverConfig()),
         CachedFlowEdgeFunctions(Problem), AllTop(Problem.allTopFunction()),
-        JumpFn(std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
-            AllTop, IDEProblem)),
-        Seeds(Problem.initialSeeds()) {}
+        JumpFn(std::make_shared<JumpFunctionsTy>(AllTop, IDEProblem)),
+        Seeds(Problem.initialSeeds()),
+        WorkList(ICF, SolverConfig.schedulingPolicy()) {}
 
   IDESolver(const IDESolver &) = delete;
   IDESolver &operator=(const IDESolver &) = delete;
@@ -150,6 +169,7 @@ public:
     REG_COUNTER("Gen facts", 0, PAMM_SEVERITY_LEVEL::Core);
     REG_COUNTER("Kill facts", 0, PAMM_SEVERITY_LEVEL::Core);
     REG_COUNTER("Summary-reuse", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("PersistedSummary-reuse", 0, PAMM_SEVERITY_LEVEL::Core);
     REG_COUNTER("Intra Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
     REG_COUNTER("Inter Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
     REG_COUNTER("FF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
@@ -159,6 +179,7 @@ public:
     REG_COUNTER("SpecialSummary-FF Application", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("SpecialSummary-EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("JumpFn Construction", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Max Worklist Size", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Process Call", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Process Normal", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Process Exit", 0, PAMM_SEVERITY_LEVEL::Full);
@@ -167,30 +188,290 @@ public:
     REG_HISTOGRAM("Points-to", PAMM_SEVERITY_LEVEL::Full);
 
     PHASAR_LOG_LEVEL(INFO, "IDE solver is solving the specified problem");
+    if (SolverConfig.numThreads() > 1 && !IDEProblem.isThreadSafe()) {
+      PHASAR_LOG_LEVEL(WARNING, "The analysis problem is not thread-safe, "
+                                "solve it sequentially");
+    }
+    bool Parallel = getNumThreads() > 1;
+    if (Parallel && usesSummaries()) {
+      PHASAR_LOG_LEVEL(WARNING, "External, persisted and packed summaries are "
+                                "only supported by the sequential solver, "
+                                "solve it sequentially");
+      Parallel = false;
+    }
+    if (Parallel) {
+      solveInParallel();
+    } else {
+      solvePhaseI();
+      if (SolverConfig.computeValues()) {
+        solvePhaseII();
+      }
+    }
+    PHASAR_LOG_LEVEL(INFO, "Problem solved");
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
+      computeAndPrintStatistics();
+    }
+    if (SolverConfig.emitESG()) {
+      emitESGAsDot();
+    }
+  }
+
+  /// Phase I: submits the initial seeds and constructs the exploded super
+  /// graph on the calling thread. solve() runs both phases; clients that
+  /// interleave Phase I of several solvers, e.g., via ExternalSummaries, call
+  /// the phases separately.
+  void solvePhaseI() {
+    PAMM_GET_INSTANCE;
     PHASAR_LOG_LEVEL(INFO,
                      "Submit initial seeds, construct exploded super graph");
     // computations starting here
     START_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
     // We start our analysis and construct exploded supergraph
     submitInitialSeeds();
+    processWorkList();
     STOP_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
-    if (SolverConfig.computeValues()) {
-      START_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
-      // Computing the final values for the edge functions
-      PHASAR_LOG_LEVEL(
-          INFO, "Compute the final values according to the edge functions");
-      computeValues();
-      STOP_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  /// Phase II: computes the final values according to the jump functions
+  /// constructed by solvePhaseI().
+  void solvePhaseII() {
+    PAMM_GET_INSTANCE;
+    START_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+    // Computing the final values for the edge functions
+    PHASAR_LOG_LEVEL(INFO,
+                     "Compute the final values according to the edge functions");
+    computeValues();
+    STOP_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  /// Uses Summaries for calls to functions whose definitions are analyzed
+  /// elsewhere, e.g., in another module or in a previous version of the
+  /// program. Only supported by the sequential solver; Summaries must outlive
+  /// the solver.
+  void setExternalSummaries(
+      ExternalSummaries<n_t, d_t, f_t, l_t> *Summaries) noexcept {
+    ExtSummaries = Summaries;
+  }
+
+  /// Applies the end summaries provided by Summaries to calls instead of
+  /// analyzing the callees for the facts they cover. Only supported by the
+  /// sequential solver and for problems that opt in (see
+  /// IFDSTabulationProblem::canPersistSummaries()); Summaries must outlive the
+  /// solver.
+  void setPersistedSummaries(
+      PersistedSummaries<n_t, d_t, f_t, l_t> *Summaries) {
+    if (Summaries && !IDEProblem.canPersistSummaries()) {
+      PHASAR_LOG_LEVEL(WARNING, "The problem does not support persisted "
+                                "summaries, analyze all functions instead");
+      return;
     }
-    PHASAR_LOG_LEVEL(INFO, "Problem solved");
-    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
-      computeAndPrintStatistics();
+    PSummaries = Summaries;
+  }
+
+  /// Applies the summaries of Pack to calls of the functions it summarizes
+  /// completely, instead of analyzing them, unless the problem provides its
+  /// own summary flow function. Only supported for IFDS problems on LLVM IR
+  /// and by the sequential solver; Pack must be indexed for the program under
+  /// analysis and outlive the solver. Problems that do not opt in (see
+  /// IFDSTabulationProblem::canPersistSummaries()) ignore the pack, as
+  /// applying it skips the side effects of their flow functions.
+  void setSummaryPack(SummaryPack *Pack) {
+    if (Pack && !IDEProblem.canPersistSummaries()) {
+      PHASAR_LOG_LEVEL(WARNING, "The problem does not support summary packs, "
+                                "analyze all functions instead");
+      return;
     }
-    if (SolverConfig.emitESG()) {
-      emitESGAsDot();
+    CachedFlowEdgeFunctions.setSummaryPack(Pack);
+  }
+
+  /// Adds the end summaries computed during Phase I to the persisted
+  /// summaries, for every fact that has reached the start point of a function
+  /// via a call or an initial seed. Must be called after Phase I has finished.
+  /// Does nothing if path edges have been deferred by a path-edge filter, as
+  /// the end summaries are incomplete in this case.
+  void exportPersistedSummaries() {
+    if (!PSummaries || !DeferredPathEdges.empty()) {
+      return;
+    }
+    auto Export = [this](n_t SP, d_t Fact) {
+      PSummaries->addEndSummaries(ICF->getFunctionOf(SP), Fact,
+                                  getEndSummaries(SP, Fact));
+    };
+    IncomingTab.forEachCell([&Export](n_t SP, d_t Fact,
+                                      const auto & /*Incoming*/) {
+      Export(SP, Fact);
+    });
+    for (const auto &[Node, Facts] : Seeds.getSeeds()) {
+      if (!ICF->isStartPoint(Node)) {
+        continue;
+      }
+      for (const auto &Fact : Facts) {
+        Export(Node, Fact.first);
+      }
     }
   }
 
+  /// Returns the end summaries of the function starting at SP for Fact
+  /// holding at SP. If <SP, Fact> has not been reached during Phase I, it is
+  /// added as an initial seed with the bottom value, i.e., without knowing
+  /// the values flowing in from the (external) callers, and Phase I is
+  /// resumed until the worklist is exhausted.
+  ///
+  /// Must not be called while this solver is processing its worklist.
+  std::vector<typename ExternalSummaries<n_t, d_t, f_t, l_t>::EndSummaryTy>
+  summarize(n_t SP, d_t Fact) {
+    if (jumpFunction(PathEdge<n_t, d_t>(Fact, SP, Fact)) == AllTop) {
+      Seeds.addSeed(SP, Fact, IDEProblem.bottomElement());
+      propagate(Fact, SP, Fact, EdgeIdentity<l_t>::getInstance(), nullptr,
+                false);
+      processWorkList();
+    }
+    return getEndSummaries(SP, Fact);
+  }
+
+  /// Returns the end summaries of the function starting at SP for Fact
+  /// holding at SP that are known so far.
+  std::vector<typename ExternalSummaries<n_t, d_t, f_t, l_t>::EndSummaryTy>
+  getEndSummaries(n_t SP, d_t Fact) {
+    std::vector<typename ExternalSummaries<n_t, d_t, f_t, l_t>::EndSummaryTy>
+        Summaries;
+    if (!EndsummaryTab.contains(SP, Fact)) {
+      return Summaries;
+    }
+    EndsummaryTab.get(SP, Fact).forEachCell(
+        [&Summaries](n_t EP, d_t D, const EdgeFunctionPtrType &EF) {
+          Summaries.emplace_back(EP, D, EF);
+        });
+    return Summaries;
+  }
+
+  /// Processes all calls to which external summaries have been applied once
+  /// more, such that summaries that have grown since are taken into account,
+  /// and resumes Phase I. Returns true if new path edges have been processed.
+  bool reprocessExternalCalls() {
+    unsigned PathEdgeCountBefore = PathEdgeCount;
+    // processCall() may record further calls
+    const auto Calls = ExternalCalls;
+    for (const auto &Call : Calls) {
+      processCall(Call);
+    }
+    processWorkList();
+    return PathEdgeCount != PathEdgeCountBefore;
+  }
+
+  /// Restricts Phase I to the nodes of the exploded super graph for which
+  /// Filter returns true. Path edges to other nodes are recorded, but not
+  /// processed, until resumeDeferredPathEdges() is called after the filter
+  /// has been widened. An empty filter processes all path edges. Only
+  /// supported by the sequential solver.
+  void setPathEdgeFilter(std::function<bool(n_t)> Filter) {
+    PathEdgeFilter = std::move(Filter);
+  }
+
+  /// Resumes Phase I with the deferred path edges whose targets pass the
+  /// current path-edge filter. Returns the number of resumed path edges.
+  size_t resumeDeferredPathEdges() {
+    size_t NumResumed = scheduleDeferredPathEdges();
+    processWorkList();
+    return NumResumed;
+  }
+
+  /// Adds the deferred path edges whose targets pass the current path-edge
+  /// filter to the worklist without processing them. Returns their number.
+  size_t scheduleDeferredPathEdges() {
+    size_t NumResumed = 0;
+    for (auto It = DeferredPathEdges.begin(); It != DeferredPathEdges.end();) {
+      if (PathEdgeFilter && !PathEdgeFilter(It->first)) {
+        ++It;
+        continue;
+      }
+      for (const auto &[SourceVal, TargetVal] : It->second) {
+        WorkList.push(PathEdge<n_t, d_t>(SourceVal, It->first, TargetVal));
+      }
+      NumResumed += It->second.size();
+      It = DeferredPathEdges.erase(It);
+    }
+    return NumResumed;
+  }
+
+  /// Returns the targets of the path edges deferred by the path-edge filter.
+  [[nodiscard]] std::vector<n_t> getDeferredPathEdgeTargets() const {
+    std::vector<n_t> Targets;
+    Targets.reserve(DeferredPathEdges.size());
+    for (const auto &Deferred : DeferredPathEdges) {
+      Targets.push_back(Deferred.first);
+    }
+    return Targets;
+  }
+
+  /// Lets Listener observe the target node and fact of every path edge that
+  /// is processed during Phase I. Only supported by the sequential solver.
+  void setPathEdgeListener(std::function<void(n_t, d_t)> Listener) {
+    PathEdgeListener = std::move(Listener);
+  }
+
+  /// Schedules the processing of initial seeds, initiating the analysis.
+  /// Clients should only call this methods if performing synchronization on
+  /// their own. Normally, solve() should be called instead.
+  void submitInitialSeeds() {
+    PAMM_GET_INSTANCE;
+    addZeroValueToSeeds();
+    PHASAR_LOG_LEVEL(DEBUG,
+                     "Number of initial seeds: " << Seeds.countInitialSeeds());
+    PHASAR_LOG_LEVEL(DEBUG, "List of initial seeds: ");
+    for (const auto &[StartPoint, Facts] : Seeds.getSeeds()) {
+      PHASAR_LOG_LEVEL(DEBUG,
+                       "Start point: " << IDEProblem.NtoString(StartPoint));
+      /// If statically disabling the logger, Fact and Value are unused. To
+      /// prevent the copilation to fail with -Werror, add the [[maybe_unused]]
+      /// attribute
+      for ([[maybe_unused]] const auto &[Fact, Value] : Facts) {
+        PHASAR_LOG_LEVEL(DEBUG, "\tFact: " << IDEProblem.DtoString(Fact));
+        PHASAR_LOG_LEVEL(DEBUG, "\tValue: " << IDEProblem.LtoString(Value));
+      }
+    }
+    for (const auto &[StartPoint, Facts] : Seeds.getSeeds()) {
+      for (const auto &[Fact, Value] : Facts) {
+        PHASAR_LOG_LEVEL(
+            DEBUG, "Submit seed at: " << IDEProblem.NtoString(StartPoint));
+        PHASAR_LOG_LEVEL(DEBUG, "\tFact: " << IDEProblem.DtoString(Fact));
+        PHASAR_LOG_LEVEL(DEBUG, "\tValue: " << IDEProblem.LtoString(Value));
+        if (!IDEProblem.isZeroValue(Fact)) {
+          INC_COUNTER("Gen facts", 1, PAMM_SEVERITY_LEVEL::Core);
+        }
+        propagate(Fact, StartPoint, Fact, EdgeIdentity<l_t>::getInstance(),
+                  nullptr, false);
+        JumpFn->addFunction(Fact, StartPoint, Fact,
+                            EdgeIdentity<l_t>::getInstance());
+      }
+    }
+  }
+
+  /// Processes at most MaxNumPathEdges pending path edges of Phase I and
+  /// returns true if path edges are still pending. Together with
+  /// submitInitialSeeds(), this lets clients interleave Phase I with other
+  /// work, e.g., with the Phase I of another solver.
+  bool processPathEdges(size_t MaxNumPathEdges) {
+    processWorkList(MaxNumPathEdges);
+    return !WorkList.empty();
+  }
+
+  /// Computes the values at the given nodes only, rather than at all nodes as
+  /// Phase II does: the values at the start points and call sites are
+  /// computed from the jump functions constructed so far (Phase II(i)) and
+  /// the values at Nodes are derived from them. The values are kept across
+  /// calls, such that a later call only propagates the values along the jump
+  /// functions that Phase I has added or changed in the meantime.
+  void computeValuesAt(const std::vector<n_t> &Nodes) {
+    if (!ComputesValuesOnDemand) {
+      ComputesValuesOnDemand = true;
+      computeValuesAtCallStartNodes();
+    } else {
+      computeValuesAtNewCallStartNodes();
+    }
+    valueComputationTask(Nodes);
+  }
+
   /// Returns the L-type result for the given value at the given statement.
   [[nodiscard]] virtual l_t resultAt(n_t Stmt, d_t Value) {
     return ValTab.get(Stmt, Value);
@@ -395,7 +676,10 @@ protected:
 
   EdgeFunctionPtrType AllTop;
 
-  std::shared_ptr<JumpFunctions<AnalysisDomainTy, Container>> JumpFn;
+  std::shared_ptr<JumpFunctionsTy> JumpFn;
+
+  // owns the canonical objects of all internable jump functions
+  EdgeFunctionArena<l_t> EFArena;
 
   std::map<std::tuple<n_t, d_t, n_t, d_t>, std::vector<EdgeFunctionPtrType>>
       IntermediateEdgeFunctions;
@@ -418,6 +702,33 @@ protected:
 
   std::map<std::pair<n_t, d_t>, size_t> FSummaryReuse;
 
+  // path edges that have been discovered but not processed, yet; Phase I runs
+  // until this worklist is exhausted
+  PathEdgeWorklist<n_t, d_t, f_t, i_t> WorkList;
+
+  // summaries of callees that are defined outside of the analyzed IR
+  ExternalSummaries<n_t, d_t, f_t, l_t> *ExtSummaries = nullptr;
+
+  // the call edges to which external summaries have been applied
+  std::vector<PathEdge<n_t, d_t>> ExternalCalls;
+  std::set<std::tuple<d_t, n_t, d_t>> KnownExternalCalls;
+
+  // summaries of previous solver runs that are applied instead of analyzing
+  // the callees they cover, and that receive the summaries of this run
+  PersistedSummaries<n_t, d_t, f_t, l_t> *PSummaries = nullptr;
+
+  // restricts the path edges that are processed during Phase I; path edges
+  // to other nodes are deferred by their target node
+  std::function<bool(n_t)> PathEdgeFilter;
+  std::unordered_map<n_t, std::set<std::pair<d_t, d_t>>> DeferredPathEdges;
+  std::function<void(n_t, d_t)> PathEdgeListener;
+
+  // set by computeValuesAt(); the jump functions to call sites that have been
+  // added or changed since then, whose values are yet to be propagated
+  bool ComputesValuesOnDemand = false;
+  std::vector<std::tuple<d_t, n_t, d_t, EdgeFunctionPtrType>>
+      PendingCallSiteJumpFns;
+
   // When transforming an IFDSTabulationProblem into an IDETabulationProblem,
   // we need to allocate dynamically, otherwise the objects lifetime runs out
   // - as a modifiable r-value reference created here that should be stored in
@@ -435,9 +746,9 @@ protected:
         SolverConfig(IDEProblem.getIFDSIDESolverConfig()),
         CachedFlowEdgeFunctions(IDEProblem),
         AllTop(IDEProblem.allTopFunction()),
-        JumpFn(std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
-            AllTop, IDEProblem)),
-        Seeds(IDEProblem.initialSeeds()) {}
+        JumpFn(std::make_shared<JumpFunctionsTy>(AllTop, IDEProblem)),
+        Seeds(IDEProblem.initialSeeds()),
+        WorkList(ICF, SolverConfig.schedulingPolicy()) {}
 
   /// Lines 13-20 of the algorithm; processing a call site in the caller's
   /// context.
@@ -506,9 +817,14 @@ protected:
                                             << SumEdgFnE->str());
                 PHASAR_LOG_LEVEL(DEBUG, "Compose: " << SumEdgFnE->str() << " * "
                                                     << f->str() << '\n'));
-            propagate(d1, ReturnSiteN, d3, f->composeWith(SumEdgFnE), n, false);
+            propagate(
+                d1, ReturnSiteN, d3,
+                CachedFlowEdgeFunctions.composeEdgeFunctions(f, SumEdgFnE), n,
+                false);
           }
         }
+      } else if (f_t Definition = getExternalDefinition(SCalledProcN)) {
+        processExternalCall(Edge, f, Definition, ReturnSiteNs);
       } else {
         // compute the call-flow function
         FlowFunctionPtrType Function =
@@ -524,11 +840,21 @@ protected:
                                       ICF->getFunctionName(SCalledProcN) +
                                       "' currently not available!");
         }
+        // The persisted summaries of a callee cover all of its start points,
+        // hence, they are applied once for each fact entering it
+        std::vector<d_t> Unsummarized;
+        for (d_t d3 : Res) {
+          if (!applyPersistedSummaries(Edge, f, SCalledProcN, d3,
+                                       ReturnSiteNs)) {
+            Unsummarized.push_back(d3);
+          }
+        }
         // if startPointsOf is empty, the called function is a declaration
         for (n_t SP : StartPointsOf) {
           saveEdges(n, SP, d2, Res, true);
-          // for each result node of the call-flow function
-          for (d_t d3 : Res) {
+          // for each result node of the call-flow function that is not
+          // summarized
+          for (d_t d3 : Unsummarized) {
             using TableCell =
                 typename Table<n_t, d_t, EdgeFunctionPtrType>::Cell;
             // create initial self-loop
@@ -554,63 +880,9 @@ protected:
             // sites because we have observed a potentially new incoming
             // edge into <sP,d3>
             for (const TableCell &Entry : endSummary(SP, d3)) {
-              n_t eP = Entry.getRowKey();
-              d_t d4 = Entry.getColumnKey();
-              EdgeFunctionPtrType fCalleeSummary = Entry.getValue();
-              // for each return site
-              for (n_t RetSiteN : ReturnSiteNs) {
-                // compute return-flow function
-                FlowFunctionPtrType RetFunction =
-                    CachedFlowEdgeFunctions.getRetFlowFunction(n, SCalledProcN,
-                                                               eP, RetSiteN);
-                INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-                const container_type ReturnedFacts = computeReturnFlowFunction(
-                    RetFunction, d3, d4, n, Container{d2});
-                ADD_TO_HISTOGRAM("Data-flow facts", returnedFacts.size(), 1,
-                                 PAMM_SEVERITY_LEVEL::Full);
-                saveEdges(eP, RetSiteN, d4, ReturnedFacts, true);
-                // for each target value of the function
-                for (d_t d5 : ReturnedFacts) {
-                  // update the caller-side summary function
-                  // get call edge function
-                  EdgeFunctionPtrType f4 =
-                      CachedFlowEdgeFunctions.getCallEdgeFunction(
-                          n, d2, SCalledProcN, d3);
-                  PHASAR_LOG_LEVEL(DEBUG,
-                                   "Queried Call Edge Function: " << f4->str());
-                  // get return edge function
-                  EdgeFunctionPtrType f5 =
-                      CachedFlowEdgeFunctions.getReturnEdgeFunction(
-                          n, SCalledProcN, eP, d4, RetSiteN, d5);
-                  PHASAR_LOG_LEVEL(
-                      DEBUG, "Queried Return Edge Function: " << f5->str());
-                  if (SolverConfig.emitESG()) {
-                    for (auto SP : ICF->getStartPointsOf(SCalledProcN)) {
-                      IntermediateEdgeFunctions[std::make_tuple(n, d2, SP, d3)]
-                          .push_back(f4);
-                    }
-                    IntermediateEdgeFunctions[std::make_tuple(eP, d4, RetSiteN,
-                                                              d5)]
-                        .push_back(f5);
-                  }
-                  INC_COUNTER("EF Queries", 2, PAMM_SEVERITY_LEVEL::Full);
-                  // compose call * calleeSummary * return edge functions
-                  PHASAR_LOG_LEVEL(DEBUG, "Compose: " << f5->str() << " * "
-                                                      << fCalleeSummary->str()
-                                                      << " * " << f4->str());
-                  PHASAR_LOG_LEVEL(DEBUG,
-                                   "         (return * calleeSummary * call)");
-                  EdgeFunctionPtrType fPrime =
-                      f4->composeWith(fCalleeSummary)->composeWith(f5);
-                  PHASAR_LOG_LEVEL(DEBUG, "       = " << fPrime->str());
-                  d_t d5_restoredCtx = restoreContextOnReturnedFact(n, d2, d5);
-                  // propagte the effects of the entire call
-                  PHASAR_LOG_LEVEL(DEBUG, "Compose: " << fPrime->str() << " * "
-                                                      << f->str());
-                  propagate(d1, RetSiteN, d5_restoredCtx,
-                            f->composeWith(fPrime), n, false);
-                }
-              }
+              applyEndSummary(Edge, f, SCalledProcN, d3, Entry.getRowKey(),
+                              Entry.getColumnKey(), Entry.getValue(),
+                              ReturnSiteNs);
             }
           }
         }
@@ -639,7 +911,7 @@ protected:
               .push_back(EdgeFnE);
         }
         INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
-        auto fPrime = f->composeWith(EdgeFnE);
+        auto fPrime = CachedFlowEdgeFunctions.composeEdgeFunctions(f, EdgeFnE);
         PHASAR_LOG_LEVEL(DEBUG, "Compose: " << EdgeFnE->str() << " * "
                                             << f->str() << " = "
                                             << fPrime->str());
@@ -648,6 +920,131 @@ protected:
     }
   }
 
+  /// Line 15.2 of Naeem/Lhotak/Rodriguez; applies the end summary from
+  /// <sP,d3> to <eP,d4> of Callee, with the summary edge function
+  /// fCalleeSummary, to the call edge Edge, whose jump function is f.
+  void applyEndSummary(const PathEdge<n_t, d_t> &Edge,
+                       const EdgeFunctionPtrType &f, f_t Callee, d_t d3, n_t eP,
+                       d_t d4, const EdgeFunctionPtrType &fCalleeSummary,
+                       const std::set<n_t> &ReturnSiteNs) {
+    PAMM_GET_INSTANCE;
+    d_t d1 = Edge.factAtSource();
+    n_t n = Edge.getTarget();
+    d_t d2 = Edge.factAtTarget();
+    // for each return site
+    for (n_t RetSiteN : ReturnSiteNs) {
+      // compute return-flow function
+      FlowFunctionPtrType RetFunction =
+          CachedFlowEdgeFunctions.getRetFlowFunction(n, Callee, eP, RetSiteN);
+      INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+      const container_type ReturnedFacts =
+          computeReturnFlowFunction(RetFunction, d3, d4, n, Container{d2});
+      ADD_TO_HISTOGRAM("Data-flow facts", returnedFacts.size(), 1,
+                       PAMM_SEVERITY_LEVEL::Full);
+      saveEdges(eP, RetSiteN, d4, ReturnedFacts, true);
+      // for each target value of the function
+      for (d_t d5 : ReturnedFacts) {
+        // update the caller-side summary function
+        // get call edge function
+        EdgeFunctionPtrType f4 =
+            CachedFlowEdgeFunctions.getCallEdgeFunction(n, d2, Callee, d3);
+        PHASAR_LOG_LEVEL(DEBUG, "Queried Call Edge Function: " << f4->str());
+        // get return edge function
+        EdgeFunctionPtrType f5 = CachedFlowEdgeFunctions.getReturnEdgeFunction(
+            n, Callee, eP, d4, RetSiteN, d5);
+        PHASAR_LOG_LEVEL(DEBUG, "Queried Return Edge Function: " << f5->str());
+        if (SolverConfig.emitESG()) {
+          for (auto SP : ICF->getStartPointsOf(Callee)) {
+            IntermediateEdgeFunctions[std::make_tuple(n, d2, SP, d3)].push_back(
+                f4);
+          }
+          IntermediateEdgeFunctions[std::make_tuple(eP, d4, RetSiteN, d5)]
+              .push_back(f5);
+        }
+        INC_COUNTER("EF Queries", 2, PAMM_SEVERITY_LEVEL::Full);
+        // compose call * calleeSummary * return edge functions
+        PHASAR_LOG_LEVEL(DEBUG, "Compose: " << f5->str() << " * "
+                                            << fCalleeSummary->str() << " * "
+                                            << f4->str());
+        PHASAR_LOG_LEVEL(DEBUG, "         (return * calleeSummary * call)");
+        EdgeFunctionPtrType fPrime =
+            CachedFlowEdgeFunctions.composeEdgeFunctions(
+                CachedFlowEdgeFunctions.composeEdgeFunctions(f4,
+                                                             fCalleeSummary),
+                f5);
+        PHASAR_LOG_LEVEL(DEBUG, "       = " << fPrime->str());
+        d_t d5_restoredCtx = restoreContextOnReturnedFact(n, d2, d5);
+        // propagte the effects of the entire call
+        PHASAR_LOG_LEVEL(DEBUG,
+                         "Compose: " << fPrime->str() << " * " << f->str());
+        propagate(d1, RetSiteN, d5_restoredCtx,
+                  CachedFlowEdgeFunctions.composeEdgeFunctions(f, fPrime), n,
+                  false);
+      }
+    }
+  }
+
+  /// Applies the persisted end summaries of Callee for d3 holding at its start
+  /// point to the call edge Edge, whose jump function is f. Returns false if
+  /// there are none, i.e., Callee must be analyzed for d3.
+  bool applyPersistedSummaries(const PathEdge<n_t, d_t> &Edge,
+                               const EdgeFunctionPtrType &f, f_t Callee,
+                               d_t d3, const std::set<n_t> &ReturnSiteNs) {
+    if (!PSummaries) {
+      return false;
+    }
+    auto Summaries = PSummaries->getEndSummaries(Callee, d3);
+    if (!Summaries) {
+      return false;
+    }
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("PersistedSummary-reuse", 1, PAMM_SEVERITY_LEVEL::Core);
+    PHASAR_LOG_LEVEL(DEBUG, "Apply persisted summaries of '"
+                                << ICF->getFunctionName(Callee) << '\'');
+    for (const auto &[eP, d4, fCalleeSummary] : *Summaries) {
+      applyEndSummary(Edge, f, Callee, d3, eP, d4, fCalleeSummary,
+                      ReturnSiteNs);
+    }
+    return true;
+  }
+
+  /// Returns the externally analyzed definition of Callee if ExtSummaries
+  /// summarizes it, nullptr otherwise.
+  f_t getExternalDefinition(f_t Callee) {
+    return ExtSummaries ? ExtSummaries->getDefinition(Callee) : nullptr;
+  }
+
+  /// Processes a call to a function whose Definition is analyzed externally:
+  /// maps the call-site facts into Definition and applies its external end
+  /// summaries. Unlike for calls within the ICFG, no incoming edges are
+  /// registered; the call is reprocessed by reprocessExternalCalls() instead.
+  void processExternalCall(const PathEdge<n_t, d_t> &Edge,
+                           const EdgeFunctionPtrType &f, f_t Definition,
+                           const std::set<n_t> &ReturnSiteNs) {
+    PAMM_GET_INSTANCE;
+    n_t n = Edge.getTarget();
+    d_t d2 = Edge.factAtTarget();
+    PHASAR_LOG_LEVEL(DEBUG, "Apply external summaries of '"
+                                << ICF->getFunctionName(Definition) << '\'');
+    if (KnownExternalCalls.emplace(Edge.factAtSource(), n, d2).second) {
+      ExternalCalls.push_back(Edge);
+    }
+    FlowFunctionPtrType Function =
+        CachedFlowEdgeFunctions.getCallFlowFunction(n, Definition);
+    INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+    const container_type Res =
+        computeCallFlowFunction(Function, Edge.factAtSource(), d2);
+    for (n_t SP : ICF->getStartPointsOf(Definition)) {
+      for (d_t d3 : Res) {
+        for (const auto &[eP, d4, fCalleeSummary] :
+             ExtSummaries->getEndSummaries(SP, d3)) {
+          applyEndSummary(Edge, f, Definition, d3, eP, d4, fCalleeSummary,
+                          ReturnSiteNs);
+        }
+      }
+    }
+  }
+
   /// Lines 33-37 of the algorithm.
   /// Simply propagate normal, intra-procedural flows.
   /// @param edge
@@ -673,7 +1070,8 @@ protected:
         EdgeFunctionPtrType g =
             CachedFlowEdgeFunctions.getNormalEdgeFunction(n, d2, nPrime, d3);
         PHASAR_LOG_LEVEL(DEBUG, "Queried Normal Edge Function: " << g->str());
-        EdgeFunctionPtrType fPrime = f->composeWith(g);
+        EdgeFunctionPtrType fPrime =
+            CachedFlowEdgeFunctions.composeEdgeFunctions(f, g);
         if (SolverConfig.emitESG()) {
           IntermediateEdgeFunctions[std::make_tuple(n, d2, nPrime, d3)]
               .push_back(g);
@@ -711,6 +1109,10 @@ protected:
     PAMM_GET_INSTANCE;
     d_t Fact = NAndD.second;
     for (const f_t Callee : ICF->getCalleesOfCallAt(Stmt)) {
+      // Phase I has not analyzed callees that are replaced by a summary
+      if (CachedFlowEdgeFunctions.getSummaryFlowFunction(Stmt, Callee)) {
+        continue;
+      }
       FlowFunctionPtrType CallFlowFunction =
           CachedFlowEdgeFunctions.getCallFlowFunction(Stmt, Callee);
       INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
@@ -864,22 +1266,104 @@ protected:
     PAMM_GET_INSTANCE;
     for (n_t n : Values) {
       for (n_t SP : ICF->getStartPointsOf(ICF->getFunctionOf(n))) {
-        using TableCell = typename Table<d_t, d_t, EdgeFunctionPtrType>::Cell;
-        Table<d_t, d_t, EdgeFunctionPtrType> &LookupByTarget =
-            JumpFn->lookupByTarget(n);
-        for (const TableCell &SourceValTargetValAndFunction :
-             LookupByTarget.cellSet()) {
-          d_t dPrime = SourceValTargetValAndFunction.getRowKey();
-          d_t d = SourceValTargetValAndFunction.getColumnKey();
-          EdgeFunctionPtrType fPrime = SourceValTargetValAndFunction.getValue();
-          l_t TargetVal = val(SP, dPrime);
-          setVal(n, d,
-                 IDEProblem.join(val(n, d),
-                                 fPrime->computeTarget(std::move(TargetVal))));
-          INC_COUNTER("Value Computation", 1, PAMM_SEVERITY_LEVEL::Full);
-        }
+        JumpFn->forEachLookupByTarget(
+            n, [&](d_t dPrime, d_t d, const EdgeFunctionPtrType &fPrime) {
+              l_t TargetVal = val(SP, dPrime);
+              setVal(n, d,
+                     IDEProblem.join(
+                         val(n, d),
+                         fPrime->computeTarget(std::move(TargetVal))));
+              INC_COUNTER("Value Computation", 1, PAMM_SEVERITY_LEVEL::Full);
+            });
+      }
+    }
+  }
+
+  /// Computes the values at the given nodes into Results, which may be a
+  /// thread-local table. ValTab and the jump functions are only read, hence
+  /// multiple threads may run this task on disjoint sets of nodes at the same
+  /// time. Returns the number of value computations.
+  size_t valueComputationTask(const std::vector<n_t> &Values,
+                              Table<n_t, d_t, l_t> &Results) {
+    const auto &CurrValTab = std::as_const(ValTab);
+    auto ValAt = [this, &CurrValTab](n_t NHashN, d_t NHashD) -> l_t {
+      if (CurrValTab.contains(NHashN, NHashD)) {
+        return CurrValTab.get(NHashN, NHashD);
+      }
+      return IDEProblem.topElement();
+    };
+    size_t NumComputations = 0;
+    for (n_t n : Values) {
+      for (n_t SP : ICF->getStartPointsOf(ICF->getFunctionOf(n))) {
+        JumpFn->forEachLookupByTarget(
+            n, [&](d_t dPrime, d_t d, const EdgeFunctionPtrType &fPrime) {
+              l_t Curr =
+                  Results.contains(n, d) ? Results.get(n, d) : ValAt(n, d);
+              Results.insert(n, d,
+                             IDEProblem.join(std::move(Curr),
+                                             fPrime->computeTarget(
+                                                 ValAt(SP, dPrime))));
+              ++NumComputations;
+            });
       }
     }
+    return NumComputations;
+  }
+
+  /// Phase II(ii): computes the values at all nodes that are neither call
+  /// sites nor start points. If multiple threads are configured, the nodes
+  /// are partitioned by function and the partitions are handed out to the
+  /// threads, largest first; each thread collects its values in its own table
+  /// and all tables are merged into ValTab at the end.
+  void computeValuesAtNonCallStartNodes() {
+    PAMM_GET_INSTANCE;
+    const std::set<n_t> AllNonCallStartNodes = ICF->allNonCallStartNodes();
+    const unsigned NumThreads = getNumThreads();
+    if (NumThreads <= 1) {
+      valueComputationTask(
+          {AllNonCallStartNodes.begin(), AllNonCallStartNodes.end()});
+      return;
+    }
+    std::vector<std::vector<n_t>> Partitions;
+    std::unordered_map<f_t, size_t> PartitionOf;
+    for (n_t n : AllNonCallStartNodes) {
+      auto [It, Inserted] =
+          PartitionOf.try_emplace(ICF->getFunctionOf(n), Partitions.size());
+      if (Inserted) {
+        Partitions.emplace_back();
+      }
+      Partitions[It->second].push_back(n);
+    }
+    std::sort(Partitions.begin(), Partitions.end(),
+              [](const auto &Lhs, const auto &Rhs) {
+                return Lhs.size() > Rhs.size();
+              });
+    std::atomic<size_t> NextPartition{0};
+    std::vector<Table<n_t, d_t, l_t>> LocalValTabs(NumThreads);
+    std::vector<size_t> NumComputations(NumThreads, 0);
+    auto Worker = [&](unsigned ThreadIdx) {
+      for (size_t P = NextPartition++; P < Partitions.size();
+           P = NextPartition++) {
+        NumComputations[ThreadIdx] +=
+            valueComputationTask(Partitions[P], LocalValTabs[ThreadIdx]);
+      }
+    };
+    std::vector<std::thread> Workers;
+    Workers.reserve(NumThreads - 1);
+    for (unsigned I = 1; I < NumThreads; ++I) {
+      Workers.emplace_back(Worker, I);
+    }
+    Worker(0);
+    for (auto &W : Workers) {
+      W.join();
+    }
+    for (unsigned I = 0; I < NumThreads; ++I) {
+      LocalValTabs[I].forEachCell([this](n_t n, d_t d, const l_t &L) {
+        ValTab.insert(n, d, L);
+      });
+      INC_COUNTER("Value Computation", NumComputations[I],
+                  PAMM_SEVERITY_LEVEL::Full);
+    }
   }
 
   virtual void saveEdges(n_t SourceNode, n_t SinkStmt, d_t SourceVal,
@@ -893,18 +1377,22 @@ protected:
                                                        DestVals.end());
   }
 
-  /// Computes the final values for edge functions.
-  void computeValues() {
-    PHASAR_LOG_LEVEL(DEBUG, "Start computing values");
-    // Phase II(i)
+  /// Returns the initial seeds of Phase II(i), i.e., the solver's initial
+  /// seeds and the unbalanced return sites.
+  std::map<n_t, std::map<d_t, l_t>> getValueSeeds() {
     std::map<n_t, std::map<d_t, l_t>> AllSeeds = Seeds.getSeeds();
     for (n_t UnbalancedRetSite : UnbalancedRetSites) {
       if (AllSeeds.find(UnbalancedRetSite) == AllSeeds.end()) {
         AllSeeds[UnbalancedRetSite][ZeroValue] = IDEProblem.topElement();
       }
     }
-    // do processing
-    for (const auto &[StartPoint, Facts] : AllSeeds) {
+    return AllSeeds;
+  }
+
+  /// Phase II(i): propagates the values of the initial seeds to the start
+  /// points and call sites.
+  void computeValuesAtCallStartNodes() {
+    for (const auto &[StartPoint, Facts] : getValueSeeds()) {
       for (auto &[Fact, Value] : Facts) {
         PHASAR_LOG_LEVEL(DEBUG,
                          "set initial seed at: "
@@ -918,22 +1406,139 @@ protected:
         valuePropagationTask(SuperGraphNode);
       }
     }
+  }
+
+  /// Phase II(i) for the part of the exploded super graph that Phase I has
+  /// constructed since the last computeValuesAt(): propagates the values of
+  /// new seeds, e.g., unbalanced return sites, and the values of the start
+  /// points along the pending jump functions to call sites. Since the values
+  /// are only ever joined, the values computed before remain valid.
+  void computeValuesAtNewCallStartNodes() {
+    PAMM_GET_INSTANCE;
+    for (const auto &[StartPoint, Facts] : getValueSeeds()) {
+      for (const auto &[Fact, Value] : Facts) {
+        if (!ValTab.contains(StartPoint, Fact)) {
+          setVal(StartPoint, Fact, Value);
+          valuePropagationTask(std::pair<n_t, d_t>(StartPoint, Fact));
+        }
+      }
+    }
+    auto Pending = std::move(PendingCallSiteJumpFns);
+    PendingCallSiteJumpFns.clear();
+    for (const auto &[SourceVal, CallSite, TargetVal, JumpFnE] : Pending) {
+      f_t Func = ICF->getFunctionOf(CallSite);
+      // the nodes from which propagateValueAtStart() would propagate
+      std::set<n_t> Starts = ICF->getStartPointsOf(Func);
+      for (n_t RetSite : UnbalancedRetSites) {
+        if (ICF->getFunctionOf(RetSite) == Func) {
+          Starts.insert(RetSite);
+        }
+      }
+      for (const auto &Seed : Seeds.getSeeds()) {
+        if (ICF->getFunctionOf(Seed.first) == Func) {
+          Starts.insert(Seed.first);
+        }
+      }
+      for (n_t Start : Starts) {
+        if (ValTab.contains(Start, SourceVal)) {
+          INC_COUNTER("Value Propagation", 1, PAMM_SEVERITY_LEVEL::Full);
+          propagateValue(CallSite, TargetVal,
+                         JumpFnE->computeTarget(val(Start, SourceVal)));
+        }
+      }
+    }
+  }
+
+  /// Computes the final values for edge functions.
+  void computeValues() {
+    PHASAR_LOG_LEVEL(DEBUG, "Start computing values");
+    // Phase II(i)
+    computeValuesAtCallStartNodes();
     // Phase II(ii)
     // we create an array of all nodes and then dispatch fractions of this
     // array to multiple threads
-    const std::set<n_t> AllNonCallStartNodes = ICF->allNonCallStartNodes();
-    valueComputationTask(
-        {AllNonCallStartNodes.begin(), AllNonCallStartNodes.end()});
+    computeValuesAtNonCallStartNodes();
   }
 
-  /// Schedules the processing of initial seeds, initiating the analysis.
-  /// Clients should only call this methods if performing synchronization on
-  /// their own. Normally, solve() should be called instead.
-  void submitInitialSeeds() {
+  /// Processes the pending path edges in the order given by the configured
+  /// PathEdgeSchedulingPolicy until the exploded super-graph is complete, or
+  /// until MaxNumPathEdges path edges have been taken from the worklist.
+  /// New path edges are not processed immediately by propagate(), but are
+  /// added to the worklist, such that the stack depth does not depend on the
+  /// size of the analyzed program.
+  void processWorkList(
+      size_t MaxNumPathEdges = std::numeric_limits<size_t>::max()) {
     PAMM_GET_INSTANCE;
-    // Check if the initial seeds contain the zero value at every starting
-    // point. If not, the zero value needs to be added to allow for correct
-    // solving of the problem.
+    PHASAR_LOG_LEVEL(DEBUG, "Process path edges using scheduling policy: "
+                                << WorkList.getPolicy());
+    for (; !WorkList.empty() && MaxNumPathEdges > 0; --MaxNumPathEdges) {
+      PathEdge<n_t, d_t> Edge = WorkList.pop();
+      if (PathEdgeFilter && !PathEdgeFilter(Edge.getTarget())) {
+        DeferredPathEdges[Edge.getTarget()].emplace(Edge.factAtSource(),
+                                                    Edge.factAtTarget());
+        continue;
+      }
+      PathEdgeCount++;
+      if (PathEdgeListener) {
+        PathEdgeListener(Edge.getTarget(), Edge.factAtTarget());
+      }
+      pathEdgeProcessingTask(std::move(Edge));
+    }
+    INC_COUNTER("Max Worklist Size", WorkList.getMaxSize(),
+                PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  /// Returns true if summaries computed outside of this solver run replace the
+  /// analysis of callees; the parallel tabulation does not apply them.
+  [[nodiscard]] bool usesSummaries() const {
+    return ExtSummaries || PSummaries ||
+           CachedFlowEdgeFunctions.getSummaryPack();
+  }
+
+  /// Returns the number of threads the problem is solved with: the
+  /// configured number if the problem is thread-safe, one otherwise.
+  [[nodiscard]] unsigned getNumThreads() const {
+    return IDEProblem.isThreadSafe() ? SolverConfig.numThreads() : 1;
+  }
+
+  /// Runs Phase I and Phase II(i) on getNumThreads() threads using a
+  /// ParallelTabulation; Phase II(ii) is performed afterwards on the merged
+  /// tables.
+  void solveInParallel() {
+    PAMM_GET_INSTANCE;
+    PHASAR_LOG_LEVEL(INFO, "Construct exploded super graph using "
+                               << getNumThreads() << " threads");
+    ParallelTabulation<AnalysisDomainTy, Container, JumpFunctionsTy> Tabulation(
+        IDEProblem, getNumThreads(),
+        [this](n_t SourceNode, n_t SinkStmt, d_t SourceVal,
+               const container_type &DestVals, bool InterP) {
+          saveEdges(SourceNode, SinkStmt, SourceVal, DestVals, InterP);
+        },
+        IntermediateEdgeFunctions);
+    START_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    addZeroValueToSeeds();
+    Tabulation.tabulate(Seeds.getSeeds());
+    UnbalancedRetSites = Tabulation.getUnbalancedRetSites();
+    STOP_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    if (!SolverConfig.computeValues()) {
+      Tabulation.moveResultsInto(*JumpFn, EndsummaryTab, IncomingTab, ValTab);
+      return;
+    }
+    START_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+    PHASAR_LOG_LEVEL(
+        INFO, "Compute the final values according to the edge functions");
+    // Phase II(i)
+    Tabulation.propagateValues(getValueSeeds());
+    Tabulation.moveResultsInto(*JumpFn, EndsummaryTab, IncomingTab, ValTab);
+    // Phase II(ii)
+    computeValuesAtNonCallStartNodes();
+    STOP_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  /// Check if the initial seeds contain the zero value at every starting
+  /// point. If not, the zero value needs to be added to allow for correct
+  /// solving of the problem.
+  void addZeroValueToSeeds() {
     for (const auto &[StartPoint, Facts] : Seeds.getSeeds()) {
       if (Facts.find(ZeroValue) == Facts.end()) {
         // Add zero value if it's not in the set of facts.
@@ -943,35 +1548,6 @@ protected:
         Seeds.addSeed(StartPoint, ZeroValue, IDEProblem.bottomElement());
       }
     }
-    PHASAR_LOG_LEVEL(DEBUG,
-                     "Number of initial seeds: " << Seeds.countInitialSeeds());
-    PHASAR_LOG_LEVEL(DEBUG, "List of initial seeds: ");
-    for (const auto &[StartPoint, Facts] : Seeds.getSeeds()) {
-      PHASAR_LOG_LEVEL(DEBUG,
-                       "Start point: " << IDEProblem.NtoString(StartPoint));
-      /// If statically disabling the logger, Fact and Value are unused. To
-      /// prevent the copilation to fail with -Werror, add the [[maybe_unused]]
-      /// attribute
-      for ([[maybe_unused]] const auto &[Fact, Value] : Facts) {
-        PHASAR_LOG_LEVEL(DEBUG, "\tFact: " << IDEProblem.DtoString(Fact));
-        PHASAR_LOG_LEVEL(DEBUG, "\tValue: " << IDEProblem.LtoString(Value));
-      }
-    }
-    for (const auto &[StartPoint, Facts] : Seeds.getSeeds()) {
-      for (const auto &[Fact, Value] : Facts) {
-        PHASAR_LOG_LEVEL(
-            DEBUG, "Submit seed at: " << IDEProblem.NtoString(StartPoint));
-        PHASAR_LOG_LEVEL(DEBUG, "\tFact: " << IDEProblem.DtoString(Fact));
-        PHASAR_LOG_LEVEL(DEBUG, "\tValue: " << IDEProblem.LtoString(Value));
-        if (!IDEProblem.isZeroValue(Fact)) {
-          INC_COUNTER("Gen facts", 1, PAMM_SEVERITY_LEVEL::Core);
-        }
-        propagate(Fact, StartPoint, Fact, EdgeIdentity<l_t>::getInstance(),
-                  nullptr, false);
-        JumpFn->addFunction(Fact, StartPoint, Fact,
-                            EdgeIdentity<l_t>::getInstance());
-      }
-    }
   }
 
   /// Lines 21-32 of the algorithm.
@@ -1055,7 +1631,9 @@ protected:
                                                 << f->str() << " * "
                                                 << f4->str());
             PHASAR_LOG_LEVEL(DEBUG, "         (return * function * call)");
-            EdgeFunctionPtrType fPrime = f4->composeWith(f)->composeWith(f5);
+            EdgeFunctionPtrType fPrime =
+                CachedFlowEdgeFunctions.composeEdgeFunctions(
+                    CachedFlowEdgeFunctions.composeEdgeFunctions(f4, f), f5);
             PHASAR_LOG_LEVEL(DEBUG, "       = " << fPrime->str());
             // for each jump function coming into the call, propagate to
             // return site using the composed function
@@ -1069,8 +1647,10 @@ protected:
                   d_t d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
                   PHASAR_LOG_LEVEL(DEBUG, "Compose: " << fPrime->str() << " * "
                                                       << f3->str());
-                  propagate(d3, RetSiteC, d5_restoredCtx,
-                            f3->composeWith(fPrime), c, false);
+                  propagate(
+                      d3, RetSiteC, d5_restoredCtx,
+                      CachedFlowEdgeFunctions.composeEdgeFunctions(f3, fPrime),
+                      c, false);
                 }
               }
             }
@@ -1111,8 +1691,9 @@ protected:
             INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
             PHASAR_LOG_LEVEL(DEBUG,
                              "Compose: " << f5->str() << " * " << f->str());
-            propagteUnbalancedReturnFlow(RetSiteC, d5, f->composeWith(f5),
-                                         Caller);
+            propagteUnbalancedReturnFlow(
+                RetSiteC, d5,
+                CachedFlowEdgeFunctions.composeEdgeFunctions(f, f5), Caller);
             // register for value processing (2nd IDE phase)
             UnbalancedRetSites.insert(RetSiteC);
           }
@@ -1260,7 +1841,9 @@ protected:
         const auto &JumpFnContainer = RevLookupResult->get();
         const auto Find = std::find_if(
             JumpFnContainer.begin(), JumpFnContainer.end(),
-            [SourceVal](auto &KVpair) { return KVpair.first == SourceVal; });
+            [SourceVal](const auto &KVpair) {
+              return KVpair.first == SourceVal;
+            });
         if (Find != JumpFnContainer.end()) {
           return Find->second;
         }
@@ -1269,8 +1852,10 @@ protected:
       // was found
       return AllTop;
     }();
-    EdgeFunctionPtrType fPrime = JumpFnE->joinWith(f);
-    bool NewFunction = !(fPrime->equal_to(JumpFnE));
+    EdgeFunctionPtrType fPrime =
+        EFArena.intern(CachedFlowEdgeFunctions.joinEdgeFunctions(JumpFnE, f));
+    // interned functions that are equal_to each other are identical
+    bool NewFunction = fPrime != JumpFnE && !fPrime->equal_to(JumpFnE);
 
     IF_LOG_ENABLED(
         PHASAR_LOG_LEVEL(
@@ -1283,9 +1868,11 @@ protected:
         PHASAR_LOG_LEVEL(DEBUG, ' '));
     if (NewFunction) {
       JumpFn->addFunction(SourceVal, Target, TargetVal, fPrime);
-      const PathEdge<n_t, d_t> Edge(SourceVal, Target, TargetVal);
-      PathEdgeCount++;
-      pathEdgeProcessingTask(Edge);
+      if (ComputesValuesOnDemand && ICF->isCallSite(Target)) {
+        PendingCallSiteJumpFns.emplace_back(SourceVal, Target, TargetVal,
+                                            fPrime);
+      }
+      WorkList.push(PathEdge<n_t, d_t>(SourceVal, Target, TargetVal));
 
       IF_LOG_ENABLED(if (!IDEProblem.isZeroValue(TargetVal)) {
         PHASAR_LOG_LEVEL(
@@ -1598,6 +2185,8 @@ protected:
     PHASAR_LOG_LEVEL(INFO, "#Facts killed    : " << GET_COUNTER("Kill facts"));
     PHASAR_LOG_LEVEL(INFO,
                      "#Summary-reuse   : " << GET_COUNTER("Summary-reuse"));
+    PHASAR_LOG_LEVEL(INFO, "#Persisted-reuse : "
+                               << GET_COUNTER("PersistedSummary-reuse"));
     PHASAR_LOG_LEVEL(INFO,
                      "#Intra Path Edges: " << GET_COUNTER("Intra Path Edges"));
     PHASAR_LOG_LEVEL(INFO,
@@ -1616,6 +2205,11 @@ protected:
                            << GET_COUNTER("SpecialSummary-FF Application"));
       PHASAR_LOG_LEVEL(INFO, "Jump function construciton count: "
                                  << GET_COUNTER("JumpFn Construction"));
+      PHASAR_LOG_LEVEL(INFO, "Maximum worklist size: "
+                                 << GET_COUNTER("Max Worklist Size"));
+      PHASAR_LOG_LEVEL(INFO, "Interned edge functions: "
+                                 << EFArena.size() << " (reused "
+                                 << EFArena.getNumReused() << " times)");
       PHASAR_LOG_LEVEL(INFO,
                        "Phase I duration: " << PRINT_TIMER("DFA Phase I"));
       PHASAR_LOG_LEVEL(INFO,
@@ -1854,10 +2448,12 @@ public:
   };
 };
 
-template <typename AnalysisDomainTy, typename Container>
+template <typename AnalysisDomainTy, typename Container,
+          typename JumpFunctionsTy>
 llvm::raw_ostream &
 operator<<(llvm::raw_ostream &OS,
-           const IDESolver<AnalysisDomainTy, Container> &Solver) {
+           const IDESolver<AnalysisDomainTy, Container, JumpFunctionsTy>
+               &Solver) {
   Solver.dumpResults(OS);
   return OS;
 }
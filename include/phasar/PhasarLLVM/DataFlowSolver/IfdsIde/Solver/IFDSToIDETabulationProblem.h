@@ -73,6 +73,7 @@ public:
             IFDSProblem.getEntryPoints()),
         Problem(IFDSProblem) {
     this->ZeroValue = Problem.createZeroValue();
+    this->setIFDSIDESolverConfig(Problem.getIFDSIDESolverConfig());
   }
 
   FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) override {
@@ -110,6 +111,18 @@ public:
     return Problem.isZeroValue(Fact);
   }
 
+  [[nodiscard]] bool isThreadSafe() const override {
+    return Problem.isThreadSafe();
+  }
+
+  [[nodiscard]] bool canReuseSummaries() const override {
+    return Problem.canReuseSummaries();
+  }
+
+  [[nodiscard]] bool canPersistSummaries() const override {
+    return Problem.canPersistSummaries();
+  }
+
   BinaryDomain topElement() override { return BinaryDomain::TOP; }
 
   BinaryDomain bottomElement() override { return BinaryDomain::BOTTOM; }
@@ -0,0 +1,324 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_IFDSTOVARIATIONALTABULATIONPROBLEM_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_IFDSTOVARIATIONALTABULATIONPROBLEM_H
+
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverResults.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
+#include "phasar/PhasarLLVM/Utils/FeatureModel.h"
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+/// The analysis domain of an IFDS problem whose facts are lifted with
+/// presence conditions.
+template <typename OriginalAnalysisDomain>
+struct VariationalAnalysisDomain : public OriginalAnalysisDomain {
+  using l_t = PresenceCondition;
+};
+
+/// Restricts the presence condition of a fact to the configurations in which
+/// an edge of the exploded super graph is present, i.e., conjoins the
+/// presence conditions; the join of two such functions is their disjunction.
+class PresenceConditionEdgeFunction
+    : public EdgeFunction<PresenceCondition>,
+      public std::enable_shared_from_this<PresenceConditionEdgeFunction> {
+public:
+  using typename EdgeFunction<PresenceCondition>::EdgeFunctionPtrType;
+
+  explicit PresenceConditionEdgeFunction(PresenceCondition Condition)
+      : Condition(std::move(Condition)) {}
+
+  ~PresenceConditionEdgeFunction() override = default;
+
+  /// Returns the identity if Condition holds in all configurations and
+  /// AllTop if it holds in none, such that the solver does not propagate facts
+  /// along paths that are infeasible in every configuration.
+  static EdgeFunctionPtrType create(const PresenceCondition &Condition) {
+    if (Condition.all()) {
+      return EdgeIdentity<PresenceCondition>::getInstance();
+    }
+    if (Condition.none()) {
+      return std::make_shared<AllTop<PresenceCondition>>(Condition);
+    }
+    return std::make_shared<PresenceConditionEdgeFunction>(Condition);
+  }
+
+  PresenceCondition computeTarget(PresenceCondition Source) override {
+    Source &= Condition;
+    return Source;
+  }
+
+  EdgeFunctionPtrType composeWith(EdgeFunctionPtrType SecondFunction) override {
+    if (auto *PC = dynamic_cast<PresenceConditionEdgeFunction *>(
+            SecondFunction.get())) {
+      PresenceCondition Conjunction = Condition;
+      Conjunction &= PC->Condition;
+      return create(Conjunction);
+    }
+    if (dynamic_cast<EdgeIdentity<PresenceCondition> *>(
+            SecondFunction.get())) {
+      return shared_from_this();
+    }
+    // AllTop and AllBottom are constant
+    return SecondFunction;
+  }
+
+  EdgeFunctionPtrType joinWith(EdgeFunctionPtrType OtherFunction) override {
+    if (auto *PC = dynamic_cast<PresenceConditionEdgeFunction *>(
+            OtherFunction.get())) {
+      PresenceCondition Disjunction = Condition;
+      Disjunction |= PC->Condition;
+      return create(Disjunction);
+    }
+    if (dynamic_cast<AllTop<PresenceCondition> *>(OtherFunction.get())) {
+      return shared_from_this();
+    }
+    // the identity and AllBottom subsume any condition
+    return OtherFunction;
+  }
+
+  [[nodiscard]] bool equal_to // NOLINT - would break too many client analyses
+      (EdgeFunctionPtrType Other) const override {
+    if (auto *PC = dynamic_cast<PresenceConditionEdgeFunction *>(Other.get())) {
+      return Condition == PC->Condition;
+    }
+    return false;
+  }
+
+  [[nodiscard]] bool isInternable() const override { return true; }
+
+  [[nodiscard]] llvm::hash_code getHashCode() const override {
+    return llvm::DenseMapInfo<PresenceCondition>::getHashValue(Condition);
+  }
+
+  [[nodiscard]] const PresenceCondition &getCondition() const noexcept {
+    return Condition;
+  }
+
+  void print(llvm::raw_ostream &OS,
+             bool /*IsForDebug = false*/) const override {
+    OS << "PC" << Condition;
+  }
+
+private:
+  PresenceCondition Condition;
+};
+
+/**
+ * This class lifts a given IFDSTabulationProblem to an IDETabulationProblem
+ * over presence conditions, such that a single solver run analyzes all
+ * configurations of a FeatureModel (cf. SPLlift, Bodden et al., PLDI 2013).
+ * The value of a fact at a statement is the set of configurations in which it
+ * holds there. The flow functions are those of the original problem; the
+ * edges of branches on features are restricted to the configurations in which
+ * they are taken.
+ */
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>>
+class IFDSToVariationalTabulationProblem
+    : public IDETabulationProblem<VariationalAnalysisDomain<AnalysisDomainTy>,
+                                  Container> {
+  using Base =
+      IDETabulationProblem<VariationalAnalysisDomain<AnalysisDomainTy>,
+                           Container>;
+  using typename Base::EdgeFunctionPtrType;
+  using typename Base::FlowFunctionPtrType;
+
+public:
+  using n_t = typename VariationalAnalysisDomain<AnalysisDomainTy>::n_t;
+  using f_t = typename VariationalAnalysisDomain<AnalysisDomainTy>::f_t;
+  using d_t = typename VariationalAnalysisDomain<AnalysisDomainTy>::d_t;
+  using l_t = typename VariationalAnalysisDomain<AnalysisDomainTy>::l_t;
+
+  IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem;
+
+  IFDSToVariationalTabulationProblem(
+      IFDSTabulationProblem<AnalysisDomainTy, Container> &IFDSProblem,
+      const FeatureModel &Features)
+      : Base(IFDSProblem.getProjectIRDB(), IFDSProblem.getTypeHierarchy(),
+             IFDSProblem.getICFG(), IFDSProblem.getPointstoInfo(),
+             IFDSProblem.getEntryPoints()),
+        Problem(IFDSProblem), Features(Features) {
+    this->ZeroValue = Problem.createZeroValue();
+    this->setIFDSIDESolverConfig(Problem.getIFDSIDESolverConfig());
+  }
+
+  [[nodiscard]] const FeatureModel &getFeatureModel() const noexcept {
+    return Features;
+  }
+
+  FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) override {
+    return Problem.getNormalFlowFunction(Curr, Succ);
+  }
+
+  FlowFunctionPtrType getCallFlowFunction(n_t CallSite, f_t DestFun) override {
+    return Problem.getCallFlowFunction(CallSite, DestFun);
+  }
+
+  FlowFunctionPtrType getRetFlowFunction(n_t CallSite, f_t CalleeFun,
+                                         n_t ExitInst, n_t RetSite) override {
+    return Problem.getRetFlowFunction(CallSite, CalleeFun, ExitInst, RetSite);
+  }
+
+  FlowFunctionPtrType getCallToRetFlowFunction(n_t CallSite, n_t RetSite,
+                                               std::set<f_t> Callees) override {
+    return Problem.getCallToRetFlowFunction(CallSite, RetSite, Callees);
+  }
+
+  FlowFunctionPtrType getSummaryFlowFunction(n_t CallSite,
+                                             f_t DestFun) override {
+    return Problem.getSummaryFlowFunction(CallSite, DestFun);
+  }
+
+  /// The initial seeds hold in all configurations.
+  InitialSeeds<n_t, d_t, l_t> initialSeeds() override {
+    InitialSeeds<n_t, d_t, l_t> Seeds;
+    for (const auto &[Node, Facts] : Problem.initialSeeds().getSeeds()) {
+      for (const auto &Fact : Facts) {
+        Seeds.addSeed(Node, Fact.first, Features.getTrue());
+      }
+    }
+    return Seeds;
+  }
+
+  [[nodiscard]] d_t createZeroValue() const override {
+    return Problem.createZeroValue();
+  }
+
+  [[nodiscard]] bool isZeroValue(d_t Fact) const override {
+    return Problem.isZeroValue(Fact);
+  }
+
+  l_t topElement() override { return Features.getFalse(); }
+
+  l_t bottomElement() override { return Features.getTrue(); }
+
+  l_t join(l_t Lhs, l_t Rhs) override {
+    Lhs |= Rhs;
+    return Lhs;
+  }
+
+  EdgeFunctionPtrType allTopFunction() override {
+    return std::make_shared<AllTop<l_t>>(Features.getFalse());
+  }
+
+  EdgeFunctionPtrType getNormalEdgeFunction(n_t Curr, d_t /*CurrNode*/,
+                                            n_t Succ,
+                                            d_t /*SuccNode*/) override {
+    auto [It, Inserted] = BranchEdgeFunctions.try_emplace({Curr, Succ});
+    if (Inserted) {
+      It->second = PresenceConditionEdgeFunction::create(
+          Features.getPresenceCondition(Curr, Succ));
+    }
+    return It->second;
+  }
+
+  EdgeFunctionPtrType getCallEdgeFunction(n_t /*CallSite*/, d_t /*SrcNode*/,
+                                          f_t /*DestinationFunction*/,
+                                          d_t /*DestNode*/) override {
+    return EdgeIdentity<l_t>::getInstance();
+  }
+
+  EdgeFunctionPtrType getReturnEdgeFunction(n_t /*CallSite*/,
+                                            f_t /*CalleeFunction*/,
+                                            n_t /*ExitInst*/, d_t /*ExitNode*/,
+                                            n_t /*ReturnSite*/,
+                                            d_t /*RetNode*/) override {
+    return EdgeIdentity<l_t>::getInstance();
+  }
+
+  EdgeFunctionPtrType
+  getCallToRetEdgeFunction(n_t /*CallSite*/, d_t /*CallNode*/,
+                           n_t /*ReturnSite*/, d_t /*ReturnSideNode*/,
+                           std::set<f_t> /*Callees*/) override {
+    return EdgeIdentity<l_t>::getInstance();
+  }
+
+  EdgeFunctionPtrType getSummaryEdgeFunction(n_t /*CallSite*/,
+                                             d_t /*CallNode*/,
+                                             n_t /*RetSite*/,
+                                             d_t /*RetSiteNode*/) override {
+    return EdgeIdentity<l_t>::getInstance();
+  }
+
+  void printNode(llvm::raw_ostream &OS, n_t Stmt) const override {
+    Problem.printNode(OS, Stmt);
+  }
+
+  void printDataFlowFact(llvm::raw_ostream &OS, d_t Fact) const override {
+    Problem.printDataFlowFact(OS, Fact);
+  }
+
+  void printFunction(llvm::raw_ostream &OS, f_t Func) const override {
+    Problem.printFunction(OS, Func);
+  }
+
+  void printEdgeFact(llvm::raw_ostream &OS, l_t Val) const override {
+    OS << Val;
+  }
+
+  /// Projects the results onto the given configuration, i.e., returns the
+  /// facts that hold in it, as the original problem would have computed them.
+  [[nodiscard]] Table<n_t, d_t, BinaryDomain>
+  projectResults(const SolverResults<n_t, d_t, l_t> &Results,
+                 size_t Configuration) const {
+    Table<n_t, d_t, BinaryDomain> Projection;
+    for (const auto &Cell : Results.getAllResultEntries()) {
+      if (Cell.getValue().test(Configuration)) {
+        Projection.insert(Cell.getRowKey(), Cell.getColumnKey(),
+                          BinaryDomain::BOTTOM);
+      }
+    }
+    return Projection;
+  }
+
+  /// Emits the report of the original problem for each configuration.
+  void emitTextReport(const SolverResults<n_t, d_t, l_t> &Results,
+                      llvm::raw_ostream &OS = llvm::outs()) override {
+    for (size_t Idx = 0; Idx < Features.getNumConfigurations(); ++Idx) {
+      OS << "\n=== Configuration " << Idx << " ===\n";
+      auto Projection = projectResults(Results, Idx);
+      Problem.emitTextReport(
+          SolverResults<n_t, d_t, BinaryDomain>(Projection, this->ZeroValue),
+          OS);
+    }
+  }
+
+  void emitGraphicalReport(const SolverResults<n_t, d_t, l_t> &Results,
+                           llvm::raw_ostream &OS = llvm::outs()) override {
+    for (size_t Idx = 0; Idx < Features.getNumConfigurations(); ++Idx) {
+      auto Projection = projectResults(Results, Idx);
+      Problem.emitGraphicalReport(
+          SolverResults<n_t, d_t, BinaryDomain>(Projection, this->ZeroValue),
+          OS);
+    }
+  }
+
+private:
+  const FeatureModel &Features;
+  // the edge functions of branches are shared by all facts
+  llvm::DenseMap<std::pair<n_t, n_t>, EdgeFunctionPtrType> BranchEdgeFunctions;
+};
+
+} // namespace psr
+
+#endif
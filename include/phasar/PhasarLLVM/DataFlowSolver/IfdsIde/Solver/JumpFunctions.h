@@ -171,6 +171,36 @@ public:
     return NonEmptyLookupByTargetNode[Target];
   }
 
+  /**
+   * Calls Handler(sourceVal, targetVal, edgeFunction) for all jump function
+   * records with the given target statement. In contrast to lookupByTarget()
+   * this neither allocates nor modifies the jump functions, hence it may be
+   * used by multiple threads at the same time.
+   */
+  template <typename HandlerFn>
+  void forEachLookupByTarget(n_t Target, HandlerFn &&Handler) const {
+    if (auto Search = NonEmptyLookupByTargetNode.find(Target);
+        Search != NonEmptyLookupByTargetNode.end()) {
+      Search->second.forEachCell(std::forward<HandlerFn>(Handler));
+    }
+  }
+
+  /**
+   * Calls Handler(sourceVal, target, targetVal, edgeFunction) for all jump
+   * functions.
+   */
+  template <typename HandlerFn>
+  void forEachFunction(HandlerFn &&Handler) const {
+    for (const auto &[Target, SourceValTargetValAndFunction] :
+         NonEmptyLookupByTargetNode) {
+      SourceValTargetValAndFunction.forEachCell(
+          [&Handler, Target{Target}](d_t SourceVal, d_t TargetVal,
+                                     const EdgeFunctionPtrType &EdgeFunc) {
+            Handler(SourceVal, Target, TargetVal, EdgeFunc);
+          });
+    }
+  }
+
   /**
    * Removes a jump function. The source statement is implicit.
    * @see PathEdge
@@ -0,0 +1,168 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_LLVMPERSISTEDSUMMARIES_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_LLVMPERSISTEDSUMMARIES_H
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Value.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PersistedSummaries.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryStore.h"
+#include "phasar/PhasarLLVM/Utils/FunctionHashes.h"
+
+namespace psr {
+
+/// Persisted summaries of an analysis on LLVM IR that are kept in a
+/// SummaryStore. A function is identified by its closure hash, such that the
+/// summaries of a function are reused by all programs containing the same
+/// code, e.g., by all programs linking the same library.
+///
+/// End summaries are only added to the store if all of their facts can be
+/// represented relative to the summarized function and all of their edge
+/// functions are either the identity or AllBottom.
+template <typename L>
+class LLVMPersistedSummaries
+    : public PersistedSummaries<const llvm::Instruction *, const llvm::Value *,
+                                const llvm::Function *, L> {
+public:
+  using typename PersistedSummaries<const llvm::Instruction *,
+                                    const llvm::Value *, const llvm::Function *,
+                                    L>::EndSummaryTy;
+
+  LLVMPersistedSummaries(SummaryStore &Store, const FunctionHashes &Hashes,
+                         const llvm::Value *ZeroValue, L BottomElement)
+      : Store(Store), Hashes(Hashes), ZeroValue(ZeroValue),
+        AllBottomFn(std::make_shared<AllBottom<L>>(std::move(BottomElement))) {
+  }
+
+  [[nodiscard]] std::optional<std::vector<EndSummaryTy>>
+  getEndSummaries(const llvm::Function *Fun,
+                  const llvm::Value *Fact) override {
+    const SummaryStore::FunctionSummary *Summary = lookup(Fun);
+    if (!Summary) {
+      return std::nullopt;
+    }
+    auto Source = encode(*Fun, Fact);
+    if (!Source || !Summary->isSummarized(*Source)) {
+      return std::nullopt;
+    }
+    auto Range = std::equal_range(
+        Summary->Entries.begin(), Summary->Entries.end(), *Source,
+        [](const auto &LHS, const auto &RHS) {
+          return getSource(LHS) < getSource(RHS);
+        });
+    std::vector<EndSummaryTy> Summaries;
+    for (auto It = Range.first; It != Range.second; ++It) {
+      const auto *ExitPoint = Store.getInstruction(*Fun, It->ExitPoint);
+      const auto *Target = decode(*Fun, It->Target);
+      if (!ExitPoint || !Target) {
+        // The summary does not fit the function, let the solver analyze it
+        return std::nullopt;
+      }
+      Summaries.emplace_back(ExitPoint, Target,
+                             It->Edge == SummaryStore::EdgeKind::Identity
+                                 ? EdgeIdentity<L>::getInstance()
+                                 : AllBottomFn);
+    }
+    ++NumReused;
+    return Summaries;
+  }
+
+  void addEndSummaries(const llvm::Function *Fun, const llvm::Value *Fact,
+                       const std::vector<EndSummaryTy> &Summaries) override {
+    auto Hash = Hashes.getClosureHash(Fun->getName());
+    auto Source = encode(*Fun, Fact);
+    if (!Hash || !Source) {
+      return;
+    }
+    SummaryStore::FunctionSummary Summary;
+    Summary.EntryFacts.push_back(*Source);
+    for (const auto &[ExitPoint, Target, EF] : Summaries) {
+      auto TargetRef = encode(*Fun, Target);
+      auto Edge = encodeEdgeFunction(EF);
+      if (!TargetRef || !Edge) {
+        // A partial summary would be unsound
+        return;
+      }
+      Summary.Entries.push_back(
+          {*Source, Store.getInstructionNumber(ExitPoint), *TargetRef, *Edge});
+    }
+    Store.insert(*Hash, std::move(Summary));
+    ++NumAdded;
+  }
+
+  /// Returns the number of lookups that have been answered by the store.
+  [[nodiscard]] size_t getNumReused() const noexcept { return NumReused; }
+
+  /// Returns the number of facts whose end summaries have been added.
+  [[nodiscard]] size_t getNumAdded() const noexcept { return NumAdded; }
+
+private:
+  static SummaryStore::FactRef getSource(const SummaryStore::Entry &E) {
+    return E.Source;
+  }
+  static SummaryStore::FactRef getSource(SummaryStore::FactRef Fact) {
+    return Fact;
+  }
+
+  const SummaryStore::FunctionSummary *lookup(const llvm::Function *Fun) {
+    if (Fun->isDeclaration()) {
+      return nullptr;
+    }
+    auto Hash = Hashes.getClosureHash(Fun->getName());
+    return Hash ? Store.lookup(*Hash) : nullptr;
+  }
+
+  std::optional<SummaryStore::FactRef> encode(const llvm::Function &Fun,
+                                              const llvm::Value *Fact) {
+    if (Fact == ZeroValue) {
+      return SummaryStore::FactRef{};
+    }
+    return Store.encode(Fun, Fact);
+  }
+
+  const llvm::Value *decode(const llvm::Function &Fun,
+                            SummaryStore::FactRef Fact) {
+    if (Fact.Kind == SummaryStore::FactRef::KindTy::Zero) {
+      return ZeroValue;
+    }
+    return Store.decode(Fun, Fact);
+  }
+
+  std::optional<SummaryStore::EdgeKind>
+  encodeEdgeFunction(const std::shared_ptr<EdgeFunction<L>> &EF) const {
+    if (dynamic_cast<EdgeIdentity<L> *>(EF.get())) {
+      return SummaryStore::EdgeKind::Identity;
+    }
+    if (AllBottomFn->equal_to(EF)) {
+      return SummaryStore::EdgeKind::AllBottom;
+    }
+    return std::nullopt;
+  }
+
+  SummaryStore &Store;
+  const FunctionHashes &Hashes;
+  const llvm::Value *ZeroValue;
+  std::shared_ptr<EdgeFunction<L>> AllBottomFn;
+  size_t NumReused = 0;
+  size_t NumAdded = 0;
+};
+
+} // namespace psr
+
+#endif
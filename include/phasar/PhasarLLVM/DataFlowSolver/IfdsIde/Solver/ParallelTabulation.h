@@ -0,0 +1,760 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+/*
+ * ParallelTabulation.h
+ *
+ *  Created on: 18.10.2022
+ *      Author: pdschbrt
+ */
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_PARALLELTABULATION_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_PARALLELTABULATION_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowEdgeFunctionCache.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/EdgeFunctionArena.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JumpFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+/// Shared-memory parallel implementation of Phase I (construction of the jump
+/// functions) and Phase II(i) (value propagation) of the IDESolver.
+///
+/// The solver's tables are split into shards. Each function of the analyzed
+/// program is owned by exactly one shard that holds the jump functions, end
+/// summaries, incoming call edges and values for all nodes of that function.
+/// A shard is only ever processed by a single worker thread at a time, hence
+/// its tables do not need any further synchronization. Work that affects a
+/// function owned by another shard (a new jump function, an incoming call edge
+/// or a summary that needs to be applied at a call site) is posted to that
+/// shard's inbox.
+///
+/// There are several shards per worker. Each worker prefers its own shards,
+/// but steals any other shard with pending work as soon as its own shards run
+/// dry, such that the load is balanced even if few functions dominate the
+/// analysis.
+///
+/// The analysis problem's flow and edge functions are queried concurrently.
+/// Every worker uses its own FlowEdgeFunctionCache.
+template <typename AnalysisDomainTy, typename Container,
+          typename JumpFunctionsTy = JumpFunctions<AnalysisDomainTy, Container>>
+class ParallelTabulation {
+public:
+  using ProblemTy = IDETabulationProblem<AnalysisDomainTy, Container>;
+  using container_type = typename ProblemTy::container_type;
+  using FlowFunctionPtrType = typename ProblemTy::FlowFunctionPtrType;
+  using EdgeFunctionPtrType = typename ProblemTy::EdgeFunctionPtrType;
+
+  using l_t = typename AnalysisDomainTy::l_t;
+  using n_t = typename AnalysisDomainTy::n_t;
+  using i_t = typename AnalysisDomainTy::i_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+
+  using EdgeRecorderTy =
+      std::function<void(n_t, n_t, d_t, const container_type &, bool)>;
+  using IntermediateEdgeFunctionsTy =
+      std::map<std::tuple<n_t, d_t, n_t, d_t>,
+               std::vector<EdgeFunctionPtrType>>;
+
+  /// EdgeRecorder is invoked for each batch of exploded super-graph edges if
+  /// edge recording is enabled in the problem's solver configuration; all
+  /// calls are serialized.
+  ParallelTabulation(ProblemTy &Problem, unsigned NumThreads,
+                     EdgeRecorderTy EdgeRecorder,
+                     IntermediateEdgeFunctionsTy &IntermediateEdgeFunctions)
+      : Problem(Problem), ICF(Problem.getICFG()),
+        SolverConfig(Problem.getIFDSIDESolverConfig()),
+        ZeroValue(Problem.getZeroValue()), AllTop(Problem.allTopFunction()),
+        NumThreads(NumThreads == 0 ? 1 : NumThreads),
+        EdgeRecorder(std::move(EdgeRecorder)),
+        IntermediateEdgeFunctions(IntermediateEdgeFunctions) {
+    for (unsigned I = 0; I < this->NumThreads; ++I) {
+      Caches.push_back(
+          std::make_unique<FlowEdgeFunctionCache<AnalysisDomainTy, Container>>(
+              Problem));
+    }
+    for (unsigned I = 0; I < this->NumThreads * ShardsPerThread; ++I) {
+      Shards.push_back(std::make_unique<Shard>(
+          AllTop, Problem, ICF, SolverConfig.schedulingPolicy()));
+    }
+  }
+
+  ~ParallelTabulation() = default;
+
+  ParallelTabulation(const ParallelTabulation &) = delete;
+  ParallelTabulation &operator=(const ParallelTabulation &) = delete;
+  ParallelTabulation(ParallelTabulation &&) = delete;
+  ParallelTabulation &operator=(ParallelTabulation &&) = delete;
+
+  /// Phase I: constructs the jump functions for the given initial seeds.
+  void tabulate(const std::map<n_t, std::map<d_t, l_t>> &Seeds) {
+    for (const auto &[StartPoint, Facts] : Seeds) {
+      for (const auto &Entry : Facts) {
+        addJumpFunction(shardOf(StartPoint), *Caches.front(), Entry.first,
+                        StartPoint, Entry.first,
+                        EdgeIdentity<l_t>::getInstance());
+      }
+    }
+    run(&ParallelTabulation::drainPathEdges);
+  }
+
+  /// Phase II(i): propagates the given initial values from the start points
+  /// to the call sites and into the callees. Must be called after
+  /// tabulate().
+  void propagateValues(const std::map<n_t, std::map<d_t, l_t>> &Seeds) {
+    for (const auto &[StartPoint, Facts] : Seeds) {
+      SeedNodes.insert(StartPoint);
+      for (const auto &[Fact, Value] : Facts) {
+        Shard &Owner = shardOf(StartPoint);
+        Owner.ValTab.insert(StartPoint, Fact, Value);
+        scheduleValue(Owner, StartPoint, Fact);
+      }
+    }
+    run(&ParallelTabulation::drainValues);
+  }
+
+  /// Returns the return sites (inside callers) to which we have unbalanced
+  /// returns.
+  [[nodiscard]] const std::set<n_t> &getUnbalancedRetSites() const {
+    return UnbalancedRetSites;
+  }
+
+  /// Moves the contents of all shards into the given tables. The shards are
+  /// empty afterwards.
+  void moveResultsInto(
+      JumpFunctionsTy &JumpFn,
+      Table<n_t, d_t, Table<n_t, d_t, EdgeFunctionPtrType>> &EndsummaryTab,
+      Table<n_t, d_t, std::map<n_t, container_type>> &IncomingTab,
+      Table<n_t, d_t, l_t> &ValTab) {
+    // All tables are keyed by nodes that are owned by exactly one shard, hence
+    // the shards' contents are disjoint.
+    for (auto &S : Shards) {
+      S->JumpFn.forEachFunction([&JumpFn](d_t SourceVal, n_t Target,
+                                          d_t TargetVal, const auto &EdgeFunc) {
+        JumpFn.addFunction(SourceVal, Target, TargetVal, EdgeFunc);
+      });
+      S->JumpFn.clear();
+      EndsummaryTab.insert(S->EndsummaryTab);
+      S->EndsummaryTab.clear();
+      IncomingTab.insert(S->IncomingTab);
+      S->IncomingTab.clear();
+      ValTab.insert(S->ValTab);
+      S->ValTab.clear();
+    }
+  }
+
+private:
+  /// <SourceVal> -> <Target, TargetVal> is a new jump function for a target
+  /// owned by another shard.
+  struct PropagateMessage {
+    d_t SourceVal;
+    n_t Target;
+    d_t TargetVal;
+    EdgeFunctionPtrType EdgeFn;
+  };
+
+  /// <CallSite, D2> has an incoming call edge into <SP, D3>; sent to the
+  /// owner of SP.
+  struct IncomingMessage {
+    n_t SP;
+    d_t D3;
+    n_t CallSite;
+    d_t D2;
+  };
+
+  /// The summary <SP, D1> -> <ExitInst, D2> of Callee must be applied to all
+  /// jump functions that reach <CallSite, D4>; sent to the owner of CallSite.
+  struct SummaryMessage {
+    n_t CallSite;
+    d_t D4;
+    f_t Callee;
+    d_t D1;
+    n_t ExitInst;
+    d_t D2;
+    EdgeFunctionPtrType SummaryFn;
+  };
+
+  using Message =
+      std::variant<PropagateMessage, IncomingMessage, SummaryMessage>;
+
+  /// Value must be joined into the value of <Target, Fact>; sent to the owner
+  /// of Target.
+  struct ValueMessage {
+    n_t Target;
+    d_t Fact;
+    l_t Value;
+  };
+
+  struct Shard {
+    Shard(EdgeFunctionPtrType AllTop, const ProblemTy &Problem, const i_t *ICF,
+          PathEdgeSchedulingPolicy Policy)
+        : JumpFn(std::move(AllTop), Problem), WorkList(ICF, Policy) {}
+
+    // held by the worker that currently processes this shard
+    std::mutex Mtx;
+    std::mutex InboxMtx;
+    std::vector<Message> Inbox;
+    std::vector<ValueMessage> ValueInbox;
+    // number of messages and worklist items that are pending for this shard
+    std::atomic<size_t> NumPending{0};
+
+    JumpFunctionsTy JumpFn;
+    EdgeFunctionArena<l_t> EFArena;
+    Table<n_t, d_t, Table<n_t, d_t, EdgeFunctionPtrType>> EndsummaryTab;
+    Table<n_t, d_t, std::map<n_t, container_type>> IncomingTab;
+    PathEdgeWorklist<n_t, d_t, f_t, i_t> WorkList;
+
+    Table<n_t, d_t, l_t> ValTab;
+    std::deque<std::pair<n_t, d_t>> ValueWorkList;
+  };
+
+  using CacheTy = FlowEdgeFunctionCache<AnalysisDomainTy, Container>;
+  using DrainFnTy = bool (ParallelTabulation::*)(Shard &, CacheTy &);
+
+  static constexpr unsigned ShardsPerThread = 4;
+
+  Shard &shardOf(n_t Inst) {
+    uint64_t Hash = std::hash<f_t>{}(ICF->getFunctionOf(Inst));
+    // function pointers are aligned, mix all bits into the shard index
+    Hash ^= Hash >> 33;
+    Hash *= 0xff51afd7ed558ccdULL;
+    Hash ^= Hash >> 33;
+    return *Shards[Hash % Shards.size()];
+  }
+
+  void run(DrainFnTy Drain) {
+    std::vector<std::thread> Workers;
+    Workers.reserve(NumThreads - 1);
+    for (unsigned I = 1; I < NumThreads; ++I) {
+      Workers.emplace_back([this, I, Drain] { work(I, Drain); });
+    }
+    work(0, Drain);
+    for (auto &Worker : Workers) {
+      Worker.join();
+    }
+  }
+
+  void work(unsigned ThreadIdx, DrainFnTy Drain) {
+    CacheTy &Cache = *Caches[ThreadIdx];
+    const size_t NumShards = Shards.size();
+    // NumPending is only decremented after all work that results from a
+    // message or worklist item has been posted, hence it drops to zero if and
+    // only if the fixpoint has been reached
+    while (NumPending.load() != 0) {
+      // read before scanning the shards, such that work that is made
+      // available during the scan prevents this worker from going to sleep
+      uint64_t Epoch = WorkEpoch.load();
+      bool Worked = false;
+      for (size_t I = 0; I < NumShards; ++I) {
+        Shard &S = *Shards[(ThreadIdx * ShardsPerThread + I) % NumShards];
+        if (S.NumPending.load(std::memory_order_acquire) == 0) {
+          continue;
+        }
+        std::unique_lock<std::mutex> Lock(S.Mtx, std::try_to_lock);
+        if (!Lock.owns_lock()) {
+          continue;
+        }
+        bool Drained = (this->*Drain)(S, Cache);
+        Lock.unlock();
+        Worked |= Drained;
+        // work may have been posted to S after it has been drained; it could
+        // not be stolen while S was locked. Work that has only been announced
+        // wakes up the workers itself once it is posted.
+        if (Drained && S.NumPending.load() != 0) {
+          notifyWorkers();
+        }
+      }
+      if (!Worked) {
+        std::unique_lock<std::mutex> Lock(IdleMtx);
+        ++NumIdle;
+        IdleCV.wait(Lock, [this, Epoch] {
+          return NumPending.load() == 0 || WorkEpoch.load() != Epoch;
+        });
+        --NumIdle;
+      }
+    }
+  }
+
+  /// Wakes up the idle workers as new work is available or the fixpoint has
+  /// been reached.
+  void notifyWorkers() {
+    // the epoch is incremented before NumIdle is checked and an idle worker
+    // increments NumIdle before it checks the epoch, hence no wake-up is lost
+    WorkEpoch.fetch_add(1);
+    if (NumIdle.load() != 0) {
+      // a worker that has checked its predicate is blocked once the mutex is
+      // available again
+      { std::lock_guard<std::mutex> Lock(IdleMtx); }
+      IdleCV.notify_all();
+    }
+  }
+
+  void addPending(Shard &S) {
+    NumPending.fetch_add(1, std::memory_order_acq_rel);
+    S.NumPending.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  void removePending(Shard &S) {
+    S.NumPending.fetch_sub(1, std::memory_order_acq_rel);
+    if (NumPending.fetch_sub(1) == 1) {
+      notifyWorkers();
+    }
+  }
+
+  void post(Shard &Owner, Message Msg) {
+    addPending(Owner);
+    {
+      std::lock_guard<std::mutex> Lock(Owner.InboxMtx);
+      Owner.Inbox.push_back(std::move(Msg));
+    }
+    notifyWorkers();
+  }
+
+  void post(Shard &Owner, ValueMessage Msg) {
+    addPending(Owner);
+    {
+      std::lock_guard<std::mutex> Lock(Owner.InboxMtx);
+      Owner.ValueInbox.push_back(std::move(Msg));
+    }
+    notifyWorkers();
+  }
+
+  void saveEdges(n_t SourceNode, n_t SinkStmt, d_t SourceVal,
+                 const container_type &DestVals, bool InterP) {
+    if (!SolverConfig.recordEdges() || !EdgeRecorder) {
+      return;
+    }
+    std::lock_guard<std::mutex> Lock(RecorderMtx);
+    EdgeRecorder(SourceNode, SinkStmt, SourceVal, DestVals, InterP);
+  }
+
+  void addIntermediateEdgeFunction(n_t Source, d_t SourceVal, n_t Target,
+                                   d_t TargetVal, EdgeFunctionPtrType EdgeFn) {
+    if (!SolverConfig.emitESG()) {
+      return;
+    }
+    std::lock_guard<std::mutex> Lock(RecorderMtx);
+    IntermediateEdgeFunctions[std::make_tuple(Source, SourceVal, Target,
+                                              TargetVal)]
+        .push_back(std::move(EdgeFn));
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Phase I
+
+  /// Processes the messages and path edges of S until both are exhausted.
+  /// Returns false if there was nothing to process. Work that has been
+  /// announced for S but not yet posted is left to the idle wait in work(),
+  /// which wakes up once it is posted.
+  bool drainPathEdges(Shard &S, CacheTy &Cache) {
+    std::vector<Message> Msgs;
+    bool Worked = false;
+    while (true) {
+      {
+        std::lock_guard<std::mutex> Lock(S.InboxMtx);
+        Msgs.swap(S.Inbox);
+      }
+      if (Msgs.empty() && S.WorkList.empty()) {
+        return Worked;
+      }
+      Worked = true;
+      for (auto &Msg : Msgs) {
+        if (auto *Prop = std::get_if<PropagateMessage>(&Msg)) {
+          addJumpFunction(S, Cache, Prop->SourceVal, Prop->Target,
+                          Prop->TargetVal, Prop->EdgeFn);
+        } else if (auto *Inc = std::get_if<IncomingMessage>(&Msg)) {
+          handleIncoming(S, Cache, *Inc);
+        } else {
+          handleSummary(S, Cache, std::get<SummaryMessage>(Msg));
+        }
+        removePending(S);
+      }
+      Msgs.clear();
+      while (!S.WorkList.empty()) {
+        pathEdgeProcessingTask(S, Cache, S.WorkList.pop());
+        removePending(S);
+      }
+    }
+  }
+
+  void pathEdgeProcessingTask(Shard &S, CacheTy &Cache,
+                              const PathEdge<n_t, d_t> &Edge) {
+    if (!ICF->isCallSite(Edge.getTarget())) {
+      if (ICF->isExitInst(Edge.getTarget())) {
+        processExit(S, Cache, Edge);
+      }
+      if (!ICF->getSuccsOf(Edge.getTarget()).empty()) {
+        processNormalFlow(S, Cache, Edge);
+      }
+    } else {
+      processCall(S, Cache, Edge);
+    }
+  }
+
+  EdgeFunctionPtrType jumpFunction(Shard &S, const PathEdge<n_t, d_t> &Edge) {
+    auto FwdLookupRes =
+        S.JumpFn.forwardLookup(Edge.factAtSource(), Edge.getTarget());
+    if (FwdLookupRes) {
+      auto &Ref = FwdLookupRes->get();
+      if (auto Find = std::find_if(Ref.begin(), Ref.end(),
+                                   [&Edge](const auto &Pair) {
+                                     return Edge.factAtTarget() == Pair.first;
+                                   });
+          Find != Ref.end()) {
+        return Find->second;
+      }
+    }
+    return AllTop;
+  }
+
+  /// Counterpart of IDESolver::propagate() for targets owned by S.
+  void addJumpFunction(Shard &S, CacheTy &Cache, d_t SourceVal, n_t Target,
+                       d_t TargetVal, const EdgeFunctionPtrType &F) {
+    EdgeFunctionPtrType JumpFnE = AllTop;
+    if (const auto RevLookupResult =
+            S.JumpFn.reverseLookup(Target, TargetVal)) {
+      const auto &JumpFnContainer = RevLookupResult->get();
+      if (const auto Find = std::find_if(
+              JumpFnContainer.begin(), JumpFnContainer.end(),
+              [SourceVal](const auto &KVpair) {
+                return KVpair.first == SourceVal;
+              });
+          Find != JumpFnContainer.end()) {
+        JumpFnE = Find->second;
+      }
+    }
+    EdgeFunctionPtrType fPrime =
+        S.EFArena.intern(Cache.joinEdgeFunctions(JumpFnE, F));
+    if (fPrime != JumpFnE && !fPrime->equal_to(JumpFnE)) {
+      S.JumpFn.addFunction(SourceVal, Target, TargetVal, std::move(fPrime));
+      addPending(S);
+      S.WorkList.push(PathEdge<n_t, d_t>(SourceVal, Target, TargetVal));
+    }
+  }
+
+  void propagate(Shard &S, CacheTy &Cache, d_t SourceVal, n_t Target,
+                 d_t TargetVal, EdgeFunctionPtrType F) {
+    Shard &Owner = shardOf(Target);
+    if (&Owner == &S) {
+      addJumpFunction(S, Cache, SourceVal, Target, TargetVal, F);
+    } else {
+      post(Owner,
+           PropagateMessage{SourceVal, Target, TargetVal, std::move(F)});
+    }
+  }
+
+  void processCall(Shard &S, CacheTy &Cache, const PathEdge<n_t, d_t> &Edge) {
+    d_t d1 = Edge.factAtSource();
+    n_t n = Edge.getTarget();
+    d_t d2 = Edge.factAtTarget();
+    EdgeFunctionPtrType f = jumpFunction(S, Edge);
+    const std::set<n_t> ReturnSiteNs = ICF->getReturnSitesOfCallAt(n);
+    const std::set<f_t> Callees = ICF->getCalleesOfCallAt(n);
+    for (f_t SCalledProcN : Callees) {
+      if (FlowFunctionPtrType SpecialSum =
+              Cache.getSummaryFlowFunction(n, SCalledProcN)) {
+        for (n_t ReturnSiteN : ReturnSiteNs) {
+          const container_type Res = SpecialSum->computeTargets(d2);
+          saveEdges(n, ReturnSiteN, d2, Res, false);
+          for (d_t d3 : Res) {
+            EdgeFunctionPtrType SumEdgFnE =
+                Cache.getSummaryEdgeFunction(n, d2, ReturnSiteN, d3);
+            propagate(S, Cache, d1, ReturnSiteN, d3,
+                      Cache.composeEdgeFunctions(f, SumEdgFnE));
+          }
+        }
+        continue;
+      }
+      FlowFunctionPtrType Function =
+          Cache.getCallFlowFunction(n, SCalledProcN);
+      const container_type Res = Function->computeTargets(d2);
+      for (n_t SP : ICF->getStartPointsOf(SCalledProcN)) {
+        saveEdges(n, SP, d2, Res, true);
+        for (d_t d3 : Res) {
+          // the owner of the callee creates the initial self-loop and applies
+          // the end summaries that are already known for <SP,d3>
+          post(shardOf(SP), IncomingMessage{SP, d3, n, d2});
+        }
+      }
+    }
+    for (n_t ReturnSiteN : ReturnSiteNs) {
+      FlowFunctionPtrType CallToReturnFF =
+          Cache.getCallToRetFlowFunction(n, ReturnSiteN, Callees);
+      const container_type ReturnFacts = CallToReturnFF->computeTargets(d2);
+      saveEdges(n, ReturnSiteN, d2, ReturnFacts, false);
+      for (d_t d3 : ReturnFacts) {
+        EdgeFunctionPtrType EdgeFnE =
+            Cache.getCallToRetEdgeFunction(n, d2, ReturnSiteN, d3, Callees);
+        addIntermediateEdgeFunction(n, d2, ReturnSiteN, d3, EdgeFnE);
+        propagate(S, Cache, d1, ReturnSiteN, d3,
+                  Cache.composeEdgeFunctions(f, EdgeFnE));
+      }
+    }
+  }
+
+  void processNormalFlow(Shard &S, CacheTy &Cache,
+                         const PathEdge<n_t, d_t> &Edge) {
+    d_t d1 = Edge.factAtSource();
+    n_t n = Edge.getTarget();
+    d_t d2 = Edge.factAtTarget();
+    EdgeFunctionPtrType f = jumpFunction(S, Edge);
+    for (const auto nPrime : ICF->getSuccsOf(n)) {
+      FlowFunctionPtrType FlowFunc = Cache.getNormalFlowFunction(n, nPrime);
+      const container_type Res = FlowFunc->computeTargets(d2);
+      saveEdges(n, nPrime, d2, Res, false);
+      for (d_t d3 : Res) {
+        EdgeFunctionPtrType g = Cache.getNormalEdgeFunction(n, d2, nPrime, d3);
+        addIntermediateEdgeFunction(n, d2, nPrime, d3, g);
+        propagate(S, Cache, d1, nPrime, d3, Cache.composeEdgeFunctions(f, g));
+      }
+    }
+  }
+
+  void processExit(Shard &S, CacheTy &Cache, const PathEdge<n_t, d_t> &Edge) {
+    n_t n = Edge.getTarget();
+    EdgeFunctionPtrType f = jumpFunction(S, Edge);
+    f_t FunctionThatNeedsSummary = ICF->getFunctionOf(n);
+    d_t d1 = Edge.factAtSource();
+    d_t d2 = Edge.factAtTarget();
+    bool HasIncoming = false;
+    for (n_t SP : ICF->getStartPointsOf(FunctionThatNeedsSummary)) {
+      S.EndsummaryTab.get(SP, d1).insert(n, d2, f);
+      for (const auto &[CallSite, CallerFacts] : S.IncomingTab.get(SP, d1)) {
+        HasIncoming = true;
+        for (d_t d4 : CallerFacts) {
+          post(shardOf(CallSite), SummaryMessage{CallSite, d4,
+                                                 FunctionThatNeedsSummary, d1,
+                                                 n, d2, f});
+        }
+      }
+    }
+    if (!SolverConfig.followReturnsPastSeeds() || HasIncoming ||
+        !Problem.isZeroValue(d1)) {
+      return;
+    }
+    const std::set<n_t> Callers = ICF->getCallersOf(FunctionThatNeedsSummary);
+    for (n_t Caller : Callers) {
+      for (n_t RetSiteC : ICF->getReturnSitesOfCallAt(Caller)) {
+        FlowFunctionPtrType RetFunction = Cache.getRetFlowFunction(
+            Caller, FunctionThatNeedsSummary, n, RetSiteC);
+        const container_type Targets = RetFunction->computeTargets(d2);
+        saveEdges(n, RetSiteC, d2, Targets, true);
+        for (d_t d5 : Targets) {
+          EdgeFunctionPtrType f5 = Cache.getReturnEdgeFunction(
+              Caller, FunctionThatNeedsSummary, n, d2, RetSiteC, d5);
+          addIntermediateEdgeFunction(n, d2, RetSiteC, d5, f5);
+          propagate(S, Cache, ZeroValue, RetSiteC, d5,
+                    Cache.composeEdgeFunctions(f, f5));
+          std::lock_guard<std::mutex> Lock(UnbalancedRetSitesMtx);
+          UnbalancedRetSites.insert(RetSiteC);
+        }
+      }
+    }
+    if (Callers.empty()) {
+      FlowFunctionPtrType RetFunction = Cache.getRetFlowFunction(
+          nullptr, FunctionThatNeedsSummary, n, nullptr);
+      RetFunction->computeTargets(d2);
+    }
+  }
+
+  void handleIncoming(Shard &S, CacheTy &Cache, const IncomingMessage &Msg) {
+    addJumpFunction(S, Cache, Msg.D3, Msg.SP, Msg.D3,
+                    EdgeIdentity<l_t>::getInstance());
+    S.IncomingTab.get(Msg.SP, Msg.D3)[Msg.CallSite].insert(Msg.D2);
+    f_t Callee = ICF->getFunctionOf(Msg.SP);
+    Shard &Caller = shardOf(Msg.CallSite);
+    for (const auto &Entry : S.EndsummaryTab.get(Msg.SP, Msg.D3).cellVec()) {
+      post(Caller, SummaryMessage{Msg.CallSite, Msg.D2, Callee, Msg.D3,
+                                  Entry.getRowKey(), Entry.getColumnKey(),
+                                  Entry.getValue()});
+    }
+  }
+
+  void handleSummary(Shard &S, CacheTy &Cache, const SummaryMessage &Msg) {
+    for (n_t RetSiteC : ICF->getReturnSitesOfCallAt(Msg.CallSite)) {
+      FlowFunctionPtrType RetFunction = Cache.getRetFlowFunction(
+          Msg.CallSite, Msg.Callee, Msg.ExitInst, RetSiteC);
+      const container_type Targets = RetFunction->computeTargets(Msg.D2);
+      saveEdges(Msg.ExitInst, RetSiteC, Msg.D2, Targets, true);
+      for (d_t d5 : Targets) {
+        EdgeFunctionPtrType f4 =
+            Cache.getCallEdgeFunction(Msg.CallSite, Msg.D4, Msg.Callee, Msg.D1);
+        EdgeFunctionPtrType f5 = Cache.getReturnEdgeFunction(
+            Msg.CallSite, Msg.Callee, Msg.ExitInst, Msg.D2, RetSiteC, d5);
+        if (SolverConfig.emitESG()) {
+          for (n_t SP : ICF->getStartPointsOf(Msg.Callee)) {
+            addIntermediateEdgeFunction(Msg.CallSite, Msg.D4, SP, Msg.D1, f4);
+          }
+          addIntermediateEdgeFunction(Msg.ExitInst, Msg.D2, RetSiteC, d5, f5);
+        }
+        EdgeFunctionPtrType fPrime = Cache.composeEdgeFunctions(
+            Cache.composeEdgeFunctions(f4, Msg.SummaryFn), f5);
+        // for each jump function coming into the call, propagate to the
+        // return site using the composed function
+        auto RevLookupResult = S.JumpFn.reverseLookup(Msg.CallSite, Msg.D4);
+        if (!RevLookupResult) {
+          continue;
+        }
+        for (size_t I = 0; I < RevLookupResult->get().size(); ++I) {
+          auto ValAndFunc = RevLookupResult->get()[I];
+          if (!ValAndFunc.second->equal_to(AllTop)) {
+            propagate(S, Cache, ValAndFunc.first, RetSiteC, d5,
+                      Cache.composeEdgeFunctions(ValAndFunc.second, fPrime));
+          }
+        }
+      }
+    }
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Phase II(i)
+
+  /// Counterpart of drainPathEdges() for the values.
+  bool drainValues(Shard &S, CacheTy &Cache) {
+    std::vector<ValueMessage> Msgs;
+    bool Worked = false;
+    while (true) {
+      {
+        std::lock_guard<std::mutex> Lock(S.InboxMtx);
+        Msgs.swap(S.ValueInbox);
+      }
+      if (Msgs.empty() && S.ValueWorkList.empty()) {
+        return Worked;
+      }
+      Worked = true;
+      for (auto &Msg : Msgs) {
+        propagateValue(S, Msg.Target, Msg.Fact, std::move(Msg.Value));
+        removePending(S);
+      }
+      Msgs.clear();
+      while (!S.ValueWorkList.empty()) {
+        auto [n, d] = S.ValueWorkList.front();
+        S.ValueWorkList.pop_front();
+        valuePropagationTask(S, Cache, n, d);
+        removePending(S);
+      }
+    }
+  }
+
+  void scheduleValue(Shard &S, n_t n, d_t d) {
+    addPending(S);
+    S.ValueWorkList.emplace_back(n, d);
+  }
+
+  l_t val(Shard &S, n_t n, d_t d) {
+    if (S.ValTab.contains(n, d)) {
+      return S.ValTab.get(n, d);
+    }
+    // implicitly initialized to top; see line [1] of Fig. 7 in SRH96 paper
+    return Problem.topElement();
+  }
+
+  void propagateValue(Shard &S, n_t n, d_t d, l_t L) {
+    l_t ValNHash = val(S, n, d);
+    l_t LPrime = Problem.join(ValNHash, std::move(L));
+    if (!(LPrime == ValNHash)) {
+      S.ValTab.insert(n, d, std::move(LPrime));
+      scheduleValue(S, n, d);
+    }
+  }
+
+  void valuePropagationTask(Shard &S, CacheTy &Cache, n_t n, d_t d) {
+    // initial seeds and unbalanced return sites are treated as start points
+    if (ICF->isStartPoint(n) || SeedNodes.count(n)) {
+      for (const n_t CallSite :
+           ICF->getCallsFromWithin(ICF->getFunctionOf(n))) {
+        auto LookupResults = S.JumpFn.forwardLookup(d, CallSite);
+        if (!LookupResults) {
+          continue;
+        }
+        for (size_t I = 0; I < LookupResults->get().size(); ++I) {
+          auto Entry = LookupResults->get()[I];
+          propagateValue(S, CallSite, Entry.first,
+                         Entry.second->computeTarget(val(S, n, d)));
+        }
+      }
+    }
+    if (!ICF->isCallSite(n)) {
+      return;
+    }
+    for (const f_t Callee : ICF->getCalleesOfCallAt(n)) {
+      FlowFunctionPtrType CallFlowFunction =
+          Cache.getCallFlowFunction(n, Callee);
+      for (const d_t dPrime : CallFlowFunction->computeTargets(d)) {
+        EdgeFunctionPtrType EdgeFn =
+            Cache.getCallEdgeFunction(n, d, Callee, dPrime);
+        for (const n_t StartPoint : ICF->getStartPointsOf(Callee)) {
+          addIntermediateEdgeFunction(n, d, StartPoint, dPrime, EdgeFn);
+          l_t Value = EdgeFn->computeTarget(val(S, n, d));
+          Shard &Owner = shardOf(StartPoint);
+          if (&Owner == &S) {
+            propagateValue(S, StartPoint, dPrime, std::move(Value));
+          } else {
+            post(Owner, ValueMessage{StartPoint, dPrime, std::move(Value)});
+          }
+        }
+      }
+    }
+  }
+
+  ProblemTy &Problem;
+  const i_t *ICF;
+  const IFDSIDESolverConfig &SolverConfig;
+  d_t ZeroValue;
+  EdgeFunctionPtrType AllTop;
+  unsigned NumThreads;
+
+  std::vector<std::unique_ptr<CacheTy>> Caches;
+  std::vector<std::unique_ptr<Shard>> Shards;
+  // number of messages and worklist items that are pending in all shards
+  std::atomic<size_t> NumPending{0};
+
+  // idle workers block on IdleCV until WorkEpoch changes
+  std::mutex IdleMtx;
+  std::condition_variable IdleCV;
+  std::atomic<uint64_t> WorkEpoch{0};
+  std::atomic<unsigned> NumIdle{0};
+
+  std::mutex RecorderMtx;
+  EdgeRecorderTy EdgeRecorder;
+  IntermediateEdgeFunctionsTy &IntermediateEdgeFunctions;
+
+  std::mutex UnbalancedRetSitesMtx;
+  std::set<n_t> UnbalancedRetSites;
+
+  // initial seeds of Phase II(i); read-only while the workers are running
+  std::set<n_t> SeedNodes;
+};
+
+} // namespace psr
+
+#endif
@@ -23,9 +23,9 @@ namespace psr {
 
 template <typename N, typename D> class PathEdge {
 private:
-  const N Target;
-  const D DSource;
-  const D DTarget;
+  N Target;
+  D DSource;
+  D DTarget;
 
 public:
   PathEdge(D DSource, N Target, D DTarget)
@@ -0,0 +1,226 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+/*
+ * PathEdgeWorklist.h
+ *
+ *  Created on: 18.10.2022
+ *      Author: pdschbrt
+ */
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_PATHEDGEWORKLIST_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_PATHEDGEWORKLIST_H
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+
+namespace psr {
+
+/// Holds the path edges that have been discovered by the IDESolver but have
+/// not been processed, yet. The order in which pending edges are handed out is
+/// determined by the PathEdgeSchedulingPolicy:
+///
+///   - FIFO: breadth-first exploration of the exploded super-graph
+///   - LIFO: depth-first exploration (mimics the former recursive solver)
+///   - ReversePostOrder: edges are prioritized by the post-order of their
+///     target's function in the call graph (callees before callers, hence
+///     summaries are completed before they are applied) and, within the same
+///     function, by the reverse-postorder of the target instruction in the
+///     function's control-flow graph (loop bodies are stabilized before
+///     their facts leave the loop)
+///
+/// The ranks that are required for the ReversePostOrder policy are computed
+/// lazily on a per-function basis.
+template <typename N, typename D, typename F, typename I>
+class PathEdgeWorklist {
+public:
+  using n_t = N;
+  using d_t = D;
+  using f_t = F;
+  using i_t = I;
+
+  PathEdgeWorklist(const i_t *ICF, PathEdgeSchedulingPolicy Policy)
+      : ICF(ICF), Policy(Policy) {
+    assert(Policy != PathEdgeSchedulingPolicy::Invalid &&
+           "Invalid path-edge scheduling policy!");
+  }
+
+  ~PathEdgeWorklist() = default;
+
+  PathEdgeWorklist(const PathEdgeWorklist &) = delete;
+  PathEdgeWorklist &operator=(const PathEdgeWorklist &) = delete;
+  PathEdgeWorklist(PathEdgeWorklist &&) noexcept = default;
+  PathEdgeWorklist &operator=(PathEdgeWorklist &&) noexcept = default;
+
+  void push(PathEdge<n_t, d_t> Edge) {
+    switch (Policy) {
+    case PathEdgeSchedulingPolicy::ReversePostOrder: {
+      auto Prio = getPriority(Edge.getTarget());
+      PriorityQueue.push({Prio, Sequence++, std::move(Edge)});
+      break;
+    }
+    default:
+      Queue.push_back(std::move(Edge));
+      break;
+    }
+    if (size() > MaxSize) {
+      MaxSize = size();
+    }
+  }
+
+  [[nodiscard]] PathEdge<n_t, d_t> pop() {
+    assert(!empty() && "Cannot pop from an empty worklist!");
+    switch (Policy) {
+    case PathEdgeSchedulingPolicy::LIFO: {
+      PathEdge<n_t, d_t> Edge = std::move(Queue.back());
+      Queue.pop_back();
+      return Edge;
+    }
+    case PathEdgeSchedulingPolicy::ReversePostOrder: {
+      PathEdge<n_t, d_t> Edge = PriorityQueue.top().Edge;
+      PriorityQueue.pop();
+      return Edge;
+    }
+    default: {
+      PathEdge<n_t, d_t> Edge = std::move(Queue.front());
+      Queue.pop_front();
+      return Edge;
+    }
+    }
+  }
+
+  [[nodiscard]] bool empty() const {
+    return Queue.empty() && PriorityQueue.empty();
+  }
+
+  [[nodiscard]] size_t size() const {
+    return Queue.size() + PriorityQueue.size();
+  }
+
+  /// Returns the maximum number of path edges that were pending at the same
+  /// time.
+  [[nodiscard]] size_t getMaxSize() const { return MaxSize; }
+
+  [[nodiscard]] PathEdgeSchedulingPolicy getPolicy() const { return Policy; }
+
+private:
+  struct PrioritizedEdge {
+    uint64_t Priority;
+    uint64_t Seq;
+    PathEdge<n_t, d_t> Edge;
+
+    friend bool operator>(const PrioritizedEdge &Lhs,
+                          const PrioritizedEdge &Rhs) {
+      // Ties are broken in insertion order to keep the solver deterministic.
+      return Lhs.Priority > Rhs.Priority ||
+             (Lhs.Priority == Rhs.Priority && Lhs.Seq > Rhs.Seq);
+    }
+  };
+
+  uint64_t getPriority(n_t Inst) {
+    auto Search = InstRank.find(Inst);
+    if (Search == InstRank.end()) {
+      rankFunction(ICF->getFunctionOf(Inst));
+      // Instructions that are unreachable from the function's start points
+      // are scheduled last.
+      Search =
+          InstRank.try_emplace(Inst, std::numeric_limits<uint32_t>::max()).first;
+    }
+    uint32_t FRank = FunRank[ICF->getFunctionOf(Inst)];
+    return (static_cast<uint64_t>(FRank) << 32) | Search->second;
+  }
+
+  /// Computes the call-graph post-order for all functions reachable from Fun
+  /// that have not been ranked so far as well as the reverse-postorder of
+  /// Fun's instructions. Both traversals are iterative to be able to deal with
+  /// arbitrarily deep graphs.
+  void rankFunction(f_t Fun) {
+    if (!FunRank.count(Fun)) {
+      std::vector<std::pair<f_t, std::vector<f_t>>> Stack;
+      auto getCallees = [this](f_t Caller) {
+        std::vector<f_t> Callees;
+        for (n_t CS : ICF->getCallsFromWithin(Caller)) {
+          for (f_t Callee : ICF->getCalleesOfCallAt(CS)) {
+            Callees.push_back(Callee);
+          }
+        }
+        return Callees;
+      };
+      VisitedFuns.insert(Fun);
+      Stack.emplace_back(Fun, getCallees(Fun));
+      while (!Stack.empty()) {
+        auto &[Caller, Callees] = Stack.back();
+        if (Callees.empty()) {
+          FunRank[Caller] = NextFunRank++;
+          Stack.pop_back();
+          continue;
+        }
+        f_t Callee = Callees.back();
+        Callees.pop_back();
+        if (VisitedFuns.insert(Callee).second) {
+          Stack.emplace_back(Callee, getCallees(Callee));
+        }
+      }
+    }
+    std::vector<n_t> PostOrder;
+    std::unordered_set<n_t> Visited;
+    std::vector<std::pair<n_t, std::vector<n_t>>> Stack;
+    for (n_t SP : ICF->getStartPointsOf(Fun)) {
+      if (!Visited.insert(SP).second) {
+        continue;
+      }
+      Stack.emplace_back(SP, ICF->getSuccsOf(SP));
+      while (!Stack.empty()) {
+        auto &[Inst, Succs] = Stack.back();
+        if (Succs.empty()) {
+          PostOrder.push_back(Inst);
+          Stack.pop_back();
+          continue;
+        }
+        n_t Succ = Succs.back();
+        Succs.pop_back();
+        if (Visited.insert(Succ).second) {
+          Stack.emplace_back(Succ, ICF->getSuccsOf(Succ));
+        }
+      }
+    }
+    uint32_t Rank = 0;
+    for (auto It = PostOrder.rbegin(); It != PostOrder.rend(); ++It) {
+      InstRank[*It] = Rank++;
+    }
+  }
+
+  const i_t *ICF;
+  PathEdgeSchedulingPolicy Policy;
+  std::deque<PathEdge<n_t, d_t>> Queue;
+  std::priority_queue<PrioritizedEdge, std::vector<PrioritizedEdge>,
+                      std::greater<PrioritizedEdge>>
+      PriorityQueue;
+  std::unordered_map<n_t, uint32_t> InstRank;
+  std::unordered_map<f_t, uint32_t> FunRank;
+  std::unordered_set<f_t> VisitedFuns;
+  uint32_t NextFunRank = 0;
+  uint64_t Sequence = 0;
+  size_t MaxSize = 0;
+};
+
+} // namespace psr
+
+#endif
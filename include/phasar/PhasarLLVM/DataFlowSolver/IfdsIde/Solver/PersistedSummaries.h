@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+/*
+ * PersistedSummaries.h
+ *
+ *  Created on: 18.10.2022
+ *      Author: pdschbrt
+ */
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_PERSISTEDSUMMARIES_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_PERSISTEDSUMMARIES_H
+
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+
+namespace psr {
+
+/// Provides end summaries that have been computed by previous solver runs,
+/// possibly for other programs, and collects the end summaries computed by
+/// the current run, such that they can be persisted for later runs.
+///
+/// Unlike ExternalSummaries, persisted summaries are looked up per data-flow
+/// fact: at a call, the IDESolver applies the persisted end summaries of the
+/// callee for the facts they cover and analyzes the callee as usual for all
+/// other facts.
+template <typename N, typename D, typename F, typename L>
+class PersistedSummaries {
+public:
+  using EdgeFunctionPtrType = std::shared_ptr<EdgeFunction<L>>;
+  /// An end summary: an exit statement of the summarized function, a fact
+  /// holding at that statement and the edge function from the start point.
+  using EndSummaryTy = std::tuple<N, D, EdgeFunctionPtrType>;
+
+  virtual ~PersistedSummaries() = default;
+
+  /// Returns all end summaries of Fun for Fact holding at its start point, or
+  /// std::nullopt if they are not known.
+  [[nodiscard]] virtual std::optional<std::vector<EndSummaryTy>>
+  getEndSummaries(F Fun, D Fact) = 0;
+
+  /// Adds all end summaries of Fun for Fact holding at its start point, which
+  /// have been computed by the current solver run.
+  virtual void addEndSummaries(F Fun, D Fact,
+                               const std::vector<EndSummaryTy> &Summaries) = 0;
+};
+
+} // namespace psr
+
+#endif
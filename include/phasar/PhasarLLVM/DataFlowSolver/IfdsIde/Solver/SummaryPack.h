@@ -0,0 +1,171 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_SUMMARYPACK_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_SUMMARYPACK_H
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Value.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryStore.h"
+
+namespace psr {
+
+class ProjectIRDB;
+
+/// The summaries of an IFDS analysis for the functions of one or more
+/// libraries, e.g., libc or libstdc++, computed once from the bitcode of the
+/// libraries (see WholeProgramAnalysis) and stored in the SummaryStore
+/// format.
+///
+/// After loading the packs, index() resolves the summaries of all function
+/// definitions of the program under analysis by their closure hashes, such
+/// that a callee is looked up by its llvm::Function in constant time. Only
+/// complete summaries are resolved: summaries that cover the zero value and
+/// all arguments of a function that does not access mutable global
+/// variables. All facts that may hold at the start point of such a function
+/// are thus either summarized or not accessed by the function at all.
+///
+/// A pack only records the end summaries of the functions, not the results
+/// that an analysis collects as a side effect of its flow functions, e.g.,
+/// the leaks found by IFDSTaintAnalysis or the uses reported by
+/// IFDSUninitializedVariables. Such analyses do not opt in to
+/// IFDSTabulationProblem::canPersistSummaries(), so packs are currently
+/// limited to analyses whose results are fully described by the facts that
+/// hold at each statement.
+class SummaryPack {
+public:
+  explicit SummaryPack(std::string ProblemID) : Store(std::move(ProblemID)) {}
+
+  /// Adds the summaries of the pack at Path. Returns false if it cannot be
+  /// read or belongs to another analysis problem.
+  bool load(const std::string &Path);
+
+  /// Resolves the summaries of all function definitions of IRDB. Must be
+  /// called after all packs have been loaded.
+  void index(const ProjectIRDB &IRDB);
+
+  /// Returns the complete summary of F, or nullptr if there is none.
+  [[nodiscard]] const SummaryStore::FunctionSummary *
+  lookup(const llvm::Function *F) const {
+    auto It = Index.find(F);
+    return It != Index.end() ? It->second : nullptr;
+  }
+
+  [[nodiscard]] SummaryStore &getStore() noexcept { return Store; }
+
+  /// Returns the number of functions with a complete summary.
+  [[nodiscard]] size_t size() const noexcept { return Index.size(); }
+
+  /// Returns true if Summary covers the zero value and all arguments of F.
+  [[nodiscard]] static bool
+  isComplete(const llvm::Function &F,
+             const SummaryStore::FunctionSummary &Summary);
+
+private:
+  SummaryStore Store;
+  llvm::DenseMap<const llvm::Function *, const SummaryStore::FunctionSummary *>
+      Index;
+};
+
+/// The summary flow function of a call to a function with a complete summary
+/// in a SummaryPack: maps a fact holding at the call site to the facts
+/// holding at the return site(s) by applying the call flow function, the end
+/// summaries of the callee and the return flow functions, without analyzing
+/// the callee. Facts that are not covered by the end summaries, e.g., facts
+/// about global variables, are not accessed by the callee and flow through
+/// it unchanged.
+template <typename Container = std::set<const llvm::Value *>>
+class SummaryPackFlowFunction
+    : public FlowFunction<const llvm::Value *, Container> {
+public:
+  using typename FlowFunction<const llvm::Value *,
+                              Container>::FlowFunctionPtrType;
+  using typename FlowFunction<const llvm::Value *, Container>::container_type;
+  /// The return flow functions of the call per exit statement of the callee.
+  using ReturnFlowFunctionsTy =
+      std::vector<std::pair<const llvm::Instruction *, FlowFunctionPtrType>>;
+
+  SummaryPackFlowFunction(SummaryStore &Store, const llvm::Function &Callee,
+                          const SummaryStore::FunctionSummary &Summary,
+                          const llvm::Value *ZeroValue,
+                          FlowFunctionPtrType CallFlowFunction,
+                          ReturnFlowFunctionsTy ReturnFlowFunctions)
+      : Store(Store), Callee(Callee), Summary(Summary), ZeroValue(ZeroValue),
+        CallFlowFunction(std::move(CallFlowFunction)),
+        ReturnFlowFunctions(std::move(ReturnFlowFunctions)) {}
+
+  container_type computeTargets(const llvm::Value *Source) override {
+    container_type Targets;
+    for (const auto *Fact : CallFlowFunction->computeTargets(Source)) {
+      auto Ref = Fact == ZeroValue
+                     ? std::optional<SummaryStore::FactRef>(
+                           SummaryStore::FactRef{})
+                     : Store.encode(Callee, Fact);
+      if (!Ref || !Summary.isSummarized(*Ref)) {
+        for (const auto &Return : ReturnFlowFunctions) {
+          addTargets(Targets, Return.second, Fact);
+        }
+        continue;
+      }
+      auto Range = std::equal_range(
+          Summary.Entries.begin(), Summary.Entries.end(),
+          SummaryStore::Entry{*Ref, 0, {}, SummaryStore::EdgeKind::Identity},
+          [](const auto &LHS, const auto &RHS) {
+            return LHS.Source < RHS.Source;
+          });
+      for (auto It = Range.first; It != Range.second; ++It) {
+        const auto *ExitPoint = Store.getInstruction(Callee, It->ExitPoint);
+        const auto *Target =
+            It->Target.Kind == SummaryStore::FactRef::KindTy::Zero
+                ? ZeroValue
+                : Store.decode(Callee, It->Target);
+        if (!Target) {
+          continue;
+        }
+        for (const auto &Return : ReturnFlowFunctions) {
+          if (Return.first == ExitPoint) {
+            addTargets(Targets, Return.second, Target);
+          }
+        }
+      }
+    }
+    return Targets;
+  }
+
+private:
+  static void addTargets(container_type &Targets,
+                         const FlowFunctionPtrType &ReturnFlowFunction,
+                         const llvm::Value *Fact) {
+    auto Returned = ReturnFlowFunction->computeTargets(Fact);
+    Targets.insert(Returned.begin(), Returned.end());
+  }
+
+  SummaryStore &Store;
+  const llvm::Function &Callee;
+  const SummaryStore::FunctionSummary &Summary;
+  const llvm::Value *ZeroValue;
+  FlowFunctionPtrType CallFlowFunction;
+  ReturnFlowFunctionsTy ReturnFlowFunctions;
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_SUMMARYSTORE_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_IFDSIDE_SOLVER_SUMMARYSTORE_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+
+namespace llvm {
+class Function;
+class Instruction;
+class MemoryBufferRef;
+class raw_ostream;
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+/// The end summaries of an analysis persisted across program runs, such that
+/// functions that are shared by many programs, e.g., the functions of a
+/// library, need not be analyzed again.
+///
+/// The summaries of a function are keyed by its closure hash (see
+/// FunctionHashes), which only depends on the code of the function and its
+/// transitive callees. Data-flow facts and exit statements are stored
+/// relative to the summarized function: as the position of an argument or an
+/// instruction within the function, or as the name of a global value. Like the
+/// closure hash, instruction positions ignore debug intrinsics.
+/// Summaries are only persisted if all of their facts can be represented in
+/// this way and all of their edge functions are either the identity or
+/// AllBottom, which covers all IFDS problems.
+///
+/// A store belongs to a single analysis problem, identified by the problem
+/// id written to its header; stores of other problems are not loaded.
+class SummaryStore {
+public:
+  /// A data-flow fact relative to the summarized function.
+  struct FactRef {
+    enum class KindTy : uint8_t { Zero, Argument, Instruction, Global };
+
+    KindTy Kind = KindTy::Zero;
+    // the argument number, the instruction number or the id of the name of a
+    // global value, respectively
+    uint32_t Index = 0;
+
+    friend bool operator==(FactRef LHS, FactRef RHS) noexcept {
+      return LHS.Kind == RHS.Kind && LHS.Index == RHS.Index;
+    }
+    friend bool operator<(FactRef LHS, FactRef RHS) noexcept {
+      return std::tie(LHS.Kind, LHS.Index) < std::tie(RHS.Kind, RHS.Index);
+    }
+  };
+
+  enum class EdgeKind : uint8_t { Identity, AllBottom };
+
+  /// An end summary: Target holds at the exit statement with the number
+  /// ExitPoint if Source holds at the start point of the function.
+  struct Entry {
+    FactRef Source;
+    uint32_t ExitPoint = 0;
+    FactRef Target;
+    EdgeKind Edge = EdgeKind::Identity;
+
+    friend bool operator==(const Entry &LHS, const Entry &RHS) noexcept {
+      return LHS.Source == RHS.Source && LHS.ExitPoint == RHS.ExitPoint &&
+             LHS.Target == RHS.Target && LHS.Edge == RHS.Edge;
+    }
+  };
+
+  struct FunctionSummary {
+    // the facts at the start point for which all end summaries are known,
+    // sorted
+    std::vector<FactRef> EntryFacts;
+    // sorted by their source facts
+    std::vector<Entry> Entries;
+
+    [[nodiscard]] bool isSummarized(FactRef Fact) const;
+  };
+
+  explicit SummaryStore(std::string ProblemID)
+      : ProblemID(std::move(ProblemID)) {}
+
+  /// Reads the summaries from Buffer and adds them to this store. Returns
+  /// false, leaving the store unchanged, if Buffer is malformed, has been
+  /// written by another version of the format or for another problem.
+  bool read(llvm::MemoryBufferRef Buffer);
+
+  /// Reads the summaries from the file at Path, if it exists.
+  bool readFromFile(const std::string &Path);
+
+  void write(llvm::raw_ostream &OS) const;
+
+  /// Writes all summaries to the file at Path, replacing its contents.
+  bool writeToFile(const std::string &Path) const;
+
+  [[nodiscard]] const FunctionSummary *lookup(uint64_t FunctionHash) const;
+
+  /// Adds the end summaries of the function with the closure hash
+  /// FunctionHash, merging them with the ones already stored.
+  void insert(uint64_t FunctionHash, FunctionSummary Summary);
+
+  [[nodiscard]] size_t size() const noexcept { return Summaries.size(); }
+
+  [[nodiscard]] const std::string &getProblemID() const noexcept {
+    return ProblemID;
+  }
+
+  /// Returns the representation of V, which is not the zero value, relative
+  /// to F, if there is one.
+  [[nodiscard]] std::optional<FactRef> encode(const llvm::Function &F,
+                                              const llvm::Value *V);
+
+  /// Returns the value Ref refers to relative to F, or nullptr if there is
+  /// no such value. Ref must not refer to the zero value.
+  [[nodiscard]] const llvm::Value *decode(const llvm::Function &F,
+                                          FactRef Ref);
+
+  /// Returns the position of Inst within its function, not counting debug
+  /// intrinsics. Inst must not be a debug intrinsic.
+  [[nodiscard]] uint32_t getInstructionNumber(const llvm::Instruction *Inst);
+
+  /// Returns the instruction at position Number within F, or nullptr.
+  [[nodiscard]] const llvm::Instruction *getInstruction(const llvm::Function &F,
+                                                        uint32_t Number);
+
+private:
+  const std::vector<const llvm::Instruction *> &
+  getInstructions(const llvm::Function &F);
+
+  uint32_t getGlobalNameId(llvm::StringRef Name);
+
+  std::string ProblemID;
+  llvm::DenseMap<uint64_t, FunctionSummary> Summaries;
+  std::vector<std::string> GlobalNames;
+  llvm::StringMap<uint32_t> GlobalNameIds;
+  // the instructions of the functions that have been encoded or decoded so far
+  llvm::DenseMap<const llvm::Function *, std::vector<const llvm::Instruction *>>
+      Instructions;
+  llvm::DenseMap<const llvm::Instruction *, uint32_t> InstructionNumbers;
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_MONO_CONTEXTS_CALLSTRINGCONTEXTTREE_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_MONO_CONTEXTS_CALLSTRINGCONTEXTTREE_H
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Contexts/CallStringCTX.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+namespace psr {
+
+/// Hash-conses the K-limited call-string contexts of an inter-procedural
+/// monotone analysis into a tree. Each context is identified by a dense id and
+/// stored as its parent, i.e. the context without its most recent call site,
+/// plus that call site. Two contexts are equal iff their ids are equal, and
+/// pushing and popping call sites takes (amortized) constant time without
+/// copying any call strings.
+///
+/// Pushing a call site onto a context of length K drops the oldest call site
+/// of that context, just as CallStringCTX<N, K>::push_back() does.
+template <typename N, unsigned K> class CallStringContextTree {
+  static_assert(K > 0, "The call strings must have a length of at least one");
+
+public:
+  using ContextId = uint32_t;
+
+  /// The id of the empty context, which is the root of the tree.
+  static constexpr ContextId EmptyContext = 0;
+
+  CallStringContextTree() { Nodes.push_back({EmptyContext, N{}, 0}); }
+
+  /// Returns the context that results from appending CallSite to Ctx.
+  [[nodiscard]] ContextId push(ContextId Ctx, N CallSite) {
+    if (getLength(Ctx) == K) {
+      Ctx = dropOldest(Ctx);
+    }
+    return getOrCreateChild(Ctx, CallSite);
+  }
+
+  /// Returns Ctx without its most recent call site, and that call site. Ctx
+  /// must not be the empty context.
+  [[nodiscard]] std::pair<ContextId, N> pop(ContextId Ctx) const {
+    assert(Ctx != EmptyContext && "Cannot pop from the empty context");
+    return {Nodes[Ctx].Parent, Nodes[Ctx].CallSite};
+  }
+
+  [[nodiscard]] unsigned getLength(ContextId Ctx) const {
+    return Nodes[Ctx].Length;
+  }
+
+  /// Returns the call sites of Ctx, starting with the oldest one.
+  [[nodiscard]] llvm::SmallVector<N, K> getCallSites(ContextId Ctx) const {
+    llvm::SmallVector<N, K> CallSites(getLength(Ctx));
+    for (auto It = CallSites.rbegin(); It != CallSites.rend(); ++It) {
+      *It = Nodes[Ctx].CallSite;
+      Ctx = Nodes[Ctx].Parent;
+    }
+    return CallSites;
+  }
+
+  /// Converts Ctx into its equivalent CallStringCTX.
+  [[nodiscard]] CallStringCTX<N, K> getCallStringCTX(ContextId Ctx) const {
+    CallStringCTX<N, K> Result;
+    for (N CallSite : getCallSites(Ctx)) {
+      Result.push_back(CallSite);
+    }
+    return Result;
+  }
+
+  /// Returns the number of distinct contexts, including the empty one.
+  [[nodiscard]] size_t size() const { return Nodes.size(); }
+
+  void print(llvm::raw_ostream &OS, ContextId Ctx) const {
+    OS << "Call string: [ ";
+    auto CallSites = getCallSites(Ctx);
+    for (size_t I = 0; I < CallSites.size(); ++I) {
+      if (I != 0) {
+        OS << " * ";
+      }
+      OS << llvmIRToString(CallSites[I]);
+    }
+    OS << " ]";
+  }
+
+private:
+  static constexpr ContextId NoContext = std::numeric_limits<ContextId>::max();
+
+  struct Node {
+    ContextId Parent;
+    N CallSite;
+    unsigned Length;
+    // the context without the oldest call site, computed on demand
+    ContextId WithoutOldest = NoContext;
+  };
+
+  ContextId getOrCreateChild(ContextId Parent, N CallSite) {
+    auto [It, Inserted] = Children.try_emplace(
+        std::make_pair(Parent, CallSite), static_cast<ContextId>(Nodes.size()));
+    if (Inserted) {
+      assert(Nodes.size() < NoContext && "Too many call-string contexts");
+      Nodes.push_back({Parent, CallSite, getLength(Parent) + 1});
+    }
+    return It->second;
+  }
+
+  ContextId dropOldest(ContextId Ctx) {
+    if (Nodes[Ctx].WithoutOldest != NoContext) {
+      return Nodes[Ctx].WithoutOldest;
+    }
+    ContextId Result = EmptyContext;
+    if (getLength(Ctx) > 1) {
+      // Nodes may be reallocated, hence do not keep references into it
+      auto [Parent, CallSite] = pop(Ctx);
+      Result = getOrCreateChild(dropOldest(Parent), CallSite);
+    }
+    Nodes[Ctx].WithoutOldest = Result;
+    return Result;
+  }
+
+  std::vector<Node> Nodes;
+  llvm::DenseMap<std::pair<ContextId, N>, ContextId> Children;
+};
+
+} // namespace psr
+
+#endif
@@ -83,6 +83,9 @@ public:
   virtual bool equal_to( // NOLINT - this would break client analyses
       const mono_container_t &Lhs, const mono_container_t &Rhs) = 0;
 
+  /// Returns an empty container. The Mono solvers create all of their
+  /// containers through this function, such that a problem using BitVectorSet
+  /// containers can let them reference a BitVectorSetDomain it owns.
   virtual mono_container_t allTop() { return mono_container_t{}; }
 
   virtual std::unordered_map<n_t, mono_container_t> initialSeeds() = 0;
@@ -59,6 +59,8 @@ public:
 
   ~InterMonoSolverTest() override = default;
 
+  mono_container_t allTop() override;
+
   mono_container_t merge(const mono_container_t &Lhs,
                          const mono_container_t &Rhs) override;
 
@@ -84,6 +86,9 @@ public:
   void printDataFlowFact(llvm::raw_ostream &OS, d_t Fact) const override;
 
   void printFunction(llvm::raw_ostream &OS, f_t Fun) const override;
+
+private:
+  BitVectorSetDomain<d_t> Domain;
 };
 
 } // namespace psr
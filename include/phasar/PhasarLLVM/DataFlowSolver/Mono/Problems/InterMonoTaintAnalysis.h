@@ -62,6 +62,8 @@ public:
 
   ~InterMonoTaintAnalysis() override = default;
 
+  mono_container_t allTop() override;
+
   mono_container_t merge(const mono_container_t &Lhs,
                          const mono_container_t &Rhs) override;
 
@@ -93,6 +95,7 @@ public:
 private:
   [[maybe_unused]] const TaintConfig &Config;
   std::map<n_t, std::set<d_t>> Leaks;
+  BitVectorSetDomain<d_t> Domain;
 };
 
 } // namespace psr
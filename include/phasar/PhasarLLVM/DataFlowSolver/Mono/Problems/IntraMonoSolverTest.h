@@ -60,6 +60,8 @@ public:
 
   ~IntraMonoSolverTest() override = default;
 
+  mono_container_t allTop() override;
+
   mono_container_t merge(const mono_container_t &Lhs,
                          const mono_container_t &Rhs) override;
 
@@ -76,6 +78,9 @@ public:
 
   void printFunction(llvm::raw_ostream &OS,
                      const llvm::Function *Fun) const override;
+
+private:
+  BitVectorSetDomain<d_t> Domain;
 };
 
 } // namespace psr
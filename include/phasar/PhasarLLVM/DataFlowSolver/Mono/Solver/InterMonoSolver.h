@@ -17,14 +17,21 @@
 #ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_MONO_SOLVER_INTERMONOSOLVER_H
 #define PHASAR_PHASARLLVM_DATAFLOWSOLVER_MONO_SOLVER_INTERMONOSOLVER_H
 
+#include <cstdint>
 #include <deque>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Contexts/CallStringCTX.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Contexts/CallStringContextTree.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/InterMonoProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/MonoWorklist.h"
 #include "phasar/Utils/LLVMShorthands.h"
 
 namespace psr {
@@ -39,35 +46,69 @@ public:
   using v_t = typename AnalysisDomainTy::v_t;
   using i_t = typename AnalysisDomainTy::i_t;
   using mono_container_t = typename AnalysisDomainTy::mono_container_t;
+  using ContextTreeTy = CallStringContextTree<n_t, K>;
+  using ContextId = typename ContextTreeTy::ContextId;
 
 protected:
   ProblemTy &IMProblem;
-  std::deque<std::pair<n_t, n_t>> Worklist;
-  std::unordered_map<
-      n_t, std::unordered_map<CallStringCTX<n_t, K>, mono_container_t>>
-      Analysis;
-  std::unordered_set<f_t> AddedFunctions;
   const i_t *ICF;
+  MonoWorklist<n_t, f_t, i_t> Worklist;
+  // the call-string contexts, each of which is identified by a ContextId
+  ContextTreeTy Contexts;
+  // (node, context) -> index of the node's data-flow facts in that context
+  llvm::DenseMap<std::pair<n_t, ContextId>, uint32_t> AnalysisIds;
+  // a std::deque does not move its elements on insertion at the end
+  std::deque<mono_container_t> Analysis;
+  // node -> contexts for which data-flow facts exist, in order of creation
+  llvm::DenseMap<n_t, llvm::SmallVector<ContextId, 1>> ContextsOf;
+  std::unordered_set<f_t> AddedFunctions;
+
+  /// Returns the data-flow facts that hold at Node in context Ctx and
+  /// creates them from the problem's top element if there are none yet. The
+  /// reference remains valid when facts for other nodes or contexts are
+  /// created.
+  mono_container_t &getFacts(n_t Node, ContextId Ctx) {
+    auto [It, Inserted] = AnalysisIds.try_emplace(
+        std::make_pair(Node, Ctx), static_cast<uint32_t>(Analysis.size()));
+    if (Inserted) {
+      // containers must not be default constructed, as they may have to share
+      // state with the problem's containers, e.g. the domain of a BitVectorSet
+      Analysis.push_back(IMProblem.allTop());
+      ContextsOf[Node].push_back(Ctx);
+    }
+    return Analysis[It->second];
+  }
+
+  /// Returns a copy of the contexts in which data-flow facts exist at Node,
+  /// so that facts can be created while iterating. The most recently created
+  /// context comes first, hence the facts of the (more specific) contexts
+  /// that are created by calls precede those of the initial empty context.
+  llvm::SmallVector<ContextId, 1> getContextsOf(n_t Node) const {
+    auto Search = ContextsOf.find(Node);
+    if (Search == ContextsOf.end()) {
+      return {};
+    }
+    return {Search->second.rbegin(), Search->second.rend()};
+  }
 
   void initialize() {
     for (auto &[Node, FlowFacts] : IMProblem.initialSeeds()) {
       auto ControlFlowEdges =
           ICF->getAllControlFlowEdges(ICF->getFunctionOf(Node));
-      Worklist.insert(Worklist.begin(), ControlFlowEdges.begin(),
-                      ControlFlowEdges.end());
+      Worklist.pushFront(ControlFlowEdges.begin(), ControlFlowEdges.end());
       // Initialize with empty context and empty data-flow set such that the
       // flow functions are at least called once per instruction
       for (auto &[Src, Dst] : ControlFlowEdges) {
-        Analysis[Src][CallStringCTX<n_t, K>()] = IMProblem.allTop();
+        getFacts(Src, ContextTreeTy::EmptyContext) = IMProblem.allTop();
       }
       // Initialize last
       if (!ControlFlowEdges.empty()) {
-        Analysis[ControlFlowEdges.back().second][CallStringCTX<n_t, K>()] =
+        getFacts(ControlFlowEdges.back().second, ContextTreeTy::EmptyContext) =
             IMProblem.allTop();
       }
       // Additionally, insert the initial seeds
-      Analysis[Node][CallStringCTX<n_t, K>()].insert(FlowFacts.begin(),
-                                                     FlowFacts.end());
+      getFacts(Node, ContextTreeTy::EmptyContext)
+          .insert(FlowFacts.begin(), FlowFacts.end());
     }
   }
 
@@ -85,7 +126,7 @@ protected:
 
   void printWorkList() {
     llvm::outs() << "CURRENT WORKLIST:\n";
-    for (auto &[Src, Dst] : Worklist) {
+    for (auto &[Src, Dst] : Worklist.getPendingEdges()) {
       llvm::outs() << llvmIRToString(Src) << " --> " << llvmIRToString(Dst)
                    << '\n';
     }
@@ -103,25 +144,25 @@ protected:
       AddedFunctions.insert(Callee);
       // Add call Edge(s)
       for (auto StartPoint : ICF->getStartPointsOf(Callee)) {
-        Worklist.push_back({Src, StartPoint});
+        Worklist.push({Src, StartPoint});
       }
       // Add intra edges of callee
       auto Edges = ICF->getAllControlFlowEdges(Callee);
-      Worklist.insert(Worklist.begin(), Edges.begin(), Edges.end());
+      Worklist.pushFront(Edges.begin(), Edges.end());
       // Initialize with empty context and empty data-flow set such that the
       // flow functions are at least called once per instruction
       for (auto &[Src, Dst] : Edges) {
-        Analysis[Src][CallStringCTX<n_t, K>()] = IMProblem.allTop();
+        getFacts(Src, ContextTreeTy::EmptyContext) = IMProblem.allTop();
       }
       // Initialize last
       if (!Edges.empty()) {
-        Analysis[Edges.back().second][CallStringCTX<n_t, K>()] =
+        getFacts(Edges.back().second, ContextTreeTy::EmptyContext) =
             IMProblem.allTop();
       }
       // Add return Edge(s)
       for (auto Ret : ICF->getExitPointsOf(Callee)) {
         for (auto RetSite : ICF->getReturnSitesOfCallAt(Src)) {
-          Worklist.push_back({Ret, RetSite});
+          Worklist.push({Ret, RetSite});
         }
       }
     }
@@ -132,16 +173,16 @@ protected:
   void addToWorklist(std::pair<n_t, n_t> Edge) {
     auto Src = Edge.first;
     auto Dst = Edge.second;
-    Worklist.push_back({Src, Dst});
+    Worklist.push({Src, Dst});
     // add intra-procedural edges again
     for (auto Nprimeprime : ICF->getSuccsOf(Dst)) {
-      Worklist.push_back({Dst, Nprimeprime});
+      Worklist.push({Dst, Nprimeprime});
     }
     // add inter-procedural call edges again
     if (ICF->isCallSite(Dst)) {
       for (auto Callee : ICF->getCalleesOfCallAt(Dst)) {
         for (auto StartPoint : ICF->getStartPointsOf(Callee)) {
-          Worklist.push_back({Dst, StartPoint});
+          Worklist.push({Dst, StartPoint});
         }
       }
     }
@@ -149,15 +190,16 @@ protected:
     if (ICF->isExitInst(Dst)) {
       for (const auto *Caller : ICF->getCallersOf(ICF->getFunctionOf(Dst))) {
         for (const auto *Nprimeprime : ICF->getSuccsOf(Caller)) {
-          Worklist.push_back({Dst, Nprimeprime});
+          Worklist.push({Dst, Nprimeprime});
         }
       }
     }
   }
 
 public:
-  InterMonoSolver(InterMonoProblem<AnalysisDomainTy> &IMP)
-      : IMProblem(IMP), ICF(IMP.getICFG()) {}
+  InterMonoSolver(InterMonoProblem<AnalysisDomainTy> &IMP,
+                  MonoWorklistStrategy Strategy = MonoWorklistStrategy::FIFO)
+      : IMProblem(IMP), ICF(IMP.getICFG()), Worklist(ICF, Strategy) {}
 
   InterMonoSolver(const InterMonoSolver &) = delete;
 
@@ -172,18 +214,28 @@ public:
   std::unordered_map<
       n_t, std::unordered_map<CallStringCTX<n_t, K>, mono_container_t>>
   getAnalysis() {
-    return Analysis;
+    std::unordered_map<
+        n_t, std::unordered_map<CallStringCTX<n_t, K>, mono_container_t>>
+        Result;
+    for (const auto &[Node, Ctxs] : ContextsOf) {
+      auto &ContextMap = Result[Node];
+      for (ContextId Ctx : Ctxs) {
+        ContextMap[Contexts.getCallStringCTX(Ctx)] = getFacts(Node, Ctx);
+      }
+    }
+    return Result;
   }
 
+  [[nodiscard]] const ContextTreeTy &getContexts() const { return Contexts; }
+
   void processNormal(std::pair<n_t, n_t> Edge) {
     llvm::outs() << "Handle normal flow\n";
     auto Src = Edge.first;
     auto Dst = Edge.second;
     llvm::outs() << "Src: " << llvmIRToString(Src) << '\n';
     llvm::outs() << "Dst: " << llvmIRToString(Dst) << '\n';
-    std::unordered_map<CallStringCTX<n_t, K>, mono_container_t> Out;
-    for (auto &[Ctx, Facts] : Analysis[Src]) {
-      Out[Ctx] = IMProblem.normalFlow(Src, Analysis[Src][Ctx]);
+    for (ContextId Ctx : getContextsOf(Src)) {
+      auto Out = IMProblem.normalFlow(Src, getFacts(Src, Ctx));
       // need to merge if Dst is a branch target
       if (ICF->isBranchTarget(Src, Dst)) {
         llvm::outs() << "Num preds: " << ICF->getPredsOf(Dst).size() << '\n';
@@ -193,27 +245,25 @@ public:
             // out set of Src on-the-fly as we do not have a dedicated
             // storage for merge points (otherwise we run into trouble with
             // merge operator such as set union)
-            auto OtherPredOut = IMProblem.normalFlow(Pred, Analysis[Pred][Ctx]);
-            Out[Ctx] = IMProblem.merge(Out[Ctx], OtherPredOut);
+            auto OtherPredOut = IMProblem.normalFlow(Pred, getFacts(Pred, Ctx));
+            Out = IMProblem.merge(Out, OtherPredOut);
           }
         }
       }
       // Check if data-flow facts have changed and if so, add Edge(s) to
       // worklist again.
       llvm::outs() << "\nNormal Out[Ctx]:\n";
-      IMProblem.printContainer(llvm::outs(), Out[Ctx]);
+      IMProblem.printContainer(llvm::outs(), Out);
       llvm::outs() << "\nAnalysis[Dst][Ctx]:\n";
-      IMProblem.printContainer(llvm::outs(), Analysis[Dst][Ctx]);
-      bool FlowFactStabilized =
-          IMProblem.equal_to(Out[Ctx], Analysis[Dst][Ctx]);
+      IMProblem.printContainer(llvm::outs(), getFacts(Dst, Ctx));
+      bool FlowFactStabilized = IMProblem.equal_to(Out, getFacts(Dst, Ctx));
       if (!FlowFactStabilized) {
         llvm::outs() << "\nNormal stabilized? --> " << FlowFactStabilized
                      << '\n';
-        auto Merged = Out[Ctx];
         llvm::outs() << "Normal merged:\n";
-        IMProblem.printContainer(llvm::outs(), Merged);
+        IMProblem.printContainer(llvm::outs(), Out);
         llvm::outs() << '\n';
-        Analysis[Dst][Ctx] = Merged;
+        getFacts(Dst, Ctx) = std::move(Out);
         addToWorklist({Src, Dst});
       }
     }
@@ -222,32 +272,28 @@ public:
   void processCall(std::pair<n_t, n_t> Edge) {
     auto Src = Edge.first;
     auto Dst = Edge.second;
-    std::unordered_map<CallStringCTX<n_t, K>, mono_container_t> Out;
     if (!isIntraEdge(Edge)) {
       llvm::outs() << "Handle call flow\n";
       llvm::outs() << "Src: " << llvmIRToString(Src) << '\n';
       llvm::outs() << "Dst: " << llvmIRToString(Dst) << '\n';
-      for (auto &[Ctx, Facts] : Analysis[Src]) {
-        auto CTXAdd(Ctx);
-        CTXAdd.push_back(Src);
-        Out[CTXAdd] = IMProblem.callFlow(Src, ICF->getFunctionOf(Dst),
-                                         Analysis[Src][Ctx]);
+      for (ContextId Ctx : getContextsOf(Src)) {
+        ContextId CTXAdd = Contexts.push(Ctx, Src);
+        auto Out = IMProblem.callFlow(Src, ICF->getFunctionOf(Dst),
+                                      getFacts(Src, Ctx));
         bool FlowFactStabilized =
-            IMProblem.equal_to(Out[CTXAdd], Analysis[Dst][CTXAdd]);
+            IMProblem.equal_to(Out, getFacts(Dst, CTXAdd));
         llvm::outs() << "Call Out[CTXAdd]:\n";
-        IMProblem.printContainer(llvm::outs(), Out[CTXAdd]);
+        IMProblem.printContainer(llvm::outs(), Out);
         llvm::outs() << '\n';
         llvm::outs() << "Call Analysis[Dst][CTXAdd]:\n";
-        IMProblem.printContainer(llvm::outs(), Analysis[Dst][CTXAdd]);
+        IMProblem.printContainer(llvm::outs(), getFacts(Dst, CTXAdd));
         llvm::outs() << '\n';
         llvm::outs() << "Call stabilized? --> " << FlowFactStabilized << '\n';
         if (!FlowFactStabilized) {
-          // auto merge = IMProblem.merge(Analysis[Dst][CTXAdd], Out[CTXAdd]);
-          auto Merge = Out[CTXAdd];
           llvm::outs() << "Call merge:\n";
-          IMProblem.printContainer(llvm::outs(), Merge);
+          IMProblem.printContainer(llvm::outs(), Out);
           llvm::outs() << '\n';
-          Analysis[Dst][CTXAdd] = Merge;
+          getFacts(Dst, CTXAdd) = std::move(Out);
           addToWorklist({Src, Dst});
         }
       }
@@ -256,27 +302,24 @@ public:
       llvm::outs() << "Handle call to ret flow\n";
       llvm::outs() << "Src: " << llvmIRToString(Src) << '\n';
       llvm::outs() << "Dst: " << llvmIRToString(Dst) << '\n';
-      for (auto &[Ctx, Facts] : Analysis[Src]) {
+      for (ContextId Ctx : getContextsOf(Src)) {
         // call-to-ret flow does not modify contexts
-        Out[Ctx] = IMProblem.callToRetFlow(
-            Src, Dst, ICF->getCalleesOfCallAt(Src), Analysis[Src][Ctx]);
-        bool FlowFactStabilized =
-            IMProblem.equal_to(Out[Ctx], Analysis[Dst][Ctx]);
+        auto Out = IMProblem.callToRetFlow(
+            Src, Dst, ICF->getCalleesOfCallAt(Src), getFacts(Src, Ctx));
+        bool FlowFactStabilized = IMProblem.equal_to(Out, getFacts(Dst, Ctx));
         llvm::outs() << "Call to ret stabilized? --> " << FlowFactStabilized
                      << '\n';
         llvm::outs() << "Call Out[Ctx]:\n";
-        IMProblem.printContainer(llvm::outs(), Out[Ctx]);
+        IMProblem.printContainer(llvm::outs(), Out);
         llvm::outs() << '\n';
         llvm::outs() << "Call Analysis[Dst][CTX]:\n";
-        IMProblem.printContainer(llvm::outs(), Analysis[Dst][Ctx]);
+        IMProblem.printContainer(llvm::outs(), getFacts(Dst, Ctx));
         llvm::outs() << '\n';
         if (!FlowFactStabilized) {
-          auto Merge = Out[Ctx];
           llvm::outs() << "Call to ret merge:\n";
-          IMProblem.printContainer(llvm::outs(), Merge);
+          IMProblem.printContainer(llvm::outs(), Out);
           llvm::outs() << '\n';
-          Analysis[Dst][Ctx] =
-              Merge; // IMProblem.merge(Analysis[Dst][Ctx], Out[Ctx]);
+          getFacts(Dst, Ctx) = std::move(Out);
           addToWorklist({Src, Dst});
         }
       }
@@ -286,54 +329,61 @@ public:
   void processExit(std::pair<n_t, n_t> Edge) {
     auto Src = Edge.first;
     auto Dst = Edge.second;
-    std::unordered_map<CallStringCTX<n_t, K>, mono_container_t> Out;
+    // distinct contexts may lead to the same context after the return
+    llvm::DenseMap<ContextId, mono_container_t> Out;
     llvm::outs() << "\nHandle ret flow in: "
                  << ICF->getFunctionName(ICF->getFunctionOf(Src)) << '\n';
     llvm::outs() << "Src: " << llvmIRToString(Src) << '\n';
     llvm::outs() << "Dst: " << llvmIRToString(Dst) << '\n';
-    for (auto &[Ctx, Facts] : Analysis[Src]) {
-      auto CTXRm(Ctx);
-      llvm::outs() << "CTXRm: " << CTXRm << '\n';
+    for (ContextId Ctx : getContextsOf(Src)) {
+      ContextId CTXRm = Ctx;
+      llvm::outs() << "CTXRm: ";
+      Contexts.print(llvm::outs(), CTXRm);
+      llvm::outs() << '\n';
       // we need to use several call- and retsites if the context is empty
       std::set<n_t> CallSites;
       std::set<n_t> RetSites;
       // handle empty context
-      if (Ctx.empty()) {
+      if (Ctx == ContextTreeTy::EmptyContext) {
         CallSites = ICF->getCallersOf(ICF->getFunctionOf(Src));
       } else {
         // handle context containing at least one element
-        CallSites.insert(CTXRm.pop_back());
+        auto [Parent, CallSite] = Contexts.pop(Ctx);
+        CTXRm = Parent;
+        CallSites.insert(CallSite);
       }
       // retrieve the possible return sites for each call
       for (auto CallSite : CallSites) {
         auto RetSitesPerCall = ICF->getReturnSitesOfCallAt(CallSite);
         RetSites.insert(RetSitesPerCall.begin(), RetSitesPerCall.end());
       }
+      auto &OutFacts =
+          Out.try_emplace(CTXRm, IMProblem.allTop()).first->second;
       for (auto CallSite : CallSites) {
         auto RetFactsPerCall = IMProblem.returnFlow(
-            CallSite, ICF->getFunctionOf(Src), Src, Dst, Analysis[Src][Ctx]);
-        Out[CTXRm].insert(RetFactsPerCall.begin(), RetFactsPerCall.end());
+            CallSite, ICF->getFunctionOf(Src), Src, Dst, getFacts(Src, Ctx));
+        OutFacts.insert(RetFactsPerCall.begin(), RetFactsPerCall.end());
       }
       // TODO!
       llvm::outs() << "ResSites.size(): " << RetSites.size() << '\n';
       for (auto RetSite : RetSites) {
         llvm::outs() << "RetSite: " << llvmIRToString(RetSite) << '\n';
         llvm::outs() << "Return facts: ";
-        IMProblem.printContainer(llvm::outs(), Out[CTXRm]);
+        IMProblem.printContainer(llvm::outs(), OutFacts);
         llvm::outs() << '\n';
         llvm::outs() << "RetSite facts: ";
-        IMProblem.printContainer(llvm::outs(), Analysis[RetSite][CTXRm]);
+        IMProblem.printContainer(llvm::outs(), getFacts(RetSite, CTXRm));
         llvm::outs() << '\n';
         bool FlowFactStabilized =
-            IMProblem.equal_to(Out[CTXRm], Analysis[RetSite][CTXRm]);
+            IMProblem.equal_to(OutFacts, getFacts(RetSite, CTXRm));
         llvm::outs() << "Ret stabilized? --> " << FlowFactStabilized << '\n';
         if (!FlowFactStabilized) {
-          mono_container_t Merge;
-          Merge.insert(Analysis[RetSite][CTXRm].begin(),
-                       Analysis[RetSite][CTXRm].end());
-          Merge.insert(Out[CTXRm].begin(), Out[CTXRm].end());
-          Analysis[RetSite][CTXRm] = Merge;
-          Analysis[Dst][CTXRm] = Merge;
+          // copy the facts of the return site, such that the merged facts
+          // share its state, e.g. the domain of a BitVectorSet
+          auto Merge = getFacts(RetSite, CTXRm);
+          Merge.insert(OutFacts.begin(), OutFacts.end());
+          getFacts(RetSite, CTXRm) = Merge;
+          getFacts(Dst, CTXRm) = Merge;
           // IMProblem.merge(Analysis[RetSite][CTXRm], Out[CTXRm]);
           llvm::outs() << "Merged to: ";
           IMProblem.printContainer(llvm::outs(), Merge);
@@ -358,8 +408,7 @@ public:
   virtual void solve() {
     initialize();
     while (!Worklist.empty()) {
-      std::pair<n_t, n_t> Edge = Worklist.front();
-      Worklist.pop_front();
+      std::pair<n_t, n_t> Edge = Worklist.pop();
       auto Src = Edge.first;
       auto Dst = Edge.second;
       if (ICF->isCallSite(Src)) {
@@ -370,7 +419,7 @@ public:
         // Handle call flow(s)
         if (!isIntraEdge(Edge)) {
           // real call
-          for (auto &[Ctx, Facts] : Analysis[Src]) {
+          for (size_t I = 0, E = getContextsOf(Src).size(); I < E; ++I) {
             processCall(Edge); // TODO: decompose into processCall and
                                // processCallToRet
           }
@@ -390,8 +439,9 @@ public:
   }
 
   mono_container_t getResultsAt(n_t Stmt) {
-    mono_container_t Result;
-    for (auto &[Ctx, Facts] : Analysis[Stmt]) {
+    auto Result = IMProblem.allTop();
+    for (ContextId Ctx : getContextsOf(Stmt)) {
+      const auto &Facts = getFacts(Stmt, Ctx);
       Result.insert(Facts.begin(), Facts.end());
     }
     return Result;
@@ -399,14 +449,16 @@ public:
 
   virtual void dumpResults(llvm::raw_ostream &OS = llvm::outs()) {
     OS << "======= DUMP LLVM-INTER-MONOTONE-SOLVER RESULTS =======\n";
-    for (auto &[Node, ContextMap] : this->Analysis) {
+    for (const auto &[Node, Ctxs] : ContextsOf) {
       OS << "Instruction:\n" << this->IMProblem.NtoString(Node);
       OS << "\nFacts:\n";
-      if (ContextMap.empty()) {
+      if (Ctxs.empty()) {
         OS << "\tEMPTY\n";
       } else {
-        for (auto &[Context, FlowFacts] : ContextMap) {
-          OS << Context << '\n';
+        for (ContextId Ctx : Ctxs) {
+          const auto &FlowFacts = Analysis[AnalysisIds.lookup({Node, Ctx})];
+          Contexts.print(OS, Ctx);
+          OS << '\n';
           if (FlowFacts.empty()) {
             OS << "\tEMPTY\n";
           } else {
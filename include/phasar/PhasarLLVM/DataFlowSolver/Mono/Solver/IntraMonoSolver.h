@@ -17,12 +17,12 @@
 #ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_MONO_SOLVER_INTRAMONOSOLVER_H
 #define PHASAR_PHASARLLVM_DATAFLOWSOLVER_MONO_SOLVER_INTRAMONOSOLVER_H
 
-#include <deque>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/IntraMonoProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/MonoWorklist.h"
 #include "phasar/Utils/BitVectorSet.h"
 
 namespace psr {
@@ -41,9 +41,21 @@ public:
 
 protected:
   ProblemTy &IMProblem;
-  std::deque<std::pair<n_t, n_t>> Worklist;
-  std::unordered_map<n_t, mono_container_t> Analysis;
   const c_t *CFG;
+  MonoWorklist<n_t, f_t, c_t> Worklist;
+  std::unordered_map<n_t, mono_container_t> Analysis;
+
+  /// Returns the data-flow facts that hold at Node and creates them from the
+  /// problem's top element if there are none yet. Containers must not be
+  /// default constructed, as they may have to share state with the problem's
+  /// containers, e.g. the domain of a BitVectorSet.
+  mono_container_t &getFacts(n_t Node) {
+    auto Search = Analysis.find(Node);
+    if (Search == Analysis.end()) {
+      Search = Analysis.emplace(Node, IMProblem.allTop()).first;
+    }
+    return Search->second;
+  }
 
   void initialize() {
     auto EntryPoints = IMProblem.getEntryPoints();
@@ -52,8 +64,7 @@ protected:
           IMProblem.getProjectIRDB()->getFunctionDefinition(EntryPoint);
       auto ControlFlowEdges = CFG->getAllControlFlowEdges(Function);
       // add all intra-procedural edges to the worklist
-      Worklist.insert(Worklist.begin(), ControlFlowEdges.begin(),
-                      ControlFlowEdges.end());
+      Worklist.pushFront(ControlFlowEdges.begin(), ControlFlowEdges.end());
       // set all analysis information to the empty set
       for (auto Insts : CFG->getAllInstructionsOf(Function)) {
         Analysis.insert(std::make_pair(Insts, IMProblem.allTop()));
@@ -61,12 +72,15 @@ protected:
     }
     // insert initial seeds
     for (auto &[Node, FlowFacts] : IMProblem.initialSeeds()) {
-      Analysis[Node].insert(FlowFacts.begin(), FlowFacts.end());
+      getFacts(Node).insert(FlowFacts.begin(), FlowFacts.end());
     }
   }
 
 public:
-  IntraMonoSolver(ProblemTy &IMP) : IMProblem(IMP), CFG(IMP.getCFG()) {}
+  IntraMonoSolver(
+      ProblemTy &IMP,
+      MonoWorklistStrategy Strategy = MonoWorklistStrategy::ReversePostOrder)
+      : IMProblem(IMP), CFG(IMP.getCFG()), Worklist(CFG, Strategy) {}
 
   virtual ~IntraMonoSolver() = default;
 
@@ -76,11 +90,10 @@ public:
     // step 2: Iteration (updating Worklist and Analysis)
     while (!Worklist.empty()) {
       // llvm::outs() << "worklist size: " << Worklist.size() << "\n";
-      std::pair<n_t, n_t> Edge = Worklist.front();
-      Worklist.pop_front();
+      std::pair<n_t, n_t> Edge = Worklist.pop();
       n_t Src = Edge.first;
       n_t Dst = Edge.second;
-      auto Out = IMProblem.normalFlow(Src, Analysis[Src]);
+      auto Out = IMProblem.normalFlow(Src, getFacts(Src));
       // need to merge if Dst is a branch target
       if (CFG->isBranchTarget(Src, Dst)) {
         for (auto Pred : CFG->getPredsOf(Dst)) {
@@ -89,15 +102,15 @@ public:
             // set of Src on-the-fly as we do not have a dedicated storage for
             // merge points (otherwise we run into trouble with merge operator
             // such as set union)
-            auto OtherPredOut = IMProblem.normalFlow(Pred, Analysis[Pred]);
+            auto OtherPredOut = IMProblem.normalFlow(Pred, getFacts(Pred));
             Out = IMProblem.merge(Out, OtherPredOut);
           }
         }
       }
-      if (!IMProblem.equal_to(Out, Analysis[Dst])) {
-        Analysis[Dst] = Out;
+      if (auto &DstFacts = getFacts(Dst); !IMProblem.equal_to(Out, DstFacts)) {
+        DstFacts = Out;
         for (auto Nprimeprime : CFG->getSuccsOf(Dst)) {
-          Worklist.push_back({Dst, Nprimeprime});
+          Worklist.push({Dst, Nprimeprime});
         }
       }
     }
@@ -109,7 +122,7 @@ public:
     }
   }
 
-  mono_container_t getResultsAt(n_t Stmt) { return Analysis[Stmt]; }
+  mono_container_t getResultsAt(n_t Stmt) { return getFacts(Stmt); }
 
   virtual void dumpResults(llvm::raw_ostream &OS = llvm::outs()) {
     OS << "Intra-Monotone solver results:\n"
@@ -0,0 +1,291 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_MONO_SOLVER_MONOWORKLIST_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_MONO_SOLVER_MONOWORKLIST_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/DenseSet.h"
+
+#include "phasar/PhasarLLVM/ControlFlow/ICFG.h"
+
+namespace psr {
+
+/// Determines the order in which the monotone solvers process the
+/// control-flow edges that are pending in their worklists.
+enum class MonoWorklistStrategy {
+  /// Edges are processed in the order in which they have been added.
+  FIFO,
+  /// Edges are prioritized by their target instruction: first by the
+  /// strongly connected component of the target's function in the call graph
+  /// (callers before callees, only for inter-procedural solvers) and then by
+  /// the reverse-postorder of the target in its function's control-flow
+  /// graph. Hence, the facts of a loop body are stabilized before they are
+  /// propagated past the loop.
+  ReversePostOrder
+};
+
+/// Holds the control-flow edges that the IntraMonoSolver or InterMonoSolver
+/// still has to process. An edge that is already pending is not added a
+/// second time: when it is processed, the most recent facts of its source are
+/// used anyway.
+///
+/// G is either a CFG or an ICFG; in the latter case, the functions are
+/// ordered according to the call graph as well. All ranks are computed lazily
+/// on a per-function basis.
+template <typename N, typename F, typename G> class MonoWorklist {
+public:
+  using n_t = N;
+  using f_t = F;
+  using EdgeTy = std::pair<n_t, n_t>;
+
+  MonoWorklist(const G *Graph, MonoWorklistStrategy Strategy)
+      : Graph(Graph), Strategy(Strategy) {}
+
+  ~MonoWorklist() = default;
+
+  MonoWorklist(const MonoWorklist &) = delete;
+  MonoWorklist &operator=(const MonoWorklist &) = delete;
+  MonoWorklist(MonoWorklist &&) noexcept = default;
+  MonoWorklist &operator=(MonoWorklist &&) noexcept = default;
+
+  /// Adds Edge unless it is already pending. Returns true if Edge was added.
+  bool push(EdgeTy Edge) {
+    if (!Pending.insert(Edge).second) {
+      return false;
+    }
+    if (Strategy == MonoWorklistStrategy::ReversePostOrder) {
+      PriorityQueue.push({getPriority(Edge.second), Sequence++, Edge});
+    } else {
+      Queue.push_back(Edge);
+    }
+    return true;
+  }
+
+  /// Adds the edges in [First, Last). With the FIFO strategy, they are
+  /// processed before all edges that are already pending.
+  template <typename InputIt> void pushFront(InputIt First, InputIt Last) {
+    if (Strategy == MonoWorklistStrategy::ReversePostOrder) {
+      for (; First != Last; ++First) {
+        push(*First);
+      }
+      return;
+    }
+    std::vector<EdgeTy> Fresh;
+    for (; First != Last; ++First) {
+      if (Pending.insert(*First).second) {
+        Fresh.push_back(*First);
+      }
+    }
+    Queue.insert(Queue.begin(), Fresh.begin(), Fresh.end());
+  }
+
+  [[nodiscard]] EdgeTy pop() {
+    assert(!empty() && "Cannot pop from an empty worklist!");
+    EdgeTy Edge;
+    if (Strategy == MonoWorklistStrategy::ReversePostOrder) {
+      Edge = PriorityQueue.top().Edge;
+      PriorityQueue.pop();
+    } else {
+      Edge = Queue.front();
+      Queue.pop_front();
+    }
+    Pending.erase(Edge);
+    return Edge;
+  }
+
+  [[nodiscard]] bool empty() const { return Pending.empty(); }
+
+  [[nodiscard]] size_t size() const { return Pending.size(); }
+
+  [[nodiscard]] MonoWorklistStrategy getStrategy() const { return Strategy; }
+
+  /// Returns the pending edges in an unspecified order.
+  [[nodiscard]] std::vector<EdgeTy> getPendingEdges() const {
+    return {Pending.begin(), Pending.end()};
+  }
+
+private:
+  struct PrioritizedEdge {
+    uint64_t Priority;
+    uint64_t Seq;
+    EdgeTy Edge;
+
+    friend bool operator>(const PrioritizedEdge &Lhs,
+                          const PrioritizedEdge &Rhs) {
+      // Ties are broken in insertion order to keep the solver deterministic.
+      return Lhs.Priority > Rhs.Priority ||
+             (Lhs.Priority == Rhs.Priority && Lhs.Seq > Rhs.Seq);
+    }
+  };
+
+  static constexpr uint32_t Unreachable = std::numeric_limits<uint32_t>::max();
+
+  static constexpr bool IsInterprocedural =
+      std::is_base_of_v<ICFG<n_t, f_t>, G>;
+
+  uint64_t getPriority(n_t Inst) {
+    f_t Fun = Graph->getFunctionOf(Inst);
+    auto FunSearch = FunRank.find(Fun);
+    if (FunSearch == FunRank.end()) {
+      rankFunction(Fun);
+      FunSearch = FunRank.find(Fun);
+    }
+    // A function may have been ranked as a callee of another function, which
+    // does not rank its instructions
+    if (RankedInstsOf.insert(Fun).second) {
+      rankInstructions(Fun);
+    }
+    auto Search = InstRank.find(Inst);
+    if (Search == InstRank.end()) {
+      // Instructions that are unreachable from the function's start points
+      // are scheduled last.
+      Search = InstRank.try_emplace(Inst, Unreachable).first;
+    }
+    return (static_cast<uint64_t>(FunSearch->second) << 32) | Search->second;
+  }
+
+  void rankFunction(f_t Fun) {
+    if constexpr (IsInterprocedural) {
+      rankSCCsFrom(Fun);
+    } else {
+      FunRank[Fun] = static_cast<uint32_t>(FunRank.size());
+    }
+  }
+
+  /// Computes the strongly connected components of the part of the call graph
+  /// that is reachable from Root and has not been ranked so far (Tarjan's
+  /// algorithm, iteratively). Tarjan completes the components in reverse
+  /// topological order, hence the components that are completed later are
+  /// ranked lower, i.e. scheduled earlier.
+  void rankSCCsFrom(f_t Root) {
+    struct Frame {
+      f_t Fun;
+      std::vector<f_t> Callees;
+    };
+    std::unordered_map<f_t, uint32_t> Index;
+    std::unordered_map<f_t, uint32_t> LowLink;
+    std::unordered_set<f_t> OnStack;
+    std::vector<f_t> SCCStack;
+    std::vector<Frame> CallStack;
+    uint32_t NextIndex = 0;
+
+    auto Visit = [&](f_t Fun) {
+      Index[Fun] = LowLink[Fun] = NextIndex++;
+      SCCStack.push_back(Fun);
+      OnStack.insert(Fun);
+      CallStack.push_back({Fun, getCallees(Fun)});
+    };
+
+    Visit(Root);
+    while (!CallStack.empty()) {
+      auto &Top = CallStack.back();
+      if (!Top.Callees.empty()) {
+        f_t Callee = Top.Callees.back();
+        Top.Callees.pop_back();
+        if (FunRank.count(Callee)) {
+          // belongs to a component that has been ranked before
+          continue;
+        }
+        if (!Index.count(Callee)) {
+          Visit(Callee);
+        } else if (OnStack.count(Callee)) {
+          LowLink[Top.Fun] = std::min(LowLink[Top.Fun], Index[Callee]);
+        }
+        continue;
+      }
+      f_t Fun = Top.Fun;
+      CallStack.pop_back();
+      if (!CallStack.empty()) {
+        f_t Caller = CallStack.back().Fun;
+        LowLink[Caller] = std::min(LowLink[Caller], LowLink[Fun]);
+      }
+      if (LowLink[Fun] == Index[Fun]) {
+        uint32_t Rank = NextSCCRank--;
+        f_t Member;
+        do {
+          Member = SCCStack.back();
+          SCCStack.pop_back();
+          OnStack.erase(Member);
+          FunRank[Member] = Rank;
+        } while (Member != Fun);
+      }
+    }
+  }
+
+  std::vector<f_t> getCallees(f_t Caller) const {
+    std::vector<f_t> Callees;
+    for (n_t CS : Graph->getCallsFromWithin(Caller)) {
+      for (f_t Callee : Graph->getCalleesOfCallAt(CS)) {
+        Callees.push_back(Callee);
+      }
+    }
+    return Callees;
+  }
+
+  /// Computes the reverse-postorder of Fun's instructions.
+  void rankInstructions(f_t Fun) {
+    std::vector<n_t> PostOrder;
+    std::unordered_set<n_t> Visited;
+    std::vector<std::pair<n_t, std::vector<n_t>>> Stack;
+    for (n_t SP : Graph->getStartPointsOf(Fun)) {
+      if (!Visited.insert(SP).second) {
+        continue;
+      }
+      Stack.emplace_back(SP, Graph->getSuccsOf(SP));
+      while (!Stack.empty()) {
+        auto &[Inst, Succs] = Stack.back();
+        if (Succs.empty()) {
+          PostOrder.push_back(Inst);
+          Stack.pop_back();
+          continue;
+        }
+        n_t Succ = Succs.back();
+        Succs.pop_back();
+        if (Visited.insert(Succ).second) {
+          Stack.emplace_back(Succ, Graph->getSuccsOf(Succ));
+        }
+      }
+    }
+    uint32_t Rank = 0;
+    for (auto It = PostOrder.rbegin(); It != PostOrder.rend(); ++It) {
+      InstRank[*It] = Rank++;
+    }
+  }
+
+  const G *Graph;
+  MonoWorklistStrategy Strategy;
+  std::deque<EdgeTy> Queue;
+  std::priority_queue<PrioritizedEdge, std::vector<PrioritizedEdge>,
+                      std::greater<PrioritizedEdge>>
+      PriorityQueue;
+  llvm::DenseSet<EdgeTy> Pending;
+  std::unordered_map<n_t, uint32_t> InstRank;
+  std::unordered_map<f_t, uint32_t> FunRank;
+  /// The functions whose instructions have been ranked in InstRank
+  std::unordered_set<f_t> RankedInstsOf;
+  uint32_t NextSCCRank = std::numeric_limits<uint32_t>::max() - 1;
+  uint64_t Sequence = 0;
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,357 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_SYNCPDS_SOLVER_PDSSOLVER_H
+#define PHASAR_PHASARLLVM_DATAFLOWSOLVER_SYNCPDS_SOLVER_PDSSOLVER_H
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+
+namespace psr {
+
+/// The effect of a rule of a pushdown system on a stack whose top symbol is
+/// g:
+///  - Normal: g is left unchanged,
+///  - Push: Symbol is pushed onto g,
+///  - Pop: g is popped, only applies if g = Symbol,
+///  - PopOrBottom: like Pop, but also applies to the bottom of the stack,
+///    which is kept, i.e., an unbalanced pop.
+template <typename SymbolTy> struct PDSStackAction {
+  enum class KindTy { Normal, Push, Pop, PopOrBottom };
+
+  KindTy Kind = KindTy::Normal;
+  SymbolTy Symbol{};
+};
+
+/// A rule <P, c, f> -> <Target, c', f'> of two synchronized pushdown systems
+/// that share their control states, e.g., a call-stack and a field-stack
+/// pushdown system.
+template <typename StateTy, typename CallSymbolTy, typename FieldSymbolTy>
+struct SyncPDSRule {
+  StateTy Target{};
+  PDSStackAction<CallSymbolTy> Call{};
+  PDSStackAction<FieldSymbolTy> Field{};
+};
+
+/// Computes the configurations <P, c, f> of two synchronized pushdown systems
+/// that are reachable from a set of initial configurations <P, Bottom,
+/// Bottom>, where c is the call stack and f the field stack, along paths that
+/// are valid in both systems.
+///
+/// As in the post* saturation procedure of Schwoon, the stacks are
+/// represented by automata whose states below the top of a stack are the
+/// intermediate states q_{P, g} of the push rules to P. A synchronized
+/// configuration consists of a control state and the pair of the top
+/// transitions of both stacks, i.e., the top symbol and the automaton state
+/// the rest of the stack starts at. Pops continue with all transitions
+/// leaving that state, including the ones that are added later. The
+/// configurations are thus tracked pairwise and, unlike two systems that are
+/// only synchronized on their control states, a control state is only reached
+/// with an empty field stack if it is reached with a matching call stack
+/// along the same path. Two paths only mix at the intermediate states of a
+/// push rule they share. The number of configurations remains finite, as
+/// there are finitely many intermediate states.
+///
+/// The rules are added on demand, e.g., once a control state has been
+/// reached (see setReachedListener()). A rule applies to all configurations
+/// of its control state, including the ones that have been reached before
+/// the rule has been added, such that rules and initial states can be added
+/// at any time until solve() returns.
+template <typename StateTy, typename CallSymbolTy, typename FieldSymbolTy>
+class SynchronizedPDSSolver {
+public:
+  using RuleTy = SyncPDSRule<StateTy, CallSymbolTy, FieldSymbolTy>;
+  using CallActionTy = PDSStackAction<CallSymbolTy>;
+  using FieldActionTy = PDSStackAction<FieldSymbolTy>;
+
+  SynchronizedPDSSolver(CallSymbolTy CallBottom, FieldSymbolTy FieldBottom)
+      : CallStacks(CallBottom), FieldStacks(FieldBottom) {}
+
+  /// Adds the initial configuration <P, Bottom, Bottom>.
+  void addInitialState(StateTy P) {
+    addConfiguration({P, CallStacks.Bottom, FinalState, FieldStacks.Bottom,
+                      FinalState});
+  }
+
+  void addRule(StateTy From, const RuleTy &Rule) {
+    auto &Node = Nodes[From];
+    Node.Rules.push_back(Rule);
+    // Configurations reached from here on are handled by the work list
+    for (size_t I = 0, End = Node.Configurations.size(); I < End; ++I) {
+      // copy, applying the rule may add configurations
+      auto Config = Nodes[From].Configurations[I];
+      applyRule(Rule, Config);
+    }
+  }
+
+  /// Adds configurations until no more rule applies.
+  void solve() {
+    while (!WorkList.empty()) {
+      auto Config = WorkList.back();
+      WorkList.pop_back();
+      const auto &From = std::get<0>(Config);
+      for (size_t I = 0; I < Nodes[From].Rules.size(); ++I) {
+        // copy, applying the rule may add control states
+        RuleTy Rule = Nodes[From].Rules[I];
+        applyRule(Rule, Config);
+      }
+    }
+  }
+
+  [[nodiscard]] bool hasPendingConfigurations() const noexcept {
+    return !WorkList.empty();
+  }
+
+  /// Returns true if a configuration <P, c, f> is reachable.
+  [[nodiscard]] bool isReached(StateTy P) const {
+    auto It = Nodes.find(P);
+    return It != Nodes.end() && !It->second.Configurations.empty();
+  }
+
+  /// Returns true if a configuration <P, c, Bottom> is reachable.
+  [[nodiscard]] bool isReachedWithEmptyFieldStack(StateTy P) const {
+    auto It = Nodes.find(P);
+    return It != Nodes.end() && It->second.ReachedWithEmptyFieldStack;
+  }
+
+  /// Sets a function that is called whenever a control state is reached for
+  /// the first time. The listener must not modify this solver.
+  void setReachedListener(std::function<void(StateTy)> Listener) {
+    ReachedListener = std::move(Listener);
+  }
+
+  [[nodiscard]] size_t getNumConfigurations() const noexcept {
+    return Configurations.size();
+  }
+
+private:
+  /// <P, top of the call stack, its rest, top of the field stack, its rest>
+  using ConfigurationTy =
+      std::tuple<StateTy, CallSymbolTy, unsigned, FieldSymbolTy, unsigned>;
+
+  /// The automaton representing the stacks of one of the pushdown systems.
+  /// Its states are the final state, i.e., the bottom of the stack, and the
+  /// intermediate states of the push rules.
+  template <typename SymbolTy> struct StackAutomaton {
+    /// A stack whose top symbol is known or which continues with any
+    /// transition leaving a state, after a pop.
+    struct TopTy {
+      SymbolTy Symbol{};
+      unsigned Rest = FinalState;
+      bool Popped = false;
+    };
+
+    explicit StackAutomaton(SymbolTy Bottom)
+        : Bottom(Bottom), Out(1), Continuations(1) {}
+
+    unsigned getIntermediateState(StateTy P, SymbolTy Symbol) {
+      auto [It, Inserted] =
+          IntermediateStates.try_emplace({P, Symbol}, Out.size());
+      if (Inserted) {
+        Out.emplace_back();
+        Continuations.emplace_back();
+      }
+      return It->second;
+    }
+
+    /// Returns false if the transition already exists.
+    bool addTransition(unsigned Q, SymbolTy Symbol, unsigned R) {
+      if (!Transitions.insert({Q, Symbol, R}).second) {
+        return false;
+      }
+      Out[Q].emplace_back(Symbol, R);
+      return true;
+    }
+
+    /// Returns the top of the stack after applying Action of a rule to Target
+    /// to a stack with the top Symbol whose rest starts at Rest, or
+    /// std::nullopt if the action does not apply.
+    template <typename AddTransitionFn>
+    std::optional<TopTy> apply(const PDSStackAction<SymbolTy> &Action,
+                               StateTy Target, SymbolTy Symbol, unsigned Rest,
+                               AddTransitionFn AddTransition) {
+      using KindTy = typename PDSStackAction<SymbolTy>::KindTy;
+      switch (Action.Kind) {
+      case KindTy::Normal:
+        return TopTy{Symbol, Rest};
+      case KindTy::Push: {
+        unsigned Intermediate = getIntermediateState(Target, Action.Symbol);
+        AddTransition(Intermediate, Symbol, Rest);
+        return TopTy{Action.Symbol, Intermediate};
+      }
+      case KindTy::PopOrBottom:
+        if (Symbol == Bottom) {
+          return TopTy{Bottom, Rest};
+        }
+        [[fallthrough]];
+      case KindTy::Pop:
+        if (Symbol == Action.Symbol) {
+          return TopTy{SymbolTy{}, Rest, true};
+        }
+        break;
+      }
+      return std::nullopt;
+    }
+
+    /// Returns the possible tops of a stack, one per transition leaving the
+    /// state of a popped one.
+    [[nodiscard]] llvm::SmallVector<std::pair<SymbolTy, unsigned>, 2>
+    getTops(const TopTy &Top) const {
+      if (!Top.Popped) {
+        return {{Top.Symbol, Top.Rest}};
+      }
+      return Out[Top.Rest];
+    }
+
+    SymbolTy Bottom;
+    std::vector<llvm::SmallVector<std::pair<SymbolTy, unsigned>, 2>> Out;
+    /// The pops that continue with the transitions leaving a state, indices
+    /// into SynchronizedPDSSolver::Continuations
+    std::vector<llvm::SmallVector<unsigned, 2>> Continuations;
+    llvm::DenseMap<std::pair<StateTy, SymbolTy>, unsigned> IntermediateStates;
+    llvm::DenseSet<std::tuple<unsigned, SymbolTy, unsigned>> Transitions;
+  };
+
+  using CallTopTy = typename StackAutomaton<CallSymbolTy>::TopTy;
+  using FieldTopTy = typename StackAutomaton<FieldSymbolTy>::TopTy;
+
+  /// The application of a rule that popped at least one of the stacks and
+  /// thus leads to a configuration per transition leaving the rest of that
+  /// stack.
+  struct ContinuationTy {
+    StateTy Target;
+    CallTopTy Call;
+    FieldTopTy Field;
+  };
+
+  struct NodeInfo {
+    std::vector<ConfigurationTy> Configurations;
+    std::vector<RuleTy> Rules;
+    bool ReachedWithEmptyFieldStack = false;
+  };
+
+  void addConfiguration(const ConfigurationTy &Config) {
+    if (!Configurations.insert(Config).second) {
+      return;
+    }
+    auto &Node = Nodes[std::get<0>(Config)];
+    bool FirstReached = Node.Configurations.empty();
+    Node.Configurations.push_back(Config);
+    if (std::get<3>(Config) == FieldStacks.Bottom) {
+      Node.ReachedWithEmptyFieldStack = true;
+    }
+    WorkList.push_back(Config);
+    if (FirstReached && ReachedListener) {
+      ReachedListener(std::get<0>(Config));
+    }
+  }
+
+  /// Adds the configurations of Continuation for all combinations of the
+  /// tops of its stacks.
+  void continueWith(const ContinuationTy &Continuation) {
+    for (auto [CallSymbol, CallRest] : CallStacks.getTops(Continuation.Call)) {
+      for (auto [FieldSymbol, FieldRest] :
+           FieldStacks.getTops(Continuation.Field)) {
+        addConfiguration({Continuation.Target, CallSymbol, CallRest,
+                          FieldSymbol, FieldRest});
+      }
+    }
+  }
+
+  /// Adds the configurations of the continuations that popped the call stack
+  /// to Q and continue with Symbol and R.
+  void addCallTransition(unsigned Q, CallSymbolTy Symbol, unsigned R) {
+    if (!CallStacks.addTransition(Q, Symbol, R)) {
+      return;
+    }
+    for (size_t I = 0; I < CallStacks.Continuations[Q].size(); ++I) {
+      auto Continuation = Continuations[CallStacks.Continuations[Q][I]];
+      Continuation.Call = {Symbol, R};
+      continueWith(Continuation);
+    }
+  }
+
+  /// Adds the configurations of the continuations that popped the field
+  /// stack to Q and continue with Symbol and R.
+  void addFieldTransition(unsigned Q, FieldSymbolTy Symbol, unsigned R) {
+    if (!FieldStacks.addTransition(Q, Symbol, R)) {
+      return;
+    }
+    for (size_t I = 0; I < FieldStacks.Continuations[Q].size(); ++I) {
+      auto Continuation = Continuations[FieldStacks.Continuations[Q][I]];
+      Continuation.Field = {Symbol, R};
+      continueWith(Continuation);
+    }
+  }
+
+  void applyRule(const RuleTy &Rule, const ConfigurationTy &Config) {
+    auto [From, CallSymbol, CallRest, FieldSymbol, FieldRest] = Config;
+    auto Call = CallStacks.apply(
+        Rule.Call, Rule.Target, CallSymbol, CallRest,
+        [this](unsigned Q, CallSymbolTy Symbol, unsigned R) {
+          addCallTransition(Q, Symbol, R);
+        });
+    if (!Call) {
+      return;
+    }
+    auto Field = FieldStacks.apply(
+        Rule.Field, Rule.Target, FieldSymbol, FieldRest,
+        [this](unsigned Q, FieldSymbolTy Symbol, unsigned R) {
+          addFieldTransition(Q, Symbol, R);
+        });
+    if (!Field) {
+      return;
+    }
+    ContinuationTy Continuation{Rule.Target, *Call, *Field};
+    if (Call->Popped || Field->Popped) {
+      // register every continuation once
+      if (!RegisteredContinuations
+               .insert({Rule.Target, Call->Symbol, Call->Rest,
+                        unsigned(Call->Popped), Field->Symbol, Field->Rest,
+                        unsigned(Field->Popped)})
+               .second) {
+        return;
+      }
+      unsigned Idx = Continuations.size();
+      Continuations.push_back(Continuation);
+      if (Call->Popped) {
+        CallStacks.Continuations[Call->Rest].push_back(Idx);
+      }
+      if (Field->Popped) {
+        FieldStacks.Continuations[Field->Rest].push_back(Idx);
+      }
+    }
+    continueWith(Continuation);
+  }
+
+  static constexpr unsigned FinalState = 0;
+
+  StackAutomaton<CallSymbolTy> CallStacks;
+  StackAutomaton<FieldSymbolTy> FieldStacks;
+  llvm::DenseMap<StateTy, NodeInfo> Nodes;
+  llvm::DenseSet<ConfigurationTy> Configurations;
+  std::vector<ContinuationTy> Continuations;
+  llvm::DenseSet<std::tuple<StateTy, CallSymbolTy, unsigned, unsigned,
+                            FieldSymbolTy, unsigned, unsigned>>
+      RegisteredContinuations;
+  std::vector<ConfigurationTy> WorkList;
+  std::function<void(StateTy)> ReachedListener;
+};
+
+} // namespace psr
+
+#endif
@@ -10,12 +10,184 @@
 #ifndef PHASAR_PHASARLLVM_DATAFLOWSOLVER_SYNCPDS_SOLVER_SYNCPDSSOLVER_H
 #define PHASAR_PHASARLLVM_DATAFLOWSOLVER_SYNCPDS_SOLVER_SYNCPDSSOLVER_H
 
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/PointerIntPair.h"
+
+#include "nlohmann/json.hpp"
+
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToInfo.h"
+#include "phasar/PhasarLLVM/Pointer/PointsToSetOwner.h"
+
+namespace llvm {
+class Instruction;
+class Type;
+class Value;
+} // namespace llvm
+
 namespace psr {
 
-class SyncPDSSolver {
-private:
+class LLVMBasedICFG;
+
+/// A demand-driven, context- and field-sensitive alias analysis based on
+/// synchronized pushdown systems (SPDS, Späth et al., POPL 2019).
+///
+/// A query for a pointer V searches backwards from V to the allocation sites
+/// V may point to and forwards from these allocation sites to all pointers
+/// that may point to the same objects. Calls and returns are matched by a
+/// call-stack pushdown system, loads, stores and field accesses by a
+/// field-stack pushdown system. Both systems share their control states, the
+/// pointers and the direction of the search, and are solved together, see
+/// SynchronizedPDSSolver: the configurations pair the states of both stacks,
+/// such that a pointer is only reached if it is reachable with a matching call
+/// stack and a matching field stack along the same path. A pointer is an alias
+/// of V if it is reached with an empty field stack.
+///
+/// The pointer assignment graph is built lazily and shared by all queries,
+/// and the results of all queries are memoized. The solver implements
+/// LLVMPointsToInfo, such that it can be used as the points-to information
+/// of an IDETabulationProblem, e.g., the IDETypeStateAnalysis, instead of a
+/// whole-program points-to analysis.
+class SyncPDSSolver : public LLVMPointsToInfo {
 public:
-  ~SyncPDSSolver() = default;
+  explicit SyncPDSSolver(const LLVMBasedICFG &ICF);
+
+  ~SyncPDSSolver() override = default;
+
+  SyncPDSSolver(const SyncPDSSolver &) = delete;
+  SyncPDSSolver &operator=(const SyncPDSSolver &) = delete;
+
+  /// Returns the pointers that may point to an object V may point to,
+  /// including V itself.
+  [[nodiscard]] PointsToSetPtrTy getAliasesOf(const llvm::Value *V);
+
+  /// Returns the allocation sites, i.e., allocas, global objects, calls to
+  /// heap allocating or unknown functions, and arguments of functions without
+  /// callers, of the objects V may point to.
+  [[nodiscard]] AllocationSiteSetPtrTy
+  getAllocationSitesOf(const llvm::Value *V);
+
+  /// Returns the number of queries that have been solved, i.e., that could
+  /// not be answered from the cache.
+  [[nodiscard]] size_t getNumQueries() const noexcept { return NumQueries; }
+
+  [[nodiscard]] bool isInterProcedural() const override { return true; }
+
+  /// Returns Invalid, the solver is none of LLVM's alias analyses.
+  [[nodiscard]] PointerAnalysisType getPointerAnalysistype() const override {
+    return PointerAnalysisType::Invalid;
+  }
+
+  [[nodiscard]] AliasResult
+  alias(const llvm::Value *V1, const llvm::Value *V2,
+        const llvm::Instruction *I = nullptr) override;
+
+  /// Returns the aliases of V, see getAliasesOf().
+  [[nodiscard]] PointsToSetPtrTy
+  getPointsToSet(const llvm::Value *V,
+                 const llvm::Instruction *I = nullptr) override;
+
+  [[nodiscard]] AllocationSiteSetPtrTy
+  getReachableAllocationSites(const llvm::Value *V, bool IntraProcOnly = false,
+                              const llvm::Instruction *I = nullptr) override;
+
+  [[nodiscard]] bool
+  isInReachableAllocationSites(const llvm::Value *V,
+                               const llvm::Value *PotentialValue,
+                               bool IntraProcOnly = false,
+                               const llvm::Instruction *I = nullptr) override;
+
+  void print(llvm::raw_ostream &OS = llvm::outs()) const override;
+
+  [[nodiscard]] nlohmann::json getAsJson() const override;
+
+  void printAsJson(llvm::raw_ostream &OS = llvm::outs()) const override;
+
+  /// Not supported, the solver computes its points-to information on demand.
+  void mergeWith(const PointsToInfo &PTI) override;
+
+  /// Treats V1 and V2 as copies of each other in all subsequent queries.
+  void introduceAlias(const llvm::Value *V1, const llvm::Value *V2,
+                      const llvm::Instruction *I = nullptr,
+                      AliasResult Kind = AliasResult::MustAlias) override;
+
+private:
+  enum class Direction { Backward, Forward };
+
+  /// A control state of both pushdown systems: a pointer and whether the
+  /// search for its allocation sites (backward) or aliases (forward) is in
+  /// progress.
+  using NodeTy = llvm::PointerIntPair<const llvm::Value *, 1, Direction>;
+
+  /// The stack symbols of the field-stack pushdown system: the dereference of
+  /// a pointer by a load or store, or the address computation of a field by a
+  /// getelementptr with constant indices.
+  using FieldTy = uint32_t;
+  static constexpr FieldTy NoField = 0;
+  static constexpr FieldTy Deref = 1;
+
+  /// An edge of the pointer assignment graph, together with its effect on the
+  /// call stack and the field stack.
+  struct Move {
+    enum class CallActionTy { None, Enter, Leave };
+    enum class FieldActionTy { None, Push, Pop };
+
+    NodeTy Target;
+    CallActionTy CallAction = CallActionTy::None;
+    const llvm::Instruction *CallSite = nullptr;
+    FieldActionTy FieldAction = FieldActionTy::None;
+    FieldTy Field = NoField;
+  };
+
+  struct QueryResult {
+    DynamicPointsToSetPtr<PointsToSetTy> Aliases;
+    DynamicPointsToSetPtr<PointsToSetTy> AllocationSites;
+    /// The allocation sites within the function of the query, computed when
+    /// first requested
+    DynamicPointsToSetPtr<PointsToSetTy> IntraProcAllocationSites;
+    /// The Generation the sets have been computed in
+    size_t Generation = 0;
+  };
+
+  QueryResult &query(const llvm::Value *V);
+
+  void computeIntraProcAllocationSites(const llvm::Value *V,
+                                       QueryResult &Result);
+
+  const std::vector<Move> &getMoves(NodeTy Node);
+  void computeBackwardMoves(const llvm::Value *V, std::vector<Move> &Moves);
+  void computeForwardMoves(const llvm::Value *V, std::vector<Move> &Moves);
+
+  [[nodiscard]] bool isAllocationSite(const llvm::Value *V) const;
+
+  /// Returns the field of a getelementptr with constant, not all zero
+  /// indices, or NoField if its result is treated as a copy of its base.
+  FieldTy getField(const llvm::Value *GEP);
+
+  [[nodiscard]] static DynamicPointsToSetPtr<PointsToSetTy>
+  getEmptyPointsToSet();
+
+  const LLVMBasedICFG &ICF;
+
+  llvm::DenseMap<NodeTy, std::vector<Move>> Moves;
+  std::map<std::pair<const llvm::Type *, std::vector<int64_t>>, FieldTy>
+      Fields;
+  /// Copies introduced by introduceAlias()
+  llvm::DenseMap<const llvm::Value *, std::vector<const llvm::Value *>>
+      IntroducedAliases;
+
+  PointsToSetOwner<PointsToSetTy>::memory_resource_type MRes;
+  PointsToSetOwner<PointsToSetTy> Owner{&MRes};
+  /// The results of all queries. introduceAlias() starts a new Generation;
+  /// outdated results are recomputed in place when they are queried again,
+  /// such that previously returned handles remain valid.
+  llvm::DenseMap<const llvm::Value *, QueryResult> Cache;
+  size_t Generation = 0;
+  size_t NumQueries = 0;
 };
 
 } // namespace psr
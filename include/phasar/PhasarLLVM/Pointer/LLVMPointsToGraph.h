@@ -112,6 +112,13 @@ private:
   PointsToSetOwner<PointsToSetTy> Owner{&MRes};
   std::unordered_map<const llvm::Value *, DynamicPointsToSetPtr<PointsToSetTy>>
       Cache;
+  /// The reachable allocation sites per value together with the
+  /// AllocationSitesGeneration they have been computed in. Outdated sets are
+  /// recomputed in place, such that previously returned handles remain valid.
+  std::unordered_map<const llvm::Value *,
+                     std::pair<DynamicPointsToSetPtr<PointsToSetTy>, size_t>>
+      AllocationSiteCache;
+  size_t AllocationSitesGeneration = 0;
 
   // void mergeGraph(const LLVMPointsToGraph &Other);
 
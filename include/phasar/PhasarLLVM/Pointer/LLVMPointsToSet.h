@@ -19,10 +19,15 @@
 
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/MemoryBufferRef.h"
 
 #include "nlohmann/json.hpp"
 
+#include <cstdint>
 #include <memory_resource>
+#include <utility>
+#include <vector>
 
 namespace llvm {
 class Value;
@@ -41,6 +46,14 @@ private:
   using PointsToSetMap =
       llvm::DenseMap<const llvm::Value *, DynamicPointsToSetPtr<PointsToSetTy>>;
 
+  /// The alias classes of the pointers used in a single function in
+  /// compressed sparse row format: class I consists of the values
+  /// Members[Offsets[I]] to Members[Offsets[I + 1] - 1].
+  struct FunctionAliasClasses {
+    std::vector<const llvm::Value *> Members;
+    std::vector<uint32_t> Offsets;
+  };
+
   LLVMBasedPointsToAnalysis PTA;
   llvm::DenseSet<const llvm::Function *> AnalyzedFunctions;
 
@@ -49,6 +62,41 @@ private:
 
   PointsToSetMap PointsToSets;
 
+  struct AllocationSiteSet {
+    DynamicPointsToSetPtr<PointsToSetTy> Sites;
+    /// Handles of the sets of merged alias classes that have been redirected
+    /// to Sites
+    llvm::SmallVector<DynamicPointsToSetPtr<PointsToSetTy>, 0> Redirected;
+    /// The AllocationSitesGeneration Sites have been computed in
+    size_t Generation = 0;
+  };
+
+  /// The reachable allocation sites of an alias class, indexed by the class'
+  /// points-to set and the function that intra-procedural queries are
+  /// restricted to (nullptr for inter-procedural queries). A set is
+  /// recomputed in place when it is queried after a points-to set has
+  /// changed, and released when its alias class is merged into another one,
+  /// such that previously returned handles remain valid.
+  llvm::DenseMap<std::pair<const PointsToSetTy *, const llvm::Function *>,
+                 AllocationSiteSet>
+      AllocationSiteSets;
+  /// The functions of the entries of AllocationSiteSets per alias class
+  llvm::DenseMap<const PointsToSetTy *,
+                 llvm::SmallVector<const llvm::Function *, 1>>
+      AllocationSiteSetFunctions;
+  size_t AllocationSitesGeneration = 0;
+  PointsToSetOwner<PointsToSetTy> AllocationSiteOwner{&MRes};
+
+  void computePointsToSets(ProjectIRDB &IRDB, bool UseLazyEvaluation);
+
+  void computeModulesPointsToSets(const llvm::Module &M,
+                                  bool UseLazyEvaluation);
+
+  /// Fills the points-to sets from the binary format written by
+  /// printAsBinary(). Leaves this object unchanged and returns false if
+  /// SerializedPTS cannot be used for the IRDB.
+  bool loadBinary(const ProjectIRDB &IRDB, llvm::MemoryBufferRef SerializedPTS);
+
   void computeValuesPointsToSet(const llvm::Value *V);
 
   void computeFunctionsPointsToSet(llvm::Function *F);
@@ -68,9 +116,19 @@ private:
                                         const llvm::Function *VFun,
                                         const llvm::GlobalObject *VG);
 
-  /// Utility function used by computeFunctionsPointsToSet(...)
-  void addPointer(llvm::AAResults &AA, const llvm::DataLayout &DL,
-                  const llvm::Value *V, std::vector<const llvm::Value *> &Reps);
+  /// Computes the alias classes of the pointers used in F. Only reads the IR
+  /// and AA; the classes are added to the points-to sets by addAliasClasses().
+  [[nodiscard]] static FunctionAliasClasses
+  computeAliasClasses(llvm::AAResults &AA, const llvm::Function &F);
+
+  void addAliasClasses(const FunctionAliasClasses &Classes);
+
+  void invalidateAllocationSites() { ++AllocationSitesGeneration; }
+
+  /// Releases the allocation-site sets of the alias class Merged, which has
+  /// been merged into Into, and redirects their handles to the sets of Into.
+  void mergeAllocationSites(const PointsToSetTy *Merged,
+                            const PointsToSetTy *Into);
 
   [[nodiscard]] static DynamicPointsToSetPtr<PointsToSetTy>
   getEmptyPointsToSet();
@@ -85,9 +143,29 @@ public:
       ProjectIRDB &IRDB, bool UseLazyEvaluation = true,
       PointerAnalysisType PATy = PointerAnalysisType::CFLAnders);
 
+  /**
+   * Creates points-to set(s) for the functions and globals of M only, which
+   * must be one of the IRDB's modules. Values of other modules are not
+   * considered, e.g. when the modules of the IRDB are analyzed separately.
+   */
+  LLVMPointsToSet(ProjectIRDB &IRDB, const llvm::Module &M,
+                  bool UseLazyEvaluation = true,
+                  PointerAnalysisType PATy = PointerAnalysisType::CFLAnders);
+
   explicit LLVMPointsToSet(ProjectIRDB &IRDB,
                            const nlohmann::json &SerializedPTS);
 
+  /**
+   * Loads the points-to information that has previously been exported via
+   * printAsBinary(). SerializedPTS is read in place, so it may refer to a
+   * memory-mapped file. If SerializedPTS is malformed, has been written by an
+   * incompatible version, or belongs to a different module, the points-to
+   * information is computed lazily instead.
+   */
+  explicit LLVMPointsToSet(
+      ProjectIRDB &IRDB, llvm::MemoryBufferRef SerializedPTS,
+      PointerAnalysisType PATy = PointerAnalysisType::CFLAnders);
+
   ~LLVMPointsToSet() override = default;
 
   [[nodiscard]] inline bool isInterProcedural() const override {
@@ -132,6 +210,14 @@ public:
 
   void printAsJson(llvm::raw_ostream &OS = llvm::outs()) const override;
 
+  /**
+   * Writes the points-to information in a compact, versioned binary format.
+   * Values are identified by dense ids that are derived from the structure of
+   * the IRDB's modules, together with a hash of that structure, such that a
+   * stale file is detected on loading. OS should be opened in binary mode.
+   */
+  void printAsBinary(const ProjectIRDB &IRDB, llvm::raw_ostream &OS) const;
+
   /**
    * Shows a parts of an alias set. Good for debugging when one wants to peak
    * into a points to set.
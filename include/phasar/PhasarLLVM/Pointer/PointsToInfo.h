@@ -44,7 +44,11 @@ template <typename V, typename N> class PointsToInfo {
 public:
   using PointsToSetTy = llvm::DenseSet<V>;
   using PointsToSetPtrTy = DynamicPointsToSetConstPtr<PointsToSetTy>;
-  using AllocationSiteSetPtrTy = std::unique_ptr<PointsToSetTy>;
+  /// Allocation-site sets are owned by the points-to information and shared
+  /// between all queries that yield the same set. A returned handle remains
+  /// valid as long as the points-to information exists, but the set may be
+  /// recomputed once the points-to information has changed.
+  using AllocationSiteSetPtrTy = DynamicPointsToSetConstPtr<PointsToSetTy>;
 
   virtual ~PointsToInfo() = default;
 
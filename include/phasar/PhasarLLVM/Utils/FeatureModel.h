@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_UTILS_FEATUREMODEL_H_
+#define PHASAR_PHASARLLVM_UTILS_FEATUREMODEL_H_
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+
+namespace llvm {
+class BranchInst;
+class GlobalVariable;
+class Instruction;
+class raw_ostream;
+} // namespace llvm
+
+namespace psr {
+
+class ProjectIRDB;
+
+/// A presence condition: the set of configurations, given by their indices,
+/// in which a piece of code or a data-flow fact is present.
+using PresenceCondition = llvm::BitVector;
+
+llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
+                              const PresenceCondition &PC);
+
+/// The features of a variability-encoded program and the configurations in
+/// which it is built.
+///
+/// A variability-encoded program represents a preprocessor directive
+/// '#ifdef NAME' by a conditional branch 'if (FeaturePrefix ## NAME)' on a
+/// global variable, such that all configurations are compiled into a single
+/// module. A configuration is the set of the names of its enabled features;
+/// all other features are disabled. The presence conditions of the edges of
+/// all branches that depend on features only are precomputed, such that
+/// getPresenceCondition() is a single lookup.
+class FeatureModel {
+public:
+  static constexpr llvm::StringLiteral DefaultFeaturePrefix =
+      "__phasar_feature_";
+
+  FeatureModel(const ProjectIRDB &IRDB,
+               std::vector<std::set<std::string>> Configurations,
+               llvm::StringRef FeaturePrefix = DefaultFeaturePrefix);
+
+  /// Parses configurations given as comma-separated lists of enabled
+  /// features, e.g., "LOGGING,SSL".
+  [[nodiscard]] static std::vector<std::set<std::string>>
+  parseConfigurations(const std::vector<std::string> &Configurations);
+
+  [[nodiscard]] size_t getNumConfigurations() const noexcept {
+    return Configurations.size();
+  }
+
+  [[nodiscard]] const std::set<std::string> &
+  getConfiguration(size_t Idx) const {
+    return Configurations[Idx];
+  }
+
+  /// Returns the names of all features the program branches on.
+  [[nodiscard]] std::set<std::string> getFeatures() const;
+
+  /// Returns the presence condition that holds in all configurations.
+  [[nodiscard]] const PresenceCondition &getTrue() const noexcept {
+    return True;
+  }
+
+  /// Returns the presence condition that holds in no configuration.
+  [[nodiscard]] const PresenceCondition &getFalse() const noexcept {
+    return False;
+  }
+
+  /// Returns the configurations in which control may flow from Curr to Succ,
+  /// which is getTrue() unless Curr branches on features.
+  [[nodiscard]] const PresenceCondition &
+  getPresenceCondition(const llvm::Instruction *Curr,
+                       const llvm::Instruction *Succ) const;
+
+  /// Returns the number of branches that depend on features.
+  [[nodiscard]] size_t getNumFeatureBranches() const noexcept {
+    return BranchConditions.size();
+  }
+
+  void print(llvm::raw_ostream &OS) const;
+
+private:
+  std::vector<std::set<std::string>> Configurations;
+  std::string FeaturePrefix;
+  PresenceCondition True;
+  PresenceCondition False;
+  // the configurations in which a branch may take its first and its second
+  // successor, respectively
+  llvm::DenseMap<const llvm::BranchInst *,
+                 std::pair<PresenceCondition, PresenceCondition>>
+      BranchConditions;
+  llvm::DenseMap<const llvm::GlobalVariable *, std::string> Features;
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_UTILS_FUNCTIONHASHES_H_
+#define PHASAR_PHASARLLVM_UTILS_FUNCTIONHASHES_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+
+namespace llvm {
+class Function;
+class raw_ostream;
+} // namespace llvm
+
+namespace psr {
+
+class ProjectIRDB;
+
+/// Returns a hash of the structure of F: its type and, for every instruction,
+/// the opcode, types, flags and operands. Local operands are hashed by their
+/// position within F, constants by their value and global values by their
+/// name; names of local values, debug intrinsics and metadata are ignored.
+/// Hence, the hash is stable across compilations of the same source code and
+/// across program runs.
+[[nodiscard]] uint64_t getStructuralHash(const llvm::Function &F);
+
+/// The structural hashes of all function definitions of a ProjectIRDB, keyed
+/// by function name, together with their closure hashes: the closure hash of
+/// a function additionally covers all functions it may transitively call.
+/// Indirect calls may call any function whose address is taken.
+///
+/// Two versions of a function with equal closure hashes execute the same
+/// code, hence, they have the same procedure summaries for all analyses that
+/// do not depend on their callers.
+class FunctionHashes {
+public:
+  explicit FunctionHashes(const ProjectIRDB &IRDB);
+
+  /// Returns the structural hash of the function definition FunctionName.
+  [[nodiscard]] std::optional<uint64_t>
+  getHash(llvm::StringRef FunctionName) const;
+
+  /// Returns the closure hash of the function definition FunctionName.
+  [[nodiscard]] std::optional<uint64_t>
+  getClosureHash(llvm::StringRef FunctionName) const;
+
+  /// Returns true if FunctionName or a function it may transitively call
+  /// refers to a global variable that is not constant.
+  [[nodiscard]] bool mayAccessMutableGlobals(llvm::StringRef FunctionName) const;
+
+  /// Returns the names of the function definitions whose closure hashes
+  /// differ from the ones in Old, including functions that are new.
+  [[nodiscard]] std::vector<std::string>
+  getChangedFunctions(const FunctionHashes &Old) const;
+
+  [[nodiscard]] size_t size() const { return Entries.size(); }
+
+  void print(llvm::raw_ostream &OS) const;
+
+private:
+  struct Entry {
+    uint64_t Hash = 0;
+    uint64_t ClosureHash = 0;
+    bool MayAccessMutableGlobals = false;
+  };
+
+  llvm::StringMap<Entry> Entries;
+};
+
+} // namespace psr
+
+#endif
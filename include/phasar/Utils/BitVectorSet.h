@@ -12,175 +12,299 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <functional>
 #include <initializer_list>
-
-#include "boost/bimap.hpp"
-#include "boost/bimap/unordered_set_of.hpp"
-
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/raw_ostream.h"
 
 namespace psr {
 namespace internal {
 inline bool isLess(const llvm::BitVector &Lhs, const llvm::BitVector &Rhs) {
-  unsigned LhsBits = Lhs.size();
-  unsigned RhsBits = Rhs.size();
+  // Compare the words of both sides, starting from the most significant one.
+  // llvm::BitVector keeps all unused bits of its last word cleared, hence the
+  // missing upper words of the smaller side are treated as zero.
+  auto LhsWords = Lhs.getData();
+  auto RhsWords = Rhs.getData();
+  for (size_t I = std::max(LhsWords.size(), RhsWords.size()); I > 0; --I) {
+    auto LhsWord = I <= LhsWords.size() ? LhsWords[I - 1] : 0;
+    auto RhsWord = I <= RhsWords.size() ? RhsWords[I - 1] : 0;
+    if (LLVM_UNLIKELY(LhsWord != RhsWord)) {
+      return LhsWord < RhsWord;
+    }
+  }
+  return false;
+}
+} // namespace internal
 
-  if (LhsBits > RhsBits) {
-    if (Lhs.find_first_in(RhsBits, LhsBits) != -1) {
-      return false;
+/**
+ * A BitVectorSetDomain assigns a dense index to each element that is
+ * contained in a BitVectorSet referencing it and maps the indices back to the
+ * elements. An analysis should own its domain, so that the indices of
+ * different analyses do not interfere and are released together with the
+ * analysis.
+ *
+ * A domain can be made safe for concurrent insertion and lookup, e.g. for sets
+ * that are manipulated by a parallel solver. Sets that are not explicitly
+ * given a domain use the process-wide default domain, which is not
+ * thread-safe and never shrinks.
+ *
+ * The sets that reference a domain store pointers to it, hence the domain can
+ * neither be copied nor moved and must outlive these sets.
+ */
+template <typename T> class BitVectorSetDomain {
+public:
+  explicit BitVectorSetDomain(bool Concurrent = false)
+      : Concurrent(Concurrent) {}
+  ~BitVectorSetDomain() = default;
+
+  BitVectorSetDomain(const BitVectorSetDomain &) = delete;
+  BitVectorSetDomain &operator=(const BitVectorSetDomain &) = delete;
+  BitVectorSetDomain(BitVectorSetDomain &&) = delete;
+  BitVectorSetDomain &operator=(BitVectorSetDomain &&) = delete;
+
+  /// Returns the index of Data and assigns the next free index to Data if it
+  /// has not been seen before.
+  size_t getOrInsertIndex(const T &Data) {
+    if (!Concurrent) {
+      return getOrInsertIndexImpl(Data);
+    }
+    {
+      std::shared_lock<std::shared_mutex> Lock(Mtx);
+      auto Search = Indices.find(Data);
+      if (Search != Indices.end()) {
+        return Search->second;
+      }
     }
-  } else if (LhsBits < RhsBits) {
-    if (Rhs.find_first_in(LhsBits, RhsBits) != -1) {
-      return true;
+    std::unique_lock<std::shared_mutex> Lock(Mtx);
+    return getOrInsertIndexImpl(Data);
+  }
+
+  /// Calls getOrInsertIndex() for all elements in [First, Last) and appends
+  /// their indices to Result, acquiring the lock of a concurrent domain only
+  /// once.
+  template <typename InputIt>
+  void getOrInsertIndices(InputIt First, InputIt Last,
+                          llvm::SmallVectorImpl<size_t> &Result) {
+    std::unique_lock<std::shared_mutex> Lock(Mtx, std::defer_lock);
+    if (Concurrent) {
+      Lock.lock();
+    }
+    for (; First != Last; ++First) {
+      Result.push_back(getOrInsertIndexImpl(*First));
     }
   }
 
-  // Compare every bit on both sides because Lhs and Rhs either have the same
-  // amount of bits or all other upper bits of the larger one are zero.
-  for (int I = static_cast<int>(std::min(LhsBits, RhsBits)) - 1; I >= 0; --I) {
-    if (LLVM_UNLIKELY(Lhs[I] != Rhs[I])) {
-      return Rhs[I];
+  /// Returns the index of Data if it has been inserted before.
+  [[nodiscard]] std::optional<size_t> getIndex(const T &Data) const {
+    std::shared_lock<std::shared_mutex> Lock(Mtx, std::defer_lock);
+    if (Concurrent) {
+      Lock.lock();
+    }
+    auto Search = Indices.find(Data);
+    if (Search == Indices.end()) {
+      return std::nullopt;
     }
+    return Search->second;
+  }
+
+  /// Returns the element with the given index. The reference remains valid
+  /// when further elements are inserted.
+  [[nodiscard]] const T &getValue(size_t Idx) const {
+    std::shared_lock<std::shared_mutex> Lock(Mtx, std::defer_lock);
+    if (Concurrent) {
+      Lock.lock();
+    }
+    assert(Idx < Values.size() && "Index has not been assigned by this domain");
+    return *Values[Idx];
+  }
+
+  [[nodiscard]] size_t size() const {
+    std::shared_lock<std::shared_mutex> Lock(Mtx, std::defer_lock);
+    if (Concurrent) {
+      Lock.lock();
+    }
+    return Values.size();
+  }
+
+  [[nodiscard]] bool isConcurrent() const noexcept { return Concurrent; }
+
+  /// The domain of all sets that have not been given an explicit domain.
+  static BitVectorSetDomain &getDefault() {
+    static BitVectorSetDomain Default;
+    return Default;
+  }
+
+private:
+  size_t getOrInsertIndexImpl(const T &Data) {
+    auto [It, Inserted] = Indices.try_emplace(Data, Values.size());
+    if (Inserted) {
+      // the keys of a node-based map are stable across rehashing
+      Values.push_back(&It->first);
+    }
+    return It->second;
   }
-  return false;
-}
-} // namespace internal
+
+  // Using boost::hash<T> causes ambiguity for hash_value():
+  //  -<llvm/ADT/Hashing.h>
+  //  -<boost/functional/hash/extensions.hpp>
+  //  -<boost/graph/adjacency_list.hpp>
+  std::unordered_map<T, size_t, std::hash<T>> Indices;
+  std::vector<const T *> Values;
+  mutable std::shared_mutex Mtx;
+  const bool Concurrent;
+};
 
 /**
  * BitVectorSet implements a set that requires minimal space. Elements are
- * kept in a static map and the set itself only stores a vector of bits which
- * indicate whether elements are contained in the set.
+ * kept in a BitVectorSetDomain and the set itself only stores a vector of bits
+ * which indicate whether elements are contained in the set. All operations on
+ * two sets work on whole words of the bit vectors; sets that are combined
+ * with each other must use the same domain. Sets of different domains can
+ * only be compared for equality.
  *
  * @brief Implements a set that requires minimal space.
  */
 template <typename T> class BitVectorSet {
 private:
-  // Using boost::hash<T> causes ambiguity for hash_value():
-  //  -<llvm/ADT/Hashing.h>
-  //  -<boost/functional/hash/extensions.hpp>
-  //  -<boost/graph/adjacency_list.hpp>
-  using bimap_t = boost::bimap<boost::bimaps::unordered_set_of<T, std::hash<T>>,
-                               boost::bimaps::unordered_set_of<size_t>>;
-  inline static bimap_t Position; // NOLINT
+  // A set without a domain is always empty; the domain is determined on the
+  // first insertion or by combining the set with another one.
+  BitVectorSetDomain<T> *Domain = nullptr;
   llvm::BitVector Bits;
 
-  template <typename D> class BitVectorSetIterator {
-    llvm::BitVector Bits;
+  [[nodiscard]] bool hasSameDomain(const BitVectorSet &Other) const noexcept {
+    return !Domain || !Other.Domain || Domain == Other.Domain;
+  }
+
+  void mergeDomain(const BitVectorSet &Other) {
+    assert(hasSameDomain(Other) &&
+           "Cannot combine BitVectorSets of different domains");
+    if (!Domain) {
+      Domain = Other.Domain;
+    }
+  }
 
+  BitVectorSetDomain<T> &getOrCreateDomain() {
+    if (!Domain) {
+      Domain = &BitVectorSetDomain<T>::getDefault();
+    }
+    return *Domain;
+  }
+
+  class BitVectorSetIterator {
   public:
     using iterator_category = std::forward_iterator_tag;
-    using value_type = D;
+    using value_type = T;
     using difference_type = std::ptrdiff_t;
-    using pointer = D *;
-    using reference = D &;
-    BitVectorSetIterator(D Ptr = nullptr) : PosPtr(Ptr) {}
+    using pointer = const T *;
+    using reference = const T &;
 
-    BitVectorSetIterator<D> &operator=(D *Ptr) {
-      PosPtr = Ptr;
-      return *this;
-    }
-
-    void setBits(const llvm::BitVector &OtherBits) { Bits = OtherBits; }
+    BitVectorSetIterator() = default;
 
-    bool operator==(const BitVectorSetIterator<D> &OtherIterator) const {
-      return PosPtr == OtherIterator.getPtr();
+    bool operator==(const BitVectorSetIterator &OtherIterator) const {
+      return Pos == OtherIterator.Pos;
     }
 
-    bool operator!=(const BitVectorSetIterator<D> &OtherIterator) const {
+    bool operator!=(const BitVectorSetIterator &OtherIterator) const {
       return !(*this == OtherIterator);
     }
 
-    BitVectorSetIterator<D> &operator+=(const difference_type &Movement) {
+    BitVectorSetIterator &operator+=(const difference_type &Movement) {
       for (difference_type I = 0; I < Movement; I++) {
-        PosPtr++;
+        ++*this;
       }
       return *this;
     }
 
-    BitVectorSetIterator<D> &operator++() {
-      do {
-        int NextIdx = Bits.find_next(PosPtr->first);
-
-        if (NextIdx <= static_cast<int>(PosPtr->first)) {
-          PosPtr = Position.right.find(Bits.size());
-          break;
-        }
-
-        PosPtr = Position.right.find(NextIdx);
-
-        assert(PosPtr->first < Bits.size() &&
-               "pos_ptr->first index into BitVector out of range");
-      } while (!Bits[PosPtr->first]);
-
+    BitVectorSetIterator &operator++() {
+      int NextIdx = Set->Bits.find_next(Pos);
+      Pos = NextIdx == -1 ? Set->Bits.size() : NextIdx;
       return *this;
     }
 
-    BitVectorSetIterator<D> operator++(int) {
+    BitVectorSetIterator operator++(int) {
       auto Temp(*this);
       ++*this;
       return Temp;
     }
 
-    BitVectorSetIterator<D> operator+(const difference_type &Movement) {
-      auto OldPtr = PosPtr;
-      for (difference_type I = 0; I < Movement; I++) {
-        PosPtr++;
-      }
+    BitVectorSetIterator operator+(const difference_type &Movement) const {
       auto Temp(*this);
-      PosPtr = OldPtr;
+      Temp += Movement;
       return Temp;
     }
 
-    difference_type operator-(const BitVectorSetIterator<D> &OtherIterator) {
-      return std::distance(OtherIterator.getPtr(), this->getPtr());
+    difference_type operator-(const BitVectorSetIterator &OtherIterator) {
+      difference_type Distance = 0;
+      for (auto It = OtherIterator; It != *this; ++It) {
+        ++Distance;
+      }
+      return Distance;
     }
 
-    // T& operator*(){return pos_ptr->second;}
-
-    const T &operator*() const { return PosPtr->second; }
-
-    D *operator->() { return PosPtr; }
+    const T &operator*() const { return Set->Domain->getValue(Pos); }
 
-    [[nodiscard]] D getPtr() const { return PosPtr; }
+    const T *operator->() const { return &**this; }
 
-    // const D* getConstPtr()const{return pos_ptr;}
-
-    // T getPos() {return pos_ptr->first;}
-
-    // T getVal() {return pos_ptr->second;}
+  private:
+    friend class BitVectorSet;
 
-    [[nodiscard]] llvm::BitVector getBits() const { return Bits; }
+    BitVectorSetIterator(const BitVectorSet *Set, size_t Pos)
+        : Set(Set), Pos(Pos) {}
 
-  private:
-    D PosPtr;
+    const BitVectorSet *Set = nullptr;
+    size_t Pos = 0;
   };
 
 public:
-  using iterator = BitVectorSetIterator<typename bimap_t::right_iterator>;
-  using const_iterator =
-      BitVectorSetIterator<typename bimap_t::right_const_iterator>;
+  // elements cannot be modified through an iterator
+  using iterator = BitVectorSetIterator;
+  using const_iterator = BitVectorSetIterator;
   using value_type = T;
+  using word_type = uintptr_t;
 
   BitVectorSet() = default;
 
+  explicit BitVectorSet(BitVectorSetDomain<T> &Domain) : Domain(&Domain) {}
+
   explicit BitVectorSet(size_t Count) : Bits(Count, false) {}
 
   BitVectorSet(std::initializer_list<T> IList) {
     insert(IList.begin(), IList.end());
   }
 
+  BitVectorSet(BitVectorSetDomain<T> &Domain, std::initializer_list<T> IList)
+      : Domain(&Domain) {
+    insert(IList.begin(), IList.end());
+  }
+
   template <typename InputIt> BitVectorSet(InputIt First, InputIt Last) {
     insert(First, Last);
   }
 
+  template <typename InputIt>
+  BitVectorSet(BitVectorSetDomain<T> &Domain, InputIt First, InputIt Last)
+      : Domain(&Domain) {
+    insert(First, Last);
+  }
+
   [[nodiscard]] BitVectorSet<T> setUnion(const BitVectorSet<T> &Other) const {
-    size_t MaxSize = std::max(Bits.size(), Other.Bits.size());
-    BitVectorSet<T> Res;
-    Res.Bits.reserve(MaxSize);
-    Res.Bits = Bits;
-    Res.Bits |= Other.Bits;
+    const BitVectorSet &Larger =
+        Bits.size() >= Other.Bits.size() ? *this : Other;
+    const BitVectorSet &Smaller = &Larger == this ? Other : *this;
+    BitVectorSet<T> Res = Larger;
+    Res.mergeDomain(Smaller);
+    Res.Bits |= Smaller.Bits;
     return Res;
   }
 
@@ -190,63 +314,79 @@ public:
     const BitVectorSet &Larger =
         Bits.size() > Other.Bits.size() ? *this : Other;
 
+    Res.mergeDomain(Larger);
     Res.Bits &= Larger.Bits;
     return Res;
   }
 
-  void setIntersectWith(const BitVectorSet<T> &Other) { Bits &= Other.Bits; }
+  /// Returns the elements of this set that are not contained in Other.
+  [[nodiscard]] BitVectorSet<T>
+  setDifference(const BitVectorSet<T> &Other) const {
+    BitVectorSet Res = *this;
+    Res.setDifferenceWith(Other);
+    return Res;
+  }
+
+  void setIntersectWith(const BitVectorSet<T> &Other) {
+    mergeDomain(Other);
+    Bits &= Other.Bits;
+  }
 
-  void setUnionWith(const BitVectorSet<T> &Other) { Bits |= Other.Bits; }
+  void setUnionWith(const BitVectorSet<T> &Other) {
+    mergeDomain(Other);
+    Bits |= Other.Bits;
+  }
+
+  void setDifferenceWith(const BitVectorSet<T> &Other) {
+    if (this == &Other) {
+      clear();
+    } else {
+      mergeDomain(Other);
+      Bits.reset(Other.Bits);
+    }
+  }
 
   [[nodiscard]] bool includes(const BitVectorSet<T> &Other) const {
+    assert(hasSameDomain(Other) &&
+           "Cannot combine BitVectorSets of different domains");
     return !Other.Bits.test(Bits);
   }
 
   void insert(const T &Data) {
-    auto Search = Position.left.find(Data);
-    // Data already known
-    if (Search != Position.left.end()) {
-      if (Bits.size() <= Search->second) {
-        Bits.resize(Search->second + 1);
-      }
-      Bits.set(Search->second);
-    } else {
-      // Data unknown
-      size_t Idx = Position.left.size();
-      Position.left.insert(std::make_pair(Data, Position.left.size()));
-      if (Bits.size() <= Position.left.size()) {
-        Bits.resize(Position.left.size());
-      }
-      Bits.set(Idx);
+    size_t Idx = getOrCreateDomain().getOrInsertIndex(Data);
+    if (Bits.size() <= Idx) {
+      Bits.resize(Idx + 1);
     }
+    Bits.set(Idx);
   }
 
-  void insert(const BitVectorSet<T> &Other) { Bits |= Other.Bits; }
+  void insert(const BitVectorSet<T> &Other) { setUnionWith(Other); }
 
+  /// Inserts all elements in [First, Last). The indices of all elements are
+  /// obtained at once and the bit vector is resized at most once.
   template <typename InputIt> void insert(InputIt First, InputIt Last) {
-    while (First != Last) {
-      insert(*First);
-      ++First;
+    if (First == Last) {
+      return;
     }
-  }
-
-  void erase(const T &Data) noexcept {
-    auto Search = Position.left.find(Data);
-    if (Search != Position.left.end()) {
-      if (Bits.size() > Search->second) {
-        Bits.reset(Search->second);
-      }
+    llvm::SmallVector<size_t, 16> Indices;
+    getOrCreateDomain().getOrInsertIndices(First, Last, Indices);
+    size_t MaxIdx = *std::max_element(Indices.begin(), Indices.end());
+    if (Bits.size() <= MaxIdx) {
+      Bits.resize(MaxIdx + 1);
+    }
+    for (size_t Idx : Indices) {
+      Bits.set(Idx);
     }
   }
 
-  void erase(const BitVectorSet<T> &Other) {
-    if (this == &Other) {
-      clear();
-    } else {
-      Bits.reset(Other.Bits);
+  void erase(const T &Data) {
+    if (auto Idx = getIndex(Data); Idx && *Idx < Bits.size()) {
+      Bits.reset(*Idx);
     }
   }
 
+  void erase(const BitVectorSet<T> &Other) { setDifferenceWith(Other); }
+
   void clear() noexcept {
     Bits.clear();
     Bits.resize(0);
@@ -256,26 +396,43 @@ public:
 
   void reserve(size_t NewCap) { Bits.reserve(NewCap); }
 
-  [[nodiscard]] bool find(const T &Data) const noexcept { return count(Data); }
+  [[nodiscard]] bool find(const T &Data) const { return count(Data); }
 
-  [[nodiscard]] size_t count(const T &Data) const noexcept {
-    auto Search = Position.left.find(Data);
-    if (Search != Position.left.end()) {
-      if (Bits.size() > Search->second) {
-        return Bits[Search->second];
-      }
+  [[nodiscard]] size_t count(const T &Data) const {
+    if (auto Idx = getIndex(Data); Idx && *Idx < Bits.size()) {
+      return Bits[*Idx];
     }
     return 0;
   }
 
+  /// Returns the number of elements, i.e. the population count of the bits.
   [[nodiscard]] size_t size() const noexcept { return Bits.count(); }
 
+  /// Returns the raw words of the bit vector; with W being the number of bits
+  /// per word, bit I % W of word I / W is set iff the element with index I is
+  /// contained. Unused bits of the last word are zero.
+  [[nodiscard]] llvm::ArrayRef<word_type> getWords() const noexcept {
+    return Bits.getData();
+  }
+
+  /// Returns the domain of this set, or nullptr if the set does not have one
+  /// (yet).
+  [[nodiscard]] BitVectorSetDomain<T> *getDomain() const noexcept {
+    return Domain;
+  }
+
   friend bool operator==(const BitVectorSet &Lhs, const BitVectorSet &Rhs) {
     bool LeftEmpty = Lhs.empty();
     bool RightEmpty = Rhs.empty();
     if (LeftEmpty || RightEmpty) {
       return LeftEmpty == RightEmpty;
     }
+    if (!Lhs.hasSameDomain(Rhs)) {
+      // the same bit denotes different elements in different domains
+      return Lhs.size() == Rhs.size() &&
+             std::all_of(Lhs.begin(), Lhs.end(),
+                         [&Rhs](const T &Elem) { return Rhs.count(Elem); });
+    }
     // Check, whether Lhs and Rhs actually have the same bits set and not
     // whether their internal representation is exactly identitcal
     auto LhsWords = Lhs.Bits.getData();
@@ -297,57 +454,47 @@ public:
     return !(Lhs == Rhs);
   }
 
+  /// Orders sets by their bits, which is only meaningful for sets of the same
+  /// domain.
   friend bool operator<(const BitVectorSet &Lhs, const BitVectorSet &Rhs) {
+    assert(Lhs.hasSameDomain(Rhs) &&
+           "Cannot order BitVectorSets of different domains");
     return internal::isLess(Lhs.Bits, Rhs.Bits);
   }
 
   friend llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
                                        const BitVectorSet &B) {
     OS << '<';
-    size_t Idx = 0;
-    for (auto &Position : B.Position.left) {
-      if (Position.second < B.Bits.size() && B.Bits[Position.second]) {
-        ++Idx;
-        OS << Position.first;
-        if (Idx < B.size()) {
-          OS << ", ";
-        }
+    bool First = true;
+    for (const auto &Elem : B) {
+      if (!First) {
+        OS << ", ";
       }
+      First = false;
+      OS << Elem;
     }
     OS << '>';
     return OS;
   }
 
-  [[nodiscard]] iterator begin() {
+  [[nodiscard]] const_iterator begin() const {
     int Index = Bits.find_first();
     if (Index == -1) {
       Index = Bits.size();
     }
-    iterator BeginIter(Position.right.find(Index));
-    BeginIter.setBits(Bits);
-    return BeginIter;
+    return const_iterator(this, Index);
   }
 
-  [[nodiscard]] iterator end() {
-    iterator EndIter(Position.right.find(Bits.size()));
-    EndIter.setBits(Bits);
-    return EndIter;
+  [[nodiscard]] const_iterator end() const {
+    return const_iterator(this, Bits.size());
   }
 
-  [[nodiscard]] const_iterator begin() const {
-    int Index = Bits.find_first();
-    if (Index == -1) {
-      Index = Bits.size();
+private:
+  [[nodiscard]] std::optional<size_t> getIndex(const T &Data) const {
+    if (!Domain) {
+      return std::nullopt;
     }
-    const_iterator BeginIter(Position.right.find(Index));
-    BeginIter.setBits(Bits);
-    return BeginIter;
-  }
-
-  [[nodiscard]] const_iterator end() const {
-    const_iterator EndIter(Position.right.find(Bits.size()));
-    EndIter.setBits(Bits);
-    return EndIter;
+    return Domain->getIndex(Data);
   }
 };
 
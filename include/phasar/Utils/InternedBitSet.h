@@ -0,0 +1,305 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_INTERNEDBITSET_H_
+#define PHASAR_UTILS_INTERNEDBITSET_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/Utils/Interner.h"
+
+namespace psr {
+
+/**
+ * InternedBitSet implements a set of values that have been interned by an
+ * Interner<T>. In contrast to BitVectorSet, no map needs to be consulted on
+ * insertion, lookup or iteration: the set is a plain dense bit vector that is
+ * indexed by the interned ids. Trailing zero words are never stored, so that
+ * equality, ordering and union are simple loops over machine words that the
+ * compiler can vectorize.
+ *
+ * The interner of the elements is remembered to render the set's values.
+ *
+ * @brief Implements a dense bit set of interned values.
+ */
+template <typename T> class InternedBitSet {
+  using WordType = uint64_t;
+  static constexpr unsigned BitsPerWord = 64;
+
+  llvm::SmallVector<WordType, 2> Words;
+  const Interner<T> *Owner = nullptr;
+
+  void trim() {
+    while (!Words.empty() && Words.back() == 0) {
+      Words.pop_back();
+    }
+  }
+
+  void mergeOwner(const InternedBitSet &Other) {
+    if (!Owner) {
+      Owner = Other.Owner;
+    }
+  }
+
+public:
+  using value_type = Interned<T>;
+
+  class const_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Interned<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Interned<T> *;
+    using reference = Interned<T>;
+
+    const_iterator() = default;
+
+    reference operator*() const {
+      return Set->Owner->getHandle(static_cast<uint32_t>(Pos));
+    }
+
+    const_iterator &operator++() {
+      Pos = Set->findNext(Pos + 1);
+      return *this;
+    }
+
+    const_iterator operator++(int) {
+      auto Temp(*this);
+      ++*this;
+      return Temp;
+    }
+
+    bool operator==(const const_iterator &Other) const {
+      return Pos == Other.Pos;
+    }
+
+    bool operator!=(const const_iterator &Other) const {
+      return !(*this == Other);
+    }
+
+  private:
+    friend class InternedBitSet;
+
+    const_iterator(const InternedBitSet *Set, size_t Pos)
+        : Set(Set), Pos(Pos) {}
+
+    const InternedBitSet *Set = nullptr;
+    size_t Pos = 0;
+  };
+  using iterator = const_iterator;
+
+  InternedBitSet() = default;
+
+  InternedBitSet(std::initializer_list<Interned<T>> IList) {
+    insert(IList.begin(), IList.end());
+  }
+
+  template <typename InputIt> InternedBitSet(InputIt First, InputIt Last) {
+    insert(First, Last);
+  }
+
+  [[nodiscard]] InternedBitSet setUnion(const InternedBitSet &Other) const {
+    const InternedBitSet &Larger =
+        Words.size() >= Other.Words.size() ? *this : Other;
+    const InternedBitSet &Smaller = &Larger == this ? Other : *this;
+    InternedBitSet Res = Larger;
+    Res.mergeOwner(Smaller);
+    for (size_t I = 0, E = Smaller.Words.size(); I < E; ++I) {
+      Res.Words[I] |= Smaller.Words[I];
+    }
+    return Res;
+  }
+
+  [[nodiscard]] InternedBitSet
+  setIntersect(const InternedBitSet &Other) const {
+    InternedBitSet Res = *this;
+    Res.setIntersectWith(Other);
+    return Res;
+  }
+
+  void setUnionWith(const InternedBitSet &Other) {
+    mergeOwner(Other);
+    if (Words.size() < Other.Words.size()) {
+      Words.resize(Other.Words.size());
+    }
+    for (size_t I = 0, E = Other.Words.size(); I < E; ++I) {
+      Words[I] |= Other.Words[I];
+    }
+  }
+
+  void setIntersectWith(const InternedBitSet &Other) {
+    if (Words.size() > Other.Words.size()) {
+      Words.resize(Other.Words.size());
+    }
+    for (size_t I = 0, E = Words.size(); I < E; ++I) {
+      Words[I] &= Other.Words[I];
+    }
+    trim();
+  }
+
+  [[nodiscard]] bool includes(const InternedBitSet &Other) const {
+    if (Other.Words.size() > Words.size()) {
+      return false;
+    }
+    for (size_t I = 0, E = Other.Words.size(); I < E; ++I) {
+      if (Other.Words[I] & ~Words[I]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void insert(Interned<T> Data) {
+    assert(Data.getInterner() && "Cannot insert a default-constructed handle");
+    assert((!Owner || Owner == Data.getInterner()) &&
+           "All elements must stem from the same interner");
+    Owner = Data.getInterner();
+    size_t WordIdx = Data.getId() / BitsPerWord;
+    if (Words.size() <= WordIdx) {
+      Words.resize(WordIdx + 1);
+    }
+    Words[WordIdx] |= WordType(1) << (Data.getId() % BitsPerWord);
+  }
+
+  void insert(const InternedBitSet &Other) { setUnionWith(Other); }
+
+  template <typename InputIt> void insert(InputIt First, InputIt Last) {
+    while (First != Last) {
+      insert(*First);
+      ++First;
+    }
+  }
+
+  void erase(Interned<T> Data) noexcept {
+    size_t WordIdx = Data.getId() / BitsPerWord;
+    if (WordIdx < Words.size()) {
+      Words[WordIdx] &= ~(WordType(1) << (Data.getId() % BitsPerWord));
+      trim();
+    }
+  }
+
+  void erase(const InternedBitSet &Other) {
+    for (size_t I = 0, E = std::min(Words.size(), Other.Words.size()); I < E;
+         ++I) {
+      Words[I] &= ~Other.Words[I];
+    }
+    trim();
+  }
+
+  void clear() noexcept { Words.clear(); }
+
+  [[nodiscard]] bool empty() const noexcept { return Words.empty(); }
+
+  [[nodiscard]] bool find(Interned<T> Data) const noexcept {
+    return count(Data);
+  }
+
+  [[nodiscard]] size_t count(Interned<T> Data) const noexcept {
+    size_t WordIdx = Data.getId() / BitsPerWord;
+    if (WordIdx < Words.size()) {
+      return (Words[WordIdx] >> (Data.getId() % BitsPerWord)) & 1;
+    }
+    return 0;
+  }
+
+  [[nodiscard]] size_t size() const noexcept {
+    size_t Count = 0;
+    for (auto Word : Words) {
+      Count += llvm::countPopulation(Word);
+    }
+    return Count;
+  }
+
+  /// Returns the raw words of the bit vector; bit I % 64 of word I / 64 is set
+  /// iff the value with id I is contained. The last word, if any, is non-zero.
+  [[nodiscard]] llvm::ArrayRef<WordType> getWords() const noexcept {
+    return Words;
+  }
+
+  [[nodiscard]] const Interner<T> *getInterner() const noexcept {
+    return Owner;
+  }
+
+  friend bool operator==(const InternedBitSet &Lhs,
+                         const InternedBitSet &Rhs) {
+    return Lhs.Words == Rhs.Words;
+  }
+
+  friend bool operator!=(const InternedBitSet &Lhs,
+                         const InternedBitSet &Rhs) {
+    return !(Lhs == Rhs);
+  }
+
+  /// Orders sets like BitVectorSet does, i.e. by comparing the bits from the
+  /// highest id downwards.
+  friend bool operator<(const InternedBitSet &Lhs, const InternedBitSet &Rhs) {
+    if (Lhs.Words.size() != Rhs.Words.size()) {
+      return Lhs.Words.size() < Rhs.Words.size();
+    }
+    for (size_t I = Lhs.Words.size(); I > 0; --I) {
+      if (Lhs.Words[I - 1] != Rhs.Words[I - 1]) {
+        return Lhs.Words[I - 1] < Rhs.Words[I - 1];
+      }
+    }
+    return false;
+  }
+
+  friend llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
+                                       const InternedBitSet &B) {
+    OS << '<';
+    bool First = true;
+    for (auto Elem : B) {
+      if (!First) {
+        OS << ", ";
+      }
+      First = false;
+      OS << Elem;
+    }
+    OS << '>';
+    return OS;
+  }
+
+  [[nodiscard]] const_iterator begin() const {
+    return const_iterator(this, findNext(0));
+  }
+
+  [[nodiscard]] const_iterator end() const {
+    return const_iterator(this, Words.size() * BitsPerWord);
+  }
+
+private:
+  [[nodiscard]] size_t findNext(size_t Pos) const {
+    size_t WordIdx = Pos / BitsPerWord;
+    if (WordIdx >= Words.size()) {
+      return Words.size() * BitsPerWord;
+    }
+    WordType Word = Words[WordIdx] & (~WordType(0) << (Pos % BitsPerWord));
+    while (Word == 0) {
+      if (++WordIdx == Words.size()) {
+        return Words.size() * BitsPerWord;
+      }
+      Word = Words[WordIdx];
+    }
+    return WordIdx * BitsPerWord + llvm::countTrailingZeros(Word);
+  }
+};
+
+} // namespace psr
+
+#endif
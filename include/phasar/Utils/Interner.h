@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_INTERNER_H_
+#define PHASAR_UTILS_INTERNER_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "llvm/Support/raw_ostream.h"
+
+namespace psr {
+
+template <typename T> class Interner;
+
+/// Handle to a value that has been interned by an Interner<T>. A handle only
+/// consists of the dense id of the value and a pointer to its interner, which
+/// keeps the value itself in a side table. Handles are thus cheap to copy,
+/// compare and hash, and the value can still be obtained for rendering.
+template <typename T> class Interned {
+public:
+  Interned() noexcept = default;
+
+  [[nodiscard]] uint32_t getId() const noexcept { return Id; }
+
+  [[nodiscard]] const Interner<T> *getInterner() const noexcept {
+    return Owner;
+  }
+
+  /// Returns the interned value from the side table of the owning interner.
+  [[nodiscard]] const T &get() const {
+    assert(Owner && "Cannot obtain the value of a default-constructed handle");
+    return Owner->getValue(Id);
+  }
+
+  [[nodiscard]] const T &operator*() const { return get(); }
+  [[nodiscard]] const T *operator->() const { return &get(); }
+
+  friend bool operator==(Interned Lhs, Interned Rhs) noexcept {
+    return Lhs.Id == Rhs.Id && Lhs.Owner == Rhs.Owner;
+  }
+
+  friend bool operator!=(Interned Lhs, Interned Rhs) noexcept {
+    return !(Lhs == Rhs);
+  }
+
+  friend bool operator<(Interned Lhs, Interned Rhs) noexcept {
+    if (Lhs.Id != Rhs.Id) {
+      return Lhs.Id < Rhs.Id;
+    }
+    return std::less<const Interner<T> *>{}(Lhs.Owner, Rhs.Owner);
+  }
+
+  friend llvm::raw_ostream &operator<<(llvm::raw_ostream &OS, Interned Fact) {
+    if (!Fact.Owner) {
+      return OS << '#' << Fact.Id;
+    }
+    return OS << Fact.get();
+  }
+
+private:
+  friend class Interner<T>;
+
+  Interned(const Interner<T> *Owner, uint32_t Id) noexcept
+      : Owner(Owner), Id(Id) {}
+
+  const Interner<T> *Owner = nullptr;
+  uint32_t Id = 0;
+};
+
+/// Assigns stable, dense 32-bit ids to values of type T. Each distinct value
+/// is stored exactly once; the ids index a side table that maps them back to
+/// the values, e.g. for rendering.
+///
+/// The handles that are returned by an interner point back to it, hence an
+/// interner can neither be copied nor moved and must outlive all handles and
+/// sets of handles that it has produced.
+///
+/// An Interner is not thread-safe.
+template <typename T> class Interner {
+public:
+  Interner() = default;
+  ~Interner() = default;
+
+  Interner(const Interner &) = delete;
+  Interner &operator=(const Interner &) = delete;
+  Interner(Interner &&) = delete;
+  Interner &operator=(Interner &&) = delete;
+
+  /// Returns the handle of Value and assigns a fresh id to Value if it has not
+  /// been interned before.
+  [[nodiscard]] Interned<T> intern(const T &Value) {
+    auto Search = Ids.find(Value);
+    if (Search != Ids.end()) {
+      return {this, Search->second};
+    }
+    return insert(Value);
+  }
+
+  [[nodiscard]] Interned<T> intern(T &&Value) {
+    auto Search = Ids.find(Value);
+    if (Search != Ids.end()) {
+      return {this, Search->second};
+    }
+    return insert(std::move(Value));
+  }
+
+  /// Returns the handle of Value if it has been interned before.
+  [[nodiscard]] std::optional<Interned<T>> find(const T &Value) const {
+    auto Search = Ids.find(Value);
+    if (Search == Ids.end()) {
+      return std::nullopt;
+    }
+    return Interned<T>(this, Search->second);
+  }
+
+  /// Returns the handle of the value with the given id.
+  [[nodiscard]] Interned<T> getHandle(uint32_t Id) const {
+    assert(Id < Values.size() && "Id has not been assigned by this interner");
+    return {this, Id};
+  }
+
+  [[nodiscard]] const T &getValue(uint32_t Id) const {
+    assert(Id < Values.size() && "Id has not been assigned by this interner");
+    return *Values[Id];
+  }
+
+  [[nodiscard]] size_t size() const noexcept { return Values.size(); }
+
+  [[nodiscard]] bool empty() const noexcept { return Values.empty(); }
+
+private:
+  template <typename ValueT> Interned<T> insert(ValueT &&Value) {
+    assert(Values.size() < std::numeric_limits<uint32_t>::max() &&
+           "Too many values for 32-bit ids");
+    auto Id = static_cast<uint32_t>(Values.size());
+    auto It = Ids.emplace(std::forward<ValueT>(Value), Id).first;
+    // the keys of a node-based map are stable across rehashing
+    Values.push_back(&It->first);
+    return {this, Id};
+  }
+
+  std::unordered_map<T, uint32_t> Ids;
+  std::vector<const T *> Values;
+};
+
+} // namespace psr
+
+namespace std {
+template <typename T> struct hash<psr::Interned<T>> {
+  size_t operator()(psr::Interned<T> Fact) const noexcept {
+    return std::hash<uint32_t>{}(Fact.getId());
+  }
+};
+} // namespace std
+
+#endif
@@ -77,7 +77,7 @@ public:
     Tab[Row][Column] = std::move(Val);
   }
 
-  void insert(const Table &T) { Tab.insert(T.table.begin(), T.table.end()); }
+  void insert(const Table &T) { Tab.insert(T.Tab.begin(), T.Tab.end()); }
 
   void clear() { Tab.clear(); }
 
@@ -96,6 +96,16 @@ public:
     return Result;
   }
 
+  template <typename HandlerFn> void forEachCell(HandlerFn &&Handler) const {
+    // Calls Handler(row key, column key, value) for all triplets without
+    // materializing the cells.
+    for (const auto &M1 : Tab) {
+      for (const auto &M2 : M1.second) {
+        Handler(M1.first, M2.first, M2.second);
+      }
+    }
+  }
+
   [[nodiscard]] std::vector<Cell> cellVec() const {
     // Returns a vector of all row key / column key / value triplets.
     std::vector<Cell> Result;
@@ -184,6 +194,12 @@ public:
     return Tab[RowKey][ColumnKey];
   }
 
+  [[nodiscard]] const V &get(R RowKey, C ColumnKey) const {
+    // Returns the value corresponding to the given row and column keys; the
+    // mapping must exist.
+    return Tab.at(RowKey).at(ColumnKey);
+  }
+
   V remove(R RowKey, C ColumnKey) {
     // Removes the mapping, if any, associated with the given keys.
     V Val = Tab[RowKey][ColumnKey];
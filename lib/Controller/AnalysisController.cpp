@@ -45,7 +45,8 @@ namespace psr {
 bool needsToEmitPTA(AnalysisControllerEmitterOptions EmitterOptions) {
   return (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsDot) ||
          (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsJson) ||
-         (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsText);
+         (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsText) ||
+         (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsBinary);
 }
 
 AnalysisController::AnalysisController(
@@ -56,15 +57,27 @@ AnalysisController::AnalysisController(
     AnalysisStrategy Strategy, AnalysisControllerEmitterOptions EmitterOptions,
     IFDSIDESolverConfig SolverConfig, const std::string &ProjectID,
     const std::string &OutDirectory,
-    const nlohmann::json &PrecomputedPointsToInfo)
+    const nlohmann::json &PrecomputedPointsToInfo,
+    const llvm::MemoryBuffer *PrecomputedPointsToBinary,
+    std::vector<std::string> BaseModules,
+    std::vector<std::string> Configurations)
     : IRDB(IRDB), TH(IRDB),
-      PT(PrecomputedPointsToInfo.empty()
+      PT(PrecomputedPointsToBinary
+             ? LLVMPointsToSet(IRDB,
+                               PrecomputedPointsToBinary->getMemBufferRef(),
+                               PTATy)
+         : PrecomputedPointsToInfo.empty()
              ? LLVMPointsToSet(IRDB, !needsToEmitPTA(EmitterOptions), PTATy)
              : LLVMPointsToSet(IRDB, PrecomputedPointsToInfo)),
-      ICF(IRDB, CGTy, EntryPoints, &TH, &PT, SoundnessLevel, AutoGlobalSupport),
+      // Global constructors can only be modeled for a single (linked) module
+      ICF(IRDB, CGTy, EntryPoints, &TH, &PT, SoundnessLevel,
+          AutoGlobalSupport && Strategy != AnalysisStrategy::ModuleWise,
+          SolverConfig.numThreads()),
       DataFlowAnalyses(std::move(DataFlowAnalyses)),
       AnalysisConfigs(std::move(AnalysisConfigs)), EntryPoints(EntryPoints),
-      Strategy(Strategy), EmitterOptions(EmitterOptions), ProjectID(ProjectID),
+      BaseModules(std::move(BaseModules)),
+      Configurations(std::move(Configurations)), Strategy(Strategy),
+      EmitterOptions(EmitterOptions), ProjectID(ProjectID),
       OutDirectory(OutDirectory), SolverConfig(SolverConfig),
       SoundnessLevel(SoundnessLevel), AutoGlobalSupport(AutoGlobalSupport) {
   if (!OutDirectory.empty()) {
@@ -80,16 +93,16 @@ AnalysisController::AnalysisController(
 void AnalysisController::executeAs(AnalysisStrategy Strategy) {
   switch (Strategy) {
   case AnalysisStrategy::DemandDriven:
-    llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
+    executeDemandDriven();
     break;
   case AnalysisStrategy::Incremental:
-    llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
+    executeIncremental();
     break;
   case AnalysisStrategy::ModuleWise:
-    llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
+    executeModuleWise();
     break;
   case AnalysisStrategy::Variational:
-    llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
+    executeVariational();
     break;
   case AnalysisStrategy::WholeProgram:
     executeWholeProgram();
@@ -99,17 +112,81 @@ void AnalysisController::executeAs(AnalysisStrategy Strategy) {
   }
 }
 
-void AnalysisController::executeDemandDriven() {}
+// The executeX() functions of the analyses dispatch on the strategy
+// themselves, so all strategies run the same analyses.
+void AnalysisController::executeDemandDriven() { executeDataFlowAnalyses(); }
 
-void AnalysisController::executeIncremental() {}
+void AnalysisController::executeIncremental() { executeDataFlowAnalyses(); }
 
-void AnalysisController::executeModuleWise() {}
+void AnalysisController::executeModuleWise() { executeDataFlowAnalyses(); }
 
-void AnalysisController::executeVariational() {}
+void AnalysisController::executeVariational() { executeDataFlowAnalyses(); }
 
-void AnalysisController::executeWholeProgram() {
+void AnalysisController::executeWholeProgram() { executeDataFlowAnalyses(); }
+
+std::vector<const llvm::Instruction *>
+AnalysisController::getQueryLocations() const {
+  std::vector<const llvm::Instruction *> Locations;
+  auto AddExitPoints = [this, &Locations](const llvm::Function *F) {
+    if (F && !F->isDeclaration()) {
+      const auto ExitPoints = ICF.getExitPointsOf(F);
+      Locations.insert(Locations.end(), ExitPoints.begin(), ExitPoints.end());
+    }
+  };
+  if (EntryPoints.count("__ALL__")) {
+    for (const auto *F : IRDB.getAllFunctions()) {
+      AddExitPoints(F);
+    }
+  } else {
+    for (const auto &EntryPoint : EntryPoints) {
+      AddExitPoints(IRDB.getFunctionDefinition(EntryPoint));
+    }
+  }
+  return Locations;
+}
+
+void AnalysisController::reportUnsupportedStrategy() {
+  if (Strategy == AnalysisStrategy::Variational) {
+    llvm::errs() << "Only IFDS analyses are supported by the " << Strategy
+                 << " strategy, yet.\n";
+    return;
+  }
+  llvm::errs() << "Monotone analyses are not supported by the " << Strategy
+               << " strategy, please use an IFDS or IDE analysis instead.\n";
+}
+
+TaintConfig AnalysisController::loadTaintConfig(ProjectIRDB &DB) {
+  std::string AnalysisConfigPath =
+      (0 < AnalysisConfigs.size()) ? AnalysisConfigs[0] : "";
+  return !AnalysisConfigPath.empty()
+             ? TaintConfig(DB, parseTaintConfig(AnalysisConfigPath))
+             : TaintConfig(DB);
+}
+
+bool AnalysisController::loadBaseIRDB() {
+  if (BaseIRDB) {
+    return true;
+  }
+  if (BaseModules.empty()) {
+    llvm::errs() << "The incremental analysis requires the modules of the "
+                    "previous program version!\n";
+    return false;
+  }
+  BaseIRDB = std::make_unique<ProjectIRDB>(BaseModules);
+  return true;
+}
+
+void AnalysisController::executeDataFlowAnalyses() {
   size_t ConfigIdx = 0;
   for (const auto &DataFlowAnalysis : DataFlowAnalyses) {
+    // Each analysis, together with its configuration, has a summary store of
+    // its own
+    std::string SummariesID = toString(DataFlowAnalysis);
+    if (!AnalysisConfigs.empty()) {
+      SummariesID +=
+          "-" + std::filesystem::path(AnalysisConfigs[0]).stem().string();
+    }
+    SolverConfig.setPersistedSummariesID(std::move(SummariesID));
     switch (DataFlowAnalysis) {
     case DataFlowAnalysisType::IFDSUninitializedVariables: {
       executeIFDSUninitVar();
@@ -244,6 +321,15 @@ void AnalysisController::emitRequestedHelperAnalysisResults() {
       PT.printAsJson();
     }
   }
+  if (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsBinary) {
+    if (!ResultDirectory.empty()) {
+      if (auto OFS = openFileStream("/psr-pta.bin")) {
+        PT.printAsBinary(IRDB, *OFS);
+      }
+    } else {
+      PT.printAsBinary(IRDB, llvm::outs());
+    }
+  }
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitCGAsText) {
     if (!ResultDirectory.empty()) {
       if (auto OFS = openFileStream("/psr-cg.txt")) {
@@ -15,11 +15,7 @@ namespace psr {
 
 void AnalysisController::executeIDEOpenSSLTS() {
   OpenSSLEVPKDFDescription TSDesc;
-  WholeProgramAnalysis<IDESolver_P<IDETypeStateAnalysis>, IDETypeStateAnalysis>
-      WPA(SolverConfig, IRDB, &TSDesc, EntryPoints, &PT, &ICF, &TH);
-  WPA.solve();
-  emitRequestedDataFlowResults(WPA);
-  WPA.releaseAllHelperAnalyses();
+  executeIDEAnalysis<IDETypeStateAnalysis>(TSDesc);
 }
 
 } // namespace psr
@@ -14,11 +14,14 @@
  *      Author: pdschbrt
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <initializer_list>
 #include <memory>
 #include <ostream>
+#include <thread>
 
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SmallVector.h"
@@ -126,14 +129,18 @@ std::string LLVMBasedICFG::EdgeProperties::getCallSiteAsString() const {
 LLVMBasedICFG::LLVMBasedICFG(const LLVMBasedICFG &ICF)
     : IRDB(ICF.IRDB), CGType(ICF.CGType), S(ICF.S), TH(ICF.TH), PT(ICF.PT),
       // TODO copy resolver
-      Res(nullptr), VisitedFunctions(ICF.VisitedFunctions),
-      CallGraph(ICF.CallGraph), FunctionVertexMap(ICF.FunctionVertexMap) {}
+      Res(nullptr), NumThreads(ICF.NumThreads),
+      VisitedFunctions(ICF.VisitedFunctions),
+      CallGraph(ICF.CallGraph), FunctionVertexMap(ICF.FunctionVertexMap),
+      CalleeIndex(ICF.CalleeIndex), CallerIndex(ICF.CallerIndex) {}
 
 LLVMBasedICFG::LLVMBasedICFG(ProjectIRDB &IRDB, CallGraphAnalysisType CGType,
                              const std::set<std::string> &EntryPoints,
                              LLVMTypeHierarchy *TH, LLVMPointsToInfo *PT,
-                             Soundness S, bool IncludeGlobals)
-    : IRDB(IRDB), CGType(CGType), S(S), TH(TH), PT(PT) {
+                             Soundness S, bool IncludeGlobals,
+                             unsigned NumThreads)
+    : IRDB(IRDB), CGType(CGType), S(S), TH(TH), PT(PT),
+      NumThreads(std::max(NumThreads, 1U)) {
   PAMM_GET_INSTANCE;
   // check for faults in the logic
   if (!TH && (CGType != CallGraphAnalysisType::NORESOLVE)) {
@@ -148,10 +155,6 @@ LLVMBasedICFG::LLVMBasedICFG(ProjectIRDB &IRDB, CallGraphAnalysisType CGType,
     this->PT = new LLVMPointsToSet(IRDB);
     UserPTInfos = false;
   }
-  if (this->PT == nullptr) {
-    llvm::report_fatal_error("LLVMPointsToInfo not passed and "
-                             "CallGraphAnalysisType::OTF was not specified.");
-  }
   if (EntryPoints.count("__ALL__")) {
     // Handle the special case in which a user wishes to treat all functions as
     // entry points.
@@ -181,7 +184,7 @@ LLVMBasedICFG::LLVMBasedICFG(ProjectIRDB &IRDB, CallGraphAnalysisType CGType,
                       UserEntryPoints.end());
   }
   // instantiate the respective resolver type
-  Res = makeResolver(IRDB, *this->TH, *this->PT);
+  Res = makeResolver(IRDB, *this->TH, this->PT);
   PHASAR_LOG_LEVEL(INFO, "Starting CallGraphAnalysisType: " << CGType);
   VisitedFunctions.reserve(IRDB.getAllFunctions().size());
   bool FixpointReached;
@@ -193,17 +196,15 @@ LLVMBasedICFG::LLVMBasedICFG(ProjectIRDB &IRDB, CallGraphAnalysisType CGType,
       processFunction(F, *Res, FixpointReached);
     }
 
-    for (auto [CS, _] : IndirectCalls) {
-      FixpointReached &= !constructDynamicCall(CS, *Res);
-    }
-
+    FixpointReached &= !resolveIndirectCalls(*Res);
   } while (!FixpointReached);
-  for (const auto &[IndirectCall, Targets] : IndirectCalls) {
-    if (Targets == 0) {
+  for (const auto &[IndirectCall, Info] : IndirectCalls) {
+    if (Info.NumTargets == 0) {
       PHASAR_LOG_LEVEL(WARNING, "No callees found for callsite "
                                     << llvmIRToString(IndirectCall));
     }
   }
+  buildCallGraphIndex();
   REG_COUNTER("CG Vertices", getNumOfVertices(), PAMM_SEVERITY_LEVEL::Full);
   REG_COUNTER("CG Edges", getNumOfEdges(), PAMM_SEVERITY_LEVEL::Full);
   PHASAR_LOG_LEVEL(INFO, "Call graph has been constructed");
@@ -267,7 +268,7 @@ void LLVMBasedICFG::processFunction(const llvm::Function *F, Resolver &Resolver,
           // the function call must be resolved dynamically
           PHASAR_LOG_LEVEL(DEBUG, "Found dynamic call-site: "
                                       << "  " << llvmIRToString(CS));
-          IndirectCalls[CS] = 0;
+          IndirectCalls.try_emplace(CS);
 
           FixpointReached = false;
           continue;
@@ -308,84 +309,154 @@ void LLVMBasedICFG::processFunction(const llvm::Function *F, Resolver &Resolver,
 
 bool LLVMBasedICFG::constructDynamicCall(const llvm::Instruction *I,
                                          Resolver &Resolver) {
+  if (const auto *CallSite = llvm::dyn_cast<llvm::CallBase>(I)) {
+    Resolver.preCall(I);
 
-  bool NewTargetsFound = false;
+    // the function call must be resolved dynamically
+    PHASAR_LOG_LEVEL(DEBUG, "Looking into dynamic call-site: ");
+    PHASAR_LOG_LEVEL(DEBUG, "  " << llvmIRToString(I));
+    // call the resolve routine
+    return addDynamicCallTargets(CallSite, Resolver,
+                                 resolveIndirectCall(CallSite, Resolver));
+  }
+  Resolver.otherInst(I);
+  return false;
+}
+
+bool LLVMBasedICFG::addDynamicCallTargets(
+    const llvm::CallBase *CallSite, Resolver &Resolver,
+    Resolver::FunctionSetTy PossibleTargets) {
   // Find vertex of calling function.
   vertex_t ThisFunctionVertexDescriptor;
-  auto FvmItr = FunctionVertexMap.find(I->getFunction());
+  auto FvmItr = FunctionVertexMap.find(CallSite->getFunction());
   if (FvmItr != FunctionVertexMap.end()) {
     ThisFunctionVertexDescriptor = FvmItr->second;
   } else {
     PHASAR_LOG_LEVEL(
         ERROR, "constructDynamicCall: Did not find vertex of calling function "
-                   << I->getFunction()->getName() << " at callsite "
-                   << llvmIRToString(I));
+                   << CallSite->getFunction()->getName() << " at callsite "
+                   << llvmIRToString(CallSite));
     std::terminate();
   }
 
-  if (const auto *CallSite = llvm::dyn_cast<llvm::CallBase>(I)) {
-    Resolver.preCall(I);
-
-    // the function call must be resolved dynamically
-    PHASAR_LOG_LEVEL(DEBUG, "Looking into dynamic call-site: ");
-    PHASAR_LOG_LEVEL(DEBUG, "  " << llvmIRToString(I));
-    // call the resolve routine
-
-    auto PossibleTargets = LLVMBasedICFG::isVirtualFunctionCall(CallSite)
-                               ? Resolver.resolveVirtualCall(CallSite)
-                               : Resolver.resolveFunctionPointer(CallSite);
+  assert(IndirectCalls.count(CallSite));
+  auto &Info = IndirectCalls[CallSite];
 
-    assert(IndirectCalls.count(I));
+  if (Info.NumTargets >= PossibleTargets.size()) {
+    return false;
+  }
+  PHASAR_LOG_LEVEL(DEBUG, "Found " << PossibleTargets.size() - Info.NumTargets
+                                   << " new possible target(s)");
+  Info.NumTargets = PossibleTargets.size();
 
-    if (IndirectCalls[I] < PossibleTargets.size()) {
-      PHASAR_LOG_LEVEL(DEBUG, "Found "
-                                  << PossibleTargets.size() - IndirectCalls[I]
-                                  << " new possible target(s)");
-      IndirectCalls[I] = PossibleTargets.size();
-      NewTargetsFound = true;
-    }
-    if (!NewTargetsFound) {
-      return NewTargetsFound;
+  // Throw out already found targets
+  for (const auto &OE : boost::make_iterator_range(
+           boost::out_edges(ThisFunctionVertexDescriptor, CallGraph))) {
+    if (CallGraph[OE].CS == CallSite) {
+      PossibleTargets.erase(CallGraph[boost::target(OE, CallGraph)].F);
     }
-    // Throw out already found targets
-    for (const auto &OE : boost::make_iterator_range(
-             boost::out_edges(ThisFunctionVertexDescriptor, CallGraph))) {
-      if (CallGraph[OE].CS == I) {
-        PossibleTargets.erase(CallGraph[boost::target(OE, CallGraph)].F);
-      }
-    }
-    Resolver.handlePossibleTargets(CallSite, PossibleTargets);
-    // Insert possible target inside the graph and add the link with
-    // the current function
-    for (const auto &PossibleTarget : PossibleTargets) {
-      vertex_t TargetVertex;
-      auto TargetFvmItr = FunctionVertexMap.find(PossibleTarget);
-      if (TargetFvmItr != FunctionVertexMap.end()) {
-        TargetVertex = TargetFvmItr->second;
-      } else {
-        TargetVertex =
-            boost::add_vertex(VertexProperties(PossibleTarget), CallGraph);
-        FunctionVertexMap[PossibleTarget] = TargetVertex;
-      }
-      boost::add_edge(ThisFunctionVertexDescriptor, TargetVertex,
-                      EdgeProperties(I), CallGraph);
+  }
+  Resolver.handlePossibleTargets(CallSite, PossibleTargets);
+  // Insert possible target inside the graph and add the link with
+  // the current function
+  for (const auto &PossibleTarget : PossibleTargets) {
+    vertex_t TargetVertex;
+    auto TargetFvmItr = FunctionVertexMap.find(PossibleTarget);
+    if (TargetFvmItr != FunctionVertexMap.end()) {
+      TargetVertex = TargetFvmItr->second;
+    } else {
+      TargetVertex =
+          boost::add_vertex(VertexProperties(PossibleTarget), CallGraph);
+      FunctionVertexMap[PossibleTarget] = TargetVertex;
     }
+    boost::add_edge(ThisFunctionVertexDescriptor, TargetVertex,
+                    EdgeProperties(CallSite), CallGraph);
+  }
 
-    // continue resolving
-    FunctionWL.insert(FunctionWL.end(), PossibleTargets.begin(),
-                      PossibleTargets.end());
+  // continue resolving
+  FunctionWL.insert(FunctionWL.end(), PossibleTargets.begin(),
+                    PossibleTargets.end());
 
-    Resolver.postCall(I);
-  } else {
-    Resolver.otherInst(I);
+  Resolver.postCall(CallSite);
+  return true;
+}
+
+bool LLVMBasedICFG::resolveIndirectCalls(Resolver &Resolver) {
+  // Only resolve the calls that have not been resolved yet or whose
+  // resolution may have changed.
+  std::vector<const llvm::CallBase *> Pending;
+  for (auto &[I, Info] : IndirectCalls) {
+    const auto *CallSite = llvm::cast<llvm::CallBase>(I);
+    auto Version = Resolver.getResolutionVersion(CallSite);
+    if (Info.ResolvedVersion != Version) {
+      Info.ResolvedVersion = Version;
+      Pending.push_back(CallSite);
+    }
+  }
+  PHASAR_LOG_LEVEL(DEBUG, "Resolving " << Pending.size() << " of "
+                                       << IndirectCalls.size()
+                                       << " indirect call-site(s)");
+
+  bool NewTargetsFound = false;
+  if (NumThreads <= 1 || Pending.size() <= 1 ||
+      !Resolver.isResolutionThreadSafe()) {
+    for (const auto *CallSite : Pending) {
+      NewTargetsFound |= constructDynamicCall(CallSite, Resolver);
+    }
+    return NewTargetsFound;
   }
 
+  std::vector<Resolver::FunctionSetTy> PossibleTargets(Pending.size());
+  std::atomic<size_t> Next{0};
+  auto ResolveCalls = [&] {
+    for (size_t Idx = Next++; Idx < Pending.size(); Idx = Next++) {
+      PossibleTargets[Idx] = resolveIndirectCall(Pending[Idx], Resolver);
+    }
+  };
+  std::vector<std::thread> Workers;
+  size_t NumWorkers = std::min<size_t>(NumThreads, Pending.size());
+  for (size_t W = 1; W < NumWorkers; ++W) {
+    Workers.emplace_back(ResolveCalls);
+  }
+  ResolveCalls();
+  for (auto &Worker : Workers) {
+    Worker.join();
+  }
+  // Update the call-graph in the same order as the sequential resolution
+  for (size_t Idx = 0; Idx < Pending.size(); ++Idx) {
+    NewTargetsFound |= addDynamicCallTargets(Pending[Idx], Resolver,
+                                             std::move(PossibleTargets[Idx]));
+  }
   return NewTargetsFound;
 }
 
+Resolver::FunctionSetTy
+LLVMBasedICFG::resolveIndirectCall(const llvm::CallBase *CallSite,
+                                   Resolver &Resolver) const {
+  return LLVMBasedICFG::isVirtualFunctionCall(CallSite)
+             ? Resolver.resolveVirtualCall(CallSite)
+             : Resolver.resolveFunctionPointer(CallSite);
+}
+
+void LLVMBasedICFG::buildCallGraphIndex() {
+  llvm::DenseMap<const llvm::Instruction *, std::vector<const llvm::Function *>>
+      CalleesOf;
+  llvm::DenseMap<const llvm::Function *, std::vector<const llvm::Instruction *>>
+      CallersOf;
+  for (auto EdgeIt : boost::make_iterator_range(boost::edges(CallGraph))) {
+    const llvm::Instruction *CS = CallGraph[EdgeIt].CS;
+    const llvm::Function *Callee =
+        CallGraph[boost::target(EdgeIt, CallGraph)].F;
+    CalleesOf[CS].push_back(Callee);
+    CallersOf[Callee].push_back(CS);
+  }
+  CalleeIndex.build(std::move(CalleesOf));
+  CallerIndex.build(std::move(CallersOf));
+}
+
 std::unique_ptr<Resolver> LLVMBasedICFG::makeResolver(ProjectIRDB &IRDB,
                                                       LLVMTypeHierarchy &TH,
-                                                      LLVMPointsToInfo &PT) {
+                                                      LLVMPointsToInfo *PT) {
   switch (CGType) {
   case (CallGraphAnalysisType::NORESOLVE):
     return make_unique<NOResolver>(IRDB);
@@ -400,7 +471,7 @@ std::unique_ptr<Resolver> LLVMBasedICFG::makeResolver(ProjectIRDB &IRDB,
     return make_unique<DTAResolver>(IRDB, TH);
     break;
   case (CallGraphAnalysisType::OTF):
-    return make_unique<OTFResolver>(IRDB, TH, *this, PT);
+    return make_unique<OTFResolver>(IRDB, TH, *this, *PT);
     break;
   default:
     llvm::report_fatal_error("Resolver strategy not properly instantiated");
@@ -433,6 +504,10 @@ bool LLVMBasedICFG::isVirtualFunctionCall(const llvm::Instruction *N) const {
 }
 
 const llvm::Function *LLVMBasedICFG::getFunction(const string &Fun) const {
+  // If the modules are not linked, another module may merely declare Fun
+  if (const auto *Def = IRDB.getFunctionDefinition(Fun)) {
+    return Def;
+  }
   return IRDB.getFunction(Fun);
 }
 
@@ -516,6 +591,9 @@ size_t LLVMBasedICFG::removeEdges(const llvm::Function *F,
       ++EdgesRemoved;
     }
   }
+  if (EdgesRemoved) {
+    buildCallGraphIndex();
+  }
   return EdgesRemoved;
 }
 
@@ -527,6 +605,7 @@ bool LLVMBasedICFG::removeVertex(const llvm::Function *F) {
 
   boost::remove_vertex(FunctionMapIt->second, CallGraph);
   FunctionVertexMap.erase(FunctionMapIt);
+  buildCallGraphIndex();
   return true;
 }
 
@@ -542,28 +621,16 @@ size_t LLVMBasedICFG::getCallerCount(const llvm::Function *F) const {
 
 set<const llvm::Function *>
 LLVMBasedICFG::getCalleesOfCallAt(const llvm::Instruction *N) const {
-  if (!llvm::isa<llvm::CallBase>(N)) {
-    return {};
-  }
+  auto Callees = getCalleesOfCallAtRef(N);
+  return {Callees.begin(), Callees.end()};
+}
 
-  auto MapEntry = FunctionVertexMap.find(N->getFunction());
-  if (MapEntry == FunctionVertexMap.end()) {
+llvm::ArrayRef<const llvm::Function *>
+LLVMBasedICFG::getCalleesOfCallAtRef(const llvm::Instruction *N) const {
+  if (!llvm::isa<llvm::CallBase>(N)) {
     return {};
   }
-
-  set<const llvm::Function *> Callees;
-
-  out_edge_iterator EI;
-  out_edge_iterator EIEnd;
-  for (boost::tie(EI, EIEnd) = boost::out_edges(MapEntry->second, CallGraph);
-       EI != EIEnd; ++EI) {
-    auto Edge = CallGraph[*EI];
-    if (N == Edge.CS) {
-      auto Target = boost::target(*EI, CallGraph);
-      Callees.insert(CallGraph[Target].F);
-    }
-  }
-  return Callees;
+  return CalleeIndex.lookup(N);
 }
 
 void LLVMBasedICFG::forEachCalleeOfCallAt(
@@ -573,40 +640,20 @@ void LLVMBasedICFG::forEachCalleeOfCallAt(
     return;
   }
 
-  auto MapEntry = FunctionVertexMap.find(I->getFunction());
-  if (MapEntry == FunctionVertexMap.end()) {
-    return;
-  }
-
-  out_edge_iterator EI;
-
-  out_edge_iterator EIEnd;
-  for (boost::tie(EI, EIEnd) = boost::out_edges(MapEntry->second, CallGraph);
-       EI != EIEnd; ++EI) {
-    auto Edge = CallGraph[*EI];
-    if (I == Edge.CS) {
-      auto Target = boost::target(*EI, CallGraph);
-      Callback(CallGraph[Target].F);
-    }
+  for (const auto *Callee : CalleeIndex.lookup(I)) {
+    Callback(Callee);
   }
 }
 
 set<const llvm::Instruction *>
 LLVMBasedICFG::getCallersOf(const llvm::Function *F) const {
-  set<const llvm::Instruction *> CallersOf;
-  auto MapEntry = FunctionVertexMap.find(F);
-  if (MapEntry == FunctionVertexMap.end()) {
-    return CallersOf;
-  }
-  in_edge_iterator EI;
+  auto Callers = getCallersOfRef(F);
+  return {Callers.begin(), Callers.end()};
+}
 
-  in_edge_iterator EIEnd;
-  for (boost::tie(EI, EIEnd) = boost::in_edges(MapEntry->second, CallGraph);
-       EI != EIEnd; ++EI) {
-    auto Edge = CallGraph[*EI];
-    CallersOf.insert(Edge.CS);
-  }
-  return CallersOf;
+llvm::ArrayRef<const llvm::Instruction *>
+LLVMBasedICFG::getCallersOfRef(const llvm::Function *F) const {
+  return CallerIndex.lookup(F);
 }
 
 set<const llvm::Instruction *>
@@ -1029,6 +1076,7 @@ void LLVMBasedICFG::mergeWith(const LLVMBasedICFG &Other) {
   // Merge the already visited functions
   VisitedFunctions.insert(Other.VisitedFunctions.begin(),
                           Other.VisitedFunctions.end());
+  buildCallGraphIndex();
   // Merge the points-to graphs
   // WholeModulePTG.mergeWith(Other.WholeModulePTG, Calls);
 }
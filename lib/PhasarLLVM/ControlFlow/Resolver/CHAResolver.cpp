@@ -70,3 +70,5 @@ auto CHAResolver::resolveVirtualCall(const llvm::CallBase *CallSite)
   }
   return PossibleCallees;
 }
+
+bool CHAResolver::isResolutionThreadSafe() const { return true; }
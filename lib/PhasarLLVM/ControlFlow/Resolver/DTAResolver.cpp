@@ -149,11 +149,19 @@ void DTAResolver::otherInst(const llvm::Instruction *Inst) {
 
     if (SrcStructType && DestStructType &&
         heuristicAntiConstructorVtablePos(BitCast)) {
-      TypeGraph.addLink(DestStructType, SrcStructType);
+      if (TypeGraph.addLink(DestStructType, SrcStructType)) {
+        ++TypeGraphVersion;
+      }
     }
   }
 }
 
+size_t DTAResolver::getResolutionVersion(const llvm::CallBase * /*CallSite*/) {
+  return TypeGraphVersion;
+}
+
+bool DTAResolver::isResolutionThreadSafe() const { return false; }
+
 auto DTAResolver::resolveVirtualCall(const llvm::CallBase *CallSite)
     -> FunctionSetTy {
   FunctionSetTy PossibleCallTargets;
@@ -43,4 +43,6 @@ auto NOResolver::resolveFunctionPointer(const llvm::CallBase * /*CallSite*/)
 
 void NOResolver::otherInst(const llvm::Instruction *Inst) {}
 
+bool NOResolver::isResolutionThreadSafe() const { return true; }
+
 } // namespace psr
@@ -239,6 +239,21 @@ auto OTFResolver::resolveFunctionPointer(const llvm::CallBase *CallSite)
   return Callees;
 }
 
+size_t OTFResolver::getResolutionVersion(const llvm::CallBase *CallSite) {
+  // Both virtual calls and calls through function pointers are resolved using
+  // the points-to set of the called operand only. As points-to sets only grow,
+  // the resolution can only change if the set's size changes.
+  if (!CallSite->getCalledOperand()) {
+    return 0;
+  }
+  return PT.getPointsToSet(CallSite->getCalledOperand(), CallSite)->size();
+}
+
+bool OTFResolver::isResolutionThreadSafe() const {
+  // points-to sets may be computed lazily
+  return false;
+}
+
 std::set<const llvm::Type *>
 OTFResolver::getReachableTypes(const LLVMPointsToInfo::PointsToSetTy &Values) {
   std::set<const llvm::Type *> Types;
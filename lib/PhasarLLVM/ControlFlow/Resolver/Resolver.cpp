@@ -137,4 +137,10 @@ auto Resolver::resolveFunctionPointer(const llvm::CallBase *CallSite)
 
 void Resolver::otherInst(const llvm::Instruction *Inst) {}
 
+size_t Resolver::getResolutionVersion(const llvm::CallBase * /*CallSite*/) {
+  return 0;
+}
+
+bool Resolver::isResolutionThreadSafe() const { return false; }
+
 } // namespace psr
@@ -9,6 +9,10 @@
 
 #include <ios>
 #include <ostream>
+#include <utility>
+
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
 
@@ -17,6 +21,43 @@ using namespace psr;
 
 namespace psr {
 
+std::string toString(const PathEdgeSchedulingPolicy &P) {
+  switch (P) {
+#define PATH_EDGE_SCHEDULING_POLICY(NAME, CMDFLAG, TYPE)                       \
+  case PathEdgeSchedulingPolicy::TYPE:                                         \
+    return NAME;                                                               \
+    break;
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/PathEdgeSchedulingPolicy.def"
+  case PathEdgeSchedulingPolicy::Invalid:
+  default:
+    return "Invalid";
+  }
+}
+
+PathEdgeSchedulingPolicy toPathEdgeSchedulingPolicy(const std::string &S) {
+  PathEdgeSchedulingPolicy Type =
+      llvm::StringSwitch<PathEdgeSchedulingPolicy>(S)
+#define PATH_EDGE_SCHEDULING_POLICY(NAME, CMDFLAG, TYPE)                       \
+  .Case(NAME, PathEdgeSchedulingPolicy::TYPE)
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/PathEdgeSchedulingPolicy.def"
+          .Default(PathEdgeSchedulingPolicy::Invalid);
+  if (Type == PathEdgeSchedulingPolicy::Invalid) {
+    // the command-line flags are accepted in any case, e.g., "RPO"
+    std::string Flag = llvm::StringRef(S).lower();
+    Type = llvm::StringSwitch<PathEdgeSchedulingPolicy>(Flag)
+#define PATH_EDGE_SCHEDULING_POLICY(NAME, CMDFLAG, TYPE)                       \
+  .Case(CMDFLAG, PathEdgeSchedulingPolicy::TYPE)
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/PathEdgeSchedulingPolicy.def"
+               .Default(PathEdgeSchedulingPolicy::Invalid);
+  }
+  return Type;
+}
+
+llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
+                              const PathEdgeSchedulingPolicy &P) {
+  return OS << toString(P);
+}
+
 IFDSIDESolverConfig::IFDSIDESolverConfig(SolverConfigOptions Options) noexcept
     : Options(Options) {}
 
@@ -39,6 +80,30 @@ bool IFDSIDESolverConfig::computePersistedSummaries() const {
   return hasFlag(Options, SolverConfigOptions::ComputePersistedSummaries);
 }
 
+bool IFDSIDESolverConfig::generateSummaryPack() const {
+  return hasFlag(Options, SolverConfigOptions::GenerateSummaryPack);
+}
+PathEdgeSchedulingPolicy IFDSIDESolverConfig::schedulingPolicy() const {
+  return SchedulingPolicy;
+}
+unsigned IFDSIDESolverConfig::numThreads() const { return NumThreads; }
+size_t IFDSIDESolverConfig::edgeFunctionMemoSize() const {
+  return EdgeFunctionMemoSize;
+}
+size_t IFDSIDESolverConfig::flowEdgeFunctionCacheSize() const {
+  return FlowEdgeFunctionCacheSize;
+}
+const std::string &IFDSIDESolverConfig::persistedSummariesDirectory() const {
+  return PersistedSummariesDirectory;
+}
+const std::string &IFDSIDESolverConfig::persistedSummariesID() const {
+  return PersistedSummariesID;
+}
+
+const std::vector<std::string> &IFDSIDESolverConfig::summaryPacks() const {
+  return SummaryPacks;
+}
+
 void IFDSIDESolverConfig::setFollowReturnsPastSeeds(bool Set) {
   setFlag(Options, SolverConfigOptions::FollowReturnsPastSeeds, Set);
 }
@@ -58,6 +123,33 @@ void IFDSIDESolverConfig::setComputePersistedSummaries(bool Set) {
   setFlag(Options, SolverConfigOptions::ComputePersistedSummaries, Set);
 }
 
+void IFDSIDESolverConfig::setGenerateSummaryPack(bool Set) {
+  setFlag(Options, SolverConfigOptions::GenerateSummaryPack, Set);
+}
+void IFDSIDESolverConfig::setSchedulingPolicy(PathEdgeSchedulingPolicy Policy) {
+  SchedulingPolicy = Policy;
+}
+void IFDSIDESolverConfig::setNumThreads(unsigned Threads) {
+  NumThreads = Threads == 0 ? 1 : Threads;
+}
+void IFDSIDESolverConfig::setEdgeFunctionMemoSize(size_t Size) {
+  EdgeFunctionMemoSize = Size;
+}
+void IFDSIDESolverConfig::setFlowEdgeFunctionCacheSize(size_t Size) {
+  FlowEdgeFunctionCacheSize = Size;
+}
+void IFDSIDESolverConfig::setPersistedSummariesDirectory(
+    std::string Directory) {
+  PersistedSummariesDirectory = std::move(Directory);
+}
+void IFDSIDESolverConfig::setPersistedSummariesID(std::string ID) {
+  PersistedSummariesID = std::move(ID);
+}
+
+void IFDSIDESolverConfig::setSummaryPacks(std::vector<std::string> Paths) {
+  SummaryPacks = std::move(Paths);
+}
+
 void IFDSIDESolverConfig::setConfig(SolverConfigOptions Opt) { Options = Opt; }
 
 ostream &operator<<(ostream &OS, const IFDSIDESolverConfig &SC) {
@@ -69,7 +161,17 @@ ostream &operator<<(ostream &OS, const IFDSIDESolverConfig &SC) {
             << "\trecordEdges: " << SC.recordEdges() << "\n"
             << "\tcomputePersistedSummaries: " << SC.computePersistedSummaries()
             << "\n"
-            << "\temitESG: " << SC.emitESG();
+            << "\tpersistedSummariesDirectory: "
+            << SC.persistedSummariesDirectory() << "\n"
+            << "\tgenerateSummaryPack: " << SC.generateSummaryPack() << "\n"
+            << "\tsummaryPacks: " << SC.summaryPacks().size() << "\n"
+            << "\temitESG: " << SC.emitESG() << "\n"
+            << "\tschedulingPolicy: " << toString(SC.schedulingPolicy())
+            << "\n"
+            << "\tnumThreads: " << SC.numThreads() << "\n"
+            << "\tedgeFunctionMemoSize: " << SC.edgeFunctionMemoSize() << "\n"
+            << "\tflowEdgeFunctionCacheSize: "
+            << SC.flowEdgeFunctionCacheSize();
 }
 
 } // namespace psr
@@ -41,9 +41,12 @@ using namespace psr;
 
 namespace psr {
 // Initialize debug counter for edge functions
-unsigned IDELinearConstantAnalysis::CurrGenConstantId = 0; // NOLINT
-unsigned IDELinearConstantAnalysis::CurrLCAIDId = 0;       // NOLINT
-unsigned IDELinearConstantAnalysis::CurrBinaryId = 0;      // NOLINT
+// NOLINTNEXTLINE
+std::atomic<unsigned> IDELinearConstantAnalysis::CurrGenConstantId = 0;
+// NOLINTNEXTLINE
+std::atomic<unsigned> IDELinearConstantAnalysis::CurrLCAIDId = 0;
+// NOLINTNEXTLINE
+std::atomic<unsigned> IDELinearConstantAnalysis::CurrBinaryId = 0;
 
 const IDELinearConstantAnalysis::l_t IDELinearConstantAnalysis::TOP = Top{};
 
@@ -59,12 +62,6 @@ IDELinearConstantAnalysis::IDELinearConstantAnalysis(
       IDELinearConstantAnalysis::createZeroValue();
 }
 
-IDELinearConstantAnalysis::~IDELinearConstantAnalysis() {
-  CurrGenConstantId = 0;
-  CurrLCAIDId = 0;
-  CurrBinaryId = 0;
-}
-
 // Start formulating our analysis by specifying the parts required for IFDS
 
 IDELinearConstantAnalysis::FlowFunctionPtrType
@@ -532,6 +529,10 @@ bool IDELinearConstantAnalysis::GenConstant::equal_to(
   return this == Other.get();
 }
 
+llvm::hash_code IDELinearConstantAnalysis::GenConstant::getHashCode() const {
+  return llvm::hash_value(IntConst);
+}
+
 void IDELinearConstantAnalysis::GenConstant::print(llvm::raw_ostream &OS,
                                                    bool /*IsForDebug*/) const {
   OS << IntConst << " (EF:" << GenConstantId << ')';
@@ -47,6 +47,21 @@ IDETypeStateAnalysis::IDETypeStateAnalysis(const ProjectIRDB *IRDB,
     : IDETabulationProblem(IRDB, TH, ICF, PT, std::move(EntryPoints)), TSD(TSD),
       TOP(TSD.top()), BOTTOM(TSD.bottom()) {
   IDETabulationProblem::ZeroValue = IDETypeStateAnalysis::createZeroValue();
+  for (const auto *M : this->IRDB->getAllModules()) {
+    for (const auto &F : *M) {
+      std::string DemangledFname = llvm::demangle(F.getName().str());
+      if (!TSD.isAPIFunction(DemangledFname)) {
+        continue;
+      }
+      auto &Info = APIFunctions[&F];
+      Info.IsFactory = TSD.isFactoryFunction(DemangledFname);
+      Info.IsConsuming = TSD.isConsumingFunction(DemangledFname);
+      if (Info.IsConsuming) {
+        Info.ConsumerParamIdx = TSD.getConsumerParamIdx(DemangledFname);
+      }
+      Info.Token = std::move(DemangledFname);
+    }
+  }
 }
 
 // Start formulating our analysis by specifying the parts required for IFDS
@@ -141,7 +156,7 @@ IDETypeStateAnalysis::getCallFlowFunction(IDETypeStateAnalysis::n_t CallSite,
                                           IDETypeStateAnalysis::f_t DestFun) {
   // Kill all data-flow facts if we hit a function of the target API.
   // Those functions are modled within Call-To-Return.
-  if (TSD.isAPIFunction(llvm::demangle(DestFun->getName().str()))) {
+  if (getAPIFunctionInfo(DestFun)) {
     return KillAll<IDETypeStateAnalysis::d_t>::getInstance();
   }
   // Otherwise, if we have an ordinary function call, we can just use the
@@ -252,9 +267,9 @@ IDETypeStateAnalysis::getCallToRetFlowFunction(
     set<IDETypeStateAnalysis::f_t> Callees) {
   const auto *CS = llvm::cast<llvm::CallBase>(CallSite);
   for (const auto *Callee : Callees) {
-    std::string DemangledFname = llvm::demangle(Callee->getName().str());
+    const auto *APIInfo = getAPIFunctionInfo(Callee);
     // Generate the return value of factory functions from zero value
-    if (TSD.isFactoryFunction(DemangledFname)) {
+    if (APIInfo && APIInfo->IsFactory) {
       struct TSFlowFunction : FlowFunction<IDETypeStateAnalysis::d_t> {
         IDETypeStateAnalysis::d_t CS, ZeroValue;
 
@@ -286,7 +301,7 @@ IDETypeStateAnalysis::getCallToRetFlowFunction(
     // not be killed during call-to-return, since it is not safe to assume
     // that the return value will be used afterwards, i.e. is stored to memory
     // pointed to by related alloca's.
-    if (!TSD.isAPIFunction(DemangledFname) && !Callee->isDeclaration()) {
+    if (!APIInfo && !Callee->isDeclaration()) {
       for (const auto &Arg : CS->args()) {
         if (hasMatchingType(Arg)) {
           std::set<IDETypeStateAnalysis::d_t> FactsToKill =
@@ -386,11 +401,14 @@ IDETypeStateAnalysis::getCallToRetEdgeFunction(
     std::set<IDETypeStateAnalysis::f_t> Callees) {
   const auto *CS = llvm::cast<llvm::CallBase>(CallSite);
   for (const auto *Callee : Callees) {
-    std::string DemangledFname = llvm::demangle(Callee->getName().str());
+    const auto *APIInfo = getAPIFunctionInfo(Callee);
+    if (!APIInfo) {
+      continue;
+    }
 
     // For now we assume that we can only generate from the return value.
     // We apply the same edge function for the return value, i.e. callsite.
-    if (TSD.isFactoryFunction(DemangledFname)) {
+    if (APIInfo->IsFactory) {
       PHASAR_LOG_LEVEL(DEBUG, "Processing factory function");
       if (isZeroValue(CallNode) && RetSiteNode == CS) {
         struct TSFactoryEF : public TSConstant {
@@ -398,21 +416,25 @@ IDETypeStateAnalysis::getCallToRetEdgeFunction(
               : TSConstant(Tsd, State) {}
         };
         return make_shared<TSFactoryEF>(
-            TSD, TSD.getNextState(DemangledFname, TSD.uninit(), CS));
+            TSD, TSD.getNextState(APIInfo->Token, TSD.uninit(), CS));
       }
     }
 
     // For every consuming parameter and all its aliases and relevant alloca's
     // we apply the same edge function.
-    if (TSD.isConsumingFunction(DemangledFname)) {
+    if (APIInfo->IsConsuming) {
       PHASAR_LOG_LEVEL(DEBUG, "Processing consuming function");
-      for (auto Idx : TSD.getConsumerParamIdx(DemangledFname)) {
+      for (auto Idx : APIInfo->ConsumerParamIdx) {
         std::set<IDETypeStateAnalysis::d_t> PointsToAndAllocas =
             getWMAliasesAndAllocas(CS->getArgOperand(Idx));
 
         if (CallNode == RetSiteNode &&
             PointsToAndAllocas.find(CallNode) != PointsToAndAllocas.end()) {
-          return make_shared<TSEdgeFunction>(TSD, DemangledFname, CS);
+          if (TSD.getNumStates() == 0) {
+            return make_shared<TSUntabulatedEdgeFunction>(TSD, APIInfo->Token,
+                                                          CS);
+          }
+          return make_shared<TSEdgeFunction>(TSD, APIInfo->Token, CS);
         }
       }
     }
@@ -474,6 +496,128 @@ void IDETypeStateAnalysis::printEdgeFact(llvm::raw_ostream &OS,
   OS << TSD.stateToString(L);
 }
 
+IDETypeStateAnalysis::TSEdgeFunction::TSEdgeFunction(
+    const TypeStateDescription &TSD, const std::string &Tok,
+    const llvm::CallBase *CB)
+    : TSD(TSD) {
+  auto NumStates = TSD.getNumStates();
+  Table.reserve(NumStates + 1);
+  for (size_t State = 0; State < NumStates; ++State) {
+    Table.push_back(TSD.getNextState(Tok, l_t(State), CB));
+  }
+  // top() is treated as the uninitialized state
+  Table.push_back(TSD.getNextState(Tok, TSD.uninit(), CB));
+}
+
+size_t
+IDETypeStateAnalysis::TSEdgeFunction::getIndex(IDETypeStateAnalysis::l_t State)
+    const {
+  if (State == TSD.top()) {
+    return Table.size() - 1;
+  }
+  assert(State >= 0 && size_t(State) + 1 < Table.size() &&
+         "Invalid type state");
+  return State;
+}
+
+IDETypeStateAnalysis::l_t IDETypeStateAnalysis::TSEdgeFunction::computeTarget(
+    IDETypeStateAnalysis::l_t Source) {
+  auto CurrentState = Table[getIndex(Source)];
+  PHASAR_LOG_LEVEL(DEBUG, "State machine transition: ("
+                              << TSD.stateToString(Source) << ") -> "
+                              << TSD.stateToString(CurrentState));
+  return CurrentState;
+}
+
+std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>>
+IDETypeStateAnalysis::TSEdgeFunction::composeWith(
+    std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>> SecondFunction) {
+
+  if (auto *AB = dynamic_cast<AllBottom<IDETypeStateAnalysis::l_t> *>(
+          SecondFunction.get())) {
+    return this->shared_from_this();
+  }
+  if (auto *EI = dynamic_cast<EdgeIdentity<IDETypeStateAnalysis::l_t> *>(
+          SecondFunction.get())) {
+    return this->shared_from_this();
+  }
+  TransferTableTy Composed(Table.size());
+  if (const auto *Second = dynamic_cast<TSEdgeFunction *>(SecondFunction.get());
+      Second && Second->Table.size() == Table.size()) {
+    for (size_t Idx = 0; Idx < Table.size(); ++Idx) {
+      Composed[Idx] = Second->Table[getIndex(Table[Idx])];
+    }
+  } else {
+    for (size_t Idx = 0; Idx < Table.size(); ++Idx) {
+      Composed[Idx] = SecondFunction->computeTarget(Table[Idx]);
+    }
+  }
+  return make_shared<TSEdgeFunction>(TSD, std::move(Composed));
+}
+
+std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>>
+IDETypeStateAnalysis::TSEdgeFunction::joinWith(
+    std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>> OtherFunction) {
+  if (OtherFunction.get() == this ||
+      OtherFunction->equal_to(this->shared_from_this())) {
+    return this->shared_from_this();
+  }
+  if (auto *AT = dynamic_cast<AllTop<IDETypeStateAnalysis::l_t> *>(
+          OtherFunction.get())) {
+    return this->shared_from_this();
+  }
+  if (dynamic_cast<AllBottom<IDETypeStateAnalysis::l_t> *>(
+          OtherFunction.get())) {
+    return OtherFunction;
+  }
+  // Join element-wise with other transfer functions, constants and the
+  // identity; the last entry of the table belongs to top()
+  TransferTableTy Joined(Table.size());
+  bool IsBottom = true;
+  for (size_t Idx = 0; Idx < Table.size(); ++Idx) {
+    l_t Source = Idx + 1 == Table.size() ? TSD.top() : l_t(Idx);
+    l_t Lhs = Table[Idx];
+    l_t Rhs = OtherFunction->computeTarget(Source);
+    if (Lhs == Rhs || Rhs == TSD.top()) {
+      Joined[Idx] = Lhs;
+    } else if (Lhs == TSD.top()) {
+      Joined[Idx] = Rhs;
+    } else {
+      Joined[Idx] = TSD.bottom();
+    }
+    IsBottom &= Joined[Idx] == TSD.bottom();
+  }
+  if (IsBottom) {
+    return make_shared<AllBottom<IDETypeStateAnalysis::l_t>>(TSD.bottom());
+  }
+  return make_shared<TSEdgeFunction>(TSD, std::move(Joined));
+}
+
+bool IDETypeStateAnalysis::TSEdgeFunction::equal_to(
+    std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>> Other) const {
+  if (this == Other.get()) {
+    return true;
+  }
+  if (const auto *OtherTS = dynamic_cast<TSEdgeFunction *>(Other.get())) {
+    return &TSD == &OtherTS->TSD && Table == OtherTS->Table;
+  }
+  return false;
+}
+
+void IDETypeStateAnalysis::TSEdgeFunction::print(llvm::raw_ostream &OS,
+                                                 bool /*IsForDebug*/) const {
+  OS << "TSEF[";
+  for (size_t Idx = 0; Idx < Table.size(); ++Idx) {
+    l_t Source = Idx + 1 == Table.size() ? TSD.top() : l_t(Idx);
+    if (Idx) {
+      OS << ", ";
+    }
+    OS << TSD.stateToString(Source) << " -> "
+       << TSD.stateToString(Table[Idx]);
+  }
+  OS << ']';
+}
+
 shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>>
 IDETypeStateAnalysis::TSEdgeFunctionComposer::joinWith(
     shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>> OtherFunction) {
@@ -488,11 +632,9 @@ IDETypeStateAnalysis::TSEdgeFunctionComposer::joinWith(
   return make_shared<AllBottom<IDETypeStateAnalysis::l_t>>(BotElement);
 }
 
-IDETypeStateAnalysis::l_t IDETypeStateAnalysis::TSEdgeFunction::computeTarget(
+IDETypeStateAnalysis::l_t
+IDETypeStateAnalysis::TSUntabulatedEdgeFunction::computeTarget(
     IDETypeStateAnalysis::l_t Source) {
-
-  // assert((Source != TSD.top()) && "Error: call computeTarget with TOP\n");
-
   auto CurrentState = TSD.getNextState(
       Token, Source == TSD.top() ? TSD.uninit() : Source, CallSite);
   PHASAR_LOG_LEVEL(DEBUG, "State machine transition: ("
@@ -502,9 +644,8 @@ IDETypeStateAnalysis::l_t IDETypeStateAnalysis::TSEdgeFunction::computeTarget(
 }
 
 std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>>
-IDETypeStateAnalysis::TSEdgeFunction::composeWith(
+IDETypeStateAnalysis::TSUntabulatedEdgeFunction::composeWith(
     std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>> SecondFunction) {
-
   if (auto *AB = dynamic_cast<AllBottom<IDETypeStateAnalysis::l_t> *>(
           SecondFunction.get())) {
     return this->shared_from_this();
@@ -518,16 +659,12 @@ IDETypeStateAnalysis::TSEdgeFunction::composeWith(
 }
 
 std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>>
-IDETypeStateAnalysis::TSEdgeFunction::joinWith(
+IDETypeStateAnalysis::TSUntabulatedEdgeFunction::joinWith(
     std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>> OtherFunction) {
   if (OtherFunction.get() == this ||
       OtherFunction->equal_to(this->shared_from_this())) {
     return this->shared_from_this();
   }
-  // if (auto *EI = dynamic_cast<EdgeIdentity<IDETypeStateAnalysis::l_t> *>(
-  //         otherFunction.get())) {
-  //   return this->shared_from_this();
-  // }
   if (auto *AT = dynamic_cast<AllTop<IDETypeStateAnalysis::l_t> *>(
           OtherFunction.get())) {
     return this->shared_from_this();
@@ -535,17 +672,13 @@ IDETypeStateAnalysis::TSEdgeFunction::joinWith(
   return make_shared<AllBottom<IDETypeStateAnalysis::l_t>>(TSD.bottom());
 }
 
-bool IDETypeStateAnalysis::TSEdgeFunction::equal_to(
+bool IDETypeStateAnalysis::TSUntabulatedEdgeFunction::equal_to(
     std::shared_ptr<EdgeFunction<IDETypeStateAnalysis::l_t>> Other) const {
-  /*if (auto *TSEF =
-          dynamic_cast<IDETypeStateAnalysis::TSEdgeFunction *>(Other.get())) {
-    return this->CurrentState == TSEF->CurrentState;
-  }*/
   return this == Other.get();
 }
 
-void IDETypeStateAnalysis::TSEdgeFunction::print(llvm::raw_ostream &OS,
-                                                 bool /*IsForDebug*/) const {
+void IDETypeStateAnalysis::TSUntabulatedEdgeFunction::print(
+    llvm::raw_ostream &OS, bool /*IsForDebug*/) const {
   OS << "TSEF(" << Token << " at " << llvmIRToShortString(CallSite) << ")";
 }
 
@@ -592,6 +725,10 @@ auto IDETypeStateAnalysis::TSConstant::joinWith(
       return OtherFunction;
     }
   }
+  if (dynamic_cast<TSEdgeFunction *>(&*OtherFunction)) {
+    // joins element-wise
+    return OtherFunction->joinWith(shared_from_this());
+  }
   return make_shared<AllBottom<IDETypeStateAnalysis::l_t>>(TSD.bottom());
 }
 
@@ -699,6 +836,12 @@ IDETypeStateAnalysis::getLocalAliasesAndAllocas(IDETypeStateAnalysis::d_t V,
   PointsToAndAllocas.insert(RelevantAllocas.begin(), RelevantAllocas.end());
   return PointsToAndAllocas;
 }
+auto IDETypeStateAnalysis::getAPIFunctionInfo(const llvm::Function *F) const
+    -> const APIFunctionInfo * {
+  auto It = APIFunctions.find(F);
+  return It != APIFunctions.end() ? &It->second : nullptr;
+}
+
 bool hasMatchingTypeName(const llvm::Type *Ty, const std::string &Pattern) {
   if (const auto *StructTy = llvm::dyn_cast<llvm::StructType>(Ty)) {
     return StructTy->getName().contains(Pattern);
@@ -336,13 +336,28 @@ void IFDSTaintAnalysis::printFunction(llvm::raw_ostream &Os,
 }
 
 void IFDSTaintAnalysis::emitTextReport(
-    const SolverResults<n_t, d_t, BinaryDomain> & /*SR*/,
-    llvm::raw_ostream &OS) {
+    const SolverResults<n_t, d_t, BinaryDomain> &SR, llvm::raw_ostream &OS) {
+  // Only report the leaked facts that hold at their sinks according to SR,
+  // which may be a projection of the results, e.g., onto a configuration.
+  // SR is empty if the solver has not computed the values, though.
+  std::map<n_t, std::set<d_t>> ReportedLeaks;
+  if (SolverConfig.computeValues()) {
+    for (const auto &[CallSite, LeakedFacts] : Leaks) {
+      auto Facts = SR.ifdsResultsAt(CallSite);
+      for (const auto *LeakedFact : LeakedFacts) {
+        if (Facts.count(LeakedFact)) {
+          ReportedLeaks[CallSite].insert(LeakedFact);
+        }
+      }
+    }
+  } else {
+    ReportedLeaks = Leaks;
+  }
   OS << "\n----- Found the following leaks -----\n";
-  if (Leaks.empty()) {
+  if (ReportedLeaks.empty()) {
     OS << "No leaks found!\n";
   } else {
-    for (const auto &Leak : Leaks) {
+    for (const auto &Leak : ReportedLeaks) {
       OS << "At instruction\nIR  : " << llvmIRToString(Leak.first) << '\n';
       OS << "\n\nLeak(s):\n";
       for (const auto *LeakedValue : Leak.second) {
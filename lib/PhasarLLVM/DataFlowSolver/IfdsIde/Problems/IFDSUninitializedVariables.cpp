@@ -403,6 +403,16 @@ IFDSUninitializedVariables::initialSeeds() {
   InitialSeeds<IFDSUninitializedVariables::n_t, IFDSUninitializedVariables::d_t,
                IFDSUninitializedVariables::l_t>
       Seeds;
+  if (EntryPoints.size() == 1U && EntryPoints.count("__ALL__")) {
+    // Consider all available function definitions as entry points, e.g., to
+    // summarize a library
+    for (const auto *Fun : IRDB->getAllFunctions()) {
+      if (!Fun->isDeclaration()) {
+        Seeds.addSeed(&Fun->front().front(), getZeroValue());
+      }
+    }
+    return Seeds;
+  }
   for (const auto &EntryPoint : EntryPoints) {
     Seeds.addSeed(&ICF->getFunction(EntryPoint)->front().front(),
                   getZeroValue());
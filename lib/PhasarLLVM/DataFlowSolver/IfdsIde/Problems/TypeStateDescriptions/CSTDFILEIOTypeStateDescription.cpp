@@ -130,6 +130,11 @@ std::string CSTDFILEIOTypeStateDescription::stateToString(
   }
 }
 
+size_t CSTDFILEIOTypeStateDescription::getNumStates() const {
+  // BOT is the largest state besides TOP
+  return CSTDFILEIOState::BOT + 1;
+}
+
 TypeStateDescription::State CSTDFILEIOTypeStateDescription::bottom() const {
   return CSTDFILEIOState::BOT;
 }
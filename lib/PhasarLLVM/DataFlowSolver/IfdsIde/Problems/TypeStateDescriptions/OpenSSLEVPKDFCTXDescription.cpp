@@ -180,6 +180,11 @@ std::string OpenSSLEVPKDFCTXDescription::stateToString(
   }
 }
 
+size_t OpenSSLEVPKDFCTXDescription::getNumStates() const {
+  // UNINIT is the largest state besides TOP
+  return OpenSSLEVPKDFState::UNINIT + 1;
+}
+
 TypeStateDescription::State OpenSSLEVPKDFCTXDescription::bottom() const {
   return OpenSSLEVPKDFState::BOT;
 }
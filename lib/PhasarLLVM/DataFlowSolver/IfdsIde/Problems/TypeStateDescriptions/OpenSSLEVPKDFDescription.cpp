@@ -113,6 +113,11 @@ OpenSSLEVPKDFDescription::stateToString(TypeStateDescription::State S) const {
   }
 }
 
+size_t OpenSSLEVPKDFDescription::getNumStates() const {
+  // BOT is the largest state besides TOP
+  return OpenSSLEVPKDFState::BOT + 1;
+}
+
 TypeStateDescription::State OpenSSLEVPKDFDescription::bottom() const {
   return OpenSSLEVPKDFState::BOT;
 }
@@ -151,6 +151,11 @@ std::string OpenSSLSecureHeapDescription::stateToString(
   }
 }
 
+size_t OpenSSLSecureHeapDescription::getNumStates() const {
+  // ERROR is the largest state besides TOP
+  return OpenSSLSecureHeapState::ERROR + 1;
+}
+
 TypeStateDescription::State OpenSSLSecureHeapDescription::bottom() const {
   return OpenSSLSecureHeapState::BOT;
 }
@@ -128,6 +128,11 @@ std::string OpenSSLSecureMemoryDescription::stateToString(
   }
 }
 
+size_t OpenSSLSecureMemoryDescription::getNumStates() const {
+  // ALLOCATED is the largest state besides TOP
+  return OpenSSLSecureMemoryState::ALLOCATED + 1;
+}
+
 TypeStateDescription::State OpenSSLSecureMemoryDescription::bottom() const {
   return OpenSSLSecureMemoryState::BOT;
 }
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include "llvm/IR/Function.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryPack.h"
+#include "phasar/PhasarLLVM/Utils/FunctionHashes.h"
+#include "phasar/Utils/Logger.h"
+
+namespace psr {
+
+bool SummaryPack::load(const std::string &Path) {
+  size_t NumSummaries = Store.size();
+  if (!Store.readFromFile(Path)) {
+    PHASAR_LOG_LEVEL(WARNING, "Could not load summary pack '" << Path << "'");
+    return false;
+  }
+  PHASAR_LOG_LEVEL(INFO, "Loaded " << Store.size() - NumSummaries
+                                   << " function summaries from '" << Path
+                                   << "'");
+  return true;
+}
+
+void SummaryPack::index(const ProjectIRDB &IRDB) {
+  Index.clear();
+  FunctionHashes Hashes(IRDB);
+  for (const auto *F : IRDB.getAllFunctions()) {
+    if (F->isDeclaration() || Hashes.mayAccessMutableGlobals(F->getName())) {
+      continue;
+    }
+    auto Hash = Hashes.getClosureHash(F->getName());
+    if (!Hash) {
+      continue;
+    }
+    if (const auto *Summary = Store.lookup(*Hash);
+        Summary && isComplete(*F, *Summary)) {
+      Index[F] = Summary;
+    }
+  }
+  PHASAR_LOG_LEVEL(INFO, "Summary packs cover " << Index.size() << " of "
+                                                << Hashes.size()
+                                                << " function definitions");
+}
+
+bool SummaryPack::isComplete(const llvm::Function &F,
+                             const SummaryStore::FunctionSummary &Summary) {
+  if (!Summary.isSummarized(SummaryStore::FactRef{})) {
+    return false;
+  }
+  for (const auto &Arg : F.args()) {
+    if (!Summary.isSummarized({SummaryStore::FactRef::KindTy::Argument,
+                               Arg.getArgNo()})) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace psr
@@ -0,0 +1,408 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalValue.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryStore.h"
+#include "phasar/Utils/Logger.h"
+
+namespace psr {
+
+namespace {
+
+/// The summary store format consists of the header, followed by
+///
+///   char   ProblemID[ProblemIDSize]
+///   Global GlobalNames[NumGlobalNames]
+///   Func   Functions[NumFunctions]
+///
+/// where a Global is a uint32 length followed by the characters of the name,
+/// and a Func is
+///
+///   uint64 ClosureHash
+///   uint32 NumEntryFacts
+///   uint32 NumEntries
+///   uint32 EntryFacts[NumEntryFacts]
+///   uint32 Entries[NumEntries][4]   (Source, ExitPoint, Target, EdgeKind)
+///
+/// All integers are little endian. A fact is encoded in a single uint32: its
+/// kind in the upper two bits and its index in the lower 30 bits.
+struct SummaryStoreHeader {
+  char Magic[8];
+  llvm::support::ulittle32_t Version;
+  llvm::support::ulittle32_t ProblemIDSize;
+  llvm::support::ulittle32_t NumGlobalNames;
+  llvm::support::ulittle32_t NumFunctions;
+};
+static_assert(sizeof(SummaryStoreHeader) == 24);
+
+constexpr llvm::StringLiteral SummaryStoreMagic("PSR-SUM");
+/// Must be incremented whenever the layout or the value numbering changes.
+constexpr uint32_t SummaryStoreVersion = 2;
+
+constexpr unsigned FactIndexBits = 30;
+constexpr uint32_t MaxFactIndex = (1U << FactIndexBits) - 1;
+
+uint32_t packFact(SummaryStore::FactRef Fact) {
+  return (uint32_t(Fact.Kind) << FactIndexBits) | Fact.Index;
+}
+
+SummaryStore::FactRef unpackFact(uint32_t Packed) {
+  return {SummaryStore::FactRef::KindTy(Packed >> FactIndexBits),
+          Packed & MaxFactIndex};
+}
+
+bool entryLess(const SummaryStore::Entry &LHS, const SummaryStore::Entry &RHS) {
+  return std::make_tuple(packFact(LHS.Source), LHS.ExitPoint,
+                         packFact(LHS.Target), LHS.Edge) <
+         std::make_tuple(packFact(RHS.Source), RHS.ExitPoint,
+                         packFact(RHS.Target), RHS.Edge);
+}
+
+/// Reads little-endian integers from a buffer and fails on its end.
+class BufferReader {
+public:
+  explicit BufferReader(llvm::StringRef Data) : Data(Data) {}
+
+  bool read(uint32_t &Value) {
+    if (Data.size() < sizeof(Value)) {
+      return false;
+    }
+    Value = llvm::support::endian::read32le(Data.data());
+    Data = Data.drop_front(sizeof(Value));
+    return true;
+  }
+
+  bool read(uint64_t &Value) {
+    if (Data.size() < sizeof(Value)) {
+      return false;
+    }
+    Value = llvm::support::endian::read64le(Data.data());
+    Data = Data.drop_front(sizeof(Value));
+    return true;
+  }
+
+  bool read(llvm::StringRef &Str, size_t Size) {
+    if (Data.size() < Size) {
+      return false;
+    }
+    Str = Data.take_front(Size);
+    Data = Data.drop_front(Size);
+    return true;
+  }
+
+  [[nodiscard]] bool empty() const { return Data.empty(); }
+
+  [[nodiscard]] size_t size() const { return Data.size(); }
+
+private:
+  llvm::StringRef Data;
+};
+
+} // namespace
+
+bool SummaryStore::FunctionSummary::isSummarized(FactRef Fact) const {
+  return std::binary_search(EntryFacts.begin(), EntryFacts.end(), Fact);
+}
+
+bool SummaryStore::read(llvm::MemoryBufferRef Buffer) {
+  llvm::StringRef Data = Buffer.getBuffer();
+  if (Data.size() < sizeof(SummaryStoreHeader)) {
+    return false;
+  }
+  SummaryStoreHeader Header;
+  std::memcpy(&Header, Data.data(), sizeof(Header));
+  if (llvm::StringRef(Header.Magic, sizeof(Header.Magic)) !=
+          llvm::StringRef(SummaryStoreMagic.data(), sizeof(Header.Magic)) ||
+      Header.Version != SummaryStoreVersion) {
+    PHASAR_LOG_LEVEL(WARNING, "Summary store '"
+                                  << Buffer.getBufferIdentifier()
+                                  << "' has an unsupported format");
+    return false;
+  }
+  BufferReader Reader(Data.drop_front(sizeof(Header)));
+  llvm::StringRef ID;
+  if (!Reader.read(ID, Header.ProblemIDSize) || ID != ProblemID) {
+    PHASAR_LOG_LEVEL(WARNING, "Summary store '"
+                                  << Buffer.getBufferIdentifier()
+                                  << "' belongs to another problem");
+    return false;
+  }
+  std::vector<llvm::StringRef> FileGlobalNames;
+  FileGlobalNames.reserve(Header.NumGlobalNames);
+  for (uint32_t I = 0; I < Header.NumGlobalNames; ++I) {
+    uint32_t Size;
+    llvm::StringRef Name;
+    if (!Reader.read(Size) || !Reader.read(Name, Size)) {
+      return false;
+    }
+    FileGlobalNames.push_back(Name);
+  }
+  // Parse everything before modifying the store, such that a malformed
+  // buffer leaves it unchanged
+  std::vector<std::pair<uint64_t, FunctionSummary>> FileSummaries;
+  FileSummaries.reserve(Header.NumFunctions);
+  auto ReadFact = [&Reader, &FileGlobalNames](FactRef &Fact) {
+    uint32_t Packed;
+    if (!Reader.read(Packed)) {
+      return false;
+    }
+    Fact = unpackFact(Packed);
+    return Fact.Kind != FactRef::KindTy::Global ||
+           Fact.Index < FileGlobalNames.size();
+  };
+  for (uint32_t I = 0; I < Header.NumFunctions; ++I) {
+    uint64_t Hash;
+    uint32_t NumEntryFacts;
+    uint32_t NumEntries;
+    if (!Reader.read(Hash) || !Reader.read(NumEntryFacts) ||
+        !Reader.read(NumEntries) ||
+        (uint64_t(NumEntryFacts) + 4 * uint64_t(NumEntries)) *
+                sizeof(uint32_t) >
+            Reader.size()) {
+      return false;
+    }
+    auto &[FileHash, Summary] = FileSummaries.emplace_back();
+    FileHash = Hash;
+    Summary.EntryFacts.resize(NumEntryFacts);
+    for (auto &Fact : Summary.EntryFacts) {
+      if (!ReadFact(Fact)) {
+        return false;
+      }
+    }
+    Summary.Entries.resize(NumEntries);
+    for (auto &Entry : Summary.Entries) {
+      uint32_t Edge;
+      if (!ReadFact(Entry.Source) || !Reader.read(Entry.ExitPoint) ||
+          !ReadFact(Entry.Target) || !Reader.read(Edge) ||
+          Edge > uint32_t(EdgeKind::AllBottom)) {
+        return false;
+      }
+      Entry.Edge = EdgeKind(Edge);
+    }
+  }
+  if (!Reader.empty()) {
+    return false;
+  }
+
+  std::vector<uint32_t> GlobalNameIdMap;
+  GlobalNameIdMap.reserve(FileGlobalNames.size());
+  for (auto Name : FileGlobalNames) {
+    GlobalNameIdMap.push_back(getGlobalNameId(Name));
+  }
+  auto MapFact = [&GlobalNameIdMap](FactRef &Fact) {
+    if (Fact.Kind == FactRef::KindTy::Global) {
+      Fact.Index = GlobalNameIdMap[Fact.Index];
+    }
+  };
+  for (auto &[Hash, Summary] : FileSummaries) {
+    for (auto &Fact : Summary.EntryFacts) {
+      MapFact(Fact);
+    }
+    for (auto &Entry : Summary.Entries) {
+      MapFact(Entry.Source);
+      MapFact(Entry.Target);
+    }
+    insert(Hash, std::move(Summary));
+  }
+  PHASAR_LOG_LEVEL(INFO, "Loaded the summaries of "
+                             << FileSummaries.size() << " function(s) from '"
+                             << Buffer.getBufferIdentifier() << '\'');
+  return true;
+}
+
+bool SummaryStore::readFromFile(const std::string &Path) {
+  std::error_code EC;
+  if (!std::filesystem::exists(Path, EC)) {
+    return false;
+  }
+  auto Buffer = llvm::MemoryBuffer::getFile(Path);
+  if (!Buffer) {
+    PHASAR_LOG_LEVEL(WARNING, "Cannot read summary store '"
+                                  << Path
+                                  << "': " << Buffer.getError().message());
+    return false;
+  }
+  return read((*Buffer)->getMemBufferRef());
+}
+
+void SummaryStore::write(llvm::raw_ostream &OS) const {
+  llvm::support::endian::Writer W(OS, llvm::support::little);
+  SummaryStoreHeader Header{};
+  std::memcpy(Header.Magic, SummaryStoreMagic.data(), sizeof(Header.Magic));
+  Header.Version = SummaryStoreVersion;
+  Header.ProblemIDSize = ProblemID.size();
+  Header.NumGlobalNames = GlobalNames.size();
+  Header.NumFunctions = Summaries.size();
+  OS.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+  OS << ProblemID;
+  for (const auto &Name : GlobalNames) {
+    W.write<uint32_t>(Name.size());
+    OS << Name;
+  }
+  // Order the functions by their hashes, such that the output is
+  // deterministic
+  std::vector<uint64_t> Hashes;
+  Hashes.reserve(Summaries.size());
+  for (const auto &Summary : Summaries) {
+    Hashes.push_back(Summary.first);
+  }
+  std::sort(Hashes.begin(), Hashes.end());
+  for (auto Hash : Hashes) {
+    const auto &Summary = Summaries.find(Hash)->second;
+    W.write<uint64_t>(Hash);
+    W.write<uint32_t>(Summary.EntryFacts.size());
+    W.write<uint32_t>(Summary.Entries.size());
+    for (auto Fact : Summary.EntryFacts) {
+      W.write<uint32_t>(packFact(Fact));
+    }
+    for (const auto &Entry : Summary.Entries) {
+      W.write<uint32_t>(packFact(Entry.Source));
+      W.write<uint32_t>(Entry.ExitPoint);
+      W.write<uint32_t>(packFact(Entry.Target));
+      W.write<uint32_t>(uint32_t(Entry.Edge));
+    }
+  }
+}
+
+bool SummaryStore::writeToFile(const std::string &Path) const {
+  std::error_code EC;
+  llvm::raw_fd_ostream OS(Path, EC);
+  if (EC) {
+    PHASAR_LOG_LEVEL(ERROR, "Cannot write summary store '"
+                                << Path << "': " << EC.message());
+    return false;
+  }
+  write(OS);
+  return true;
+}
+
+const SummaryStore::FunctionSummary *
+SummaryStore::lookup(uint64_t FunctionHash) const {
+  auto Search = Summaries.find(FunctionHash);
+  return Search != Summaries.end() ? &Search->second : nullptr;
+}
+
+void SummaryStore::insert(uint64_t FunctionHash, FunctionSummary Summary) {
+  auto &Stored = Summaries[FunctionHash];
+  Stored.EntryFacts.insert(Stored.EntryFacts.end(), Summary.EntryFacts.begin(),
+                           Summary.EntryFacts.end());
+  std::sort(Stored.EntryFacts.begin(), Stored.EntryFacts.end());
+  Stored.EntryFacts.erase(
+      std::unique(Stored.EntryFacts.begin(), Stored.EntryFacts.end()),
+      Stored.EntryFacts.end());
+  Stored.Entries.insert(Stored.Entries.end(), Summary.Entries.begin(),
+                        Summary.Entries.end());
+  std::sort(Stored.Entries.begin(), Stored.Entries.end(), entryLess);
+  Stored.Entries.erase(
+      std::unique(Stored.Entries.begin(), Stored.Entries.end()),
+      Stored.Entries.end());
+}
+
+std::optional<SummaryStore::FactRef>
+SummaryStore::encode(const llvm::Function &F, const llvm::Value *V) {
+  if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+    if (Arg->getParent() == &F) {
+      return FactRef{FactRef::KindTy::Argument, Arg->getArgNo()};
+    }
+    return std::nullopt;
+  }
+  if (const auto *Inst = llvm::dyn_cast<llvm::Instruction>(V)) {
+    if (Inst->getFunction() == &F) {
+      getInstructions(F);
+      if (auto Search = InstructionNumbers.find(Inst);
+          Search != InstructionNumbers.end() &&
+          Search->second <= MaxFactIndex) {
+        return FactRef{FactRef::KindTy::Instruction, Search->second};
+      }
+    }
+    return std::nullopt;
+  }
+  if (const auto *Global = llvm::dyn_cast<llvm::GlobalValue>(V)) {
+    // Values with local linkage are looked up in the module of F as well
+    if (Global->hasName() && GlobalNames.size() <= MaxFactIndex) {
+      return FactRef{FactRef::KindTy::Global,
+                     getGlobalNameId(Global->getName())};
+    }
+  }
+  // Facts of other functions and constants are not persisted
+  return std::nullopt;
+}
+
+const llvm::Value *SummaryStore::decode(const llvm::Function &F,
+                                        FactRef Ref) {
+  switch (Ref.Kind) {
+  case FactRef::KindTy::Argument:
+    return Ref.Index < F.arg_size() ? F.getArg(Ref.Index) : nullptr;
+  case FactRef::KindTy::Instruction:
+    return getInstruction(F, Ref.Index);
+  case FactRef::KindTy::Global:
+    return Ref.Index < GlobalNames.size()
+               ? F.getParent()->getNamedValue(GlobalNames[Ref.Index])
+               : nullptr;
+  default:
+    return nullptr;
+  }
+}
+
+uint32_t SummaryStore::getInstructionNumber(const llvm::Instruction *Inst) {
+  getInstructions(*Inst->getFunction());
+  assert(InstructionNumbers.count(Inst) &&
+         "Debug intrinsics have no instruction number!");
+  return InstructionNumbers.lookup(Inst);
+}
+
+const llvm::Instruction *
+SummaryStore::getInstruction(const llvm::Function &F, uint32_t Number) {
+  const auto &Insts = getInstructions(F);
+  return Number < Insts.size() ? Insts[Number] : nullptr;
+}
+
+const std::vector<const llvm::Instruction *> &
+SummaryStore::getInstructions(const llvm::Function &F) {
+  auto [It, Inserted] = Instructions.try_emplace(&F);
+  if (Inserted) {
+    // Number the instructions as FunctionHashes does, such that the
+    // numbers do not depend on the debug information
+    for (const auto &Inst : llvm::instructions(F)) {
+      if (llvm::isa<llvm::DbgInfoIntrinsic>(Inst)) {
+        continue;
+      }
+      InstructionNumbers[&Inst] = It->second.size();
+      It->second.push_back(&Inst);
+    }
+  }
+  return It->second;
+}
+
+uint32_t SummaryStore::getGlobalNameId(llvm::StringRef Name) {
+  auto [It, Inserted] = GlobalNameIds.try_emplace(Name, GlobalNames.size());
+  if (Inserted) {
+    GlobalNames.push_back(Name.str());
+  }
+  return It->second;
+}
+
+} // namespace psr
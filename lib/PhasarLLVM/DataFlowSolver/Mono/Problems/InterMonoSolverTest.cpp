@@ -31,6 +31,10 @@ InterMonoSolverTest::InterMonoSolverTest(const ProjectIRDB *IRDB,
     : InterMonoProblem<InterMonoSolverTestDomain>(IRDB, TH, ICF, PT,
                                                   std::move(EntryPoints)) {}
 
+InterMonoSolverTest::mono_container_t InterMonoSolverTest::allTop() {
+  return mono_container_t(Domain);
+}
+
 InterMonoSolverTest::mono_container_t
 InterMonoSolverTest::merge(const InterMonoSolverTest::mono_container_t &Lhs,
                            const InterMonoSolverTest::mono_container_t &Rhs) {
@@ -49,7 +53,7 @@ InterMonoSolverTest::mono_container_t InterMonoSolverTest::normalFlow(
     InterMonoSolverTest::n_t Inst,
     const InterMonoSolverTest::mono_container_t &In) {
   llvm::outs() << "InterMonoSolverTest::normalFlow()\n";
-  InterMonoSolverTest::mono_container_t Result;
+  InterMonoSolverTest::mono_container_t Result(Domain);
   Result = Result.setUnion(In);
   if (const auto *const Alloc = llvm::dyn_cast<llvm::AllocaInst>(Inst)) {
     Result.insert(Alloc);
@@ -62,7 +66,7 @@ InterMonoSolverTest::callFlow(InterMonoSolverTest::n_t CallSite,
                               InterMonoSolverTest::f_t /*Callee*/,
                               const InterMonoSolverTest::mono_container_t &In) {
   llvm::outs() << "InterMonoSolverTest::callFlow()\n";
-  InterMonoSolverTest::mono_container_t Result;
+  InterMonoSolverTest::mono_container_t Result(Domain);
   Result = Result.setUnion(In);
   if (const auto *const Call = llvm::dyn_cast<llvm::CallInst>(CallSite)) {
     Result.insert(Call);
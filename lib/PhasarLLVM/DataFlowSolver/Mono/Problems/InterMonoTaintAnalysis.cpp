@@ -37,6 +37,10 @@ InterMonoTaintAnalysis::InterMonoTaintAnalysis(
                                                      std::move(EntryPoints)),
       Config(Config) {}
 
+InterMonoTaintAnalysis::mono_container_t InterMonoTaintAnalysis::allTop() {
+  return mono_container_t(Domain);
+}
+
 InterMonoTaintAnalysis::mono_container_t InterMonoTaintAnalysis::merge(
     const InterMonoTaintAnalysis::mono_container_t &Lhs,
     const InterMonoTaintAnalysis::mono_container_t &Rhs) {
@@ -56,7 +60,8 @@ InterMonoTaintAnalysis::mono_container_t InterMonoTaintAnalysis::normalFlow(
     InterMonoTaintAnalysis::n_t Inst,
     const InterMonoTaintAnalysis::mono_container_t &In) {
   PHASAR_LOG_LEVEL(DEBUG, "InterMonoTaintAnalysis::normalFlow()");
-  InterMonoTaintAnalysis::mono_container_t Out(In);
+  InterMonoTaintAnalysis::mono_container_t Out(Domain);
+  Out.insert(In);
   if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(Inst)) {
     if (In.count(Store->getValueOperand())) {
       Out.insert(Store->getPointerOperand());
@@ -86,7 +91,7 @@ InterMonoTaintAnalysis::mono_container_t InterMonoTaintAnalysis::callFlow(
     InterMonoTaintAnalysis::n_t CallSite, const llvm::Function *Callee,
     const InterMonoTaintAnalysis::mono_container_t &In) {
   PHASAR_LOG_LEVEL(DEBUG, "InterMonoTaintAnalysis::callFlow()");
-  InterMonoTaintAnalysis::mono_container_t Out;
+  InterMonoTaintAnalysis::mono_container_t Out(Domain);
   const auto *CS = llvm::cast<llvm::CallBase>(CallSite);
   for (unsigned Idx = 0; Idx < Callee->arg_size(); ++Idx) {
     if (In.count(CS->getArgOperand(Idx))) {
@@ -102,7 +107,7 @@ InterMonoTaintAnalysis::mono_container_t InterMonoTaintAnalysis::returnFlow(
     InterMonoTaintAnalysis::n_t /*RetSite*/,
     const InterMonoTaintAnalysis::mono_container_t &In) {
   PHASAR_LOG_LEVEL(DEBUG, "InterMonoTaintAnalysis::returnFlow()");
-  InterMonoTaintAnalysis::mono_container_t Out;
+  InterMonoTaintAnalysis::mono_container_t Out(Domain);
   if (const auto *Ret = llvm::dyn_cast<llvm::ReturnInst>(ExitStmt)) {
     if (In.count(Ret->getReturnValue())) {
       Out.insert(CallSite);
@@ -127,10 +132,11 @@ InterMonoTaintAnalysis::mono_container_t InterMonoTaintAnalysis::callToRetFlow(
     std::set<const llvm::Function *> Callees,
     const InterMonoTaintAnalysis::mono_container_t &In) {
   PHASAR_LOG_LEVEL(DEBUG, "InterMonoTaintAnalysis::callToRetFlow()");
-  InterMonoTaintAnalysis::mono_container_t Out(In);
+  InterMonoTaintAnalysis::mono_container_t Out(Domain);
+  Out.insert(In);
   const auto *CS = llvm::cast<llvm::CallBase>(CallSite);
-  mono_container_t Gen;
-  mono_container_t Kill;
+  mono_container_t Gen(Domain);
+  mono_container_t Kill(Domain);
   bool First = true;
   //-----------------------------------------------------------------------------
   // Handle virtual calls in the loop
@@ -146,7 +152,7 @@ InterMonoTaintAnalysis::mono_container_t InterMonoTaintAnalysis::callToRetFlow(
       First = false;
       collectSanitizedFacts(Kill, Config, CS, Callee);
     } else {
-      mono_container_t Tmp;
+      mono_container_t Tmp(Domain);
       collectSanitizedFacts(Tmp, Config, CS, Callee);
       intersectWith(Kill, Tmp);
     }
@@ -173,7 +179,7 @@ InterMonoTaintAnalysis::initialSeeds() {
   std::unordered_map<InterMonoTaintAnalysis::n_t,
                      InterMonoTaintAnalysis::mono_container_t>
       Seeds;
-  InterMonoTaintAnalysis::mono_container_t Facts;
+  InterMonoTaintAnalysis::mono_container_t Facts(Domain);
   for (unsigned Idx = 0; Idx < Main->arg_size(); ++Idx) {
     Facts.insert(getNthFunctionArgument(Main, Idx));
   }
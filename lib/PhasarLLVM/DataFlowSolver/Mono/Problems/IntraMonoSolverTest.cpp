@@ -39,6 +39,10 @@ IntraMonoSolverTest::IntraMonoSolverTest(const ProjectIRDB *IRDB,
     : IntraMonoProblem<IntraMonoSolverTestAnalysisDomain>(
           IRDB, TH, CF, PT, std::move(EntryPoints)) {}
 
+IntraMonoSolverTest::mono_container_t IntraMonoSolverTest::allTop() {
+  return mono_container_t(Domain);
+}
+
 IntraMonoSolverTest::mono_container_t
 IntraMonoSolverTest::merge(const IntraMonoSolverTest::mono_container_t &Lhs,
                            const IntraMonoSolverTest::mono_container_t &Rhs) {
@@ -57,7 +61,8 @@ IntraMonoSolverTest::mono_container_t IntraMonoSolverTest::normalFlow(
     IntraMonoSolverTest::n_t Inst,
     const IntraMonoSolverTest::mono_container_t &In) {
   llvm::outs() << "IntraMonoSolverTest::normalFlow()\n";
-  IntraMonoSolverTest::mono_container_t Result = In;
+  IntraMonoSolverTest::mono_container_t Result(Domain);
+  Result.insert(In);
   if (const auto *const Store = llvm::dyn_cast<llvm::StoreInst>(Inst)) {
     Result.insert(Store);
   }
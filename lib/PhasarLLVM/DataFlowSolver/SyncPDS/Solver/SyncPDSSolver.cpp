@@ -1,29 +1,415 @@
-// /******************************************************************************
-//  * Copyright (c) 2018 Philipp Schubert.
-//  * All rights reserved. This program and the accompanying materials are made
-//  * available under the terms of LICENSE.txt.
-//  *
-//  * Contributors:
-//  *     Philipp Schubert and others
-//  *****************************************************************************/
-
-// #include "phasar/PhasarLLVM/SPDS/Solver/SyncPDSSolver.h"
-// #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
-// #include "phasar/PhasarLLVM/DataFlowSolver/WPDS/Solver/LLVMWPDSSolver.h"
-// #include
-// <phasar/PhasarLLVM/DataFlowSolver/WPDS/Problems/WPDSAliasCollector.h>
-// #include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
-
-// namespace psr {
-
-// SyncPDSSolver::SyncPDSSolver(LLVMBasedICFG &I) : I(I) {}
-
-// std::set<const llvm::Value *> SyncPDSSolver::getAliasesOf(const llvm::Value
-// *V)
-// {
-//   WPDSAliasCollector AC(I, WPDSType::FWPDS, SearchDirection::FORWARD);
-//   LLVMWPDSSolver<const llvm::Value *, BinaryDomain, LLVMBasedICFG&>
-//   WpdsSolver(AC); return {V};
-// }
-
-// }
+/******************************************************************************
+ * Copyright (c) 2018 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <utility>
+
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalObject.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Operator.h"
+#include "llvm/IR/Value.h"
+#include "llvm/Support/Casting.h"
+#include "llvm/Support/ErrorHandling.h"
+
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/SyncPDS/Solver/PDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/SyncPDS/Solver/SyncPDSSolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToUtils.h"
+#include "phasar/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/NlohmannLogging.h"
+
+namespace psr {
+
+SyncPDSSolver::SyncPDSSolver(const LLVMBasedICFG &ICF) : ICF(ICF) {}
+
+auto SyncPDSSolver::getEmptyPointsToSet()
+    -> DynamicPointsToSetPtr<PointsToSetTy> {
+  static PointsToSetTy EmptySet{};
+  static PointsToSetTy *EmptySetPtr = &EmptySet;
+  return &EmptySetPtr;
+}
+
+bool SyncPDSSolver::isAllocationSite(const llvm::Value *V) const {
+  if (llvm::isa<llvm::AllocaInst>(V) || llvm::isa<llvm::GlobalObject>(V)) {
+    return true;
+  }
+  if (const auto *CS = llvm::dyn_cast<llvm::CallBase>(V)) {
+    if (ICF.isHeapAllocatingFunction(CS->getCalledFunction())) {
+      return true;
+    }
+    // the results of calls to functions that are not analyzed are unknown
+    // objects
+    return llvm::all_of(ICF.getCalleesOfCallAtRef(CS), [](const auto *Callee) {
+      return Callee->isDeclaration();
+    });
+  }
+  if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+    return ICF.getCallersOfRef(Arg->getParent()).empty();
+  }
+  return false;
+}
+
+auto SyncPDSSolver::getField(const llvm::Value *GEP) -> FieldTy {
+  const auto *GEPOp = llvm::cast<llvm::GEPOperator>(GEP);
+  // Variable indices, e.g., of arrays, are not distinguished
+  if (!GEPOp->hasAllConstantIndices() || GEPOp->hasAllZeroIndices()) {
+    return NoField;
+  }
+  std::vector<int64_t> Indices;
+  for (const auto &Index : GEPOp->indices()) {
+    Indices.push_back(llvm::cast<llvm::ConstantInt>(Index)->getSExtValue());
+  }
+  FieldTy Next = Deref + 1 + Fields.size();
+  return Fields
+      .try_emplace({GEPOp->getSourceElementType(), std::move(Indices)}, Next)
+      .first->second;
+}
+
+void SyncPDSSolver::computeBackwardMoves(const llvm::Value *V,
+                                         std::vector<Move> &Moves) {
+  using CallActionTy = Move::CallActionTy;
+  using FieldActionTy = Move::FieldActionTy;
+  auto Copy = [&Moves](const llvm::Value *From) {
+    Moves.push_back({NodeTy(From, Direction::Backward)});
+  };
+  if (isAllocationSite(V)) {
+    // start the search for the aliases
+    Moves.push_back({NodeTy(V, Direction::Forward)});
+    return;
+  }
+  if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(V)) {
+    Moves.push_back({NodeTy(Load->getPointerOperand(), Direction::Backward),
+                     CallActionTy::None, nullptr, FieldActionTy::Push, Deref});
+  } else if (const auto *GEP = llvm::dyn_cast<llvm::GEPOperator>(V)) {
+    auto Field = getField(GEP);
+    Moves.push_back({NodeTy(GEP->getPointerOperand(), Direction::Backward),
+                     CallActionTy::None, nullptr,
+                     Field == NoField ? FieldActionTy::None
+                                      : FieldActionTy::Push,
+                     Field});
+  } else if (llvm::isa<llvm::BitCastOperator>(V) ||
+             llvm::isa<llvm::AddrSpaceCastOperator>(V)) {
+    Copy(llvm::cast<llvm::Operator>(V)->getOperand(0));
+  } else if (const auto *Phi = llvm::dyn_cast<llvm::PHINode>(V)) {
+    for (const auto &Incoming : Phi->incoming_values()) {
+      Copy(Incoming);
+    }
+  } else if (const auto *Select = llvm::dyn_cast<llvm::SelectInst>(V)) {
+    Copy(Select->getTrueValue());
+    Copy(Select->getFalseValue());
+  } else if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+    for (const auto *Caller : ICF.getCallersOfRef(Arg->getParent())) {
+      const auto *CS = llvm::dyn_cast<llvm::CallBase>(Caller);
+      if (CS && Arg->getArgNo() < CS->arg_size()) {
+        Moves.push_back(
+            {NodeTy(CS->getArgOperand(Arg->getArgNo()), Direction::Backward),
+             CallActionTy::Leave, CS});
+      }
+    }
+  } else if (const auto *CS = llvm::dyn_cast<llvm::CallBase>(V)) {
+    for (const auto *Callee : ICF.getCalleesOfCallAtRef(CS)) {
+      if (Callee->isDeclaration()) {
+        continue;
+      }
+      for (const auto &I : llvm::instructions(Callee)) {
+        const auto *Ret = llvm::dyn_cast<llvm::ReturnInst>(&I);
+        if (Ret && Ret->getReturnValue()) {
+          Moves.push_back({NodeTy(Ret->getReturnValue(), Direction::Backward),
+                           CallActionTy::Enter, CS});
+        }
+      }
+    }
+  }
+}
+
+void SyncPDSSolver::computeForwardMoves(const llvm::Value *V,
+                                        std::vector<Move> &Moves) {
+  using CallActionTy = Move::CallActionTy;
+  using FieldActionTy = Move::FieldActionTy;
+  auto Copy = [&Moves](const llvm::Value *To) {
+    Moves.push_back({NodeTy(To, Direction::Forward)});
+  };
+  for (const auto &Use : V->uses()) {
+    const auto *User = Use.getUser();
+    if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(User)) {
+      Moves.push_back({NodeTy(Load, Direction::Forward), CallActionTy::None,
+                       nullptr, FieldActionTy::Pop, Deref});
+    } else if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(User)) {
+      if (Use.getOperandNo() == Store->getPointerOperandIndex()) {
+        // the stored value is the content of V's objects
+        Moves.push_back(
+            {NodeTy(Store->getValueOperand(), Direction::Backward),
+             CallActionTy::None, nullptr, FieldActionTy::Pop, Deref});
+      } else {
+        // V becomes the content of the objects of the pointer operand
+        Moves.push_back(
+            {NodeTy(Store->getPointerOperand(), Direction::Backward),
+             CallActionTy::None, nullptr, FieldActionTy::Push, Deref});
+      }
+    } else if (const auto *GEP = llvm::dyn_cast<llvm::GEPOperator>(User)) {
+      if (Use.getOperandNo() != GEP->getPointerOperandIndex()) {
+        continue;
+      }
+      auto Field = getField(GEP);
+      Moves.push_back({NodeTy(GEP, Direction::Forward), CallActionTy::None,
+                       nullptr,
+                       Field == NoField ? FieldActionTy::None
+                                        : FieldActionTy::Pop,
+                       Field});
+    } else if (llvm::isa<llvm::BitCastOperator>(User) ||
+               llvm::isa<llvm::AddrSpaceCastOperator>(User) ||
+               llvm::isa<llvm::PHINode>(User)) {
+      Copy(User);
+    } else if (const auto *Select = llvm::dyn_cast<llvm::SelectInst>(User)) {
+      if (Use.getOperandNo() != 0) {
+        Copy(Select);
+      }
+    } else if (const auto *CS = llvm::dyn_cast<llvm::CallBase>(User)) {
+      if (!CS->isArgOperand(&Use)) {
+        continue;
+      }
+      auto ArgNo = CS->getArgOperandNo(&Use);
+      for (const auto *Callee : ICF.getCalleesOfCallAtRef(CS)) {
+        if (!Callee->isDeclaration() && ArgNo < Callee->arg_size()) {
+          Moves.push_back({NodeTy(Callee->getArg(ArgNo), Direction::Forward),
+                           CallActionTy::Enter, CS});
+        }
+      }
+    } else if (const auto *Ret = llvm::dyn_cast<llvm::ReturnInst>(User)) {
+      for (const auto *Caller : ICF.getCallersOfRef(Ret->getFunction())) {
+        Moves.push_back({NodeTy(Caller, Direction::Forward),
+                         CallActionTy::Leave, Caller});
+      }
+    }
+  }
+}
+
+auto SyncPDSSolver::getMoves(NodeTy Node) -> const std::vector<Move> & {
+  if (auto It = Moves.find(Node); It != Moves.end()) {
+    return It->second;
+  }
+  std::vector<Move> NodeMoves;
+  const auto *V = Node.getPointer();
+  if (Node.getInt() == Direction::Backward) {
+    computeBackwardMoves(V, NodeMoves);
+  } else {
+    computeForwardMoves(V, NodeMoves);
+  }
+  if (auto It = IntroducedAliases.find(V); It != IntroducedAliases.end()) {
+    for (const auto *Alias : It->second) {
+      NodeMoves.push_back({NodeTy(Alias, Node.getInt())});
+    }
+  }
+  return Moves[Node] = std::move(NodeMoves);
+}
+
+auto SyncPDSSolver::query(const llvm::Value *V) -> QueryResult & {
+  auto &Result = Cache[V];
+  if (!Result.Aliases) {
+    Result.Aliases = Owner.acquire();
+    Result.AllocationSites = Owner.acquire();
+  } else if (Result.Generation == Generation) {
+    return Result;
+  } else {
+    Result.Aliases->clear();
+    Result.AllocationSites->clear();
+  }
+  Result.Generation = Generation;
+  ++NumQueries;
+  using PDSTy =
+      SynchronizedPDSSolver<NodeTy, const llvm::Instruction *, FieldTy>;
+  using CallKindTy = PDSTy::CallActionTy::KindTy;
+  using FieldKindTy = PDSTy::FieldActionTy::KindTy;
+  PDSTy PDS(nullptr, NoField);
+  // The nodes that are reachable in both pushdown systems along the same path
+  std::vector<NodeTy> Reached;
+  size_t NumProcessed = 0;
+  PDS.setReachedListener([&Reached](NodeTy Node) { Reached.push_back(Node); });
+  PDS.addInitialState(NodeTy(V, Direction::Backward));
+  do {
+    PDS.solve();
+    for (; NumProcessed < Reached.size(); ++NumProcessed) {
+      auto Node = Reached[NumProcessed];
+      for (const auto &M : getMoves(Node)) {
+        PDSTy::RuleTy Rule{M.Target,
+                                    {CallKindTy::Normal, M.CallSite},
+                                    {FieldKindTy::Normal, M.Field}};
+        if (M.CallAction == Move::CallActionTy::Enter) {
+          Rule.Call.Kind = CallKindTy::Push;
+        } else if (M.CallAction == Move::CallActionTy::Leave) {
+          // unbalanced returns lead into all callers
+          Rule.Call.Kind = CallKindTy::PopOrBottom;
+        }
+        if (M.FieldAction == Move::FieldActionTy::Push) {
+          Rule.Field.Kind = FieldKindTy::Push;
+        } else if (M.FieldAction == Move::FieldActionTy::Pop) {
+          Rule.Field.Kind = FieldKindTy::Pop;
+        }
+        PDS.addRule(Node, Rule);
+      }
+    }
+  } while (PDS.hasPendingConfigurations());
+
+  Result.Aliases->insert(V);
+  for (auto Node : Reached) {
+    if (!PDS.isReachedWithEmptyFieldStack(Node)) {
+      continue;
+    }
+    const auto *W = Node.getPointer();
+    if (Node.getInt() == Direction::Forward) {
+      if (W->getType()->isPointerTy()) {
+        Result.Aliases->insert(W);
+      }
+    } else if (isAllocationSite(W)) {
+      Result.AllocationSites->insert(W);
+    }
+  }
+  PHASAR_LOG_LEVEL(DEBUG, "SyncPDS query for " << llvmIRToString(V) << ": "
+                                               << Result.Aliases->size()
+                                               << " aliases, "
+                                               << Result.AllocationSites->size()
+                                               << " allocation sites, "
+                                               << Reached.size()
+                                               << " reached nodes");
+  if (Result.IntraProcAllocationSites) {
+    Result.IntraProcAllocationSites->clear();
+    computeIntraProcAllocationSites(V, Result);
+  }
+  return Result;
+}
+
+void SyncPDSSolver::computeIntraProcAllocationSites(const llvm::Value *V,
+                                                    QueryResult &Result) {
+  const auto *VFun = retrieveFunction(V);
+  for (const auto *Site : *Result.AllocationSites) {
+    if (!VFun || retrieveFunction(Site) == VFun) {
+      Result.IntraProcAllocationSites->insert(Site);
+    }
+  }
+}
+
+auto SyncPDSSolver::getAliasesOf(const llvm::Value *V) -> PointsToSetPtrTy {
+  if (!isInterestingPointer(V)) {
+    return getEmptyPointsToSet();
+  }
+  return query(V).Aliases;
+}
+
+auto SyncPDSSolver::getAllocationSitesOf(const llvm::Value *V)
+    -> AllocationSiteSetPtrTy {
+  if (!isInterestingPointer(V)) {
+    return getEmptyPointsToSet();
+  }
+  return query(V).AllocationSites;
+}
+
+AliasResult SyncPDSSolver::alias(const llvm::Value *V1, const llvm::Value *V2,
+                                 [[maybe_unused]] const llvm::Instruction *I) {
+  if (!isInterestingPointer(V1) || !isInterestingPointer(V2)) {
+    return AliasResult::NoAlias;
+  }
+  return getAliasesOf(V1)->count(V2) ? AliasResult::MayAlias
+                                     : AliasResult::NoAlias;
+}
+
+auto SyncPDSSolver::getPointsToSet(const llvm::Value *V,
+                                   [[maybe_unused]] const llvm::Instruction *I)
+    -> PointsToSetPtrTy {
+  return getAliasesOf(V);
+}
+
+auto SyncPDSSolver::getReachableAllocationSites(
+    const llvm::Value *V, bool IntraProcOnly,
+    [[maybe_unused]] const llvm::Instruction *I) -> AllocationSiteSetPtrTy {
+  if (!IntraProcOnly || !isInterestingPointer(V)) {
+    return getAllocationSitesOf(V);
+  }
+  auto &Result = query(V);
+  if (!Result.IntraProcAllocationSites) {
+    Result.IntraProcAllocationSites = Owner.acquire();
+    computeIntraProcAllocationSites(V, Result);
+  }
+  return Result.IntraProcAllocationSites;
+}
+
+bool SyncPDSSolver::isInReachableAllocationSites(
+    const llvm::Value *V, const llvm::Value *PotentialValue, bool IntraProcOnly,
+    const llvm::Instruction *I) {
+  return getReachableAllocationSites(V, IntraProcOnly, I)
+      ->count(PotentialValue);
+}
+
+void SyncPDSSolver::mergeWith([[maybe_unused]] const PointsToInfo &PTI) {
+  llvm::report_fatal_error(
+      "SyncPDSSolver cannot be merged with other points-to information!");
+}
+
+void SyncPDSSolver::introduceAlias(const llvm::Value *V1,
+                                   const llvm::Value *V2,
+                                   [[maybe_unused]] const llvm::Instruction *I,
+                                   [[maybe_unused]] AliasResult Kind) {
+  //  only introduce aliases if both values are interesting pointer
+  if (!isInterestingPointer(V1) || !isInterestingPointer(V2)) {
+    return;
+  }
+  IntroducedAliases[V1].push_back(V2);
+  IntroducedAliases[V2].push_back(V1);
+  for (const auto *V : {V1, V2}) {
+    Moves.erase(NodeTy(V, Direction::Backward));
+    Moves.erase(NodeTy(V, Direction::Forward));
+  }
+  ++Generation;
+}
+
+void SyncPDSSolver::print(llvm::raw_ostream &OS) const {
+  for (const auto &[V, Result] : Cache) {
+    if (Result.Generation != Generation) {
+      continue;
+    }
+    OS << "V: " << llvmIRToString(V) << '\n';
+    for (const auto *Alias : *Result.Aliases) {
+      OS << "\taliases -> " << llvmIRToString(Alias) << '\n';
+    }
+    for (const auto *Site : *Result.AllocationSites) {
+      OS << "\tallocated at -> " << llvmIRToString(Site) << '\n';
+    }
+  }
+}
+
+nlohmann::json SyncPDSSolver::getAsJson() const {
+  nlohmann::json J;
+  auto &Sets = J["PointsToSets"];
+  for (const auto &Entry : Cache) {
+    if (Entry.second.Generation != Generation) {
+      continue;
+    }
+    auto PtsJson = nlohmann::json::array();
+    for (const auto *Alias : *Entry.second.Aliases) {
+      auto Id = getMetaDataID(Alias);
+      if (Id != "-1") {
+        PtsJson.push_back(std::move(Id));
+      }
+    }
+    if (!PtsJson.empty()) {
+      Sets.push_back(std::move(PtsJson));
+    }
+  }
+  return J;
+}
+
+void SyncPDSSolver::printAsJson(llvm::raw_ostream &OS) const {
+  OS << getAsJson();
+}
+
+} // namespace psr
@@ -3,7 +3,8 @@ set(PHASAR_syncpds_COMPONENT_FOUND 1)
 list(APPEND
   PHASAR_SYNCPDS_DEPS
   controlflow
-  wpds
+  pointer
+  utils
 )
 
 foreach(dep ${PHASAR_SYNCPDS_DEPS})
@@ -156,6 +156,7 @@ void LLVMPointsToGraph::computePointsToGraph(llvm::Function *F) {
   PAMM_GET_INSTANCE;
   PHASAR_LOG_LEVEL(DEBUG, "Analyzing function: " << F->getName());
   AnalyzedFunctions.insert(F);
+  ++AllocationSitesGeneration;
   llvm::AAResults &AA = *PTA.getAAResults(F);
   bool EvalAAMD = true;
 
@@ -268,7 +269,15 @@ auto LLVMPointsToGraph::getReachableAllocationSites(
     const llvm::Value *V, bool /*IntraProcOnly*/,
     const llvm::Instruction * /*I*/) -> AllocationSiteSetPtrTy {
   computePointsToGraph(V);
-  auto AllocSites = std::make_unique<PointsToSetTy>();
+  auto &[AllocSites, Generation] = AllocationSiteCache[V];
+  if (!AllocSites) {
+    AllocSites = Owner.acquire();
+  } else if (Generation == AllocationSitesGeneration) {
+    return AllocSites;
+  } else {
+    AllocSites->clear();
+  }
+  Generation = AllocationSitesGeneration;
   AllocationSiteDFSVisitor AllocVis(*AllocSites, {});
   vector<boost::default_color_type> ColorMap(boost::num_vertices(PAG));
   boost::depth_first_visit(
@@ -295,6 +304,7 @@ void LLVMPointsToGraph::mergeWith(
   }
   AnalyzedFunctions.insert(OtherPTI->AnalyzedFunctions.begin(),
                            OtherPTI->AnalyzedFunctions.end());
+  ++AllocationSitesGeneration;
   using vertex_t = graph_t::vertex_descriptor;
   using vertex_map_t = std::map<vertex_t, vertex_t>;
   vertex_map_t OldToNewVertexMapping;
@@ -318,6 +328,7 @@ void LLVMPointsToGraph::introduceAlias(const llvm::Value *V1,
   auto Vert1 = ValueVertexMap[V1];
   auto Vert2 = ValueVertexMap[V2];
   boost::add_edge(Vert1, Vert2, I, PAG);
+  ++AllocationSitesGeneration;
 }
 
 vector<pair<unsigned, const llvm::Value *>>
@@ -13,14 +13,21 @@
 #include <iomanip>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <type_traits>
 #include <utility>
 
+#include "llvm/ADT/APInt.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
 #include "llvm/Analysis/AliasAnalysis.h"
+#include "llvm/Analysis/ValueTracking.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/GlobalValue.h"
@@ -31,8 +38,12 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Value.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/MemoryBufferRef.h"
+#include "llvm/Support/xxhash.h"
 
 #include "nlohmann/json.hpp"
 
@@ -53,35 +64,273 @@ template class DynamicPointsToSetPtr<>;
 template class DynamicPointsToSetConstPtr<>;
 template class PointsToSetOwner<LLVMPointsToInfo::PointsToSetTy>;
 
+namespace {
+
+/// The binary points-to format consists of the header, followed by
+///
+///   uint32 ClassOffsets[NumClasses + 1]
+///   uint32 ClassMembers[NumMembers]
+///   uint32 Padding, if NumClasses + 1 + NumMembers is odd
+///   uint64 AnalyzedFunctions[(NumFunctions + 63) / 64]
+///
+/// All integers are little endian. The members of alias class I are the
+/// sorted value ids ClassMembers[ClassOffsets[I]] to
+/// ClassMembers[ClassOffsets[I + 1] - 1]; bit I of the AnalyzedFunctions
+/// bitmap is set if the I-th function has been analyzed. Each section is
+/// aligned to the size of its elements, such that a memory-mapped file can be
+/// read in place.
+struct BinaryPointsToHeader {
+  char Magic[8];
+  llvm::support::ulittle32_t Version;
+  llvm::support::ulittle32_t NumValues;
+  llvm::support::ulittle64_t ModuleHash;
+  llvm::support::ulittle32_t NumFunctions;
+  llvm::support::ulittle32_t NumClasses;
+  llvm::support::ulittle32_t NumMembers;
+  llvm::support::ulittle32_t Reserved;
+};
+static_assert(sizeof(BinaryPointsToHeader) == 40);
+
+constexpr llvm::StringLiteral BinaryPointsToMagic("PSR-PTS");
+/// Must be incremented whenever the layout or the value numbering changes.
+constexpr uint32_t BinaryPointsToVersion = 2;
+
+/// Assigns dense ids to all values that may be part of a points-to set: the
+/// global values and, for every function definition, its arguments, its
+/// instructions and the pointer constants that they use. The modules are
+/// visited ordered by their identifiers, such that the ids only depend on the
+/// IR. The module hash covers the kinds, types and operand kinds of all
+/// numbered values, the names of the global values, the initializers of the
+/// global variables and the contents of all constants used by instructions.
+class ValueNumbering {
+public:
+  explicit ValueNumbering(const ProjectIRDB &IRDB) {
+    auto Modules = IRDB.getAllModules();
+    std::vector<const llvm::Module *> SortedModules(Modules.begin(),
+                                                    Modules.end());
+    std::sort(SortedModules.begin(), SortedModules.end(),
+              [](const llvm::Module *LHS, const llvm::Module *RHS) {
+                return LHS->getModuleIdentifier() <
+                       RHS->getModuleIdentifier();
+              });
+
+    for (const auto *M : SortedModules) {
+      for (const auto &GV : M->global_values()) {
+        addValue(&GV);
+      }
+      for (const auto &GV : M->globals()) {
+        if (GV.hasInitializer()) {
+          appendHashToHash(hashConstant(GV.getInitializer()));
+        }
+      }
+      for (const auto &F : *M) {
+        Functions.push_back(&F);
+        for (const auto &Arg : F.args()) {
+          addValue(&Arg);
+        }
+        for (const auto &Inst : llvm::instructions(F)) {
+          addValue(&Inst);
+        }
+        for (const auto &Inst : llvm::instructions(F)) {
+          for (const auto *Op : Inst.operand_values()) {
+            if (const auto *C = llvm::dyn_cast<llvm::Constant>(Op)) {
+              addConstant(C);
+              appendHashToHash(hashConstant(C));
+            }
+          }
+        }
+      }
+    }
+    flushHashBuffer();
+  }
+
+  [[nodiscard]] llvm::ArrayRef<const llvm::Value *> getValues() const {
+    return Values;
+  }
+
+  [[nodiscard]] llvm::ArrayRef<const llvm::Function *> getFunctions() const {
+    return Functions;
+  }
+
+  [[nodiscard]] uint64_t getModuleHash() const { return ModuleHash; }
+
+  [[nodiscard]] llvm::DenseMap<const llvm::Value *, uint32_t> getIds() const {
+    llvm::DenseMap<const llvm::Value *, uint32_t> Ids;
+    Ids.reserve(Values.size());
+    for (uint32_t Id = 0; Id < Values.size(); ++Id) {
+      Ids[Values[Id]] = Id;
+    }
+    return Ids;
+  }
+
+private:
+  static constexpr size_t HashChunkSize = 1 << 20;
+
+  void addValue(const llvm::Value *V) {
+    Values.push_back(V);
+    appendToHash(V->getValueID());
+    appendToHash(V->getType()->getTypeID());
+    if (const auto *GV = llvm::dyn_cast<llvm::GlobalValue>(V)) {
+      HashBuffer.append(GV->getName().begin(), GV->getName().end());
+      HashBuffer.push_back('\0');
+    } else if (const auto *U = llvm::dyn_cast<llvm::User>(V)) {
+      appendToHash(U->getNumOperands());
+      for (const auto *Op : U->operand_values()) {
+        appendToHash(Op->getValueID());
+      }
+    }
+    if (HashBuffer.size() >= HashChunkSize) {
+      flushHashBuffer();
+    }
+  }
+
+  void addConstant(const llvm::Constant *C) {
+    if (llvm::isa<llvm::GlobalValue>(C) || !SeenConstants.insert(C).second) {
+      return;
+    }
+    if (isInterestingPointer(C)) {
+      addValue(C);
+    }
+    if (llvm::isa<llvm::ConstantExpr>(C)) {
+      for (const auto *Op : C->operand_values()) {
+        addConstant(llvm::cast<llvm::Constant>(Op));
+      }
+    }
+  }
+
+  /// Hashes the contents of C; global values are identified by their names
+  /// only, such that the hash does not depend on the order of the globals.
+  uint64_t hashConstant(const llvm::Constant *C) {
+    if (auto It = ConstantHashes.find(C); It != ConstantHashes.end()) {
+      return It->second;
+    }
+    llvm::SmallString<64> Buffer;
+    auto Append = [&Buffer](uint64_t Data) {
+      char Bytes[sizeof(Data)];
+      llvm::support::endian::write64le(Bytes, Data);
+      Buffer.append(std::begin(Bytes), std::end(Bytes));
+    };
+    auto AppendWords = [&Append](const llvm::APInt &Value) {
+      for (unsigned Word = 0; Word < Value.getNumWords(); ++Word) {
+        Append(Value.getRawData()[Word]);
+      }
+    };
+    Append(C->getValueID());
+    Append(C->getType()->getTypeID());
+    if (const auto *GV = llvm::dyn_cast<llvm::GlobalValue>(C)) {
+      Buffer.append(GV->getName().begin(), GV->getName().end());
+    } else if (const auto *CI = llvm::dyn_cast<llvm::ConstantInt>(C)) {
+      AppendWords(CI->getValue());
+    } else if (const auto *CFP = llvm::dyn_cast<llvm::ConstantFP>(C)) {
+      AppendWords(CFP->getValueAPF().bitcastToAPInt());
+    } else if (const auto *CDS =
+                   llvm::dyn_cast<llvm::ConstantDataSequential>(C)) {
+      auto Data = CDS->getRawDataValues();
+      Buffer.append(Data.begin(), Data.end());
+    } else {
+      if (const auto *CE = llvm::dyn_cast<llvm::ConstantExpr>(C)) {
+        Append(CE->getOpcode());
+        if (CE->isCompare()) {
+          Append(CE->getPredicate());
+        }
+      }
+      for (const auto *Op : C->operand_values()) {
+        Append(hashConstant(llvm::cast<llvm::Constant>(Op)));
+      }
+    }
+    auto Hash = llvm::xxHash64(Buffer);
+    ConstantHashes[C] = Hash;
+    return Hash;
+  }
+
+  void appendToHash(uint32_t Data) {
+    char Bytes[sizeof(Data)];
+    llvm::support::endian::write32le(Bytes, Data);
+    HashBuffer.append(std::begin(Bytes), std::end(Bytes));
+  }
+
+  void appendHashToHash(uint64_t Data) {
+    char Bytes[sizeof(Data)];
+    llvm::support::endian::write64le(Bytes, Data);
+    HashBuffer.append(std::begin(Bytes), std::end(Bytes));
+  }
+
+  void flushHashBuffer() {
+    char Bytes[sizeof(ModuleHash)];
+    llvm::support::endian::write64le(Bytes, ModuleHash);
+    HashBuffer.append(std::begin(Bytes), std::end(Bytes));
+    ModuleHash = llvm::xxHash64(HashBuffer);
+    HashBuffer.clear();
+  }
+
+  std::vector<const llvm::Value *> Values;
+  std::vector<const llvm::Function *> Functions;
+  llvm::DenseSet<const llvm::Constant *> SeenConstants;
+  llvm::DenseMap<const llvm::Constant *, uint64_t> ConstantHashes;
+  llvm::SmallString<0> HashBuffer;
+  uint64_t ModuleHash = 0;
+};
+
+} // namespace
+
 LLVMPointsToSet::LLVMPointsToSet(ProjectIRDB &IRDB, bool UseLazyEvaluation,
                                  PointerAnalysisType PATy)
     : PTA(IRDB, UseLazyEvaluation, PATy) {
+  computePointsToSets(IRDB, UseLazyEvaluation);
+}
+
+LLVMPointsToSet::LLVMPointsToSet(ProjectIRDB &IRDB,
+                                 llvm::MemoryBufferRef SerializedPTS,
+                                 PointerAnalysisType PATy)
+    : PTA(IRDB, true, PATy) {
+  llvm::outs() << "Load precomputed points-to info from binary\n";
 
+  if (!loadBinary(IRDB, SerializedPTS)) {
+    computePointsToSets(IRDB, /*UseLazyEvaluation*/ true);
+  }
+}
+
+void LLVMPointsToSet::computePointsToSets(ProjectIRDB &IRDB,
+                                          bool UseLazyEvaluation) {
   auto NumGlobals = IRDB.getNumGlobals();
   PointsToSets.reserve(NumGlobals);
   Owner.reserve(NumGlobals);
 
   for (llvm::Module *M : IRDB.getAllModules()) {
-    // compute points-to information for all globals
+    computeModulesPointsToSets(*M, UseLazyEvaluation);
+  }
+  PHASAR_LOG_LEVEL(DEBUG, "LLVMPointsToSet completed");
+}
 
-    for (const auto &G : M->globals()) {
-      computeValuesPointsToSet(&G);
-    }
+LLVMPointsToSet::LLVMPointsToSet(ProjectIRDB &IRDB, const llvm::Module &M,
+                                 bool UseLazyEvaluation,
+                                 PointerAnalysisType PATy)
+    : PTA(IRDB, /*UseLazyEvaluation*/ true, PATy) {
+  computeModulesPointsToSets(M, UseLazyEvaluation);
+  PHASAR_LOG_LEVEL(DEBUG, "LLVMPointsToSet completed for module "
+                              << M.getModuleIdentifier());
+}
 
-    for (const auto &F : M->functions()) {
-      computeValuesPointsToSet(&F);
-    }
+void LLVMPointsToSet::computeModulesPointsToSets(const llvm::Module &M,
+                                                 bool UseLazyEvaluation) {
+  // compute points-to information for all globals
+  for (const auto &G : M.globals()) {
+    computeValuesPointsToSet(&G);
+  }
 
-    if (!UseLazyEvaluation) {
-      // compute points-to information for all functions
-      for (auto &F : *M) {
-        if (!F.isDeclaration()) {
-          computeFunctionsPointsToSet(&F);
-        }
+  for (const auto &F : M.functions()) {
+    computeValuesPointsToSet(&F);
+  }
+
+  if (!UseLazyEvaluation) {
+    // compute points-to information for all functions
+    for (const auto &F : M) {
+      if (!F.isDeclaration()) {
+        computeFunctionsPointsToSet(
+            const_cast<llvm::Function *>(&F)); // NOLINT
       }
     }
   }
-  PHASAR_LOG_LEVEL(DEBUG, "LLVMPointsToSet completed");
 }
 
 LLVMPointsToSet::LLVMPointsToSet(ProjectIRDB &IRDB,
@@ -216,6 +465,7 @@ void LLVMPointsToSet::mergePointsToSets(
   if (PTS1 == PTS2 || PTS1.get() == PTS2.get()) {
     return;
   }
+  invalidateAllocationSites();
 
   assert(PTS1 && PTS1.get());
   assert(PTS2 && PTS2.get());
@@ -246,9 +496,41 @@ void LLVMPointsToSet::mergePointsToSets(
     }
   }
 
+  mergeAllocationSites(ToDelete, LargerSet.get());
   Owner.release(ToDelete);
 }
 
+void LLVMPointsToSet::mergeAllocationSites(const PointsToSetTy *Merged,
+                                           const PointsToSetTy *Into) {
+  auto Search = AllocationSiteSetFunctions.find(Merged);
+  if (Search == AllocationSiteSetFunctions.end()) {
+    return;
+  }
+  auto Funs = std::move(Search->second);
+  AllocationSiteSetFunctions.erase(Search);
+  for (const auto *Fun : Funs) {
+    auto MergedIt = AllocationSiteSets.find({Merged, Fun});
+    assert(MergedIt != AllocationSiteSets.end());
+    auto MergedEntry = std::move(MergedIt->second);
+    AllocationSiteSets.erase(MergedIt);
+    auto [IntoIt, Inserted] = AllocationSiteSets.try_emplace({Into, Fun});
+    if (Inserted) {
+      // the set is outdated and recomputed on the next query
+      IntoIt->second = std::move(MergedEntry);
+      AllocationSiteSetFunctions[Into].push_back(Fun);
+      continue;
+    }
+    auto &IntoEntry = IntoIt->second;
+    auto *ToDelete = MergedEntry.Sites.get();
+    MergedEntry.Redirected.push_back(MergedEntry.Sites);
+    for (auto Handle : MergedEntry.Redirected) {
+      *Handle.value() = IntoEntry.Sites.get();
+      IntoEntry.Redirected.push_back(Handle);
+    }
+    AllocationSiteOwner.release(ToDelete);
+  }
+}
+
 bool LLVMPointsToSet::interIsReachableAllocationSiteTy(
     [[maybe_unused]] const llvm::Value *V, const llvm::Value *P) {
   // consider the full inter-procedural points-to/alias information
@@ -322,16 +604,140 @@ static bool mayAlias(llvm::AAResults &AA, const llvm::DataLayout &DL,
   return false;
 }
 
-void LLVMPointsToSet::addPointer(llvm::AAResults &AA,
-                                 const llvm::DataLayout &DL,
-                                 const llvm::Value *V,
-                                 std::vector<const llvm::Value *> &Reps) {
-  llvm::SmallVector<unsigned> ToMerge;
+namespace {
+
+/// Returns the object V is based on if it is an identified object, e.g. an
+/// alloca or a global. Pointers that are based on different identified
+/// objects never alias. This mirrors the corresponding check of BasicAA, which
+/// is part of every AA pipeline that we use, such that skipping the alias
+/// queries for these pairs does not change the results.
+const llvm::Value *getIdentifiedObject(const llvm::Value *V) {
+  static constexpr unsigned MaxLookupSearchDepth = 6; // as in BasicAA
+  const auto *Obj = llvm::getUnderlyingObject(
+      V->stripPointerCastsForAliasAnalysis(), MaxLookupSearchDepth);
+  return llvm::isIdentifiedObject(Obj) ? Obj : nullptr;
+}
+
+/// Partitions the pointers used in a single function into alias classes.
+///
+/// Each class is represented by one pointer per occurring type. A new pointer
+/// is compared against the representatives that are based on the same
+/// identified object or on no identified object only. The classes are kept in
+/// a union-find structure with union by size and path compression.
+class AliasClassBuilder {
+public:
+  AliasClassBuilder(llvm::AAResults &AA, const llvm::DataLayout &DL)
+      : AA(AA), DL(DL) {}
+
+  void addPointer(const llvm::Value *V);
+
+  void addSingleton(const llvm::Value *V) { getOrCreateId(V); }
+
+  void merge(const llvm::Value *V1, const llvm::Value *V2) {
+    unite(getOrCreateId(V1), getOrCreateId(V2));
+  }
+
+  void getClasses(std::vector<const llvm::Value *> &Members,
+                  std::vector<uint32_t> &Offsets);
 
-  for (unsigned It = 0, End = Reps.size(); It < End; ++It) {
-    if (mayAlias(AA, DL, V, Reps[It])) {
-      ToMerge.push_back(It);
+private:
+  struct Representative {
+    const llvm::Value *Ptr;
+    const llvm::Value *Object;
+    uint32_t Id;
+    // the order in which the representatives have been added
+    uint32_t Seq;
+  };
+  using RepresentativeList = llvm::SmallVector<Representative, 2>;
+
+  llvm::AAResults &AA;
+  const llvm::DataLayout &DL;
+
+  llvm::DenseMap<const llvm::Value *, uint32_t> Ids;
+  std::vector<const llvm::Value *> Values;
+  std::vector<uint32_t> Parents;
+  std::vector<uint32_t> Sizes;
+
+  llvm::DenseMap<const llvm::Value *, RepresentativeList> RepsByObject;
+  RepresentativeList UnknownObjectReps;
+  uint32_t NextSeq = 0;
+
+  uint32_t getOrCreateId(const llvm::Value *V) {
+    auto [It, Inserted] = Ids.try_emplace(V, Values.size());
+    if (Inserted) {
+      Values.push_back(V);
+      Parents.push_back(It->second);
+      Sizes.push_back(1);
+    }
+    return It->second;
+  }
+
+  uint32_t find(uint32_t Id) {
+    uint32_t Root = Id;
+    while (Parents[Root] != Root) {
+      Root = Parents[Root];
+    }
+    while (Parents[Id] != Root) {
+      uint32_t Next = Parents[Id];
+      Parents[Id] = Root;
+      Id = Next;
     }
+    return Root;
+  }
+
+  void unite(uint32_t Id1, uint32_t Id2) {
+    Id1 = find(Id1);
+    Id2 = find(Id2);
+    if (Id1 == Id2) {
+      return;
+    }
+    if (Sizes[Id1] < Sizes[Id2]) {
+      std::swap(Id1, Id2);
+    }
+    Parents[Id2] = Id1;
+    Sizes[Id1] += Sizes[Id2];
+  }
+
+  RepresentativeList &getBucket(const llvm::Value *Object) {
+    return Object ? RepsByObject[Object] : UnknownObjectReps;
+  }
+};
+
+void AliasClassBuilder::addPointer(const llvm::Value *V) {
+  const auto *Obj = getIdentifiedObject(V);
+  llvm::SmallVector<Representative> ToMerge;
+  auto CollectAliasing = [&](llvm::ArrayRef<Representative> Reps) {
+    for (const auto &Rep : Reps) {
+      if (mayAlias(AA, DL, V, Rep.Ptr)) {
+        ToMerge.push_back(Rep);
+      }
+    }
+  };
+
+  CollectAliasing(UnknownObjectReps);
+  if (Obj) {
+    if (auto It = RepsByObject.find(Obj); It != RepsByObject.end()) {
+      CollectAliasing(It->second);
+    }
+  } else {
+    for (const auto &[Unused, Reps] : RepsByObject) {
+      CollectAliasing(Reps);
+    }
+  }
+  // Visit the representatives in the order in which they have been added to
+  // keep the choice of the removed representatives deterministic
+  llvm::sort(ToMerge, [](const Representative &Lhs, const Representative &Rhs) {
+    return Lhs.Seq < Rhs.Seq;
+  });
+
+  uint32_t Id = getOrCreateId(V);
+  auto AddRepresentative = [&] {
+    getBucket(Obj).push_back({V, Obj, Id, NextSeq++});
+  };
+
+  if (ToMerge.empty()) {
+    AddRepresentative();
+    return;
   }
 
   // If we find several alias sets that may alias V, we must merge them.
@@ -343,56 +749,50 @@ void LLVMPointsToSet::addPointer(llvm::AAResults &AA,
   // still remove a representant, if we have another rep of the same type
   // within the same alias set.
 
-  if (ToMerge.empty()) {
-    Reps.push_back(V);
-    addSingletonPointsToSet(V);
-  } else if (ToMerge.size() == 1) {
-    auto PTS = PointsToSets[Reps[ToMerge[0]]];
-    assert(PTS && "Only added to Reps together with a "
-                  "\"addSingletonPointsToSet\" call");
-
-    if (auto VPTS = PointsToSets.find(V); VPTS != PointsToSets.end()) {
-      mergePointsToSets(PTS, VPTS->second);
-    } else {
-      PointsToSets[V] = PTS;
-      PTS->insert(V);
-    }
-
-    if (V->getType() != Reps[ToMerge[0]]->getType()) {
-      Reps.push_back(V);
-    }
-
-  } else {
-    auto PTS = PointsToSets[Reps[ToMerge[0]]];
-    llvm::SmallPtrSet<const llvm::Type *, 6> OccurringTypes{
-        Reps[ToMerge[0]]->getType()};
-    llvm::SmallVector<unsigned> ToRemove;
-
-    for (auto Idx : llvm::makeArrayRef(ToMerge).slice(1)) {
-      mergePointsToSets(PTS, PointsToSets[Reps[Idx]]);
-      if (auto [Unused, Inserted] = OccurringTypes.insert(Reps[Idx]->getType());
-          !Inserted) {
-        ToRemove.push_back(Idx);
-      }
-    }
-
-    if (auto VPTS = PointsToSets.find(V); VPTS != PointsToSets.end()) {
-      mergePointsToSets(PTS, VPTS->second);
-    } else {
-      PointsToSets[V] = PTS;
-      PTS->insert(V);
+  unite(Id, ToMerge.front().Id);
+  llvm::SmallPtrSet<const llvm::Type *, 6> OccurringTypes{
+      ToMerge.front().Ptr->getType()};
+  for (const auto &Rep : llvm::makeArrayRef(ToMerge).drop_front()) {
+    unite(Id, Rep.Id);
+    if (auto [Unused, Inserted] = OccurringTypes.insert(Rep.Ptr->getType());
+        !Inserted) {
+      llvm::erase_if(getBucket(Rep.Object), [&Rep](const auto &Other) {
+        return Other.Seq == Rep.Seq;
+      });
     }
+  }
 
-    Reps.erase(remove_by_index(Reps, ToRemove.begin(), ToRemove.end()),
-               Reps.end());
+  if (auto [Unused, Inserted] = OccurringTypes.insert(V->getType());
+      Inserted) {
+    AddRepresentative();
+  }
+}
 
-    if (auto [Unused, Inserted] = OccurringTypes.insert(V->getType());
-        Inserted) {
-      Reps.push_back(V);
+void AliasClassBuilder::getClasses(std::vector<const llvm::Value *> &Members,
+                                   std::vector<uint32_t> &Offsets) {
+  // counting sort by class
+  std::vector<uint32_t> Roots(Values.size());
+  std::vector<uint32_t> ClassOffsets(Values.size() + 1);
+  for (uint32_t Id = 0; Id < Values.size(); ++Id) {
+    Roots[Id] = find(Id);
+    ++ClassOffsets[Roots[Id] + 1];
+  }
+  Offsets.clear();
+  for (uint32_t Id = 0; Id < Values.size(); ++Id) {
+    if (Roots[Id] == Id) {
+      Offsets.push_back(ClassOffsets[Id]);
     }
+    ClassOffsets[Id + 1] += ClassOffsets[Id];
+  }
+  Offsets.push_back(Values.size());
+  Members.resize(Values.size());
+  for (uint32_t Id = 0; Id < Values.size(); ++Id) {
+    Members[ClassOffsets[Roots[Id]]++] = Values[Id];
   }
 }
 
+} // namespace
+
 static void addIfGlobal(llvm::DenseSet<const llvm::Value *> &UsedGlobals,
                         const llvm::Value *Op) {
   llvm::SmallPtrSet<const llvm::Value *, 4> Seen;
@@ -435,49 +835,46 @@ void LLVMPointsToSet::computeFunctionsPointsToSet(llvm::Function *F) {
   }
   PHASAR_LOG_LEVEL(DEBUG, "Analyzing function: " << F->getName());
 
-  llvm::AAResults &AA = *PTA.getAAResults(F);
-  bool EvalAAMD = true;
+  addAliasClasses(computeAliasClasses(*PTA.getAAResults(F), *F));
 
-  const llvm::DataLayout &DL = F->getParent()->getDataLayout();
+  // we no longer need the LLVM representation
+  PTA.erase(F);
+}
 
-  auto addPointer = [this, &AA, &DL](const llvm::Value *V, // NOLINT
-                                     std::vector<const llvm::Value *> &Reps) {
-    return this->addPointer(AA, DL, V, Reps);
-  };
+auto LLVMPointsToSet::computeAliasClasses(llvm::AAResults &AA,
+                                          const llvm::Function &F)
+    -> FunctionAliasClasses {
+  bool EvalAAMD = true;
 
-  std::vector<const llvm::Value *> Pointers;
+  AliasClassBuilder Builder(AA, F.getParent()->getDataLayout());
   llvm::DenseSet<const llvm::Value *> UsedGlobals;
 
-  for (auto &Inst : llvm::instructions(F)) {
+  for (const auto &Inst : llvm::instructions(F)) {
     if (Inst.getType()->isPointerTy()) {
       // Add all pointer instructions.
-      addPointer(&Inst, Pointers);
+      Builder.addPointer(&Inst);
     }
 
     if (EvalAAMD && llvm::isa<llvm::StoreInst>(&Inst)) {
 
-      auto *Store = llvm::cast<llvm::StoreInst>(&Inst);
-      auto *SVO = Store->getValueOperand();
-      auto *SPO = Store->getPointerOperand();
+      const auto *Store = llvm::cast<llvm::StoreInst>(&Inst);
+      const auto *SVO = Store->getValueOperand();
+      const auto *SPO = Store->getPointerOperand();
       if (SVO->getType()->isPointerTy()) {
 
         if (llvm::isa<llvm::Function>(SVO)) {
-          addSingletonPointsToSet(SVO);
-          addSingletonPointsToSet(SPO);
-          mergePointsToSets(SVO, SPO);
+          Builder.merge(SVO, SPO);
         }
-        if (auto *SVOCE = llvm::dyn_cast<llvm::ConstantExpr>(SVO)) {
+        if (const auto *SVOCE = llvm::dyn_cast<llvm::ConstantExpr>(SVO)) {
           if (SVOCE->isCast()) {
-            auto *RHS = SVOCE->getOperand(0);
+            const auto *RHS = SVOCE->getOperand(0);
 
-            addSingletonPointsToSet(SPO);
+            Builder.addSingleton(SPO);
             if (RHS->getType()->isPointerTy()) {
-              addSingletonPointsToSet(RHS);
-              mergePointsToSets(RHS, SPO);
+              Builder.merge(RHS, SPO);
             }
 
-            addSingletonPointsToSet(SVOCE);
-            mergePointsToSets(SVOCE, SPO);
+            Builder.merge(SVOCE, SPO);
           }
         }
       }
@@ -486,49 +883,67 @@ void LLVMPointsToSet::computeFunctionsPointsToSet(llvm::Function *F) {
     /// The operands/arguments of instructions should already be inserted,
     /// because of the SSA form
 
-    if (auto *Call = llvm::dyn_cast<llvm::CallBase>(&Inst)) {
-      llvm::Value *Callee = Call->getCalledOperand();
+    if (const auto *Call = llvm::dyn_cast<llvm::CallBase>(&Inst)) {
+      const llvm::Value *Callee = Call->getCalledOperand();
       // Skip actual functions for direct function calls.
       if (!llvm::isa<llvm::Function>(Callee) && isInterestingPointer(Callee) &&
           !llvm::isa<llvm::Instruction>(Callee)) {
-        addPointer(Callee, Pointers);
+        Builder.addPointer(Callee);
       }
 
       // Consider arguments.
-      for (llvm::Use &DataOp : Call->data_ops()) {
+      for (const llvm::Use &DataOp : Call->data_ops()) {
         addIfGlobal(UsedGlobals, DataOp);
         if (!llvm::isa<llvm::Instruction>(DataOp) &&
             isInterestingPointer(DataOp)) {
-          addPointer(DataOp, Pointers);
+          Builder.addPointer(DataOp);
         }
       }
     } else {
       // Consider all operands; the instructions we have already seen
-      for (auto &Op : Inst.operands()) {
+      for (const auto &Op : Inst.operands()) {
         addIfGlobal(UsedGlobals, Op);
         if (!llvm::isa<llvm::Instruction>(Op) && isInterestingPointer(Op)) {
-          addPointer(Op, Pointers);
+          Builder.addPointer(Op);
         }
       }
     }
   }
 
-  for (auto &I : F->args()) {
+  for (const auto &I : F.args()) {
     if (I.getType()->isPointerTy()) {
       // Add all pointer arguments.
-      addPointer(&I, Pointers);
+      Builder.addPointer(&I);
     }
   }
 
-  auto NumGlobals = UsedGlobals.size();
-
-  Pointers.reserve(Pointers.size() + NumGlobals);
   for (const auto *Glob : UsedGlobals) {
-    addPointer(Glob, Pointers);
+    Builder.addPointer(Glob);
   }
 
-  // we no longer need the LLVM representation
-  PTA.erase(F);
+  FunctionAliasClasses Classes;
+  Builder.getClasses(Classes.Members, Classes.Offsets);
+  return Classes;
+}
+
+void LLVMPointsToSet::addAliasClasses(const FunctionAliasClasses &Classes) {
+  invalidateAllocationSites();
+  for (size_t Class = 0; Class + 1 < Classes.Offsets.size(); ++Class) {
+    auto Members = llvm::makeArrayRef(Classes.Members)
+                       .slice(Classes.Offsets[Class],
+                              Classes.Offsets[Class + 1] -
+                                  Classes.Offsets[Class]);
+    addSingletonPointsToSet(Members.front());
+    auto PTS = PointsToSets[Members.front()];
+    for (const auto *V : Members.drop_front()) {
+      if (auto VPTS = PointsToSets.find(V); VPTS != PointsToSets.end()) {
+        mergePointsToSets(PTS, VPTS->second);
+      } else {
+        PointsToSets[V] = PTS;
+        PTS->insert(V);
+      }
+    }
+  }
 }
 
 AliasResult
@@ -572,17 +987,40 @@ auto LLVMPointsToSet::getReachableAllocationSites(
     const llvm::Value *V, bool IntraProcOnly,
     [[maybe_unused]] const llvm::Instruction *I) -> AllocationSiteSetPtrTy {
 
-  auto AllocSites = std::make_unique<PointsToSetTy>();
-
   // if V is not a (interesting) pointer we can return an empty set
   if (!isInterestingPointer(V)) {
-    return AllocSites;
+    return getEmptyPointsToSet();
   }
   computeValuesPointsToSet(V);
 
   const auto PTS = PointsToSets[V];
-  // consider the full inter-procedural points-to/alias information
-  if (!IntraProcOnly) {
+  // Intra-procedural queries for globals consider the same allocation sites
+  // as inter-procedural ones
+  const auto *VFun = IntraProcOnly && !llvm::isa<llvm::GlobalObject>(V)
+                         ? retrieveFunction(V)
+                         : nullptr;
+  if (IntraProcOnly && !VFun && !llvm::isa<llvm::GlobalObject>(V)) {
+    // We may not be able to retrieve a function for the given value since
+    // some pointer values can exist outside functions, for instance, in case
+    // of vtables, etc. Such values have no function-local allocation sites.
+    return getEmptyPointsToSet();
+  }
+
+  auto [It, Inserted] = AllocationSiteSets.try_emplace({PTS.get(), VFun});
+  auto &Entry = It->second;
+  if (Inserted) {
+    Entry.Sites = AllocationSiteOwner.acquire();
+    AllocationSiteSetFunctions[PTS.get()].push_back(VFun);
+  } else if (Entry.Generation == AllocationSitesGeneration) {
+    return Entry.Sites;
+  } else {
+    // a points-to set has changed since the set has been computed
+    Entry.Sites->clear();
+  }
+  Entry.Generation = AllocationSitesGeneration;
+  auto AllocSites = Entry.Sites;
+  if (!VFun) {
+    // consider the full inter-procedural points-to/alias information
     for (const auto *P : *PTS) {
       if (interIsReachableAllocationSiteTy(V, P)) {
         AllocSites->insert(P);
@@ -591,13 +1029,8 @@ auto LLVMPointsToSet::getReachableAllocationSites(
   } else {
     // consider the function-local, i.e. intra-procedural, points-to/alias
     // information only
-    const auto *VFun = retrieveFunction(V);
-    const auto *VG = llvm::dyn_cast<llvm::GlobalObject>(V);
-    // We may not be able to retrieve a function for the given value since some
-    // pointer values can exist outside functions, for instance, in case of
-    // vtables, etc.
     for (const auto *P : *PTS) {
-      if (intraIsReachableAllocationSiteTy(V, P, VFun, VG)) {
+      if (intraIsReachableAllocationSiteTy(V, P, VFun, nullptr)) {
         AllocSites->insert(P);
       }
     }
@@ -639,6 +1072,7 @@ void LLVMPointsToSet::mergeWith(const PointsToInfo &PTI) {
     llvm::report_fatal_error(
         "LLVMPointsToSet can only be merged with another LLVMPointsToSet!");
   }
+  invalidateAllocationSites();
   // merge analyzed functions
   AnalyzedFunctions.insert(OtherPTI->AnalyzedFunctions.begin(),
                            OtherPTI->AnalyzedFunctions.end());
@@ -716,6 +1150,165 @@ void LLVMPointsToSet::printAsJson(llvm::raw_ostream &OS) const {
   OS << getAsJson();
 }
 
+void LLVMPointsToSet::printAsBinary(const ProjectIRDB &IRDB,
+                                    llvm::raw_ostream &OS) const {
+  ValueNumbering Numbering(IRDB);
+  auto Ids = Numbering.getIds();
+
+  std::vector<uint32_t> Offsets{0};
+  std::vector<uint32_t> Members;
+  for (const PointsToSetTy *PTS : Owner.getAllPointsToSets()) {
+    auto Begin = Members.size();
+    for (const auto *Alias : *PTS) {
+      if (auto It = Ids.find(Alias); It != Ids.end()) {
+        Members.push_back(It->second);
+      }
+    }
+    if (Members.size() != Begin) {
+      std::sort(Members.begin() + Begin, Members.end());
+      Offsets.push_back(Members.size());
+    }
+  }
+
+  // Order the classes by their smallest member, such that the output does not
+  // depend on the addresses of the points-to sets
+  std::vector<uint32_t> Order(Offsets.size() - 1);
+  std::iota(Order.begin(), Order.end(), 0);
+  std::sort(Order.begin(), Order.end(), [&](uint32_t LHS, uint32_t RHS) {
+    return Members[Offsets[LHS]] < Members[Offsets[RHS]];
+  });
+
+  auto Functions = Numbering.getFunctions();
+  std::vector<uint64_t> AnalyzedBits((Functions.size() + 63) / 64);
+  for (size_t Idx = 0; Idx < Functions.size(); ++Idx) {
+    if (AnalyzedFunctions.count(Functions[Idx])) {
+      AnalyzedBits[Idx / 64] |= uint64_t(1) << (Idx % 64);
+    }
+  }
+
+  llvm::support::endian::Writer W(OS, llvm::support::little);
+  OS.write(BinaryPointsToMagic.data(), BinaryPointsToMagic.size() + 1);
+  W.write<uint32_t>(BinaryPointsToVersion);
+  W.write<uint32_t>(Numbering.getValues().size());
+  W.write<uint64_t>(Numbering.getModuleHash());
+  W.write<uint32_t>(Functions.size());
+  W.write<uint32_t>(Order.size());
+  W.write<uint32_t>(Members.size());
+  W.write<uint32_t>(0);
+
+  uint32_t Offset = 0;
+  W.write<uint32_t>(Offset);
+  for (auto Class : Order) {
+    Offset += Offsets[Class + 1] - Offsets[Class];
+    W.write<uint32_t>(Offset);
+  }
+  for (auto Class : Order) {
+    for (auto Idx = Offsets[Class]; Idx < Offsets[Class + 1]; ++Idx) {
+      W.write<uint32_t>(Members[Idx]);
+    }
+  }
+  if ((Order.size() + 1 + Members.size()) % 2) {
+    W.write<uint32_t>(0);
+  }
+  for (auto Bits : AnalyzedBits) {
+    W.write<uint64_t>(Bits);
+  }
+}
+
+bool LLVMPointsToSet::loadBinary(const ProjectIRDB &IRDB,
+                                 llvm::MemoryBufferRef SerializedPTS) {
+  auto Buffer = SerializedPTS.getBuffer();
+  if (Buffer.size() < sizeof(BinaryPointsToHeader)) {
+    PHASAR_LOG_LEVEL(WARNING, "Binary points-to info is truncated");
+    return false;
+  }
+  const auto *Header =
+      reinterpret_cast<const BinaryPointsToHeader *>(Buffer.data());
+  if (llvm::StringRef(Header->Magic, sizeof(Header->Magic)) !=
+      llvm::StringRef(BinaryPointsToMagic.data(),
+                      BinaryPointsToMagic.size() + 1)) {
+    PHASAR_LOG_LEVEL(WARNING, "Not a binary points-to info file");
+    return false;
+  }
+  if (Header->Version != BinaryPointsToVersion) {
+    PHASAR_LOG_LEVEL(WARNING, "Unsupported binary points-to info version: "
+                                  << Header->Version);
+    return false;
+  }
+
+  ValueNumbering Numbering(IRDB);
+  auto Values = Numbering.getValues();
+  auto Functions = Numbering.getFunctions();
+  if (Header->ModuleHash != Numbering.getModuleHash() ||
+      Header->NumValues != Values.size() ||
+      Header->NumFunctions != Functions.size()) {
+    PHASAR_LOG_LEVEL(WARNING,
+                     "Binary points-to info belongs to a different module");
+    return false;
+  }
+
+  size_t NumClasses = Header->NumClasses;
+  size_t NumMembers = Header->NumMembers;
+  size_t NumIdWords = NumClasses + 1 + NumMembers;
+  size_t NumBitWords = (Functions.size() + 63) / 64;
+  if (Buffer.size() != sizeof(BinaryPointsToHeader) +
+                           (NumIdWords + NumIdWords % 2) * sizeof(uint32_t) +
+                           NumBitWords * sizeof(uint64_t)) {
+    PHASAR_LOG_LEVEL(WARNING, "Binary points-to info has an invalid size");
+    return false;
+  }
+
+  const auto *IdWords = reinterpret_cast<const llvm::support::ulittle32_t *>(
+      Buffer.data() + sizeof(BinaryPointsToHeader));
+  llvm::ArrayRef<llvm::support::ulittle32_t> ClassOffsets(IdWords,
+                                                         NumClasses + 1);
+  llvm::ArrayRef<llvm::support::ulittle32_t> ClassMembers(
+      IdWords + NumClasses + 1, NumMembers);
+  llvm::ArrayRef<llvm::support::ulittle64_t> AnalyzedBits(
+      reinterpret_cast<const llvm::support::ulittle64_t *>(
+          IdWords + NumIdWords + NumIdWords % 2),
+      NumBitWords);
+
+  bool Valid = ClassOffsets.front() == 0 && ClassOffsets.back() == NumMembers;
+  for (size_t Class = 0; Valid && Class < NumClasses; ++Class) {
+    Valid = ClassOffsets[Class] < ClassOffsets[Class + 1];
+  }
+  // Every value may only be a member of a single alias class
+  llvm::BitVector SeenMembers(Values.size());
+  for (size_t Idx = 0; Valid && Idx < NumMembers; ++Idx) {
+    Valid = ClassMembers[Idx] < Values.size() &&
+            !SeenMembers.test(ClassMembers[Idx]);
+    if (Valid) {
+      SeenMembers.set(ClassMembers[Idx]);
+    }
+  }
+  if (!Valid) {
+    PHASAR_LOG_LEVEL(WARNING, "Binary points-to info is corrupted");
+    return false;
+  }
+
+  Owner.reserve(NumClasses);
+  PointsToSets.reserve(NumMembers);
+  for (size_t Class = 0; Class < NumClasses; ++Class) {
+    uint32_t Begin = ClassOffsets[Class];
+    uint32_t End = ClassOffsets[Class + 1];
+    auto PTS = Owner.acquire();
+    PTS->reserve(End - Begin);
+    for (uint32_t Idx = Begin; Idx < End; ++Idx) {
+      const auto *V = Values[ClassMembers[Idx]];
+      PointsToSets[V] = PTS;
+      PTS->insert(V);
+    }
+  }
+
+  for (size_t Idx = 0; Idx < Functions.size(); ++Idx) {
+    if ((AnalyzedBits[Idx / 64] >> (Idx % 64)) & 1) {
+      AnalyzedFunctions.insert(Functions[Idx]);
+    }
+  }
+  return true;
+}
+
 void LLVMPointsToSet::print(llvm::raw_ostream &OS) const {
   for (const auto &[V, PTS] : PointsToSets) {
     OS << "V: " << llvmIRToString(V) << '\n';
@@ -255,8 +255,10 @@ void LLVMTypeHierarchy::constructHierarchy(const llvm::Module &M) {
 
 std::set<const llvm::StructType *>
 LLVMTypeHierarchy::getSubTypes(const llvm::StructType *Type) {
-  if (TypeVertexMap.count(Type)) {
-    return TypeGraph[TypeVertexMap[Type]].ReachableTypes;
+  // Only looks up the type, as the call-graph resolvers may query the type
+  // hierarchy from multiple threads
+  if (auto It = TypeVertexMap.find(Type); It != TypeVertexMap.end()) {
+    return TypeGraph[It->second].ReachableTypes;
   }
   return {};
 }
@@ -0,0 +1,241 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/Utils/FeatureModel.h"
+#include "phasar/Utils/Logger.h"
+
+namespace psr {
+
+namespace {
+
+/// Evaluates V in the configuration Config if it only depends on features and
+/// constants. Branch conditions on features are usually of the form
+/// 'trunc (load @feature) to i1' or 'icmp ne (load @feature), 0', but may
+/// combine several features as well.
+std::optional<int64_t>
+evaluate(const llvm::Value *V, const std::set<std::string> &Config,
+         const llvm::DenseMap<const llvm::GlobalVariable *, std::string>
+             &Features,
+         unsigned Depth = 0) {
+  static constexpr unsigned MaxDepth = 16;
+  if (Depth > MaxDepth) {
+    return std::nullopt;
+  }
+  if (const auto *CI = llvm::dyn_cast<llvm::ConstantInt>(V)) {
+    return CI->getBitWidth() == 1 ? int64_t(CI->getZExtValue())
+                                  : CI->getSExtValue();
+  }
+  if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(V)) {
+    const auto *Global = llvm::dyn_cast<llvm::GlobalVariable>(
+        Load->getPointerOperand()->stripPointerCasts());
+    if (auto Search = Features.find(Global); Search != Features.end()) {
+      return Config.count(Search->second) ? 1 : 0;
+    }
+    return std::nullopt;
+  }
+  if (const auto *Cast = llvm::dyn_cast<llvm::CastInst>(V)) {
+    auto Op = evaluate(Cast->getOperand(0), Config, Features, Depth + 1);
+    if (Op && Cast->getType()->isIntegerTy(1)) {
+      return *Op & 1;
+    }
+    return Op;
+  }
+  if (const auto *Cmp = llvm::dyn_cast<llvm::ICmpInst>(V)) {
+    auto Lhs = evaluate(Cmp->getOperand(0), Config, Features, Depth + 1);
+    auto Rhs = evaluate(Cmp->getOperand(1), Config, Features, Depth + 1);
+    if (!Lhs || !Rhs) {
+      return std::nullopt;
+    }
+    // features are small non-negative integers, hence, the signedness of the
+    // comparison does not matter
+    switch (Cmp->getPredicate()) {
+    case llvm::CmpInst::ICMP_EQ:
+      return *Lhs == *Rhs;
+    case llvm::CmpInst::ICMP_NE:
+      return *Lhs != *Rhs;
+    case llvm::CmpInst::ICMP_SGT:
+    case llvm::CmpInst::ICMP_UGT:
+      return *Lhs > *Rhs;
+    case llvm::CmpInst::ICMP_SGE:
+    case llvm::CmpInst::ICMP_UGE:
+      return *Lhs >= *Rhs;
+    case llvm::CmpInst::ICMP_SLT:
+    case llvm::CmpInst::ICMP_ULT:
+      return *Lhs < *Rhs;
+    case llvm::CmpInst::ICMP_SLE:
+    case llvm::CmpInst::ICMP_ULE:
+      return *Lhs <= *Rhs;
+    default:
+      return std::nullopt;
+    }
+  }
+  if (const auto *BinOp = llvm::dyn_cast<llvm::BinaryOperator>(V)) {
+    auto Lhs = evaluate(BinOp->getOperand(0), Config, Features, Depth + 1);
+    auto Rhs = evaluate(BinOp->getOperand(1), Config, Features, Depth + 1);
+    if (!Lhs || !Rhs) {
+      return std::nullopt;
+    }
+    switch (BinOp->getOpcode()) {
+    case llvm::Instruction::And:
+      return *Lhs & *Rhs;
+    case llvm::Instruction::Or:
+      return *Lhs | *Rhs;
+    case llvm::Instruction::Xor:
+      return *Lhs ^ *Rhs;
+    default:
+      return std::nullopt;
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace
+
+llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
+                              const PresenceCondition &PC) {
+  OS << '{';
+  bool First = true;
+  for (unsigned Idx : PC.set_bits()) {
+    if (!First) {
+      OS << ", ";
+    }
+    OS << Idx;
+    First = false;
+  }
+  return OS << '}';
+}
+
+FeatureModel::FeatureModel(const ProjectIRDB &IRDB,
+                           std::vector<std::set<std::string>> Configurations,
+                           llvm::StringRef FeaturePrefix)
+    : Configurations(std::move(Configurations)),
+      FeaturePrefix(FeaturePrefix.str()),
+      True(this->Configurations.size(), true),
+      False(this->Configurations.size(), false) {
+  for (const auto *M : IRDB.getAllModules()) {
+    for (const auto &Global : M->globals()) {
+      if (Global.getName().startswith(FeaturePrefix)) {
+        Features[&Global] =
+            Global.getName().drop_front(FeaturePrefix.size()).str();
+      }
+    }
+  }
+  if (Features.empty()) {
+    return;
+  }
+  for (const auto *M : IRDB.getAllModules()) {
+    for (const auto &F : *M) {
+      for (const auto &I : llvm::instructions(F)) {
+        const auto *Branch = llvm::dyn_cast<llvm::BranchInst>(&I);
+        if (!Branch || !Branch->isConditional() ||
+            Branch->getSuccessor(0) == Branch->getSuccessor(1)) {
+          continue;
+        }
+        PresenceCondition Taken = False;
+        bool DependsOnFeaturesOnly = true;
+        for (size_t Idx = 0; Idx < this->Configurations.size(); ++Idx) {
+          auto Cond = evaluate(Branch->getCondition(),
+                               this->Configurations[Idx], Features);
+          if (!Cond) {
+            DependsOnFeaturesOnly = false;
+            break;
+          }
+          if (*Cond) {
+            Taken.set(Idx);
+          }
+        }
+        if (DependsOnFeaturesOnly) {
+          PresenceCondition NotTaken = Taken;
+          NotTaken.flip();
+          BranchConditions[Branch] = {std::move(Taken), std::move(NotTaken)};
+        }
+      }
+    }
+  }
+  PHASAR_LOG_LEVEL(INFO, "Found " << Features.size() << " feature(s) and "
+                                  << BranchConditions.size()
+                                  << " branch(es) on features");
+}
+
+std::vector<std::set<std::string>> FeatureModel::parseConfigurations(
+    const std::vector<std::string> &Configurations) {
+  std::vector<std::set<std::string>> Result;
+  Result.reserve(Configurations.size());
+  for (const auto &Configuration : Configurations) {
+    llvm::SmallVector<llvm::StringRef, 8> Names;
+    llvm::StringRef(Configuration)
+        .split(Names, ',', /*MaxSplit*/ -1, /*KeepEmpty*/ false);
+    auto &Enabled = Result.emplace_back();
+    for (auto Name : Names) {
+      Enabled.insert(Name.trim().str());
+    }
+  }
+  return Result;
+}
+
+std::set<std::string> FeatureModel::getFeatures() const {
+  std::set<std::string> Result;
+  for (const auto &Feature : Features) {
+    Result.insert(Feature.second);
+  }
+  return Result;
+}
+
+const PresenceCondition &
+FeatureModel::getPresenceCondition(const llvm::Instruction *Curr,
+                                   const llvm::Instruction *Succ) const {
+  const auto *Branch = llvm::dyn_cast<llvm::BranchInst>(Curr);
+  if (!Branch) {
+    return True;
+  }
+  auto Search = BranchConditions.find(Branch);
+  if (Search == BranchConditions.end()) {
+    return True;
+  }
+  if (Succ->getParent() == Branch->getSuccessor(0)) {
+    return Search->second.first;
+  }
+  if (Succ->getParent() == Branch->getSuccessor(1)) {
+    return Search->second.second;
+  }
+  return True;
+}
+
+void FeatureModel::print(llvm::raw_ostream &OS) const {
+  OS << "Features:";
+  for (const auto &Feature : getFeatures()) {
+    OS << ' ' << Feature;
+  }
+  OS << '\n';
+  for (size_t Idx = 0; Idx < Configurations.size(); ++Idx) {
+    OS << "Configuration " << Idx << ":";
+    for (const auto &Feature : Configurations[Idx]) {
+      OS << ' ' << Feature;
+    }
+    OS << '\n';
+  }
+}
+
+} // namespace psr
@@ -0,0 +1,397 @@
+/******************************************************************************
+ * Copyright (c) 2022 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InlineAsm.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/Utils/FunctionHashes.h"
+
+namespace psr {
+
+namespace {
+
+/// Collects the global variables that C refers to, also through nested
+/// constant expressions, aggregates and the initializers of the collected
+/// globals, e.g., the global accessed by a constant getelementptr.
+void collectGlobals(
+    const llvm::Constant *C,
+    llvm::SmallSetVector<const llvm::GlobalVariable *, 4> &Globals) {
+  llvm::SmallVector<const llvm::Constant *, 8> Worklist = {C};
+  llvm::SmallPtrSet<const llvm::Constant *, 8> Visited;
+  while (!Worklist.empty()) {
+    const auto *Curr = Worklist.pop_back_val();
+    if (!Visited.insert(Curr).second) {
+      continue;
+    }
+    if (const auto *GV = llvm::dyn_cast<llvm::GlobalVariable>(Curr)) {
+      Globals.insert(GV);
+      if (GV->hasInitializer()) {
+        Worklist.push_back(GV->getInitializer());
+      }
+      continue;
+    }
+    if (llvm::isa<llvm::GlobalValue>(Curr)) {
+      continue;
+    }
+    for (const auto &Op : Curr->operands()) {
+      if (const auto *OpC = llvm::dyn_cast<llvm::Constant>(Op.get())) {
+        Worklist.push_back(OpC);
+      }
+    }
+  }
+}
+
+/// Writes a canonical textual representation of a function that is
+/// independent of value names and metadata.
+class FunctionEncoder {
+public:
+  explicit FunctionEncoder(llvm::raw_ostream &OS) : OS(OS) {}
+
+  void encode(const llvm::Function &F) {
+    F.getFunctionType()->print(OS);
+    OS << ' ' << F.getCallingConv() << ' ' << F.isVarArg() << '\n';
+    unsigned Idx = 0;
+    for (const auto &Arg : F.args()) {
+      Ids[&Arg] = Idx++;
+    }
+    Idx = 0;
+    for (const auto &BB : F) {
+      Ids[&BB] = Idx++;
+    }
+    Idx = 0;
+    for (const auto &I : llvm::instructions(F)) {
+      if (!llvm::isa<llvm::DbgInfoIntrinsic>(I)) {
+        Ids[&I] = Idx++;
+      }
+    }
+    for (const auto &BB : F) {
+      OS << "b" << Ids[&BB] << ":\n";
+      for (const auto &I : BB) {
+        if (!llvm::isa<llvm::DbgInfoIntrinsic>(I)) {
+          encode(I);
+        }
+      }
+    }
+    // The initializers of the global variables referenced, also indirectly,
+    // are part of the behavior
+    for (const auto *G : Globals) {
+      OS << '@' << G->getName() << " = " << G->isConstant() << ' ';
+      G->getValueType()->print(OS);
+      if (G->hasInitializer()) {
+        OS << ' ';
+        G->getInitializer()->printAsOperand(OS, /*PrintType*/ true);
+      }
+      OS << '\n';
+    }
+  }
+
+private:
+  void encode(const llvm::Instruction &I) {
+    OS << I.getOpcodeName() << ' ';
+    I.getType()->print(OS);
+    OS << ' ' << I.getRawSubclassOptionalData();
+    if (const auto *Cmp = llvm::dyn_cast<llvm::CmpInst>(&I)) {
+      OS << " p" << Cmp->getPredicate();
+    } else if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+      OS << ' ';
+      Alloca->getAllocatedType()->print(OS);
+    } else if (const auto *GEP = llvm::dyn_cast<llvm::GetElementPtrInst>(&I)) {
+      OS << ' ';
+      GEP->getSourceElementType()->print(OS);
+    } else if (const auto *Phi = llvm::dyn_cast<llvm::PHINode>(&I)) {
+      for (const auto *BB : Phi->blocks()) {
+        OS << " b" << Ids.lookup(BB);
+      }
+    } else if (const auto *EV = llvm::dyn_cast<llvm::ExtractValueInst>(&I)) {
+      for (auto Idx : EV->indices()) {
+        OS << " #" << Idx;
+      }
+    } else if (const auto *IV = llvm::dyn_cast<llvm::InsertValueInst>(&I)) {
+      for (auto Idx : IV->indices()) {
+        OS << " #" << Idx;
+      }
+    }
+    for (const auto &Op : I.operands()) {
+      OS << ' ';
+      encode(Op.get());
+    }
+    OS << '\n';
+  }
+
+  void encode(const llvm::Value *V) {
+    if (llvm::isa<llvm::Argument>(V)) {
+      OS << 'a' << Ids.lookup(V);
+    } else if (llvm::isa<llvm::BasicBlock>(V)) {
+      OS << 'b' << Ids.lookup(V);
+    } else if (llvm::isa<llvm::Instruction>(V)) {
+      OS << 'i' << Ids.lookup(V);
+    } else if (const auto *G = llvm::dyn_cast<llvm::GlobalValue>(V)) {
+      OS << '@' << G->getName();
+      collectGlobals(G, Globals);
+    } else if (const auto *C = llvm::dyn_cast<llvm::Constant>(V)) {
+      C->printAsOperand(OS, /*PrintType*/ true);
+      collectGlobals(C, Globals);
+    } else if (const auto *Asm = llvm::dyn_cast<llvm::InlineAsm>(V)) {
+      OS << "asm \"" << Asm->getAsmString() << "\" \""
+         << Asm->getConstraintString() << '"';
+    } else if (llvm::isa<llvm::MetadataAsValue>(V)) {
+      OS << "md";
+    } else {
+      OS << '?';
+    }
+  }
+
+  llvm::raw_ostream &OS;
+  llvm::DenseMap<const llvm::Value *, unsigned> Ids;
+  llvm::SmallSetVector<const llvm::GlobalVariable *, 4> Globals;
+};
+
+bool accessesMutableGlobals(const llvm::Function &F) {
+  llvm::SmallSetVector<const llvm::GlobalVariable *, 4> Globals;
+  for (const auto &I : llvm::instructions(F)) {
+    for (const auto &Op : I.operands()) {
+      if (const auto *C = llvm::dyn_cast<llvm::Constant>(Op.get())) {
+        collectGlobals(C, Globals);
+      }
+    }
+  }
+  return llvm::any_of(Globals, [](const llvm::GlobalVariable *GV) {
+    return !GV->isConstant();
+  });
+}
+
+uint64_t hashValues(std::vector<uint64_t> &Values) {
+  std::sort(Values.begin(), Values.end());
+  Values.erase(std::unique(Values.begin(), Values.end()), Values.end());
+  return llvm::xxHash64(llvm::StringRef(
+      reinterpret_cast<const char *>(Values.data()), // NOLINT
+      Values.size() * sizeof(uint64_t)));
+}
+
+} // namespace
+
+uint64_t getStructuralHash(const llvm::Function &F) {
+  std::string Buffer;
+  llvm::raw_string_ostream OS(Buffer);
+  FunctionEncoder(OS).encode(F);
+  return llvm::xxHash64(OS.str());
+}
+
+FunctionHashes::FunctionHashes(const ProjectIRDB &IRDB) {
+  // The modules are sorted to obtain a deterministic order of the functions
+  auto AllModules = IRDB.getAllModules();
+  std::vector<const llvm::Module *> Modules(AllModules.begin(),
+                                            AllModules.end());
+  std::sort(Modules.begin(), Modules.end(),
+            [](const llvm::Module *LHS, const llvm::Module *RHS) {
+              return LHS->getModuleIdentifier() < RHS->getModuleIdentifier();
+            });
+  std::vector<const llvm::Function *> Functions;
+  llvm::StringMap<unsigned> FunctionIds;
+  std::vector<unsigned> AddressTaken;
+  for (const auto *M : Modules) {
+    for (const auto &F : *M) {
+      if (F.isDeclaration() ||
+          !FunctionIds.try_emplace(F.getName(), Functions.size()).second) {
+        continue;
+      }
+      if (F.hasAddressTaken()) {
+        AddressTaken.push_back(Functions.size());
+      }
+      Functions.push_back(&F);
+    }
+  }
+
+  // the call graph
+  std::vector<std::vector<unsigned>> Callees(Functions.size());
+  for (unsigned Idx = 0; Idx < Functions.size(); ++Idx) {
+    bool HasIndirectCall = false;
+    for (const auto &I : llvm::instructions(*Functions[Idx])) {
+      const auto *Call = llvm::dyn_cast<llvm::CallBase>(&I);
+      if (!Call || llvm::isa<llvm::DbgInfoIntrinsic>(Call)) {
+        continue;
+      }
+      const auto *Callee = llvm::dyn_cast<llvm::Function>(
+          Call->getCalledOperand()->stripPointerCasts());
+      if (!Callee) {
+        HasIndirectCall |= !Call->isInlineAsm();
+        continue;
+      }
+      if (auto Search = FunctionIds.find(Callee->getName());
+          Search != FunctionIds.end()) {
+        Callees[Idx].push_back(Search->second);
+      }
+    }
+    if (HasIndirectCall) {
+      Callees[Idx].insert(Callees[Idx].end(), AddressTaken.begin(),
+                          AddressTaken.end());
+    }
+  }
+
+  std::vector<Entry> Hashes(Functions.size());
+  for (unsigned Idx = 0; Idx < Functions.size(); ++Idx) {
+    Hashes[Idx].Hash = getStructuralHash(*Functions[Idx]);
+    Hashes[Idx].MayAccessMutableGlobals =
+        accessesMutableGlobals(*Functions[Idx]);
+  }
+
+  // Compute the closure hashes on the strongly connected components of the
+  // call graph (Tarjan's algorithm, iteratively); a component is completed
+  // after all components it calls.
+  constexpr unsigned Unvisited = ~0U;
+  std::vector<unsigned> Index(Functions.size(), Unvisited);
+  std::vector<unsigned> LowLink(Functions.size(), 0);
+  std::vector<bool> OnStack(Functions.size(), false);
+  std::vector<unsigned> SCCStack;
+  // pairs of function and index of the next callee to visit
+  std::vector<std::pair<unsigned, unsigned>> CallStack;
+  unsigned NextIndex = 0;
+
+  auto Visit = [&](unsigned Idx) {
+    Index[Idx] = LowLink[Idx] = NextIndex++;
+    SCCStack.push_back(Idx);
+    OnStack[Idx] = true;
+    CallStack.emplace_back(Idx, 0);
+  };
+
+  for (unsigned Root = 0; Root < Functions.size(); ++Root) {
+    if (Index[Root] != Unvisited) {
+      continue;
+    }
+    Visit(Root);
+    while (!CallStack.empty()) {
+      auto &[Idx, Next] = CallStack.back();
+      if (Next < Callees[Idx].size()) {
+        unsigned Callee = Callees[Idx][Next++];
+        if (Index[Callee] == Unvisited) {
+          Visit(Callee);
+        } else if (OnStack[Callee]) {
+          LowLink[Idx] = std::min(LowLink[Idx], Index[Callee]);
+        }
+        continue;
+      }
+      unsigned Current = Idx;
+      CallStack.pop_back();
+      if (!CallStack.empty()) {
+        unsigned Parent = CallStack.back().first;
+        LowLink[Parent] = std::min(LowLink[Parent], LowLink[Current]);
+      }
+      if (LowLink[Current] != Index[Current]) {
+        continue;
+      }
+      std::vector<unsigned> Members;
+      unsigned Member;
+      do {
+        Member = SCCStack.back();
+        SCCStack.pop_back();
+        OnStack[Member] = false;
+        Members.push_back(Member);
+      } while (Member != Current);
+      // The closure hash covers the members and the components they call,
+      // whose closure hashes are already known
+      std::vector<uint64_t> MemberHashes;
+      std::vector<uint64_t> CalleeHashes;
+      bool MayAccessMutableGlobals = false;
+      for (unsigned M : Members) {
+        MemberHashes.push_back(Hashes[M].Hash);
+        MayAccessMutableGlobals |= Hashes[M].MayAccessMutableGlobals;
+        for (unsigned Callee : Callees[M]) {
+          if (std::find(Members.begin(), Members.end(), Callee) ==
+              Members.end()) {
+            CalleeHashes.push_back(Hashes[Callee].ClosureHash);
+            MayAccessMutableGlobals |= Hashes[Callee].MayAccessMutableGlobals;
+          }
+        }
+      }
+      std::vector<uint64_t> ComponentHash = {hashValues(MemberHashes),
+                                             hashValues(CalleeHashes)};
+      uint64_t ClosureHash = llvm::xxHash64(llvm::StringRef(
+          reinterpret_cast<const char *>(ComponentHash.data()), // NOLINT
+          ComponentHash.size() * sizeof(uint64_t)));
+      for (unsigned M : Members) {
+        Hashes[M].ClosureHash = ClosureHash;
+        Hashes[M].MayAccessMutableGlobals = MayAccessMutableGlobals;
+      }
+    }
+  }
+
+  for (unsigned Idx = 0; Idx < Functions.size(); ++Idx) {
+    Entries[Functions[Idx]->getName()] = Hashes[Idx];
+  }
+}
+
+std::optional<uint64_t>
+FunctionHashes::getHash(llvm::StringRef FunctionName) const {
+  auto Search = Entries.find(FunctionName);
+  if (Search == Entries.end()) {
+    return std::nullopt;
+  }
+  return Search->second.Hash;
+}
+
+std::optional<uint64_t>
+FunctionHashes::getClosureHash(llvm::StringRef FunctionName) const {
+  auto Search = Entries.find(FunctionName);
+  if (Search == Entries.end()) {
+    return std::nullopt;
+  }
+  return Search->second.ClosureHash;
+}
+
+bool FunctionHashes::mayAccessMutableGlobals(
+    llvm::StringRef FunctionName) const {
+  auto Search = Entries.find(FunctionName);
+  return Search == Entries.end() || Search->second.MayAccessMutableGlobals;
+}
+
+std::vector<std::string>
+FunctionHashes::getChangedFunctions(const FunctionHashes &Old) const {
+  std::vector<std::string> Changed;
+  for (const auto &Entry : Entries) {
+    if (Old.getClosureHash(Entry.getKey()) != Entry.getValue().ClosureHash) {
+      Changed.push_back(Entry.getKey().str());
+    }
+  }
+  std::sort(Changed.begin(), Changed.end());
+  return Changed;
+}
+
+void FunctionHashes::print(llvm::raw_ostream &OS) const {
+  std::vector<llvm::StringRef> Names;
+  for (const auto &Entry : Entries) {
+    Names.push_back(Entry.getKey());
+  }
+  std::sort(Names.begin(), Names.end());
+  for (auto Name : Names) {
+    const auto &E = Entries.lookup(Name);
+    OS << Name << ": " << llvm::format_hex(E.Hash, 18) << ' '
+       << llvm::format_hex(E.ClosureHash, 18) << '\n';
+  }
+}
+
+} // namespace psr
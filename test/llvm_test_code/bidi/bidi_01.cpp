@@ -0,0 +1,11 @@
+int G = 0;
+
+void source() { G = 1; }
+
+void sink() { int X = G; }
+
+int main() {
+  source();
+  sink();
+  return 0;
+}
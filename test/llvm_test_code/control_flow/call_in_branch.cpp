@@ -0,0 +1,9 @@
+void foo(int i) {}
+
+int main(int argc, char **argv) {
+  int i = 42;
+  if (argc > 1) {
+    foo(i);
+  }
+  return 0;
+}
@@ -0,0 +1,9 @@
+int increment(int i) { return i + 1; }
+
+int twice(int i) { return 3 * i; }
+
+int main() {
+  int a = increment(41);
+  int b = twice(10);
+  return a + b;
+}
@@ -0,0 +1,10 @@
+int increment(int i) { return i + 1; }
+
+void set(int *p) { *p = 42; }
+
+int main() {
+  int a = 0;
+  int b = increment(0);
+  set(&b);
+  return a + b;
+}
@@ -0,0 +1,11 @@
+const int Table[3] = {1, 2, 3};
+int Counters[2] = {0, 0};
+
+int lookup() { return Table[1]; }
+
+void count() { ++Counters[1]; }
+
+int main() {
+  count();
+  return lookup();
+}
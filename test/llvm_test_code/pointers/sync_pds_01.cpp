@@ -0,0 +1,39 @@
+struct Box {
+  int *Ptr;
+  int *Other;
+};
+
+int *id(int *P) { return P; }
+
+int contexts() {
+  int A = 0;
+  int B = 1;
+  int *X = id(&A);
+  int *Y = id(&B);
+  return *X + *Y;
+}
+
+int fields() {
+  int C = 2;
+  int D = 3;
+  Box Bx;
+  Bx.Ptr = &C;
+  Bx.Other = &D;
+  int *Z = Bx.Ptr;
+  return *Z;
+}
+
+void *opaque(void *P) { return P; }
+
+void *synchronization() {
+  char C = 0;
+  char *A = &C;
+  void *X = opaque(&A);
+  void *Y = opaque(&C);
+  return Y;
+}
+
+int main() {
+  synchronization();
+  return contexts() + fields();
+}
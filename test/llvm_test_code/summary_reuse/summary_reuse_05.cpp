@@ -0,0 +1,10 @@
+int lib(int a) {
+  int u;
+  return a + u;
+}
+
+int main() {
+  int i = 20;
+  int b = lib(i);
+  return b;
+}
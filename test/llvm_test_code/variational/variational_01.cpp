@@ -0,0 +1,25 @@
+// Variability-encoded form of
+//   #ifdef LOGGING
+//   b = a;
+//   #endif
+//   #ifdef VERBOSE
+//   sink(a);
+//   #endif
+extern "C" bool __phasar_feature_LOGGING;
+extern "C" bool __phasar_feature_VERBOSE;
+
+extern int source();     // dummy source
+extern void sink(int p); // dummy sink
+
+int main() {
+  int a = source();
+  int b = 0;
+  if (__phasar_feature_LOGGING) {
+    b = a;
+  }
+  sink(b);
+  if (__phasar_feature_VERBOSE) {
+    sink(a);
+  }
+  return 0;
+}
@@ -12,7 +12,6 @@
 #include "phasar/DB/ProjectIRDB.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/SyncPDS/Solver/SyncPDSSolver.h"
-#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 #include "phasar/Utils/Logger.h"
 
@@ -29,8 +28,10 @@ int main(int Argc, char **Argv) {
   }
   ProjectIRDB DB({Argv[1]}, IRDBOptions::WPA);
   LLVMTypeHierarchy H(DB);
-  LLVMPointsToSet P(DB);
-  LLVMBasedICFG ICFG(DB, CallGraphAnalysisType::OTF, {"main"}, &H, &P);
+  // the aliases are computed on demand, so the call graph must not depend on
+  // a whole-program points-to analysis
+  LLVMBasedICFG ICFG(DB, CallGraphAnalysisType::CHA, {"main"}, &H);
+  SyncPDSSolver SPDS(ICFG);
   for (auto &F : *DB.getWPAModule()) {
     if (F.isDeclaration()) {
       continue;
@@ -56,12 +57,11 @@ int main(int Argc, char **Argv) {
             Load->getPointerOperand()->print(llvm::outs());
             llvm::outs() << '\n';
             // query SPDS solver to find the aliases
-            // SyncPDSSolver SPDS(ICFG);
-            // set<const llvm::Value *> Aliases =
-            // SPDS.getAliasesOf(Load->getPointerOperand()); llvm::outs() <<
-            // "Found aliases:"; for (auto A : Aliases) {
-            //   A->print(llvm::outs() << '\n');
-            // }
+            llvm::outs() << "Found aliases:";
+            for (const auto *Alias :
+                 *SPDS.getAliasesOf(Load->getPointerOperand())) {
+              Alias->print(llvm::outs() << '\n');
+            }
             llvm::outs() << '\n';
           } else {
             llvm::outs() << "Ups!\n";
@@ -10,15 +10,18 @@
 #include <algorithm>
 #include <chrono>
 #include <filesystem>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "boost/program_options.hpp"
 #include "boost/program_options/value_semantic.hpp"
 
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/MemoryBuffer.h"
 
 #include "nlohmann/json.hpp"
 
@@ -137,6 +140,13 @@ void validateSoundnessFlag(const std::string &Flag) {
   }
 }
 
+void validateParamSchedulingPolicy(const std::string &Policy) {
+  if (toPathEdgeSchedulingPolicy(Policy) == PathEdgeSchedulingPolicy::Invalid) {
+    throw boost::program_options::error_with_option_name(
+        "'" + Policy + "' is not a valid path-edge scheduling policy!");
+  }
+}
+
 void validateParamAnalysisConfig(const std::vector<std::string> &Configs) {
   for (const auto &Config : Configs) {
     if (!(std::filesystem::exists(Config) &&
@@ -147,7 +157,7 @@ void validateParamAnalysisConfig(const std::vector<std::string> &Configs) {
   }
 }
 
-void validatePTAJsonFile(const std::string &Config) {
+void validatePTAFile(const std::string &Config) {
   if (!(std::filesystem::exists(Config) &&
         !std::filesystem::is_directory(Config))) {
     throw boost::program_options::error_with_option_name(
@@ -188,6 +198,8 @@ int main(int Argc, const char **Argv) {
       ("classhierarchy-analysis,H", "Class-hierarchy analysis")
 			("statistical-analysis,S", "Statistics")
 			("mwa,M", "Enable Modulewise-program analysis mode")
+			("base-module", boost::program_options::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing()->notifier(&validateParamModule), "Path to the module(s) of the previous program version (required by the incremental analysis strategy INC)")
+			("configuration", boost::program_options::value<std::vector<std::string>>()->multitoken()->composing(), "Set a configuration to be analyzed as a comma-separated list of enabled features, e.g., \"LOGGING,SSL\" (required by the variational analysis strategy VAR)")
 			("printedgerec,R", "Print exploded-super-graph edge recorder")
       #ifdef DYNAMIC_LOG
       ("log,L", "Enable logging")
@@ -209,14 +221,21 @@ int main(int Argc, const char **Argv) {
       ("emit-pta-as-text", "Emit the points-to information as text")
       ("emit-pta-as-dot", "Emit the points-to information as DOT graph")
       ("emit-pta-as-json", "Emit the points-to information as JSON")
+      ("emit-pta-as-binary", "Emit the points-to information in the compact binary format")
       ("follow-return-past-seeds", boost::program_options::value<bool>()->default_value(false), "Let the IFDS/IDE Solver process unbalanced returns")
       ("auto-add-zero", boost::program_options::value<bool>()->default_value(true), "Let the IFDS/IDE Solver automatically add the special zero value to any set of dataflow-facts")
       ("compute-values", boost::program_options::value<bool>()->default_value(true), "Let the IDE Solver compute the values attached to each edge in the ESG")
       ("record-edges", boost::program_options::value<bool>()->default_value(true), "Let the IFDS/IDE Solver record all ESG edges whole solving the dataflow problem. This can have massive performance impact")
-      ("persisted-summaries", boost::program_options::value<bool>()->default_value(false), "Let the IFDS/IDE Solver compute presisted procedure summaries (Currently not supported)")
-      ("load-pta-from-json", boost::program_options::value<std::string>()->notifier(&validatePTAJsonFile),"Load the points-to info previously exported via emit-pta-as-json from the given file")
+      ("path-edge-scheduling", boost::program_options::value<std::string>()->notifier(&validateParamSchedulingPolicy)->default_value("FIFO"), "Set the order in which the IFDS/IDE Solver processes path edges (FIFO, LIFO, ReversePostOrder/RPO)")
+      ("persisted-summaries", boost::program_options::value<bool>()->default_value(false), "Let the IFDS/IDE Solver reuse and persist procedure summaries across runs (whole-program analysis only)")
+      ("summary-dir", boost::program_options::value<std::string>()->default_value("."), "Directory of the persisted procedure summaries, one store per analysis")
+      ("summary-pack", boost::program_options::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing(), "Apply the summaries of the given summary pack(s), e.g., of libc or libstdc++, instead of analyzing the functions they summarize (IFDS analyses only)")
+      ("generate-summary-pack", "Compute the summaries of all functions of the module(s) under analysis and write them as a summary pack to the summary directory instead of analyzing them (use with -E __ALL__)")
+      ("load-pta-from-json", boost::program_options::value<std::string>()->notifier(&validatePTAFile),"Load the points-to info previously exported via emit-pta-as-json from the given file")
+      ("load-pta-from-binary", boost::program_options::value<std::string>()->notifier(&validatePTAFile),"Load the points-to info previously exported via emit-pta-as-binary from the given file")
       ("pamm-out,A", boost::program_options::value<std::string>()->notifier(validateParamPammOutputFile)->default_value("PAMM_data.json"), "Filename for PAMM's gathered data")
-      ("right-to-ludicrous-speed", "Uses ludicrous speed (shared memory parallelism) whenever possible (Currently not available)");
+      ("solver-threads", boost::program_options::value<unsigned>(), "Set the number of threads used by the IFDS/IDE Solver in ludicrous-speed mode (default: number of hardware threads)")
+      ("right-to-ludicrous-speed", "Uses ludicrous speed (shared memory parallelism) whenever possible; for best scaling, disable record-edges");
   // clang-format on
   boost::program_options::options_description CmdlineOptions;
   CmdlineOptions.add(Generic).add(Config);
@@ -300,6 +319,9 @@ int main(int Argc, const char **Argv) {
   } else {
     Strategy = AnalysisStrategy::WholeProgram;
   }
+  if (PhasarConfig::VariablesMap().count("mwa")) {
+    Strategy = AnalysisStrategy::ModuleWise;
+  }
   if (!PhasarConfig::VariablesMap().count("module")) {
     llvm::outs() << "At least on LLVM target module is required!\n"
                     "Specify a LLVM target module or re-run with '--help'\n";
@@ -308,17 +330,29 @@ int main(int Argc, const char **Argv) {
 
   bool EmitStats = PhasarConfig::VariablesMap().count("statistical-analysis");
 
-  // setup IRDB as source code manager
+  // setup IRDB as source code manager; the module-wise analysis keeps the
+  // modules separate instead of linking them into a single WPA module
   ProjectIRDB IRDB(
-      PhasarConfig::VariablesMap()["module"].as<std::vector<std::string>>());
+      PhasarConfig::VariablesMap()["module"].as<std::vector<std::string>>(),
+      Strategy == AnalysisStrategy::ModuleWise
+          ? IRDBOptions::OWNS
+          : (IRDBOptions::WPA | IRDBOptions::OWNS));
 
   if (EmitStats) {
-    llvm::outs() << "Module " << IRDB.getWPAModule()->getName().str() << ":\n";
+    std::vector<llvm::Module *> StatModules;
+    if (Strategy == AnalysisStrategy::ModuleWise) {
+      const auto &AllModules = IRDB.getAllModules();
+      StatModules.assign(AllModules.begin(), AllModules.end());
+    } else {
+      StatModules.push_back(IRDB.getWPAModule());
+    }
+    for (auto *M : StatModules) {
+      llvm::outs() << "Module " << M->getName().str() << ":\n";
+      llvm::outs() << "> functions:\t\t" << M->size() << "\n";
+      llvm::outs() << "> global variables:\t" << M->global_size() << "\n";
+    }
     llvm::outs() << "> LLVM IR instructions:\t" << IRDB.getNumInstructions()
                  << "\n";
-    llvm::outs() << "> functions:\t\t" << IRDB.getWPAModule()->size() << "\n";
-    llvm::outs() << "> global variables:\t"
-                 << IRDB.getWPAModule()->global_size() << "\n";
   }
 
   // store enabled data-flow analyses
@@ -401,6 +435,9 @@ int main(int Argc, const char **Argv) {
   if (PhasarConfig::VariablesMap().count("emit-pta-as-json")) {
     EmitterOptions |= AnalysisControllerEmitterOptions::EmitPTAAsJson;
   }
+  if (PhasarConfig::VariablesMap().count("emit-pta-as-binary")) {
+    EmitterOptions |= AnalysisControllerEmitterOptions::EmitPTAAsBinary;
+  }
   if (PhasarConfig::VariablesMap().count("follow-return-past-seeds")) {
     SolverConfig.setFollowReturnsPastSeeds(
         PhasarConfig::VariablesMap()["follow-return-past-seeds"].as<bool>());
@@ -417,16 +454,60 @@ int main(int Argc, const char **Argv) {
     SolverConfig.setRecordEdges(
         PhasarConfig::VariablesMap()["record-edges"].as<bool>());
   }
+  if (PhasarConfig::VariablesMap().count("path-edge-scheduling")) {
+    SolverConfig.setSchedulingPolicy(toPathEdgeSchedulingPolicy(
+        PhasarConfig::VariablesMap()["path-edge-scheduling"]
+            .as<std::string>()));
+  }
+  if (PhasarConfig::VariablesMap().count("right-to-ludicrous-speed")) {
+    unsigned NumThreads = std::thread::hardware_concurrency();
+    if (PhasarConfig::VariablesMap().count("solver-threads")) {
+      NumThreads =
+          PhasarConfig::VariablesMap()["solver-threads"].as<unsigned>();
+    }
+    SolverConfig.setNumThreads(NumThreads);
+  }
   if (PhasarConfig::VariablesMap().count("persisted-summaries")) {
     SolverConfig.setComputePersistedSummaries(
         PhasarConfig::VariablesMap()["persisted-summaries"].as<bool>());
   }
+  if (PhasarConfig::VariablesMap().count("summary-dir")) {
+    SolverConfig.setPersistedSummariesDirectory(
+        PhasarConfig::VariablesMap()["summary-dir"].as<std::string>());
+  }
+  if (PhasarConfig::VariablesMap().count("summary-pack")) {
+    SolverConfig.setSummaryPacks(
+        PhasarConfig::VariablesMap()["summary-pack"]
+            .as<std::vector<std::string>>());
+  }
+  if (PhasarConfig::VariablesMap().count("generate-summary-pack")) {
+    SolverConfig.setGenerateSummaryPack();
+  }
+  if (PhasarConfig::VariablesMap().count("load-pta-from-json") &&
+      PhasarConfig::VariablesMap().count("load-pta-from-binary")) {
+    llvm::errs() << "Error: 'load-pta-from-json' and 'load-pta-from-binary' "
+                    "cannot be used together!\n";
+    return 1;
+  }
   nlohmann::json PrecomputedPointsToSet;
   if (auto PTAFile = PhasarConfig::VariablesMap().find("load-pta-from-json");
       PTAFile != PhasarConfig::VariablesMap().end()) {
     PrecomputedPointsToSet =
         readJsonFile(llvm::StringRef(PTAFile->second.as<std::string>()));
   }
+  std::unique_ptr<llvm::MemoryBuffer> PrecomputedPointsToBinary;
+  if (auto PTAFile = PhasarConfig::VariablesMap().find("load-pta-from-binary");
+      PTAFile != PhasarConfig::VariablesMap().end()) {
+    auto PTAPath = PTAFile->second.as<std::string>();
+    auto Buffer = llvm::MemoryBuffer::getFile(
+        PTAPath, /*IsText*/ false, /*RequiresNullTerminator*/ false);
+    if (!Buffer) {
+      llvm::errs() << "Could not read points-to info file '" << PTAPath
+                   << "': " << Buffer.getError().message() << '\n';
+      return 1;
+    }
+    PrecomputedPointsToBinary = std::move(*Buffer);
+  }
   // setup output directory
   std::string OutDirectory;
   if (PhasarConfig::VariablesMap().count("out")) {
@@ -437,11 +518,24 @@ int main(int Argc, const char **Argv) {
   if (PhasarConfig::VariablesMap().count("project-id")) {
     ProjectID = PhasarConfig::VariablesMap()["project-id"].as<std::string>();
   }
+  // setup the previous program version for the incremental analysis
+  std::vector<std::string> BaseModules;
+  if (PhasarConfig::VariablesMap().count("base-module")) {
+    BaseModules = PhasarConfig::VariablesMap()["base-module"]
+                      .as<std::vector<std::string>>();
+  }
+  // setup the configurations for the variational analysis
+  std::vector<std::string> Configurations;
+  if (PhasarConfig::VariablesMap().count("configuration")) {
+    Configurations = PhasarConfig::VariablesMap()["configuration"]
+                         .as<std::vector<std::string>>();
+  }
   AnalysisController Controller(
       IRDB, std::move(DataFlowAnalyses), std::move(AnalysisConfigs), PTATy,
       CGTy, SoundnessLevel,
       PhasarConfig::VariablesMap()["auto-globals"].as<bool>(), EntryPoints,
       Strategy, EmitterOptions, SolverConfig, ProjectID, OutDirectory,
-      PrecomputedPointsToSet);
+      PrecomputedPointsToSet, PrecomputedPointsToBinary.get(), BaseModules,
+      Configurations);
   return 0;
 }
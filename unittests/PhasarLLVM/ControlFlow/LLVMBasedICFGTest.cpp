@@ -1,8 +1,12 @@
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/IntrinsicInst.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "phasar/Config/Configuration.h"
@@ -408,6 +412,48 @@ TEST(LLVMBasedICFGTest, GlobalCtorDtor_4) {
   ASSERT_TRUE(VertFuns.find(AfterMain) != boost::end(VertFuns));
 }
 
+TEST(LLVMBasedICFGTest, CallGraphIndex_1) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "call_graphs/virtual_call_3_cpp.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::CHA, {"main"}, &TH, &PT);
+  const llvm::Function *Main = IRDB.getFunctionDefinition("main");
+  const llvm::Function *Ctor = IRDB.getFunctionDefinition("_ZN5AImplC2Ev");
+  const llvm::Function *Foo = IRDB.getFunctionDefinition("_ZN5AImpl3fooEv");
+  const llvm::Function *ADtor = IRDB.getFunctionDefinition("_ZN1AD0Ev");
+  const llvm::Function *AImplDtor = IRDB.getFunctionDefinition("_ZN5AImplD0Ev");
+  ASSERT_TRUE(Main);
+  ASSERT_TRUE(Ctor);
+  ASSERT_TRUE(Foo);
+  ASSERT_TRUE(ADtor);
+  ASSERT_TRUE(AImplDtor);
+
+  // main calls operator new, the constructor, foo() and the deleting
+  // destructor, the latter two are resolved through the vtables of A and AImpl
+  std::vector<std::set<const llvm::Function *>> Expected = {
+      {IRDB.getFunction("_Znwm")}, {Ctor}, {Foo}, {ADtor, AImplDtor}};
+  std::vector<std::set<const llvm::Function *>> Actual;
+  for (const auto &I : llvm::instructions(Main)) {
+    if (!llvm::isa<llvm::CallBase>(I) || llvm::isa<llvm::IntrinsicInst>(I)) {
+      continue;
+    }
+    auto Callees = ICFG.getCalleesOfCallAtRef(&I);
+    EXPECT_TRUE(std::is_sorted(Callees.begin(), Callees.end()));
+    for (const auto *Callee : Callees) {
+      auto Callers = ICFG.getCallersOfRef(Callee);
+      EXPECT_TRUE(std::is_sorted(Callers.begin(), Callers.end()));
+      EXPECT_TRUE(std::binary_search(Callers.begin(), Callers.end(), &I));
+    }
+    Actual.emplace_back(Callees.begin(), Callees.end());
+  }
+  EXPECT_EQ(Expected, Actual);
+  auto CallersOfFoo = ICFG.getCallersOfRef(Foo);
+  ASSERT_EQ(CallersOfFoo.size(), 1U);
+  EXPECT_EQ(ICFG.getFunctionOf(CallersOfFoo.front()), Main);
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
@@ -112,6 +112,23 @@ TEST(LLVMBasedICFG_CHATest, VirtualCallSite_7) {
   }
 }
 
+TEST(LLVMBasedICFG_CHATest, ParallelResolution) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "call_graphs/virtual_call_9_cpp.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG SeqICFG(IRDB, CallGraphAnalysisType::CHA, {"main"}, &TH, &PT);
+  LLVMBasedICFG ParICFG(IRDB, CallGraphAnalysisType::CHA, {"main"}, &TH, &PT,
+                        Soundness::Soundy, true, 4);
+  ASSERT_EQ(SeqICFG.getNumOfEdges(), ParICFG.getNumOfEdges());
+  for (const auto *F : SeqICFG.getAllVertexFunctions()) {
+    for (const auto *CS : SeqICFG.getCallsFromWithin(F)) {
+      ASSERT_EQ(SeqICFG.getCalleesOfCallAt(CS), ParICFG.getCalleesOfCallAt(CS));
+    }
+  }
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,330 @@
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Instructions.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedBackwardICFG.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/BiDiIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+#include "LLVMTestUtils.h"
+#include "TestConfig.h"
+
+using namespace psr;
+using unittest::getReturn;
+
+/// Generates the global variable Global at the start of the entry points and
+/// propagates it through the whole program. Two of these, seeded in different
+/// functions, stand in for a forward and a backward problem sharing a fact
+/// type.
+class GlobalPropagation : public IFDSSolverTest {
+public:
+  GlobalPropagation(const ProjectIRDB *IRDB, const LLVMTypeHierarchy *TH,
+                    const LLVMBasedICFG *ICF, LLVMPointsToInfo *PT,
+                    std::set<std::string> EntryPoints, d_t Global)
+      : IFDSSolverTest(IRDB, TH, ICF, PT, std::move(EntryPoints)),
+        Global(Global) {}
+
+  FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) override {
+    // Facts generated from the zero value may leave the entry points via
+    // unbalanced returns
+    if (EntryPoints.count(Curr->getFunction()->getName().str()) &&
+        Curr == &Curr->getFunction()->front().front()) {
+      return std::make_shared<Gen<d_t>>(Global, getZeroValue());
+    }
+    return IFDSSolverTest::getNormalFlowFunction(Curr, Succ);
+  }
+
+private:
+  d_t Global;
+};
+
+struct LLVMIFDSBackwardAnalysisDomain : LLVMIFDSAnalysisDomainDefault {
+  using c_t = LLVMBasedBackwardCFG;
+  using i_t = LLVMBasedBackwardsICFG;
+};
+
+/// Generates the global variable Global where it is read and propagates it
+/// backwards through the whole program, starting at the exits of the entry
+/// points.
+class GlobalReads
+    : public IFDSTabulationProblem<LLVMIFDSBackwardAnalysisDomain> {
+public:
+  GlobalReads(const ProjectIRDB *IRDB, const LLVMTypeHierarchy *TH,
+              const LLVMBasedBackwardsICFG *ICF, LLVMPointsToInfo *PT,
+              std::set<std::string> EntryPoints, d_t Global)
+      : IFDSTabulationProblem(IRDB, TH, ICF, PT, std::move(EntryPoints)),
+        Global(Global) {
+    ZeroValue = createZeroValue();
+  }
+
+  FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t /*Succ*/) override {
+    if (const auto *Load = llvm::dyn_cast<llvm::LoadInst>(Curr);
+        Load && Load->getPointerOperand() == Global) {
+      return std::make_shared<Gen<d_t>>(Global, getZeroValue());
+    }
+    return Identity<d_t>::getInstance();
+  }
+
+  FlowFunctionPtrType getCallFlowFunction(n_t /*CallSite*/,
+                                          f_t /*DestFun*/) override {
+    return Identity<d_t>::getInstance();
+  }
+
+  FlowFunctionPtrType getRetFlowFunction(n_t /*CallSite*/, f_t /*CalleeFun*/,
+                                         n_t /*ExitStmt*/,
+                                         n_t /*RetSite*/) override {
+    return Identity<d_t>::getInstance();
+  }
+
+  FlowFunctionPtrType
+  getCallToRetFlowFunction(n_t /*CallSite*/, n_t /*RetSite*/,
+                           std::set<f_t> /*Callees*/) override {
+    return Identity<d_t>::getInstance();
+  }
+
+  FlowFunctionPtrType getSummaryFlowFunction(n_t /*CallSite*/,
+                                             f_t /*DestFun*/) override {
+    return nullptr;
+  }
+
+  InitialSeeds<n_t, d_t, l_t> initialSeeds() override {
+    InitialSeeds<n_t, d_t, l_t> Seeds;
+    for (const auto &EntryPoint : EntryPoints) {
+      for (const auto *StartPoint :
+           ICF->getStartPointsOf(ICF->getFunction(EntryPoint))) {
+        Seeds.addSeed(StartPoint, getZeroValue());
+      }
+    }
+    return Seeds;
+  }
+
+  [[nodiscard]] d_t createZeroValue() const override {
+    return LLVMZeroValue::getInstance();
+  }
+
+  [[nodiscard]] bool isZeroValue(d_t Fact) const override {
+    return LLVMZeroValue::getInstance()->isLLVMZeroValue(Fact);
+  }
+
+  void printNode(llvm::raw_ostream &OS, n_t Stmt) const override {
+    OS << llvmIRToString(Stmt);
+  }
+
+  void printDataFlowFact(llvm::raw_ostream &OS, d_t Fact) const override {
+    OS << llvmIRToString(Fact);
+  }
+
+  void printFunction(llvm::raw_ostream &OS, f_t Func) const override {
+    OS << Func->getName();
+  }
+
+private:
+  d_t Global;
+};
+
+/* ============== TEST FIXTURE ============== */
+class BiDiIFDSSolverTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles = unittest::PathToLLTestFiles + "bidi/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  using SolverTy = BiDiIFDSSolver<LLVMIFDSAnalysisDomainDefault,
+                                  LLVMIFDSAnalysisDomainDefault>;
+
+  std::unique_ptr<ProjectIRDB> IRDB;
+  std::unique_ptr<LLVMTypeHierarchy> TH;
+  std::unique_ptr<LLVMPointsToSet> PT;
+  std::unique_ptr<LLVMBasedICFG> ICFG;
+  const llvm::Value *G = nullptr;
+  const llvm::Function *Main = nullptr;
+  const llvm::Function *Sink = nullptr;
+  std::unique_ptr<GlobalPropagation> FromSource;
+  std::unique_ptr<GlobalPropagation> FromSink;
+
+  /// Creates the propagations of G from the start of source() and from the
+  /// start of sink(), which are both called by main().
+  void initialize(bool FollowReturnsPastSeeds = true) {
+    IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + "bidi_01_cpp.ll"},
+        IRDBOptions::WPA);
+    TH = std::make_unique<LLVMTypeHierarchy>(*IRDB);
+    PT = std::make_unique<LLVMPointsToSet>(*IRDB);
+    ICFG = std::make_unique<LLVMBasedICFG>(*IRDB, CallGraphAnalysisType::OTF,
+                                           EntryPoints, TH.get(), PT.get());
+    G = IRDB->getGlobalVariableDefinition("G");
+    Main = IRDB->getFunctionDefinition("main");
+    Sink = IRDB->getFunctionDefinition("_Z4sinkv");
+    ASSERT_NE(nullptr, G);
+    ASSERT_NE(nullptr, Main);
+    ASSERT_NE(nullptr, Sink);
+    IFDSIDESolverConfig Config;
+    Config.setFollowReturnsPastSeeds(FollowReturnsPastSeeds);
+    FromSource = std::make_unique<GlobalPropagation>(
+        IRDB.get(), TH.get(), ICFG.get(), PT.get(),
+        std::set<std::string>{"_Z6sourcev"}, G);
+    FromSource->setIFDSIDESolverConfig(Config);
+    FromSink = std::make_unique<GlobalPropagation>(
+        IRDB.get(), TH.get(), ICFG.get(), PT.get(),
+        std::set<std::string>{"_Z4sinkv"}, G);
+    FromSink->setIFDSIDESolverConfig(Config);
+  }
+
+  /// Solves both propagations bidirectionally, one path edge at a time.
+  std::unique_ptr<SolverTy> solve(bool StopAtFirstMeeting,
+                                  SolverTy::MeetFunctionTy Meet = nullptr) {
+    auto Solver =
+        std::make_unique<SolverTy>(*FromSource, *FromSink, std::move(Meet));
+    Solver->setStepSize(1);
+    Solver->setStopAtFirstMeeting(StopAtFirstMeeting);
+    Solver->solve();
+    return Solver;
+  }
+}; // Test Fixture
+
+TEST_F(BiDiIFDSSolverTest, FrontiersMeetInCommonCaller) {
+  initialize();
+  auto Solver = solve(true);
+  // Neither search reaches the other one's seed function before both have
+  // left their own via an unbalanced return into main()
+  ASSERT_TRUE(Solver->frontiersMet());
+  ASSERT_EQ(1U, Solver->getMeetingPoints().size());
+  const auto &Meeting = Solver->getMeetingPoints().front();
+  EXPECT_EQ(G, Meeting.FwdFact);
+  EXPECT_EQ(G, Meeting.BwdFact);
+  const auto *MeetingFun = Meeting.Node->getFunction();
+  EXPECT_TRUE(MeetingFun == Main || MeetingFun == Sink);
+  EXPECT_LT(0U, Solver->getNumFwdPathEdges());
+  EXPECT_LT(0U, Solver->getNumBwdPathEdges());
+}
+
+TEST_F(BiDiIFDSSolverTest, StopAtFirstMeeting) {
+  initialize();
+  auto First = solve(true);
+  auto All = solve(false);
+  EXPECT_EQ(1U, First->getMeetingPoints().size());
+  EXPECT_LT(1U, All->getMeetingPoints().size());
+  std::set<const llvm::Instruction *> MeetingNodes;
+  for (const auto &Meeting : All->getMeetingPoints()) {
+    MeetingNodes.insert(Meeting.Node);
+  }
+  // The search from source() enters sink() with G, where the search from
+  // sink() generates it after the first instruction
+  EXPECT_EQ(1U, MeetingNodes.count(Sink->front().front().getNextNode()));
+  EXPECT_EQ(1U, MeetingNodes.count(getReturn(Main)));
+  EXPECT_LT(First->getNumFwdPathEdges() + First->getNumBwdPathEdges(),
+            All->getNumFwdPathEdges() + All->getNumBwdPathEdges());
+  // The values are only computed from complete jump functions
+  EXPECT_FALSE(First->isExhausted());
+  EXPECT_TRUE(First->fwdResultsAt(getReturn(Main)).empty());
+  EXPECT_TRUE(All->isExhausted());
+  EXPECT_EQ(1U, All->fwdResultsAt(getReturn(Main)).count(G));
+}
+
+TEST_F(BiDiIFDSSolverTest, MeetFunction) {
+  initialize();
+  auto Solver =
+      solve(true, [](const llvm::Instruction * /*Node*/,
+                     const llvm::Value * /*FwdFact*/,
+                     const llvm::Value * /*BwdFact*/) { return false; });
+  EXPECT_FALSE(Solver->frontiersMet());
+  ASSERT_TRUE(Solver->isExhausted());
+  EXPECT_EQ(1U, Solver->fwdResultsAt(getReturn(Main)).count(G));
+  EXPECT_EQ(1U, Solver->bwdResultsAt(getReturn(Main)).count(G));
+}
+
+TEST_F(BiDiIFDSSolverTest, NoMeetingWithinTheSeedFunctions) {
+  initialize(false);
+  auto Solver = solve(true);
+  // source() and sink() do not call each other
+  EXPECT_FALSE(Solver->frontiersMet());
+  EXPECT_TRUE(Solver->fwdResultsAt(getReturn(Main)).empty());
+  EXPECT_TRUE(Solver->bwdResultsAt(getReturn(Main)).empty());
+}
+
+TEST_F(BiDiIFDSSolverTest, DeferAndResumePathEdges) {
+  initialize();
+  IFDSSolver Solver(*FromSource);
+  const auto *Source = IRDB->getFunctionDefinition("_Z6sourcev");
+  Solver.setPathEdgeFilter([Source](const llvm::Instruction *Node) {
+    return Node->getFunction() == Source;
+  });
+  std::set<std::pair<const llvm::Instruction *, const llvm::Value *>>
+      PathEdges;
+  Solver.setPathEdgeListener(
+      [&PathEdges](const llvm::Instruction *Node, const llvm::Value *Fact) {
+        PathEdges.emplace(Node, Fact);
+      });
+  Solver.submitInitialSeeds();
+  while (Solver.processPathEdges(1)) {
+  }
+  // The unbalanced return into main() has been deferred
+  auto Targets = Solver.getDeferredPathEdgeTargets();
+  ASSERT_FALSE(Targets.empty());
+  for (const auto *Target : Targets) {
+    EXPECT_EQ(Main, Target->getFunction());
+  }
+  for (const auto &[Node, Fact] : PathEdges) {
+    EXPECT_EQ(Source, Node->getFunction());
+  }
+  EXPECT_EQ(0U, PathEdges.count({getReturn(Main), G}));
+
+  // The filter still rejects main()
+  EXPECT_EQ(0U, Solver.resumeDeferredPathEdges());
+  Solver.setPathEdgeFilter(nullptr);
+  EXPECT_LE(Targets.size(), Solver.resumeDeferredPathEdges());
+  EXPECT_TRUE(Solver.getDeferredPathEdgeTargets().empty());
+  EXPECT_EQ(1U, PathEdges.count({getReturn(Main), G}));
+}
+
+TEST_F(BiDiIFDSSolverTest, ForwardAndBackwardProblem) {
+  initialize();
+  // The backward ICFG reverses the call graph of the ICFG it is built on
+  LLVMBasedICFG ForwardICFG(*IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            TH.get(), PT.get());
+  LLVMBasedBackwardsICFG BackwardICFG(ForwardICFG);
+  GlobalReads Reads(IRDB.get(), TH.get(), &BackwardICFG, PT.get(),
+                    {"_Z4sinkv"}, G);
+  IFDSIDESolverConfig Config;
+  Config.setFollowReturnsPastSeeds(true);
+  Reads.setIFDSIDESolverConfig(Config);
+  BiDiIFDSSolver Solver(*FromSource, Reads);
+  Solver.setStepSize(1);
+  Solver.setStopAtFirstMeeting(false);
+  Solver.solve();
+
+  ASSERT_TRUE(Solver.frontiersMet());
+  std::set<const llvm::Instruction *> MeetingNodes;
+  for (const auto &Meeting : Solver.getMeetingPoints()) {
+    EXPECT_EQ(G, Meeting.FwdFact);
+    EXPECT_EQ(G, Meeting.BwdFact);
+    MeetingNodes.insert(Meeting.Node);
+  }
+  // G is written before the return of source() and read after the start of
+  // sink(), both of which are reached by both searches
+  const auto *Source = IRDB->getFunctionDefinition("_Z6sourcev");
+  EXPECT_EQ(1U, MeetingNodes.count(getReturn(Source)));
+  EXPECT_EQ(1U, MeetingNodes.count(&Sink->front().front()));
+  // Only the forward search reaches the end of main(), as G is not read
+  // after the call of sink()
+  EXPECT_EQ(1U, Solver.fwdResultsAt(getReturn(Main)).count(G));
+  EXPECT_EQ(0U, Solver.bwdResultsAt(getReturn(Main)).count(G));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
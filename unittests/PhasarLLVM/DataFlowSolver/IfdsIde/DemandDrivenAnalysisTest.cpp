@@ -0,0 +1,92 @@
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/DemandDrivenAnalysis.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "LLVMTestUtils.h"
+#include "TestConfig.h"
+
+using namespace psr;
+using unittest::getLocal;
+using unittest::getReturn;
+
+/* ============== TEST FIXTURE ============== */
+class DemandDrivenAnalysisTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "incremental/";
+
+  using DDATy =
+      DemandDrivenAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
+                           IDELinearConstantAnalysis>;
+  using l_t = IDELinearConstantAnalysisDomain::l_t;
+}; // Test Fixture
+
+TEST_F(DemandDrivenAnalysisTest, QueryInCallee) {
+  ProjectIRDB IRDB({PathToLlFiles + "incremental_01_v1_cpp.ll"});
+  DDATy DDA(IFDSIDESolverConfig{}, IRDB, {"main"});
+
+  const auto *Increment = IRDB.getFunctionDefinition("_Z9incrementi");
+  ASSERT_NE(nullptr, Increment);
+  // the parameter's value flows in from main()
+  EXPECT_EQ(l_t(41),
+            DDA.query(getReturn(Increment), getLocal(Increment, "i.addr")));
+  EXPECT_EQ(1U, DDA.getNumberOfQueries());
+}
+
+TEST_F(DemandDrivenAnalysisTest, LaterQueriesWidenTheRegion) {
+  ProjectIRDB IRDB({PathToLlFiles + "incremental_01_v1_cpp.ll"});
+  DDATy DDA(IFDSIDESolverConfig{}, IRDB, {"main"});
+
+  const auto *Increment = IRDB.getFunctionDefinition("_Z9incrementi");
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Increment);
+  ASSERT_NE(nullptr, Main);
+  DDA.query(getReturn(Increment));
+  // twice() is called after increment(), hence not relevant to the query
+  size_t NumRelevantFunctions = DDA.getNumberOfRelevantFunctions();
+
+  EXPECT_EQ(l_t(42), DDA.query(getReturn(Main), getLocal(Main, "a")));
+  EXPECT_EQ(l_t(20), DDA.query(getReturn(Main), getLocal(Main, "b")));
+  EXPECT_TRUE(DDA.holds(getReturn(Main), getLocal(Main, "b")));
+  EXPECT_EQ(NumRelevantFunctions + 1, DDA.getNumberOfRelevantFunctions());
+}
+
+TEST_F(DemandDrivenAnalysisTest, KeepValuesAcrossQueries) {
+  ProjectIRDB IRDB({PathToLlFiles + "incremental_01_v1_cpp.ll"});
+  DDATy DDA(IFDSIDESolverConfig{}, IRDB, {"main"});
+
+  const auto *Increment = IRDB.getFunctionDefinition("_Z9incrementi");
+  const auto *Twice = IRDB.getFunctionDefinition("_Z5twicei");
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Increment);
+  ASSERT_NE(nullptr, Twice);
+  ASSERT_NE(nullptr, Main);
+  EXPECT_EQ(l_t(41),
+            DDA.query(getReturn(Increment), getLocal(Increment, "i.addr")));
+  EXPECT_EQ(l_t(10), DDA.query(getReturn(Twice), getLocal(Twice, "i.addr")));
+  // the values of the first query still hold in the widened region
+  EXPECT_EQ(l_t(41),
+            DDA.query(getReturn(Increment), getLocal(Increment, "i.addr")));
+
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT);
+  IDELinearConstantAnalysis Problem(&IRDB, &TH, &ICFG, &PT, {"main"});
+  IDESolver_P<IDELinearConstantAnalysis> Solver(Problem);
+  Solver.solve();
+  EXPECT_EQ(Solver.resultsAt(getReturn(Main), true),
+            DDA.query(getReturn(Main), true));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
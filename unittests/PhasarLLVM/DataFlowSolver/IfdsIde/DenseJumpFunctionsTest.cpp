@@ -0,0 +1,96 @@
+#include <memory>
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/DenseJumpFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+
+#include "LCASolverComparisonTest.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class DenseJumpFunctionsTest
+    : public unittest::LCASolverComparisonTest<unsigned> {
+protected:
+  using DenseSolverTy = IDESolver<
+      IDELinearConstantAnalysisDomain, std::set<d_t>,
+      DenseJumpFunctions<IDELinearConstantAnalysisDomain, std::set<d_t>>>;
+
+  void compareWithJumpFunctions(const std::string &LlvmFilePath) {
+    compareWithReference<DenseSolverTy>(
+        LlvmFilePath, [NumThreads = GetParam()](IFDSIDESolverConfig &Config) {
+          Config.setNumThreads(NumThreads);
+        });
+  }
+}; // Test Fixture
+
+TEST_P(DenseJumpFunctionsTest, HandleBranch) {
+  compareWithJumpFunctions("branch_07_cpp_dbg.ll");
+}
+
+TEST_P(DenseJumpFunctionsTest, HandleLoop) {
+  compareWithJumpFunctions("while_04_cpp_dbg.ll");
+}
+
+TEST_P(DenseJumpFunctionsTest, HandleCalls) {
+  compareWithJumpFunctions("call_12_cpp_dbg.ll");
+}
+
+TEST_P(DenseJumpFunctionsTest, HandleRecursion) {
+  compareWithJumpFunctions("recursion_03_cpp_dbg.ll");
+}
+
+TEST(DenseJumpFunctionsStorageTest, SharesEdgeFunctionsBetweenLookups) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "linear_constant/call_12_cpp_dbg.ll"},
+      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT);
+  IDELinearConstantAnalysis LCAProblem(&IRDB, &TH, &ICFG, &PT, {"main"});
+  using l_t = IDELinearConstantAnalysisDomain::l_t;
+  using JumpFunctionsTy =
+      DenseJumpFunctions<IDELinearConstantAnalysisDomain,
+                         std::set<const llvm::Value *>>;
+  JumpFunctionsTy JumpFn(LCAProblem.allTopFunction(), LCAProblem);
+
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  const auto *Target = &Main->front().front();
+  const auto *D1 = LCAProblem.getZeroValue();
+  const auto *D2 = Target;
+  auto First = std::make_shared<AllBottom<l_t>>(LCAProblem.bottomElement());
+  auto Second = std::make_shared<AllBottom<l_t>>(LCAProblem.bottomElement());
+  JumpFn.addFunction(D1, Target, D2, First);
+  JumpFn.addFunction(D1, Target, D2, Second);
+
+  // the update is visible through both lookups
+  auto Rev = JumpFn.reverseLookup(Target, D2);
+  ASSERT_TRUE(Rev);
+  ASSERT_EQ(1U, Rev->get().size());
+  EXPECT_EQ(D1, Rev->get()[0].first);
+  EXPECT_EQ(Second, Rev->get()[0].second);
+  auto Fwd = JumpFn.forwardLookup(D1, Target);
+  ASSERT_TRUE(Fwd);
+  ASSERT_EQ(1U, Fwd->get().size());
+  EXPECT_EQ(D2, Fwd->get()[0].first);
+  EXPECT_EQ(Second, Fwd->get()[0].second);
+
+  EXPECT_TRUE(JumpFn.removeFunction(D1, Target, D2));
+  EXPECT_FALSE(JumpFn.reverseLookup(Target, D2));
+  EXPECT_FALSE(JumpFn.forwardLookup(D1, Target));
+  EXPECT_FALSE(JumpFn.removeFunction(D1, Target, D2));
+}
+
+INSTANTIATE_TEST_SUITE_P(NumThreads, DenseJumpFunctionsTest,
+                         ::testing::Values(1U, 4U));
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
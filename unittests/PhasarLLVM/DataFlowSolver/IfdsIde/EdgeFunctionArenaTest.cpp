@@ -0,0 +1,70 @@
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/EdgeFunctionArena.h"
+
+using namespace psr;
+
+namespace {
+
+class AddConst : public EdgeFunction<int> {
+public:
+  explicit AddConst(int C) : C(C) {}
+
+  int computeTarget(int Source) override { return Source + C; }
+
+  EdgeFunctionPtrType composeWith(EdgeFunctionPtrType /*Second*/) override {
+    return nullptr;
+  }
+
+  EdgeFunctionPtrType joinWith(EdgeFunctionPtrType /*Other*/) override {
+    return nullptr;
+  }
+
+  bool equal_to(EdgeFunctionPtrType Other) const override {
+    if (auto *AC = dynamic_cast<AddConst *>(Other.get())) {
+      return AC->C == C;
+    }
+    return false;
+  }
+
+private:
+  int C;
+};
+
+} // anonymous namespace
+
+TEST(EdgeFunctionArenaTest, InternEqualFunctions) {
+  EdgeFunctionArena<int> Arena;
+  auto Top1 = Arena.intern(std::make_shared<AllTop<int>>(42));
+  auto Top2 = Arena.intern(std::make_shared<AllTop<int>>(42));
+  auto Top3 = Arena.intern(std::make_shared<AllTop<int>>(13));
+  auto Bot1 = Arena.intern(std::make_shared<AllBottom<int>>(42));
+  auto Bot2 = Arena.intern(std::make_shared<AllBottom<int>>(42));
+  EXPECT_EQ(Top1, Top2);
+  EXPECT_NE(Top1, Top3);
+  EXPECT_EQ(Bot1, Bot2);
+  EXPECT_NE(Top1, Bot1);
+  EXPECT_EQ(3U, Arena.size());
+  EXPECT_EQ(2U, Arena.getNumReused());
+  // interning a canonical function is an identity operation
+  EXPECT_EQ(Top1, Arena.intern(Top1));
+  EXPECT_EQ(EdgeIdentity<int>::getInstance(),
+            Arena.intern(EdgeIdentity<int>::getInstance()));
+}
+
+TEST(EdgeFunctionArenaTest, PassThroughNonInternableFunctions) {
+  EdgeFunctionArena<int> Arena;
+  auto F = std::make_shared<AddConst>(1);
+  auto G = std::make_shared<AddConst>(1);
+  EXPECT_EQ(F, Arena.intern(F));
+  EXPECT_EQ(G, Arena.intern(G));
+  EXPECT_EQ(0U, Arena.size());
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,95 @@
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+
+#include "LCAFlowEdgeFunctionCacheTest.h"
+
+using namespace psr;
+
+namespace {
+
+using l_t = IDELinearConstantAnalysisDomain::l_t;
+
+/// Counts how often it is composed with or joined with another function.
+class CountingEdgeFunction : public EdgeFunction<l_t> {
+public:
+  l_t computeTarget(l_t Source) override { return Source; }
+
+  EdgeFunctionPtrType composeWith(EdgeFunctionPtrType /*Second*/) override {
+    ++NumCompositions;
+    return std::make_shared<CountingEdgeFunction>();
+  }
+
+  EdgeFunctionPtrType joinWith(EdgeFunctionPtrType /*Other*/) override {
+    ++NumJoins;
+    return std::make_shared<CountingEdgeFunction>();
+  }
+
+  bool equal_to(EdgeFunctionPtrType Other) const override {
+    return this == Other.get();
+  }
+
+  static inline unsigned NumCompositions = 0;
+  static inline unsigned NumJoins = 0;
+};
+
+} // anonymous namespace
+
+/* ============== TEST FIXTURE ============== */
+class EdgeFunctionMemoTest : public unittest::LCAFlowEdgeFunctionCacheTest {
+protected:
+  void SetUp() override {
+    initialize("call_12_cpp_dbg.ll");
+    CountingEdgeFunction::NumCompositions = 0;
+    CountingEdgeFunction::NumJoins = 0;
+  }
+}; // Test Fixture
+
+TEST_F(EdgeFunctionMemoTest, MemoizeCompositionsAndJoins) {
+  CacheTy Cache(*LCAProblem);
+  auto F = std::make_shared<CountingEdgeFunction>();
+  auto G = std::make_shared<CountingEdgeFunction>();
+  auto FG = Cache.composeEdgeFunctions(F, G);
+  EXPECT_EQ(FG, Cache.composeEdgeFunctions(F, G));
+  EXPECT_EQ(1U, CountingEdgeFunction::NumCompositions);
+  // the memo is keyed by the order of the operands
+  EXPECT_NE(FG, Cache.composeEdgeFunctions(G, F));
+  EXPECT_EQ(2U, CountingEdgeFunction::NumCompositions);
+  auto Join = Cache.joinEdgeFunctions(F, G);
+  EXPECT_EQ(Join, Cache.joinEdgeFunctions(F, G));
+  EXPECT_EQ(1U, CountingEdgeFunction::NumJoins);
+}
+
+TEST_F(EdgeFunctionMemoTest, DisabledMemo) {
+  LCAProblem->getIFDSIDESolverConfig().setEdgeFunctionMemoSize(0);
+  CacheTy Cache(*LCAProblem);
+  auto F = std::make_shared<CountingEdgeFunction>();
+  auto G = std::make_shared<CountingEdgeFunction>();
+  (void)Cache.composeEdgeFunctions(F, G);
+  (void)Cache.composeEdgeFunctions(F, G);
+  (void)Cache.joinEdgeFunctions(F, G);
+  (void)Cache.joinEdgeFunctions(F, G);
+  EXPECT_EQ(2U, CountingEdgeFunction::NumCompositions);
+  EXPECT_EQ(2U, CountingEdgeFunction::NumJoins);
+}
+
+TEST_F(EdgeFunctionMemoTest, ClearMemo) {
+  CacheTy Cache(*LCAProblem);
+  auto F = std::make_shared<CountingEdgeFunction>();
+  auto G = std::make_shared<CountingEdgeFunction>();
+  (void)Cache.composeEdgeFunctions(F, G);
+  (void)Cache.joinEdgeFunctions(F, G);
+  // e.g. the IR has been modified, memoized results must not be served anymore
+  Cache.clearEdgeFunctionMemo();
+  (void)Cache.composeEdgeFunctions(F, G);
+  (void)Cache.joinEdgeFunctions(F, G);
+  EXPECT_EQ(2U, CountingEdgeFunction::NumCompositions);
+  EXPECT_EQ(2U, CountingEdgeFunction::NumJoins);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
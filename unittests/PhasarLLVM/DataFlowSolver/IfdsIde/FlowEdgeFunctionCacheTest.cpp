@@ -0,0 +1,142 @@
+#include <set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowEdgeFunctionCache.h"
+
+#include "LCAFlowEdgeFunctionCacheTest.h"
+#include "LLVMTestUtils.h"
+
+using namespace psr;
+
+TEST(FunctionCacheMapTest, EvictLeastRecentlyUsed) {
+  FunctionCacheMap<uint64_t, int> Cache(2);
+  Cache.insert(1, 10);
+  Cache.insert(2, 20);
+  // 1 becomes the most recently used entry
+  ASSERT_NE(nullptr, Cache.find(1));
+  Cache.insert(3, 30);
+  EXPECT_EQ(2U, Cache.size());
+  EXPECT_EQ(1U, Cache.getNumEvicted());
+  EXPECT_EQ(nullptr, Cache.find(2));
+  ASSERT_NE(nullptr, Cache.find(1));
+  EXPECT_EQ(10, *Cache.find(1));
+  ASSERT_NE(nullptr, Cache.find(3));
+  EXPECT_EQ(30, *Cache.find(3));
+  // copies preserve the recency order
+  auto Copy = Cache;
+  Copy.insert(4, 40);
+  EXPECT_EQ(nullptr, Copy.find(1));
+  EXPECT_NE(nullptr, Copy.find(3));
+}
+
+TEST(FunctionCacheMapTest, UnboundedCacheNeverEvicts) {
+  FunctionCacheMap<uint64_t, int> Cache;
+  for (uint64_t I = 0; I < 100; ++I) {
+    Cache.insert(I, static_cast<int>(I));
+  }
+  EXPECT_EQ(100U, Cache.size());
+  EXPECT_EQ(0U, Cache.getNumEvicted());
+  ASSERT_NE(nullptr, Cache.find(0));
+  EXPECT_EQ(0, *Cache.find(0));
+}
+
+/* ============== TEST FIXTURE ============== */
+class FlowEdgeFunctionCacheTest
+    : public unittest::LCAFlowEdgeFunctionCacheTest {
+protected:
+  /// Returns the calls to Callee in Caller in program order.
+  static std::vector<const llvm::CallBase *>
+  getCallsTo(const llvm::Function *Caller, const llvm::Function *Callee) {
+    std::vector<const llvm::CallBase *> Calls;
+    for (const auto &I : llvm::instructions(Caller)) {
+      const auto *Call = llvm::dyn_cast<llvm::CallBase>(&I);
+      if (Call && Call->getCalledFunction() == Callee) {
+        Calls.push_back(Call);
+      }
+    }
+    return Calls;
+  }
+}; // Test Fixture
+
+TEST_F(FlowEdgeFunctionCacheTest, EvictFlowFunctions) {
+  initialize("call_12_cpp_dbg.ll");
+  LCAProblem->getIFDSIDESolverConfig().setFlowEdgeFunctionCacheSize(1);
+  CacheTy Cache(*LCAProblem);
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  const llvm::Instruction *Prev = nullptr;
+  unsigned NumPairs = 0;
+  for (const auto &I : llvm::instructions(Main)) {
+    if (Prev && !llvm::isa<llvm::CallBase>(Prev)) {
+      auto FF = Cache.getNormalFlowFunction(Prev, &I);
+      ASSERT_NE(nullptr, FF);
+      // the most recently used entry is served from the cache
+      EXPECT_EQ(FF, Cache.getNormalFlowFunction(Prev, &I));
+      ++NumPairs;
+    }
+    Prev = &I;
+  }
+  ASSERT_GT(NumPairs, 1U);
+  EXPECT_EQ(NumPairs - 1, Cache.getNumEvicted());
+}
+
+TEST_F(FlowEdgeFunctionCacheTest, CacheCallAndReturnFlowFunctions) {
+  initialize("call_07_cpp_dbg.ll");
+  LCAProblem->getIFDSIDESolverConfig().setFlowEdgeFunctionCacheSize(1);
+  CacheTy Cache(*LCAProblem);
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  const auto *Increment = IRDB->getFunctionDefinition("_Z9incrementi");
+  ASSERT_TRUE(Main && Increment);
+  const auto *Exit = unittest::getReturn(Increment);
+  ASSERT_NE(nullptr, Exit);
+  auto Calls = getCallsTo(Main, Increment);
+  ASSERT_EQ(2U, Calls.size());
+
+  // the call flow functions are keyed by the call site and the callee
+  auto CallFF = Cache.getCallFlowFunction(Calls[0], Increment);
+  EXPECT_EQ(CallFF, Cache.getCallFlowFunction(Calls[0], Increment));
+  EXPECT_NE(CallFF, Cache.getCallFlowFunction(Calls[1], Increment));
+  EXPECT_EQ(1U, Cache.getNumEvicted());
+
+  // the return flow functions are keyed by the call site, the callee, the
+  // exit statement and the return site
+  auto RetFF = Cache.getRetFlowFunction(Calls[0], Increment, Exit,
+                                        Calls[0]->getNextNode());
+  EXPECT_EQ(RetFF, Cache.getRetFlowFunction(Calls[0], Increment, Exit,
+                                            Calls[0]->getNextNode()));
+  EXPECT_NE(RetFF, Cache.getRetFlowFunction(Calls[1], Increment, Exit,
+                                            Calls[1]->getNextNode()));
+  EXPECT_EQ(2U, Cache.getNumEvicted());
+}
+
+TEST_F(FlowEdgeFunctionCacheTest, InternCalleeSets) {
+  initialize("call_07_cpp_dbg.ll");
+  LCAProblem->getIFDSIDESolverConfig().setFlowEdgeFunctionCacheSize(1);
+  CacheTy Cache(*LCAProblem);
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  const auto *Increment = IRDB->getFunctionDefinition("_Z9incrementi");
+  ASSERT_TRUE(Main && Increment);
+  auto Calls = getCallsTo(Main, Increment);
+  ASSERT_EQ(2U, Calls.size());
+  const auto *RetSite = Calls[0]->getNextNode();
+
+  std::set<const llvm::Function *> Callees{Increment};
+  auto FF = Cache.getCallToRetFlowFunction(Calls[0], RetSite, Callees);
+  // equal sets of callees are interned to the same key
+  std::set<const llvm::Function *> SameCallees{Increment};
+  EXPECT_EQ(FF, Cache.getCallToRetFlowFunction(Calls[0], RetSite, SameCallees));
+  EXPECT_EQ(0U, Cache.getNumEvicted());
+  // other sets of callees are not
+  (void)Cache.getCallToRetFlowFunction(Calls[0], RetSite, {Increment, Main});
+  EXPECT_EQ(1U, Cache.getNumEvicted());
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
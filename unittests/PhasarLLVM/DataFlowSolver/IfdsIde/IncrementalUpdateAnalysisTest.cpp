@@ -0,0 +1,105 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/IncrementalUpdateAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+
+#include "LLVMTestUtils.h"
+#include "TestConfig.h"
+
+using namespace psr;
+using unittest::getLocal;
+using unittest::getReturn;
+
+/* ============== TEST FIXTURE ============== */
+class IncrementalUpdateAnalysisTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "incremental/";
+
+  using IUATy =
+      IncrementalUpdateAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
+                                IDELinearConstantAnalysis>;
+  using l_t = IDELinearConstantAnalysisDomain::l_t;
+}; // Test Fixture
+
+TEST_F(IncrementalUpdateAnalysisTest, ReuseUnchangedFunctions) {
+  ProjectIRDB V1({PathToLlFiles + "incremental_01_v1_cpp.ll"});
+  ProjectIRDB V2({PathToLlFiles + "incremental_01_v2_cpp.ll"});
+  IUATy IUA(IFDSIDESolverConfig{}, V1, {"main"});
+  IUA.solve();
+
+  const auto *Main1 = V1.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main1);
+  EXPECT_EQ(l_t(42), IUA.getSolver().resultAt(getReturn(Main1),
+                                              getLocal(Main1, "a")));
+  EXPECT_EQ(l_t(20), IUA.getSolver().resultAt(getReturn(Main1),
+                                              getLocal(Main1, "b")));
+
+  IUA.update(V2);
+  EXPECT_EQ(std::vector<std::string>({"_Z5twicei", "main"}),
+            IUA.getChangedFunctions());
+  EXPECT_EQ(1U, IUA.getNumReusedFunctions());
+
+  const auto *Main2 = V2.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main2);
+  // increment() has been reused from the first version
+  EXPECT_EQ(l_t(42), IUA.getSolver().resultAt(getReturn(Main2),
+                                              getLocal(Main2, "a")));
+  EXPECT_EQ(l_t(30), IUA.getSolver().resultAt(getReturn(Main2),
+                                              getLocal(Main2, "b")));
+}
+
+TEST_F(IncrementalUpdateAnalysisTest, ReuseAcrossSeveralVersions) {
+  ProjectIRDB V1({PathToLlFiles + "incremental_01_v1_cpp.ll"});
+  ProjectIRDB V2({PathToLlFiles + "incremental_01_v2_cpp.ll"});
+  ProjectIRDB V3({PathToLlFiles + "incremental_01_v1_cpp.ll"});
+  IUATy IUA(IFDSIDESolverConfig{}, V1, {"main"});
+  IUA.solve();
+  IUA.update(V2);
+  IUA.update(V3);
+  EXPECT_EQ(1U, IUA.getNumReusedFunctions());
+
+  const auto *Main3 = V3.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main3);
+  EXPECT_EQ(l_t(42), IUA.getSolver().resultAt(getReturn(Main3),
+                                              getLocal(Main3, "a")));
+  EXPECT_EQ(l_t(20), IUA.getSolver().resultAt(getReturn(Main3),
+                                              getLocal(Main3, "b")));
+}
+
+TEST_F(IncrementalUpdateAnalysisTest, ChangedPointsToSetsInvalidateSummaries) {
+  ProjectIRDB V1({PathToLlFiles + "incremental_02_v1_cpp.ll"});
+  ProjectIRDB V2({PathToLlFiles + "incremental_02_v2_cpp.ll"});
+  IUATy IUA(IFDSIDESolverConfig{}, V1, {"main"});
+  IUA.solve();
+  IUA.update(V2);
+  // set() is unchanged, but its argument points to b instead of a now
+  EXPECT_EQ(std::vector<std::string>({"main"}), IUA.getChangedFunctions());
+  EXPECT_EQ(1U, IUA.getNumReusedFunctions());
+}
+
+TEST_F(IncrementalUpdateAnalysisTest, NoReuseForProblemsWithSideEffects) {
+  ProjectIRDB V1({PathToLlFiles + "incremental_01_v1_cpp.ll"});
+  ProjectIRDB V2({PathToLlFiles + "incremental_01_v2_cpp.ll"});
+  // The uninitialized variables analysis records the undefined uses it finds
+  IncrementalUpdateAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
+                            IFDSUninitializedVariables>
+      IUA(IFDSIDESolverConfig{}, V1, {"main"});
+  IUA.solve();
+  IUA.update(V2);
+  EXPECT_EQ(std::vector<std::string>({"_Z5twicei", "main"}),
+            IUA.getChangedFunctions());
+  EXPECT_EQ(0U, IUA.getNumReusedFunctions());
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,133 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/ModuleWiseAnalysis.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "LLVMTestUtils.h"
+#include "TestConfig.h"
+
+using namespace psr;
+using unittest::getLocal;
+using unittest::getReturn;
+
+/* ============== TEST FIXTURE ============== */
+class ModuleWiseAnalysisTest : public ::testing::TestWithParam<unsigned> {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "module_wise/module_wise_1/";
+
+  using MWATy = ModuleWiseAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
+                                   IDELinearConstantAnalysis>;
+  using l_t = IDELinearConstantAnalysisDomain::l_t;
+
+  std::unique_ptr<ProjectIRDB> IRDB;
+
+  void SetUp() override {
+    // Keep the modules separate, the analysis must not link them
+    IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + "main_cpp.ll",
+                                 PathToLlFiles + "src1_cpp.ll",
+                                 PathToLlFiles + "src2_cpp.ll"},
+        IRDBOptions::OWNS);
+    ValueAnnotationPass::resetValueID();
+  }
+}; // Test Fixture
+
+TEST_P(ModuleWiseAnalysisTest, HandleCrossModuleCalls) {
+  IFDSIDESolverConfig SolverConfig;
+  SolverConfig.setNumThreads(GetParam());
+  MWATy MWA(SolverConfig, *IRDB);
+  EXPECT_EQ(GetParam(), MWA.getNumThreads());
+  MWA.solve();
+  EXPECT_EQ(3U, MWA.getNumberOfAnalyzedModules());
+
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  auto *Solver = MWA.getSolver(Main->getParent());
+  ASSERT_NE(nullptr, Solver);
+  const auto *Ret = getReturn(Main);
+  ASSERT_NE(nullptr, Ret);
+  // int b = generate_taint();
+  EXPECT_EQ(l_t(13), Solver->resultAt(Ret, getLocal(Main, "b")));
+
+  // The values computed across the module boundaries agree with those of the
+  // whole-program analysis of the linked modules
+  ProjectIRDB WPAIRDB({PathToLlFiles + "main_cpp.ll",
+                       PathToLlFiles + "src1_cpp.ll",
+                       PathToLlFiles + "src2_cpp.ll"},
+                      IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(WPAIRDB);
+  LLVMPointsToSet PT(WPAIRDB);
+  LLVMBasedICFG ICFG(WPAIRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT);
+  IDELinearConstantAnalysis Problem(&WPAIRDB, &TH, &ICFG, &PT, {"main"});
+  IDESolver_P<IDELinearConstantAnalysis> WPASolver(Problem);
+  WPASolver.solve();
+  const auto *WPAMain = WPAIRDB.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, WPAMain);
+  for (const auto *Var : {"a", "b", "c", "d", "e"}) {
+    EXPECT_EQ(WPASolver.resultAt(getReturn(WPAMain), getLocal(WPAMain, Var)),
+              Solver->resultAt(Ret, getLocal(Main, Var)))
+        << Var;
+  }
+}
+
+TEST_P(ModuleWiseAnalysisTest, ScopeHelperAnalysesToModules) {
+  IFDSIDESolverConfig SolverConfig;
+  SolverConfig.setNumThreads(GetParam());
+  MWATy MWA(SolverConfig, *IRDB);
+  MWA.solve();
+
+  for (const auto *M : IRDB->getAllModules()) {
+    auto *PT = MWA.getPointerInfo(M);
+    auto *CG = MWA.getCallGraph(M);
+    ASSERT_NE(nullptr, PT);
+    ASSERT_NE(nullptr, CG);
+    // the call graph contains the declarations of the boundary functions of
+    // other modules, but not their definitions
+    for (const auto *F : CG->getAllVertexFunctions()) {
+      EXPECT_EQ(M, F->getParent()) << F->getName().str();
+    }
+    auto PTJson = PT->getAsJson();
+    const auto &AnalyzedFunctions = PTJson["AnalyzedFunctions"];
+    for (const auto &Name : AnalyzedFunctions) {
+      const auto *F = M->getFunction(Name.get<std::string>());
+      EXPECT_TRUE(F && !F->isDeclaration()) << Name;
+    }
+  }
+  // main calls boundary functions, hence its points-to information is needed
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  EXPECT_FALSE(MWA.getPointerInfo(Main->getParent())->empty());
+}
+
+TEST_P(ModuleWiseAnalysisTest, SolveProblemsSequentiallyUnlessThreadSafe) {
+  IFDSIDESolverConfig SolverConfig;
+  SolverConfig.setNumThreads(GetParam());
+  // The uninitialized variables analysis does not declare itself thread-safe
+  ModuleWiseAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
+                     IFDSUninitializedVariables>
+      MWA(SolverConfig, *IRDB);
+  EXPECT_EQ(1U, MWA.getNumThreads());
+  MWA.solve();
+  EXPECT_EQ(3U, MWA.getNumberOfAnalyzedModules());
+}
+
+INSTANTIATE_TEST_SUITE_P(NumThreads, ModuleWiseAnalysisTest,
+                         ::testing::Values(1U, 4U));
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,68 @@
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+
+#include "LCASolverComparisonTest.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class ParallelTabulationTest
+    : public unittest::LCASolverComparisonTest<unsigned> {
+protected:
+  void compareWithSequential(const std::string &LlvmFilePath) {
+    compareWithReference(
+        LlvmFilePath, [NumThreads = GetParam()](IFDSIDESolverConfig &Config) {
+          Config.setNumThreads(NumThreads);
+        });
+  }
+
+  /// Compares the values of the parallel Phase II, including the value
+  /// computation at all non-call/non-start nodes, with the sequential ones.
+  void compareValuesWithSequential(const std::string &LlvmFilePath) {
+    compareWithReference(
+        LlvmFilePath, [NumThreads = GetParam()](IFDSIDESolverConfig &Config) {
+          Config.setNumThreads(NumThreads);
+          Config.setComputeValues(true);
+          Config.setRecordEdges(false);
+        });
+  }
+}; // Test Fixture
+
+TEST_P(ParallelTabulationTest, HandleBranch) {
+  compareWithSequential("branch_07_cpp_dbg.ll");
+}
+
+TEST_P(ParallelTabulationTest, HandleLoop) {
+  compareWithSequential("while_04_cpp_dbg.ll");
+}
+
+TEST_P(ParallelTabulationTest, HandleCalls) {
+  compareWithSequential("call_12_cpp_dbg.ll");
+}
+
+TEST_P(ParallelTabulationTest, HandleRecursion) {
+  compareWithSequential("recursion_03_cpp_dbg.ll");
+}
+
+TEST_P(ParallelTabulationTest, HandleGlobals) {
+  compareWithSequential("global_11_cpp_dbg.ll");
+}
+
+TEST_P(ParallelTabulationTest, ComputeValuesOfCalls) {
+  compareValuesWithSequential("call_12_cpp_dbg.ll");
+}
+
+TEST_P(ParallelTabulationTest, ComputeValuesOfRecursion) {
+  compareValuesWithSequential("recursion_03_cpp_dbg.ll");
+}
+
+INSTANTIATE_TEST_SUITE_P(NumThreads, ParallelTabulationTest,
+                         ::testing::Values(2U, 4U, 8U));
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
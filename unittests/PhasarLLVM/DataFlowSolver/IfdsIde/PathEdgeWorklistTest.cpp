@@ -0,0 +1,59 @@
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+
+#include "LCASolverComparisonTest.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class PathEdgeWorklistTest
+    : public unittest::LCASolverComparisonTest<PathEdgeSchedulingPolicy> {
+protected:
+  void compareWithFIFO(const std::string &LlvmFilePath) {
+    compareWithReference(LlvmFilePath,
+                         [Policy = GetParam()](IFDSIDESolverConfig &Config) {
+                           Config.setSchedulingPolicy(Policy);
+                         });
+  }
+}; // Test Fixture
+
+TEST_P(PathEdgeWorklistTest, HandleBranch) {
+  compareWithFIFO("branch_07_cpp_dbg.ll");
+}
+
+TEST_P(PathEdgeWorklistTest, HandleLoop) {
+  compareWithFIFO("while_04_cpp_dbg.ll");
+}
+
+TEST_P(PathEdgeWorklistTest, HandleCalls) {
+  compareWithFIFO("call_12_cpp_dbg.ll");
+}
+
+TEST_P(PathEdgeWorklistTest, HandleRecursion) {
+  compareWithFIFO("recursion_03_cpp_dbg.ll");
+}
+
+TEST(PathEdgeSchedulingPolicyTest, ParseSpellings) {
+  EXPECT_EQ(PathEdgeSchedulingPolicy::ReversePostOrder,
+            toPathEdgeSchedulingPolicy("ReversePostOrder"));
+  EXPECT_EQ(PathEdgeSchedulingPolicy::ReversePostOrder,
+            toPathEdgeSchedulingPolicy("rpo"));
+  EXPECT_EQ(PathEdgeSchedulingPolicy::ReversePostOrder,
+            toPathEdgeSchedulingPolicy("RPO"));
+  EXPECT_EQ(PathEdgeSchedulingPolicy::LIFO, toPathEdgeSchedulingPolicy("lifo"));
+  EXPECT_EQ(PathEdgeSchedulingPolicy::Invalid,
+            toPathEdgeSchedulingPolicy("BFS"));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SchedulingPolicies, PathEdgeWorklistTest,
+    ::testing::Values(PathEdgeSchedulingPolicy::LIFO,
+                      PathEdgeSchedulingPolicy::ReversePostOrder));
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
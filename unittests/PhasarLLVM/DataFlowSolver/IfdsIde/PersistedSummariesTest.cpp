@@ -0,0 +1,243 @@
+#include <memory>
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/LLVMPersistedSummaries.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryStore.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/PhasarLLVM/Utils/FunctionHashes.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+#include "SummaryTestProblems.h"
+#include "TestConfig.h"
+
+using namespace psr;
+using unittest::PersistableUninitializedVariables;
+using unittest::UninitializedVariablesWithoutSummaries;
+
+/* ============== TEST FIXTURE ============== */
+class PersistedSummariesTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "summary_reuse/";
+  const std::set<std::string> EntryPoints = {"main"};
+
+  /// A single analysis run on a freshly loaded program.
+  struct Run {
+    std::unique_ptr<ProjectIRDB> IRDB;
+    std::unique_ptr<LLVMTypeHierarchy> TH;
+    std::unique_ptr<LLVMPointsToSet> PT;
+    std::unique_ptr<LLVMBasedICFG> ICFG;
+    std::unique_ptr<IFDSUninitializedVariables> Problem;
+    std::unique_ptr<FunctionHashes> Hashes;
+  };
+
+  template <typename ProblemTy = PersistableUninitializedVariables>
+  Run load(const std::string &IRFile) {
+    ValueAnnotationPass::resetValueID();
+    Run R;
+    R.IRDB = std::make_unique<ProjectIRDB>(std::vector<std::string>{IRFile},
+                                           IRDBOptions::WPA);
+    R.TH = std::make_unique<LLVMTypeHierarchy>(*R.IRDB);
+    R.PT = std::make_unique<LLVMPointsToSet>(*R.IRDB);
+    R.ICFG = std::make_unique<LLVMBasedICFG>(
+        *R.IRDB, CallGraphAnalysisType::OTF, EntryPoints, R.TH.get(),
+        R.PT.get());
+    R.Problem = std::make_unique<ProblemTy>(
+        R.IRDB.get(), R.TH.get(), R.ICFG.get(), R.PT.get(), EntryPoints);
+    R.Hashes = std::make_unique<FunctionHashes>(*R.IRDB);
+    return R;
+  }
+
+  /// Solves R with the summaries of Store and returns the ids of the facts
+  /// holding at the return of main. If Report is given, the text report of
+  /// the analysis is written to it.
+  static std::set<std::string> solve(Run &R, SummaryStore &Store,
+                                     size_t *NumReused = nullptr,
+                                     std::string *Report = nullptr) {
+    LLVMPersistedSummaries<BinaryDomain> Summaries(
+        Store, *R.Hashes, R.Problem->getZeroValue(), BinaryDomain::BOTTOM);
+    IFDSSolver Solver(*R.Problem);
+    Solver.setPersistedSummaries(&Summaries);
+    Solver.solve();
+    Solver.exportPersistedSummaries();
+    if (NumReused) {
+      *NumReused = Summaries.getNumReused();
+    }
+    if (Report) {
+      llvm::raw_string_ostream OS(*Report);
+      Solver.emitTextReport(OS);
+    }
+    std::set<std::string> Facts;
+    const auto *Main = R.IRDB->getFunctionDefinition("main");
+    for (const auto &I : llvm::instructions(Main)) {
+      if (llvm::isa<llvm::ReturnInst>(I)) {
+        for (const auto *Fact : Solver.ifdsResultsAt(&I)) {
+          if (!R.Problem->isZeroValue(Fact)) {
+            Facts.insert(getMetaDataID(Fact));
+          }
+        }
+      }
+    }
+    return Facts;
+  }
+
+  static std::string serialize(const SummaryStore &Store) {
+    std::string Buffer;
+    llvm::raw_string_ostream OS(Buffer);
+    Store.write(OS);
+    OS.flush();
+    return Buffer;
+  }
+}; // Test Fixture
+
+TEST_F(PersistedSummariesTest, ReuseSummariesOfPreviousRun) {
+  SummaryStore Store("uninit");
+  Run First = load(PathToLlFiles + "summary_reuse_03_cpp.ll");
+  size_t NumReused = 0;
+  auto Expected = solve(First, Store, &NumReused);
+  // The store is empty during the first run
+  EXPECT_EQ(0U, NumReused);
+  auto FooHash = First.Hashes->getClosureHash("_Z3fooi");
+  ASSERT_TRUE(FooHash.has_value());
+  ASSERT_NE(nullptr, Store.lookup(*FooHash));
+
+  Run Second = load(PathToLlFiles + "summary_reuse_03_cpp.ll");
+  EXPECT_EQ(Expected, solve(Second, Store, &NumReused));
+  EXPECT_LT(0U, NumReused);
+}
+
+TEST_F(PersistedSummariesTest, ReuseSummariesInOtherProgram) {
+  SummaryStore Store("uninit");
+  Run First = load(PathToLlFiles + "summary_reuse_02_cpp.ll");
+  solve(First, Store);
+
+  SummaryStore Empty("uninit");
+  Run Reference = load(PathToLlFiles + "summary_reuse_04_cpp.ll");
+  auto Expected = solve(Reference, Empty);
+
+  // foo() is the same in both programs
+  Run Second = load(PathToLlFiles + "summary_reuse_04_cpp.ll");
+  size_t NumReused = 0;
+  EXPECT_EQ(Expected, solve(Second, Store, &NumReused));
+  EXPECT_LT(0U, NumReused);
+}
+
+TEST_F(PersistedSummariesTest, WriteAndRead) {
+  SummaryStore Store("uninit");
+  Run R = load(PathToLlFiles + "summary_reuse_03_cpp.ll");
+  solve(R, Store);
+  ASSERT_LT(0U, Store.size());
+
+  auto Serialized = serialize(Store);
+  SummaryStore Loaded("uninit");
+  ASSERT_TRUE(Loaded.read(llvm::MemoryBufferRef(Serialized, "store")));
+  EXPECT_EQ(Store.size(), Loaded.size());
+  EXPECT_EQ(Serialized, serialize(Loaded));
+
+  SummaryStore Other("taint");
+  EXPECT_FALSE(Other.read(llvm::MemoryBufferRef(Serialized, "store")));
+  EXPECT_EQ(0U, Other.size());
+  EXPECT_FALSE(Loaded.read(
+      llvm::MemoryBufferRef(llvm::StringRef(Serialized).drop_back(), "store")));
+}
+
+TEST_F(PersistedSummariesTest, NoSummariesOfProblemsThatDoNotOptIn) {
+  SummaryStore Store("uninit");
+  Run R = load(PathToLlFiles + "summary_reuse_03_cpp.ll");
+  UninitializedVariablesWithoutSummaries Problem(
+      R.IRDB.get(), R.TH.get(), R.ICFG.get(), R.PT.get(), EntryPoints);
+  LLVMPersistedSummaries<BinaryDomain> Summaries(
+      Store, *R.Hashes, Problem.getZeroValue(), BinaryDomain::BOTTOM);
+  IFDSSolver Solver(Problem);
+  Solver.setPersistedSummaries(&Summaries);
+  Solver.solve();
+  Solver.exportPersistedSummaries();
+  EXPECT_EQ(0U, Store.size());
+}
+
+TEST_F(PersistedSummariesTest, SameReportWhenRunTwice) {
+  SummaryStore Store("uninit");
+  // The analysis records the undefined use within lib() while being solved
+  Run First = load<IFDSUninitializedVariables>(PathToLlFiles +
+                                               "summary_reuse_05_cpp.ll");
+  std::string Expected;
+  solve(First, Store, nullptr, &Expected);
+  ASSERT_FALSE(First.Problem->getAllUndefUses().empty());
+
+  Run Second = load<IFDSUninitializedVariables>(PathToLlFiles +
+                                                "summary_reuse_05_cpp.ll");
+  size_t NumReused = 0;
+  std::string Report;
+  solve(Second, Store, &NumReused, &Report);
+  EXPECT_EQ(0U, NumReused);
+  EXPECT_EQ(Expected, Report);
+}
+
+TEST_F(PersistedSummariesTest, IgnoreDebugIntrinsics) {
+  llvm::LLVMContext Ctx;
+  llvm::SMDiagnostic Diag;
+  auto M = llvm::parseAssemblyString(R"(
+define i32 @f(i32 %x) !dbg !4 {
+  %a = add i32 %x, 1
+  call void @llvm.dbg.value(metadata i32 %a, metadata !7, metadata !DIExpression()), !dbg !9
+  %b = mul i32 %a, 2
+  ret i32 %b
+}
+
+declare void @llvm.dbg.value(metadata, metadata, metadata)
+
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!3}
+!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1, producer: "", isOptimized: false, runtimeVersion: 0, emissionKind: FullDebug)
+!1 = !DIFile(filename: "f.c", directory: "/")
+!3 = !{i32 2, !"Debug Info Version", i32 3}
+!4 = distinct !DISubprogram(name: "f", scope: !1, file: !1, line: 1, type: !5, spFlags: DISPFlagDefinition, unit: !0)
+!5 = !DISubroutineType(types: !6)
+!6 = !{}
+!7 = !DILocalVariable(name: "a", scope: !4, file: !1, line: 1, type: !8)
+!8 = !DIBasicType(name: "int", size: 32, encoding: DW_ATE_signed)
+!9 = !DILocation(line: 1, scope: !4)
+)",
+                                     Diag, Ctx);
+  ASSERT_NE(nullptr, M);
+  const auto *F = M->getFunction("f");
+  ASSERT_NE(nullptr, F);
+  std::vector<const llvm::Instruction *> Insts;
+  for (const auto &I : llvm::instructions(F)) {
+    Insts.push_back(&I);
+  }
+  ASSERT_EQ(4U, Insts.size());
+  ASSERT_TRUE(llvm::isa<llvm::DbgInfoIntrinsic>(Insts[1]));
+
+  // The instructions are numbered as if the debug intrinsic did not exist,
+  // which is how FunctionHashes sees the function
+  SummaryStore Store("uninit");
+  EXPECT_EQ(1U, Store.getInstructionNumber(Insts[2]));
+  EXPECT_EQ(2U, Store.getInstructionNumber(Insts[3]));
+  EXPECT_EQ(Insts[2], Store.getInstruction(*F, 1));
+  EXPECT_FALSE(Store.encode(*F, Insts[1]).has_value());
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
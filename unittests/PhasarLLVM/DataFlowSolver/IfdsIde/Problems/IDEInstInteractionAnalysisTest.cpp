@@ -12,6 +12,7 @@
 #include <string>
 #include <tuple>
 #include <variant>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -26,6 +27,8 @@
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
 #include "phasar/Utils/BitVectorSet.h"
+#include "phasar/Utils/InternedBitSet.h"
+#include "phasar/Utils/Interner.h"
 #include "phasar/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 
@@ -49,6 +52,44 @@ protected:
 
   void SetUp() override {}
 
+  static std::set<std::string> getLabels(
+      std::variant<const llvm::Instruction *, const llvm::GlobalVariable *>
+          Current) {
+    std::set<std::string> Labels;
+    // case we are looking at an instruction
+    if (std::holds_alternative<const llvm::Instruction *>(Current)) {
+      const llvm::Instruction *CurrentInst =
+          std::get<const llvm::Instruction *>(Current);
+      if (CurrentInst->hasMetadata()) {
+        std::string Label =
+            llvm::cast<llvm::MDString>(
+                CurrentInst->getMetadata(PhasarConfig::MetaDataKind())
+                    ->getOperand(0))
+                ->getString()
+                .str();
+        Labels.insert(Label);
+        return Labels;
+      }
+    }
+    // case we are looking at a global variable
+    if (std::holds_alternative<const llvm::GlobalVariable *>(Current)) {
+      const llvm::GlobalVariable *CurrentGlobalVar =
+          std::get<const llvm::GlobalVariable *>(Current);
+      if (CurrentGlobalVar->hasMetadata()) {
+        std::string Label =
+            llvm::cast<llvm::MDString>(
+                CurrentGlobalVar->getMetadata(PhasarConfig::MetaDataKind())
+                    ->getOperand(0))
+                ->getString()
+                .str();
+        Labels.insert(Label);
+        return Labels;
+      }
+    }
+    // default
+    return Labels;
+  }
+
   //   IDEInstInteractionAnalysis::lca_restults_t
   void
   doAnalysisAndCompareResults(const std::string &LlvmFilePath,
@@ -67,43 +108,7 @@ protected:
     IDEInstInteractionAnalysisT<std::string, true> IIAProblem(
         IRDB.get(), &TH, &ICFG, &PT, EntryPoints);
     // use Phasar's instruction ids as testing labels
-    auto Generator =
-        [](std::variant<const llvm::Instruction *, const llvm::GlobalVariable *>
-               Current) -> std::set<std::string> {
-      std::set<std::string> Labels;
-      // case we are looking at an instruction
-      if (std::holds_alternative<const llvm::Instruction *>(Current)) {
-        const llvm::Instruction *CurrentInst =
-            std::get<const llvm::Instruction *>(Current);
-        if (CurrentInst->hasMetadata()) {
-          std::string Label =
-              llvm::cast<llvm::MDString>(
-                  CurrentInst->getMetadata(PhasarConfig::MetaDataKind())
-                      ->getOperand(0))
-                  ->getString()
-                  .str();
-          Labels.insert(Label);
-          return Labels;
-        }
-      }
-      // case we are looking at a global variable
-      if (std::holds_alternative<const llvm::GlobalVariable *>(Current)) {
-        const llvm::GlobalVariable *CurrentGlobalVar =
-            std::get<const llvm::GlobalVariable *>(Current);
-        if (CurrentGlobalVar->hasMetadata()) {
-          std::string Label =
-              llvm::cast<llvm::MDString>(
-                  CurrentGlobalVar->getMetadata(PhasarConfig::MetaDataKind())
-                      ->getOperand(0))
-                  ->getString()
-                  .str();
-          Labels.insert(Label);
-          return Labels;
-        }
-      }
-      // default
-      return Labels;
-    };
+    auto Generator = &IDEInstInteractionAnalysisTest::getLabels;
     // register the above generator function
     IIAProblem.registerEdgeFactGenerator(Generator);
     IDESolver_P<IDEInstInteractionAnalysisT<std::string, true>> IIASolver(
@@ -130,6 +135,61 @@ protected:
     }
   }
 
+  /// Checks that the analysis computes the same labels when its edge facts
+  /// are interned.
+  void compareWithInternedResults(const std::string &LlvmFilePath) {
+    IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + LlvmFilePath},
+        IRDBOptions::WPA);
+    ValueAnnotationPass::resetValueID();
+    LLVMTypeHierarchy TH(*IRDB);
+    LLVMPointsToSet PT(*IRDB);
+    LLVMBasedICFG ICFG(*IRDB, CallGraphAnalysisType::CHA, EntryPoints, &TH,
+                       &PT);
+    IDEInstInteractionAnalysisT<std::string, true> IIAProblem(
+        IRDB.get(), &TH, &ICFG, &PT, EntryPoints,
+        &IDEInstInteractionAnalysisTest::getLabels);
+    IDESolver_P<IDEInstInteractionAnalysisT<std::string, true>> IIASolver(
+        IIAProblem);
+    IIASolver.solve();
+    Interner<std::string> Labels;
+    IDEInstInteractionAnalysisT<Interned<std::string>, true> InternedProblem(
+        IRDB.get(), &TH, &ICFG, &PT, EntryPoints,
+        [&Labels](auto Current) {
+          std::set<Interned<std::string>> Facts;
+          for (auto &Label : getLabels(Current)) {
+            Facts.insert(Labels.intern(std::move(Label)));
+          }
+          return Facts;
+        });
+    IDESolver_P<IDEInstInteractionAnalysisT<Interned<std::string>, true>>
+        InternedSolver(InternedProblem);
+    InternedSolver.solve();
+    size_t NumSets = 0;
+    for (const auto &Cell :
+         IIASolver.getSolverResults().getAllResultEntries()) {
+      auto Value = Cell.getValue();
+      auto InternedValue =
+          InternedSolver.resultAt(Cell.getRowKey(), Cell.getColumnKey());
+      const auto *Set = std::get_if<BitVectorSet<std::string>>(&Value);
+      if (!Set) {
+        EXPECT_EQ(Value.index(), InternedValue.index());
+        continue;
+      }
+      const auto *InternedSet =
+          std::get_if<InternedBitSet<std::string>>(&InternedValue);
+      ASSERT_NE(nullptr, InternedSet);
+      std::set<std::string> Expected(Set->begin(), Set->end());
+      std::set<std::string> Actual;
+      for (auto Label : *InternedSet) {
+        Actual.insert(*Label);
+      }
+      EXPECT_EQ(Expected, Actual);
+      ++NumSets;
+    }
+    EXPECT_GT(NumSets, 0U);
+  }
+
   void TearDown() override {}
 
 }; // Test Fixture
@@ -661,6 +721,18 @@ TEST_F(IDEInstInteractionAnalysisTest, HandleStruct_01) {
   doAnalysisAndCompareResults("struct_01_cpp.ll", GroundTruth, false);
 }
 
+TEST_F(IDEInstInteractionAnalysisTest, HandleInternedEdgeFacts_01) {
+  compareWithInternedResults("basic_06_cpp.ll");
+}
+
+TEST_F(IDEInstInteractionAnalysisTest, HandleInternedEdgeFacts_02) {
+  compareWithInternedResults("call_01_cpp.ll");
+}
+
+TEST_F(IDEInstInteractionAnalysisTest, HandleInternedEdgeFacts_03) {
+  compareWithInternedResults("struct_01_cpp.ll");
+}
+
 // main function for the test case/*  */
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
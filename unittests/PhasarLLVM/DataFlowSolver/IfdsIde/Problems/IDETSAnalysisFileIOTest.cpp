@@ -16,6 +16,7 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDETypeStateAnalysis.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/CSTDFILEIOTypeStateDescription.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/SyncPDS/Solver/SyncPDSSolver.h"
 #include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
@@ -50,12 +51,21 @@ protected:
   IDETSAnalysisFileIOTest() = default;
   ~IDETSAnalysisFileIOTest() override = default;
 
-  void initialize(const std::vector<std::string> &IRFiles) {
+  /// Analyzes IRFiles using a whole-program LLVMPointsToSet, or, if
+  /// UseSyncPDS is true, the demand-driven SyncPDSSolver on a CHA call graph.
+  void initialize(const std::vector<std::string> &IRFiles,
+                  bool UseSyncPDS = false) {
     IRDB = make_unique<ProjectIRDB>(IRFiles, IRDBOptions::WPA);
     TH = make_unique<LLVMTypeHierarchy>(*IRDB);
-    PT = make_unique<LLVMPointsToSet>(*IRDB);
-    ICFG = make_unique<LLVMBasedICFG>(*IRDB, CallGraphAnalysisType::OTF,
-                                      EntryPoints, TH.get(), PT.get());
+    if (UseSyncPDS) {
+      ICFG = make_unique<LLVMBasedICFG>(*IRDB, CallGraphAnalysisType::CHA,
+                                        EntryPoints, TH.get());
+      PT = make_unique<SyncPDSSolver>(*ICFG);
+    } else {
+      PT = make_unique<LLVMPointsToSet>(*IRDB);
+      ICFG = make_unique<LLVMBasedICFG>(*IRDB, CallGraphAnalysisType::OTF,
+                                        EntryPoints, TH.get(), PT.get());
+    }
     CSTDFILEIODesc = make_unique<CSTDFILEIOTypeStateDescription>();
     TSProblem = make_unique<IDETypeStateAnalysis>(IRDB.get(), TH.get(),
                                                   ICFG.get(), PT.get(),
@@ -139,6 +149,36 @@ TEST_F(IDETSAnalysisFileIOTest, HandleTypeState_03) {
   compareResults(Gt, Llvmtssolver);
 }
 
+TEST_F(IDETSAnalysisFileIOTest, HandleTypeState_01_SyncPDS) {
+  initialize({PathToLlFiles + "typestate_01_c.ll"}, /*UseSyncPDS*/ true);
+  IDESolver_P<IDETypeStateAnalysis> Llvmtssolver(*TSProblem);
+  Llvmtssolver.solve();
+  const std::map<std::size_t, std::map<std::string, int>> Gt = {
+      {5, {{"3", IOSTATE::UNINIT}}},
+      {9, {{"3", IOSTATE::CLOSED}}},
+      {7, {{"3", IOSTATE::OPENED}}}};
+  compareResults(Gt, Llvmtssolver);
+}
+
+TEST_F(IDETSAnalysisFileIOTest, HandleTypeState_03_SyncPDS) {
+  initialize({PathToLlFiles + "typestate_03_c.ll"}, /*UseSyncPDS*/ true);
+  IDESolver_P<IDETypeStateAnalysis> Llvmtssolver(*TSProblem);
+
+  Llvmtssolver.solve();
+  // the aliases of the file handle are found across the call to foo()
+  const std::map<std::size_t, std::map<std::string, int>> Gt = {
+      {2, {{"foo.0", IOSTATE::OPENED}}},
+      {6,
+       {{"foo.0", IOSTATE::CLOSED},
+        {"2", IOSTATE::CLOSED},
+        {"4", IOSTATE::CLOSED}}},
+      {14,
+       {{"2", IOSTATE::CLOSED},
+        {"8", IOSTATE::CLOSED},
+        {"12", IOSTATE::CLOSED}}}};
+  compareResults(Gt, Llvmtssolver);
+}
+
 TEST_F(IDETSAnalysisFileIOTest, HandleTypeState_04) {
   initialize({PathToLlFiles + "typestate_04_c.ll"});
   IDESolver_P<IDETypeStateAnalysis> Llvmtssolver(*TSProblem);
@@ -537,6 +577,51 @@ TEST_F(IDETSAnalysisFileIOTest, HandleTypeState_19) {
   compareResults(Gt, Llvmtssolver);
 }
 
+TEST_F(IDETSAnalysisFileIOTest, HandleTransferFunctions) {
+  using TSEdgeFunction = IDETypeStateAnalysis::TSEdgeFunction;
+  CSTDFILEIOTypeStateDescription Desc;
+  auto Open = std::make_shared<TSEdgeFunction>(Desc, "fopen", nullptr);
+  auto Read = std::make_shared<TSEdgeFunction>(Desc, "fgetc", nullptr);
+  auto Close = std::make_shared<TSEdgeFunction>(Desc, "fclose", nullptr);
+
+  // Compositions are tabulated rather than chained
+  auto OpenClose = Open->composeWith(Read)->composeWith(Close);
+  ASSERT_NE(nullptr, dynamic_cast<TSEdgeFunction *>(OpenClose.get()));
+  EXPECT_EQ(CLOSED, OpenClose->computeTarget(UNINIT));
+  EXPECT_EQ(CLOSED, OpenClose->computeTarget(TOP));
+  EXPECT_EQ(ERROR, OpenClose->composeWith(Close)->computeTarget(UNINIT));
+  EXPECT_TRUE(OpenClose->equal_to(Open->composeWith(Close)));
+
+  // Joins are computed element-wise
+  auto Joined = Close->joinWith(OpenClose);
+  EXPECT_EQ(CLOSED, Joined->computeTarget(OPENED));
+  EXPECT_EQ(BOT, Joined->computeTarget(UNINIT));
+  EXPECT_EQ(ERROR, Joined->computeTarget(ERROR));
+}
+
+/// A description that does not number its states, as third-party
+/// descriptions written before getNumStates() was introduced.
+class UntabulatedFILEIODescription : public CSTDFILEIOTypeStateDescription {
+public:
+  [[nodiscard]] size_t getNumStates() const override {
+    return TypeStateDescription::getNumStates();
+  }
+};
+
+TEST_F(IDETSAnalysisFileIOTest, HandleTypeState_01_Untabulated) {
+  initialize({PathToLlFiles + "typestate_01_c.ll"});
+  UntabulatedFILEIODescription Desc;
+  IDETypeStateAnalysis Problem(IRDB.get(), TH.get(), ICFG.get(), PT.get(),
+                               Desc, EntryPoints);
+  IDESolver_P<IDETypeStateAnalysis> Llvmtssolver(Problem);
+  Llvmtssolver.solve();
+  const std::map<std::size_t, std::map<std::string, int>> Gt = {
+      {5, {{"3", IOSTATE::UNINIT}}},
+      {9, {{"3", IOSTATE::CLOSED}}},
+      {7, {{"3", IOSTATE::OPENED}}}};
+  compareResults(Gt, Llvmtssolver);
+}
+
 // main function for the test case
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
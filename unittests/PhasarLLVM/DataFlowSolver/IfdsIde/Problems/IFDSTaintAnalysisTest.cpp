@@ -92,6 +92,19 @@ TEST_F(IFDSTaintAnalysisTest, TaintTest_01) {
   compareResults(GroundTruth);
 }
 
+TEST_F(IFDSTaintAnalysisTest, TaintTest_01_ReportWithoutValues) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_01_cpp_dbg.ll"});
+  // the report falls back to the recorded leaks if Phase II is skipped
+  TaintProblem->getIFDSIDESolverConfig().setComputeValues(false);
+  IFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
+  TaintSolver.solve();
+  std::string Report;
+  llvm::raw_string_ostream OS(Report);
+  TaintSolver.emitTextReport(OS);
+  EXPECT_EQ(std::string::npos, OS.str().find("No leaks found!"));
+  EXPECT_NE(std::string::npos, OS.str().find("Leak(s):"));
+}
+
 TEST_F(IFDSTaintAnalysisTest, TaintTest_01_m2r) {
   initialize({PathToLlFiles + "dummy_source_sink/taint_01_cpp_m2r_dbg.ll"});
   IFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
@@ -129,6 +142,20 @@ TEST_F(IFDSTaintAnalysisTest, TaintTest_04) {
   compareResults(GroundTruth);
 }
 
+TEST_F(IFDSTaintAnalysisTest, TaintTest_04_Threads) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_04_cpp_dbg.ll"});
+  // the taint analysis records leaks as a side effect of its flow functions
+  // and is solved sequentially despite the configured threads
+  ASSERT_FALSE(TaintProblem->isThreadSafe());
+  TaintProblem->getIFDSIDESolverConfig().setNumThreads(4);
+  IFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
+  TaintSolver.solve();
+  map<int, set<string>> GroundTruth;
+  GroundTruth[19] = set<string>{"18"};
+  GroundTruth[24] = set<string>{"23"};
+  compareResults(GroundTruth);
+}
+
 TEST_F(IFDSTaintAnalysisTest, TaintTest_05) {
   initialize({PathToLlFiles + "dummy_source_sink/taint_05_cpp_dbg.ll"});
   IFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
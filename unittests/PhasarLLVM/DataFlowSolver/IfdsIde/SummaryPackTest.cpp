@@ -0,0 +1,161 @@
+#include <filesystem>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/WholeProgramAnalysis.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryPack.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+#include "SummaryTestProblems.h"
+#include "TestConfig.h"
+
+using namespace psr;
+using unittest::PersistableUninitializedVariables;
+using unittest::UninitializedVariablesWithoutSummaries;
+
+/// Claims to be thread-safe, such that the solver would solve it in parallel
+/// if it did not apply a summary pack.
+class ParallelUninitializedVariables
+    : public PersistableUninitializedVariables {
+public:
+  using PersistableUninitializedVariables::PersistableUninitializedVariables;
+
+  [[nodiscard]] bool isThreadSafe() const override { return true; }
+};
+
+/* ============== TEST FIXTURE ============== */
+class SummaryPackTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "summary_reuse/";
+  const std::filesystem::path PackDirectory =
+      std::filesystem::temp_directory_path() / "phasar-summary-pack-test";
+
+  void TearDown() override { std::filesystem::remove_all(PackDirectory); }
+
+  /// Computes the summary pack of the uninitialized variables analysis for
+  /// all functions of IRFile and returns its path.
+  std::string generatePack(const std::string &IRFile) {
+    ValueAnnotationPass::resetValueID();
+    ProjectIRDB IRDB({IRFile}, IRDBOptions::WPA);
+    IFDSIDESolverConfig SolverConfig;
+    SolverConfig.setGenerateSummaryPack();
+    SolverConfig.setPersistedSummariesDirectory(PackDirectory.string());
+    SolverConfig.setPersistedSummariesID("uninit");
+    WholeProgramAnalysis<IFDSSolver_P<PersistableUninitializedVariables>,
+                         PersistableUninitializedVariables>
+        WPA(SolverConfig, IRDB, {"__ALL__"});
+    WPA.solve();
+    return (PackDirectory / "uninit.pack").string();
+  }
+
+  /// Solves the analysis for IRFile on NumThreads threads, applying the
+  /// summaries of Pack if given, and returns the ids of the facts holding at
+  /// the return of main and the number of facts holding within lib().
+  template <typename ProblemTy = ParallelUninitializedVariables>
+  static std::pair<std::set<std::string>, size_t>
+  solve(const std::string &IRFile, const std::string *Pack,
+        unsigned NumThreads = 1) {
+    ValueAnnotationPass::resetValueID();
+    ProjectIRDB IRDB({IRFile}, IRDBOptions::WPA);
+    const std::set<std::string> EntryPoints = {"main"};
+    LLVMTypeHierarchy TH(IRDB);
+    LLVMPointsToSet PT(IRDB);
+    LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH,
+                       &PT);
+    ProblemTy Problem(&IRDB, &TH, &ICFG, &PT, EntryPoints);
+    IFDSIDESolverConfig Config;
+    Config.setNumThreads(NumThreads);
+    Problem.setIFDSIDESolverConfig(Config);
+    SummaryPack Summaries("uninit");
+    IFDSSolver Solver(Problem);
+    if (Pack) {
+      EXPECT_TRUE(Summaries.load(*Pack));
+      Summaries.index(IRDB);
+      EXPECT_NE(nullptr,
+                Summaries.lookup(IRDB.getFunctionDefinition("_Z3libi")));
+      Solver.setSummaryPack(&Summaries);
+    }
+    Solver.solve();
+    std::set<std::string> Facts;
+    for (const auto &I :
+         llvm::instructions(IRDB.getFunctionDefinition("main"))) {
+      if (llvm::isa<llvm::ReturnInst>(I)) {
+        for (const auto *Fact : Solver.ifdsResultsAt(&I)) {
+          if (!Problem.isZeroValue(Fact)) {
+            Facts.insert(getMetaDataID(Fact));
+          }
+        }
+      }
+    }
+    size_t NumLibFacts = 0;
+    for (const auto &I :
+         llvm::instructions(IRDB.getFunctionDefinition("_Z3libi"))) {
+      NumLibFacts += Solver.ifdsResultsAt(&I).size();
+    }
+    return {Facts, NumLibFacts};
+  }
+}; // Test Fixture
+
+TEST_F(SummaryPackTest, ApplyPackInsteadOfAnalyzingCallee) {
+  const std::string IRFile = PathToLlFiles + "summary_reuse_05_cpp.ll";
+  auto Pack = generatePack(IRFile);
+  ASSERT_TRUE(std::filesystem::exists(Pack));
+
+  auto [Expected, NumLibFacts] = solve(IRFile, nullptr);
+  EXPECT_FALSE(Expected.empty());
+  EXPECT_LT(0U, NumLibFacts);
+
+  auto [Facts, NumLibFactsWithPack] = solve(IRFile, &Pack);
+  EXPECT_EQ(Expected, Facts);
+  // lib() has not been analyzed
+  EXPECT_EQ(0U, NumLibFactsWithPack);
+}
+
+TEST_F(SummaryPackTest, ApplyPackWithSeveralThreads) {
+  const std::string IRFile = PathToLlFiles + "summary_reuse_05_cpp.ll";
+  auto Pack = generatePack(IRFile);
+  auto [Expected, NumLibFacts] = solve(IRFile, nullptr);
+
+  // The parallel tabulation does not apply packs, the solver falls back to
+  // the sequential one
+  auto [Facts, NumLibFactsWithPack] = solve(IRFile, &Pack, 4);
+  EXPECT_EQ(Expected, Facts);
+  EXPECT_EQ(0U, NumLibFactsWithPack);
+}
+
+TEST_F(SummaryPackTest, NoPackForProblemsThatDoNotOptIn) {
+  const std::string IRFile = PathToLlFiles + "summary_reuse_05_cpp.ll";
+  auto Pack = generatePack(IRFile);
+  auto [Expected, NumLibFacts] = solve(IRFile, nullptr);
+
+  auto [Facts, NumLibFactsWithPack] =
+      solve<UninitializedVariablesWithoutSummaries>(IRFile, &Pack);
+  EXPECT_EQ(Expected, Facts);
+  EXPECT_EQ(NumLibFacts, NumLibFactsWithPack);
+}
+
+TEST_F(SummaryPackTest, PackOfOtherProblem) {
+  auto Pack = generatePack(PathToLlFiles + "summary_reuse_05_cpp.ll");
+  SummaryPack Other("taint");
+  EXPECT_FALSE(Other.load(Pack));
+  EXPECT_FALSE(Other.load((PackDirectory / "missing.pack").string()));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Contexts/CallStringContextTree.h"
+
+using namespace psr;
+
+using TreeTy = CallStringContextTree<const int *, 2>;
+
+static const int CallSites[4] = {0, 1, 2, 3};
+static const int *A = &CallSites[0];
+static const int *B = &CallSites[1];
+static const int *C = &CallSites[2];
+
+TEST(CallStringContextTree, pushAndPop) {
+  TreeTy Tree;
+  EXPECT_EQ(Tree.size(), 1U);
+  EXPECT_EQ(Tree.getLength(TreeTy::EmptyContext), 0U);
+
+  auto CtxA = Tree.push(TreeTy::EmptyContext, A);
+  auto CtxAB = Tree.push(CtxA, B);
+  EXPECT_NE(CtxA, TreeTy::EmptyContext);
+  EXPECT_NE(CtxA, CtxAB);
+  EXPECT_EQ(Tree.getLength(CtxAB), 2U);
+
+  // equal call strings are represented by the same id
+  EXPECT_EQ(Tree.push(TreeTy::EmptyContext, A), CtxA);
+  EXPECT_EQ(Tree.push(CtxA, B), CtxAB);
+  EXPECT_EQ(Tree.size(), 3U);
+
+  auto [Parent, CallSite] = Tree.pop(CtxAB);
+  EXPECT_EQ(Parent, CtxA);
+  EXPECT_EQ(CallSite, B);
+  EXPECT_EQ(Tree.pop(CtxA).first, TreeTy::EmptyContext);
+}
+
+TEST(CallStringContextTree, dropOldestCallSite) {
+  TreeTy Tree;
+  auto CtxAB = Tree.push(Tree.push(TreeTy::EmptyContext, A), B);
+  auto CtxBC = Tree.push(CtxAB, C);
+  EXPECT_EQ(Tree.getLength(CtxBC), 2U);
+  EXPECT_EQ(CtxBC, Tree.push(Tree.push(TreeTy::EmptyContext, B), C));
+
+  auto CallSitesBC = Tree.getCallSites(CtxBC);
+  ASSERT_EQ(CallSitesBC.size(), 2U);
+  EXPECT_EQ(CallSitesBC[0], B);
+  EXPECT_EQ(CallSitesBC[1], C);
+
+  // the memoized suffix must be reused on subsequent pushes
+  auto Size = Tree.size();
+  EXPECT_EQ(Tree.push(CtxAB, C), CtxBC);
+  EXPECT_EQ(Tree.size(), Size);
+}
+
+TEST(CallStringContextTree, convertToCallStringCTX) {
+  TreeTy Tree;
+  auto CtxABC = Tree.push(Tree.push(Tree.push(TreeTy::EmptyContext, A), B), C);
+  CallStringCTX<const int *, 2> Expected;
+  Expected.push_back(A);
+  Expected.push_back(B);
+  Expected.push_back(C);
+  EXPECT_EQ(Tree.getCallStringCTX(CtxABC), Expected);
+  EXPECT_EQ(Tree.getCallStringCTX(TreeTy::EmptyContext),
+            (CallStringCTX<const int *, 2>()));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,157 @@
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/InterMonoProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/InterMonoSolver.h"
+#include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/BitVectorSet.h"
+#include "phasar/Utils/LLVMShorthands.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+namespace {
+
+struct AllocaCollectorDomain : public LLVMAnalysisDomainDefault {
+  using mono_container_t = BitVectorSet<LLVMAnalysisDomainDefault::d_t>;
+};
+
+/// Collects the allocas that have been executed before an instruction. All
+/// containers of the problem use the problem's own BitVectorSet domain.
+class AllocaCollector : public InterMonoProblem<AllocaCollectorDomain> {
+public:
+  using InterMonoProblem::InterMonoProblem;
+
+  mono_container_t allTop() override { return mono_container_t(Domain); }
+
+  mono_container_t merge(const mono_container_t &Lhs,
+                         const mono_container_t &Rhs) override {
+    return Lhs.setUnion(Rhs);
+  }
+
+  bool equal_to(const mono_container_t &Lhs,
+                const mono_container_t &Rhs) override {
+    return Lhs == Rhs;
+  }
+
+  mono_container_t normalFlow(n_t Inst, const mono_container_t &In) override {
+    auto Out = In;
+    if (llvm::isa<llvm::AllocaInst>(Inst)) {
+      Out.insert(Inst);
+    }
+    return Out;
+  }
+
+  mono_container_t callFlow(n_t /*CallSite*/, f_t /*Callee*/,
+                            const mono_container_t &In) override {
+    return In;
+  }
+
+  mono_container_t returnFlow(n_t /*CallSite*/, f_t /*Callee*/,
+                              n_t /*ExitStmt*/, n_t /*RetSite*/,
+                              const mono_container_t &In) override {
+    return In;
+  }
+
+  mono_container_t callToRetFlow(n_t /*CallSite*/, n_t /*RetSite*/,
+                                 std::set<f_t> /*Callees*/,
+                                 const mono_container_t &In) override {
+    return In;
+  }
+
+  std::unordered_map<n_t, mono_container_t> initialSeeds() override {
+    std::unordered_map<n_t, mono_container_t> Seeds;
+    for (const auto *StartPoint :
+         ICF->getStartPointsOf(ICF->getFunction("main"))) {
+      Seeds.insert({StartPoint, allTop()});
+    }
+    return Seeds;
+  }
+
+  void printNode(llvm::raw_ostream &OS, n_t Inst) const override {
+    OS << llvmIRToString(Inst);
+  }
+
+  void printDataFlowFact(llvm::raw_ostream &OS, d_t Fact) const override {
+    OS << llvmIRToString(Fact) << '\n';
+  }
+
+  void printFunction(llvm::raw_ostream &OS, f_t Fun) const override {
+    OS << Fun->getName();
+  }
+
+private:
+  BitVectorSetDomain<d_t> Domain;
+};
+
+} // anonymous namespace
+
+/* ============== TEST FIXTURE ============== */
+class InterMonoBitVectorSetTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "control_flow/";
+  const std::set<std::string> EntryPoints = {"main"};
+}; // Test Fixture
+
+TEST_F(InterMonoBitVectorSetTest, FactsAreMergedInTheProblemsDomain) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({PathToLlFiles + "call_in_branch_cpp.ll"},
+                   IRDBOptions::WPA);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, EntryPoints, &TH, &PT);
+  AllocaCollector Problem(&IRDB, &TH, &ICFG, &PT, EntryPoints);
+  InterMonoSolver<AllocaCollectorDomain, 3> Solver(Problem);
+  Solver.solve();
+
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  const auto *Foo = IRDB.getFunctionDefinition("_Z3fooi");
+  ASSERT_NE(nullptr, Main);
+  ASSERT_NE(nullptr, Foo);
+  auto getAllocas = [](const llvm::Function *F) {
+    std::set<const llvm::Value *> Allocas;
+    for (const auto &Inst : F->front()) {
+      if (llvm::isa<llvm::AllocaInst>(Inst)) {
+        Allocas.insert(&Inst);
+      }
+    }
+    return Allocas;
+  };
+  auto MainAllocas = getAllocas(Main);
+  auto FooAllocas = getAllocas(Foo);
+  ASSERT_EQ(4U, MainAllocas.size());
+  ASSERT_EQ(1U, FooAllocas.size());
+
+  // The facts of main are merged at the end of the if statement with those of
+  // the path that skips the call, which requires all containers of the
+  // solver to be created in the problem's domain
+  auto MainFacts = Solver.getResultsAt(&Main->back().back());
+  for (const auto *Alloca : MainAllocas) {
+    EXPECT_EQ(1U, MainFacts.count(Alloca));
+  }
+  // The facts of main are passed into foo
+  auto FooFacts = Solver.getResultsAt(&Foo->back().back());
+  for (const auto *Alloca : MainAllocas) {
+    EXPECT_EQ(1U, FooFacts.count(Alloca));
+  }
+  EXPECT_EQ(1U, FooFacts.count(*FooAllocas.begin()));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,133 @@
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "llvm/IR/InstIterator.h"
+
+#include "gtest/gtest.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/MonoWorklist.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+namespace {
+
+/// A single function whose instructions are numbered as follows:
+///
+///   0 -> 1 -> 2 -> 3 -> 5
+///        ^         |
+///        +--- 4 <--+
+class LoopCFG {
+public:
+  [[nodiscard]] int getFunctionOf(int /*Inst*/) const { return 0; }
+
+  [[nodiscard]] std::vector<int> getSuccsOf(int Inst) const {
+    auto Search = Succs.find(Inst);
+    return Search != Succs.end() ? Search->second : std::vector<int>{};
+  }
+
+  [[nodiscard]] std::set<int> getStartPointsOf(int /*Fun*/) const {
+    return {0};
+  }
+
+private:
+  std::map<int, std::vector<int>> Succs = {
+      {0, {1}}, {1, {2}}, {2, {3}}, {3, {4, 5}}, {4, {1}}};
+};
+
+using WorklistTy = MonoWorklist<int, int, LoopCFG>;
+
+} // namespace
+
+TEST(MonoWorklist, deduplicatesPendingEdges) {
+  LoopCFG CFG;
+  WorklistTy Worklist(&CFG, MonoWorklistStrategy::FIFO);
+  EXPECT_TRUE(Worklist.push({0, 1}));
+  EXPECT_TRUE(Worklist.push({1, 2}));
+  EXPECT_FALSE(Worklist.push({0, 1}));
+  EXPECT_EQ(Worklist.size(), 2U);
+  EXPECT_EQ(Worklist.pop(), std::make_pair(0, 1));
+  // once processed, an edge may be added again
+  EXPECT_TRUE(Worklist.push({0, 1}));
+  EXPECT_EQ(Worklist.pop(), std::make_pair(1, 2));
+  EXPECT_EQ(Worklist.pop(), std::make_pair(0, 1));
+  EXPECT_TRUE(Worklist.empty());
+}
+
+TEST(MonoWorklist, pushFrontPrecedesPendingEdges) {
+  LoopCFG CFG;
+  WorklistTy Worklist(&CFG, MonoWorklistStrategy::FIFO);
+  Worklist.push({3, 5});
+  std::vector<std::pair<int, int>> Edges = {{0, 1}, {3, 5}, {1, 2}};
+  Worklist.pushFront(Edges.begin(), Edges.end());
+  EXPECT_EQ(Worklist.size(), 3U);
+  EXPECT_EQ(Worklist.pop(), std::make_pair(0, 1));
+  EXPECT_EQ(Worklist.pop(), std::make_pair(1, 2));
+  EXPECT_EQ(Worklist.pop(), std::make_pair(3, 5));
+}
+
+TEST(MonoWorklist, reversePostOrder) {
+  LoopCFG CFG;
+  WorklistTy Worklist(&CFG, MonoWorklistStrategy::ReversePostOrder);
+  std::vector<std::pair<int, int>> Edges = {{3, 5}, {4, 1}, {3, 4},
+                                            {2, 3}, {1, 2}, {0, 1}};
+  Worklist.pushFront(Edges.begin(), Edges.end());
+  EXPECT_FALSE(Worklist.push({2, 3}));
+  // the loop body is handled before the loop exit; edges with the same
+  // target are handled in insertion order
+  std::vector<std::pair<int, int>> Expected = {{4, 1}, {0, 1}, {1, 2},
+                                               {2, 3}, {3, 4}, {3, 5}};
+  std::vector<std::pair<int, int>> Actual;
+  while (!Worklist.empty()) {
+    Actual.push_back(Worklist.pop());
+  }
+  EXPECT_EQ(Expected, Actual);
+}
+
+TEST(MonoWorklist, interproceduralReversePostOrder) {
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "control_flow/function_call_cpp.ll"});
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICF(IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT);
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  const auto *Mult = IRDB.getFunctionDefinition("_Z4multii");
+  ASSERT_NE(nullptr, Main);
+  ASSERT_NE(nullptr, Mult);
+
+  using EdgeTy =
+      std::pair<const llvm::Instruction *, const llvm::Instruction *>;
+  std::vector<EdgeTy> Edges;
+  for (const auto *Fun : {Main, Mult}) {
+    for (const auto &Inst : llvm::instructions(Fun)) {
+      for (const auto *Succ : ICF.getSuccsOf(&Inst)) {
+        Edges.emplace_back(&Inst, Succ);
+      }
+    }
+  }
+  MonoWorklist<const llvm::Instruction *, const llvm::Function *,
+               LLVMBasedICFG>
+      Worklist(&ICF, MonoWorklistStrategy::ReversePostOrder);
+  // add the callee's edges first and each function's edges backwards
+  Worklist.pushFront(Edges.rbegin(), Edges.rend());
+  // the caller is handled before its callee and the instructions of each
+  // function in reverse postorder, which is the program order for these
+  // straight-line functions
+  std::vector<EdgeTy> Actual;
+  while (!Worklist.empty()) {
+    Actual.push_back(Worklist.pop());
+  }
+  EXPECT_EQ(Edges, Actual);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,148 @@
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/SyncPDS/Solver/SyncPDSSolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+class SyncPDSSolverTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles = unittest::PathToLLTestFiles + "pointers/";
+
+  /// Returns the local variable Name of F.
+  static const llvm::Value *getLocal(const llvm::Function *F,
+                                     const std::string &Name) {
+    for (const auto &I : llvm::instructions(F)) {
+      if (llvm::isa<llvm::AllocaInst>(I) && I.getName() == Name) {
+        return &I;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Returns the value that is stored in the local variable Name of F.
+  static const llvm::Value *getStoredValue(const llvm::Function *F,
+                                           const std::string &Name) {
+    const auto *Local = getLocal(F, Name);
+    for (const auto &I : llvm::instructions(F)) {
+      const auto *Store = llvm::dyn_cast<llvm::StoreInst>(&I);
+      if (Store && Store->getPointerOperand() == Local) {
+        return Store->getValueOperand();
+      }
+    }
+    return nullptr;
+  }
+}; // Test Fixture
+
+TEST_F(SyncPDSSolverTest, ContextSensitivity) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({PathToLlFiles + "sync_pds_01_cpp.ll"});
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICF(IRDB, CallGraphAnalysisType::CHA, {"main"}, &TH, &PT);
+  SyncPDSSolver SPDS(ICF);
+  const auto *F = IRDB.getFunctionDefinition("_Z8contextsv");
+  ASSERT_NE(nullptr, F);
+  const auto *A = getLocal(F, "A");
+  const auto *B = getLocal(F, "B");
+  const auto *X = getStoredValue(F, "X");
+  const auto *Y = getStoredValue(F, "Y");
+  ASSERT_TRUE(A && B && X && Y);
+
+  // the returns of both calls to id() are not mixed up
+  EXPECT_EQ(LLVMPointsToInfo::PointsToSetTy({A}),
+            *SPDS.getReachableAllocationSites(X));
+  EXPECT_EQ(LLVMPointsToInfo::PointsToSetTy({B}),
+            *SPDS.getReachableAllocationSites(Y));
+  EXPECT_EQ(AliasResult::MayAlias, SPDS.alias(X, A));
+  EXPECT_EQ(AliasResult::NoAlias, SPDS.alias(X, Y));
+  EXPECT_EQ(AliasResult::NoAlias, SPDS.alias(Y, A));
+}
+
+TEST_F(SyncPDSSolverTest, FieldSensitivity) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({PathToLlFiles + "sync_pds_01_cpp.ll"});
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICF(IRDB, CallGraphAnalysisType::CHA, {"main"}, &TH, &PT);
+  SyncPDSSolver SPDS(ICF);
+  const auto *F = IRDB.getFunctionDefinition("_Z6fieldsv");
+  ASSERT_NE(nullptr, F);
+  const auto *C = getLocal(F, "C");
+  const auto *D = getLocal(F, "D");
+  const auto *Z = getStoredValue(F, "Z");
+  ASSERT_TRUE(C && D && Z);
+
+  // Bx.Ptr and Bx.Other are distinguished
+  EXPECT_EQ(LLVMPointsToInfo::PointsToSetTy({C}),
+            *SPDS.getReachableAllocationSites(Z));
+  EXPECT_EQ(AliasResult::MayAlias, SPDS.alias(Z, C));
+  EXPECT_EQ(AliasResult::NoAlias, SPDS.alias(Z, D));
+}
+
+TEST_F(SyncPDSSolverTest, QueriesAreCached) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({PathToLlFiles + "sync_pds_01_cpp.ll"});
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICF(IRDB, CallGraphAnalysisType::CHA, {"main"}, &TH, &PT);
+  SyncPDSSolver SPDS(ICF);
+  const auto *F = IRDB.getFunctionDefinition("_Z8contextsv");
+  ASSERT_NE(nullptr, F);
+  const auto *X = getStoredValue(F, "X");
+  ASSERT_NE(nullptr, X);
+
+  auto Aliases = SPDS.getPointsToSet(X);
+  EXPECT_EQ(1U, SPDS.getNumQueries());
+  EXPECT_EQ(Aliases, SPDS.getPointsToSet(X));
+  EXPECT_TRUE(SPDS.isInReachableAllocationSites(X, getLocal(F, "A")));
+  EXPECT_EQ(1U, SPDS.getNumQueries());
+  // introducing an alias invalidates the cache
+  const auto *B = getLocal(F, "B");
+  SPDS.introduceAlias(X, B);
+  EXPECT_EQ(AliasResult::MayAlias, SPDS.alias(X, B));
+  EXPECT_EQ(2U, SPDS.getNumQueries());
+  // the outdated result has been recomputed in place
+  EXPECT_EQ(Aliases, SPDS.getPointsToSet(X));
+  EXPECT_EQ(1U, Aliases->count(B));
+  EXPECT_EQ(2U, SPDS.getNumQueries());
+}
+
+TEST_F(SyncPDSSolverTest, SynchronizationAlongPaths) {
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({PathToLlFiles + "sync_pds_01_cpp.ll"});
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMPointsToSet PT(IRDB);
+  LLVMBasedICFG ICF(IRDB, CallGraphAnalysisType::CHA, {"main"}, &TH, &PT);
+  SyncPDSSolver SPDS(ICF);
+  const auto *F = IRDB.getFunctionDefinition("_Z15synchronizationv");
+  ASSERT_NE(nullptr, F);
+  const auto *A = getLocal(F, "A");
+  const auto *C = getLocal(F, "C");
+  const auto *X = getStoredValue(F, "X");
+  ASSERT_TRUE(A && C && X);
+
+  // X only points to A. C is reached with a matching call stack by
+  // dereferencing A, and with an empty field stack by returning from the
+  // second call to opaque(), but not along a single path.
+  EXPECT_EQ(LLVMPointsToInfo::PointsToSetTy({A}),
+            *SPDS.getReachableAllocationSites(X));
+  EXPECT_EQ(AliasResult::NoAlias, SPDS.alias(X, C));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,7 +1,13 @@
 #include <cstdlib>
+#include <string>
 
 #include "llvm/ADT/StringRef.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/GlobalVariable.h"
 #include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MemoryBufferRef.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "gtest/gtest.h"
@@ -92,6 +98,14 @@ static void analyze(llvm::StringRef File, const GroundTruthTy &Gt,
 
   LLVMPointsToSet Deser(IRDB, Ser);
   checkDeser(*IRDB.getWPAModule(), PTS, Deser);
+
+  std::string Bin;
+  llvm::raw_string_ostream BinOS(Bin);
+  PTS.printAsBinary(IRDB, BinOS);
+  LLVMPointsToSet BinDeser(IRDB, llvm::MemoryBufferRef(BinOS.str(), File));
+  checkDeser(*IRDB.getWPAModule(), PTS, BinDeser);
+  EXPECT_EQ(makeInnerSet(Ser.at("AnalyzedFunctions")),
+            makeInnerSet(BinDeser.getAsJson().at("AnalyzedFunctions")));
 }
 
 TEST(LLVMPointsToSetSerializationTest, Ser_Intra01) {
@@ -115,6 +129,90 @@ TEST(LLVMPointsToSetSerializationTest, Ser_Global01) {
             "main"}});
 }
 
+TEST(LLVMPointsToSetSerializationTest, Ser_BinaryStale) {
+  Logger::disable();
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB Other({unittest::PathToLLTestFiles + "pointers/basic_01_cpp.ll"});
+  std::string Bin;
+  llvm::raw_string_ostream BinOS(Bin);
+  LLVMPointsToSet(Other, false).printAsBinary(Other, BinOS);
+
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles + "pointers/call_01_cpp.ll"});
+  // The points-to info of another module must be rejected and recomputed
+  LLVMPointsToSet PTS(IRDB, false);
+  LLVMPointsToSet Deser(IRDB, llvm::MemoryBufferRef(BinOS.str(), "stale"));
+  checkDeser(*IRDB.getWPAModule(), PTS, Deser);
+
+  // Truncated files must be rejected as well
+  auto TruncatedBin = llvm::StringRef(Bin).drop_back(4);
+  LLVMPointsToSet Truncated(IRDB,
+                            llvm::MemoryBufferRef(TruncatedBin, "truncated"));
+  checkDeser(*IRDB.getWPAModule(), PTS, Truncated);
+}
+
+TEST(LLVMPointsToSetSerializationTest, Ser_BinaryDuplicateMember) {
+  Logger::disable();
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles + "pointers/basic_01_cpp.ll"});
+  std::string Bin;
+  llvm::raw_string_ostream BinOS(Bin);
+  LLVMPointsToSet(IRDB, false).printAsBinary(IRDB, BinOS);
+  BinOS.flush();
+
+  // Make the last member of the last alias class a member of the first class
+  // as well
+  auto NumClasses = llvm::support::endian::read32le(Bin.data() + 28);
+  auto NumMembers = llvm::support::endian::read32le(Bin.data() + 32);
+  ASSERT_GE(NumClasses, 2U);
+  auto *Members = Bin.data() + 40 + (NumClasses + 1) * sizeof(uint32_t);
+  llvm::support::endian::write32le(
+      Members + (NumMembers - 1) * sizeof(uint32_t),
+      llvm::support::endian::read32le(Members));
+
+  // The file must be rejected, such that the points-to info is recomputed
+  // lazily and main has not been analyzed
+  LLVMPointsToSet Deser(IRDB, llvm::MemoryBufferRef(Bin, "duplicate"));
+  EXPECT_TRUE(Deser.getAsJson().at("AnalyzedFunctions").empty());
+}
+
+TEST(LLVMPointsToSetSerializationTest, Ser_BinaryHashCoversConstants) {
+  Logger::disable();
+  ValueAnnotationPass::resetValueID();
+  ProjectIRDB IRDB(
+      {unittest::PathToLLTestFiles + "pointers/global_01_cpp.ll"});
+  LLVMPointsToSet PTS(IRDB, false);
+  auto GetModuleHash = [&] {
+    std::string Bin;
+    llvm::raw_string_ostream BinOS(Bin);
+    PTS.printAsBinary(IRDB, BinOS);
+    return BinOS.str().substr(16, sizeof(uint64_t));
+  };
+  auto Hash = GetModuleHash();
+
+  // Changing the value stored by foo() only changes a constant operand
+  const auto *Foo = IRDB.getFunctionDefinition("_Z3fooPi");
+  ASSERT_NE(nullptr, Foo);
+  llvm::StoreInst *Store = nullptr;
+  for (const auto &Inst : llvm::instructions(Foo)) {
+    if (const auto *SI = llvm::dyn_cast<llvm::StoreInst>(&Inst);
+        SI && llvm::isa<llvm::ConstantInt>(SI->getValueOperand())) {
+      Store = const_cast<llvm::StoreInst *>(SI);
+    }
+  }
+  ASSERT_NE(nullptr, Store);
+  Store->setOperand(0, llvm::ConstantInt::get(
+                           Store->getValueOperand()->getType(), 43));
+  auto StoreHash = GetModuleHash();
+  EXPECT_NE(Hash, StoreHash);
+
+  // as does changing the initializer of g
+  auto *G = IRDB.getWPAModule()->getGlobalVariable("g");
+  ASSERT_NE(nullptr, G);
+  G->setInitializer(llvm::UndefValue::get(G->getValueType()));
+  EXPECT_NE(StoreHash, GetModuleHash());
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
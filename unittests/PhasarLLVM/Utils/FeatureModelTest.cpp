@@ -0,0 +1,78 @@
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/Utils/FeatureModel.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+namespace {
+
+const std::string PathToLlFiles = unittest::PathToLLTestFiles + "variational/";
+
+PresenceCondition makePC(size_t Size, std::initializer_list<unsigned> Bits) {
+  PresenceCondition PC(Size);
+  for (auto Bit : Bits) {
+    PC.set(Bit);
+  }
+  return PC;
+}
+
+} // namespace
+
+TEST(FeatureModelTest, ParseConfigurations) {
+  auto Configs =
+      FeatureModel::parseConfigurations({"", "LOGGING", " LOGGING , VERBOSE,"});
+  ASSERT_EQ(3U, Configs.size());
+  EXPECT_TRUE(Configs[0].empty());
+  EXPECT_EQ(std::set<std::string>{"LOGGING"}, Configs[1]);
+  EXPECT_EQ((std::set<std::string>{"LOGGING", "VERBOSE"}), Configs[2]);
+}
+
+TEST(FeatureModelTest, BranchConditions) {
+  ProjectIRDB IRDB({PathToLlFiles + "variational_01_cpp.ll"});
+  FeatureModel Features(IRDB, FeatureModel::parseConfigurations(
+                                  {"", "LOGGING", "VERBOSE", "LOGGING,VERBOSE"}));
+  EXPECT_EQ((std::set<std::string>{"LOGGING", "VERBOSE"}),
+            Features.getFeatures());
+  ASSERT_EQ(2U, Features.getNumFeatureBranches());
+
+  const auto *Main = IRDB.getFunctionDefinition("main");
+  ASSERT_NE(nullptr, Main);
+  std::vector<const llvm::BranchInst *> Branches;
+  for (const auto &I : llvm::instructions(Main)) {
+    if (const auto *Branch = llvm::dyn_cast<llvm::BranchInst>(&I);
+        Branch && Branch->isConditional()) {
+      Branches.push_back(Branch);
+    }
+  }
+  ASSERT_EQ(2U, Branches.size());
+  const auto *Logging = Branches[0];
+  EXPECT_EQ(makePC(4, {1, 3}),
+            Features.getPresenceCondition(
+                Logging, &Logging->getSuccessor(0)->front()));
+  EXPECT_EQ(makePC(4, {0, 2}),
+            Features.getPresenceCondition(
+                Logging, &Logging->getSuccessor(1)->front()));
+  const auto *Verbose = Branches[1];
+  EXPECT_EQ(makePC(4, {2, 3}),
+            Features.getPresenceCondition(
+                Verbose, &Verbose->getSuccessor(0)->front()));
+  // all other edges are present in every configuration
+  EXPECT_EQ(Features.getTrue(),
+            Features.getPresenceCondition(&Main->front().front(),
+                                          Main->front().front().getNextNode()));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,69 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/Utils/FunctionHashes.h"
+
+#include "TestConfig.h"
+
+using namespace psr;
+
+namespace {
+
+const std::string PathToLlFiles = unittest::PathToLLTestFiles + "incremental/";
+
+} // namespace
+
+TEST(FunctionHashesTest, HashesAreStableAcrossLoads) {
+  ProjectIRDB IRDB1({PathToLlFiles + "incremental_01_v1_cpp.ll"});
+  ProjectIRDB IRDB2({PathToLlFiles + "incremental_01_v1_cpp.ll"});
+  FunctionHashes Hashes1(IRDB1);
+  FunctionHashes Hashes2(IRDB2);
+  ASSERT_EQ(3U, Hashes1.size());
+  for (const auto *Name : {"main", "_Z9incrementi", "_Z5twicei"}) {
+    ASSERT_TRUE(Hashes1.getHash(Name).has_value());
+    EXPECT_EQ(Hashes1.getHash(Name), Hashes2.getHash(Name));
+    EXPECT_EQ(Hashes1.getClosureHash(Name), Hashes2.getClosureHash(Name));
+  }
+  EXPECT_TRUE(Hashes2.getChangedFunctions(Hashes1).empty());
+}
+
+TEST(FunctionHashesTest, ChangesPropagateToCallers) {
+  ProjectIRDB IRDB1({PathToLlFiles + "incremental_01_v1_cpp.ll"});
+  ProjectIRDB IRDB2({PathToLlFiles + "incremental_01_v2_cpp.ll"});
+  FunctionHashes Old(IRDB1);
+  FunctionHashes New(IRDB2);
+  // only twice() has been modified
+  EXPECT_EQ(Old.getHash("_Z9incrementi"), New.getHash("_Z9incrementi"));
+  EXPECT_NE(Old.getHash("_Z5twicei"), New.getHash("_Z5twicei"));
+  EXPECT_EQ(Old.getHash("main"), New.getHash("main"));
+  // but main() calls it
+  EXPECT_NE(Old.getClosureHash("main"), New.getClosureHash("main"));
+  EXPECT_EQ(std::vector<std::string>({"_Z5twicei", "main"}),
+            New.getChangedFunctions(Old));
+  EXPECT_FALSE(New.mayAccessMutableGlobals("_Z9incrementi"));
+}
+
+TEST(FunctionHashesTest, GlobalsAccessedThroughConstantExpressions) {
+  ProjectIRDB IRDB1({PathToLlFiles + "incremental_03_v1_cpp.ll"});
+  ProjectIRDB IRDB2({PathToLlFiles + "incremental_03_v2_cpp.ll"});
+  FunctionHashes Old(IRDB1);
+  FunctionHashes New(IRDB2);
+  // lookup() reads an element of Table, whose initializer has been modified,
+  // via a constant getelementptr expression
+  EXPECT_NE(Old.getHash("_Z6lookupv"), New.getHash("_Z6lookupv"));
+  EXPECT_EQ(Old.getHash("_Z5countv"), New.getHash("_Z5countv"));
+  EXPECT_EQ(std::vector<std::string>({"_Z6lookupv", "main"}),
+            New.getChangedFunctions(Old));
+  // count() increments an element of the mutable Counters the same way
+  EXPECT_FALSE(New.mayAccessMutableGlobals("_Z6lookupv"));
+  EXPECT_TRUE(New.mayAccessMutableGlobals("_Z5countv"));
+  EXPECT_TRUE(New.mayAccessMutableGlobals("main"));
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,56 @@
+#ifndef UNITTEST_TESTUTILS_LCAFLOWEDGEFUNCTIONCACHETEST_H_
+#define UNITTEST_TESTUTILS_LCAFLOWEDGEFUNCTIONCACHETEST_H_
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowEdgeFunctionCache.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+namespace psr::unittest {
+
+/// A test fixture for the caches and memos of FlowEdgeFunctionCache: sets up
+/// the IDELinearConstantAnalysis on a file of the linear_constant test suite,
+/// whose solver configuration can be adjusted before a cache is created.
+class LCAFlowEdgeFunctionCacheTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles = PathToLLTestFiles + "linear_constant/";
+
+  using CacheTy = FlowEdgeFunctionCache<IDELinearConstantAnalysisDomain>;
+
+  std::unique_ptr<ProjectIRDB> IRDB;
+  std::unique_ptr<LLVMTypeHierarchy> TH;
+  std::unique_ptr<LLVMPointsToSet> PT;
+  std::unique_ptr<LLVMBasedICFG> ICFG;
+  std::unique_ptr<IDELinearConstantAnalysis> LCAProblem;
+
+  void initialize(const std::string &LlvmFilePath) {
+    ValueAnnotationPass::resetValueID();
+    IRDB = std::make_unique<ProjectIRDB>(
+        std::vector<std::string>{PathToLlFiles + LlvmFilePath},
+        IRDBOptions::WPA);
+    TH = std::make_unique<LLVMTypeHierarchy>(*IRDB);
+    PT = std::make_unique<LLVMPointsToSet>(*IRDB);
+    ICFG = std::make_unique<LLVMBasedICFG>(*IRDB, CallGraphAnalysisType::OTF,
+                                           std::set<std::string>{"main"},
+                                           TH.get(), PT.get());
+    LCAProblem = std::make_unique<IDELinearConstantAnalysis>(
+        IRDB.get(), TH.get(), ICFG.get(), PT.get(),
+        std::set<std::string>{"main"});
+  }
+};
+
+} // namespace psr::unittest
+
+#endif // UNITTEST_TESTUTILS_LCAFLOWEDGEFUNCTIONCACHETEST_H_
@@ -0,0 +1,76 @@
+#ifndef UNITTEST_TESTUTILS_LCASOLVERCOMPARISONTEST_H_
+#define UNITTEST_TESTUTILS_LCASOLVERCOMPARISONTEST_H_
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+
+#include "TestConfig.h"
+
+namespace psr::unittest {
+
+/// A parameterized test fixture that solves the IDELinearConstantAnalysis on
+/// a file of the linear_constant test suite twice, once with the default,
+/// sequential solver configuration and once with the solver and
+/// configuration under test, and expects both results to be equal.
+template <typename ParamTy>
+class LCASolverComparisonTest : public ::testing::TestWithParam<ParamTy> {
+protected:
+  const std::string PathToLlFiles = PathToLLTestFiles + "linear_constant/";
+
+  using l_t = IDELinearConstantAnalysisDomain::l_t;
+  using n_t = IDELinearConstantAnalysisDomain::n_t;
+  using d_t = IDELinearConstantAnalysisDomain::d_t;
+  using ResultMap = std::map<std::pair<n_t, d_t>, l_t>;
+  using ConfigureFnTy = std::function<void(IFDSIDESolverConfig &)>;
+  using DefaultSolverTy = IDESolver_P<IDELinearConstantAnalysis>;
+
+  template <typename SolverTy = DefaultSolverTy>
+  static ResultMap doAnalysis(ProjectIRDB &IRDB, LLVMBasedICFG &ICFG,
+                              LLVMTypeHierarchy &TH, LLVMPointsToSet &PT,
+                              const ConfigureFnTy &Configure) {
+    IDELinearConstantAnalysis LCAProblem(&IRDB, &TH, &ICFG, &PT, {"main"});
+    Configure(LCAProblem.getIFDSIDESolverConfig());
+    SolverTy LCASolver(LCAProblem);
+    LCASolver.solve();
+    ResultMap Results;
+    for (const auto &Cell :
+         LCASolver.getSolverResults().getAllResultEntries()) {
+      Results[{Cell.getRowKey(), Cell.getColumnKey()}] = Cell.getValue();
+    }
+    return Results;
+  }
+
+  /// Compares the results of SolverTy, configured by Configure, with the
+  /// results of the default solver in its default configuration.
+  template <typename SolverTy = DefaultSolverTy>
+  void compareWithReference(const std::string &LlvmFilePath,
+                            const ConfigureFnTy &Configure) {
+    ProjectIRDB IRDB({PathToLlFiles + LlvmFilePath}, IRDBOptions::WPA);
+    ValueAnnotationPass::resetValueID();
+    LLVMTypeHierarchy TH(IRDB);
+    LLVMPointsToSet PT(IRDB);
+    LLVMBasedICFG ICFG(IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT);
+    auto Expected =
+        doAnalysis(IRDB, ICFG, TH, PT, [](IFDSIDESolverConfig & /*Config*/) {});
+    auto Actual = doAnalysis<SolverTy>(IRDB, ICFG, TH, PT, Configure);
+    EXPECT_FALSE(Expected.empty());
+    EXPECT_EQ(Expected, Actual);
+  }
+};
+
+} // namespace psr::unittest
+
+#endif // UNITTEST_TESTUTILS_LCASOLVERCOMPARISONTEST_H_
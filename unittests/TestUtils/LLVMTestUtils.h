@@ -0,0 +1,34 @@
+#ifndef UNITTEST_TESTUTILS_LLVMTESTUTILS_H_
+#define UNITTEST_TESTUTILS_LLVMTESTUTILS_H_
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+
+namespace psr::unittest {
+
+/// Returns the alloca of the local variable Name in F, or nullptr.
+inline const llvm::Value *getLocal(const llvm::Function *F,
+                                   llvm::StringRef Name) {
+  for (const auto &I : llvm::instructions(F)) {
+    if (llvm::isa<llvm::AllocaInst>(I) && I.getName() == Name) {
+      return &I;
+    }
+  }
+  return nullptr;
+}
+
+/// Returns the first return instruction of F, or nullptr.
+inline const llvm::Instruction *getReturn(const llvm::Function *F) {
+  for (const auto &I : llvm::instructions(F)) {
+    if (llvm::isa<llvm::ReturnInst>(I)) {
+      return &I;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace psr::unittest
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef UNITTEST_TESTUTILS_SUMMARYTESTPROBLEMS_H_
+#define UNITTEST_TESTUTILS_SUMMARYTESTPROBLEMS_H_
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+
+namespace psr::unittest {
+
+/// The uninitialized variables analysis records the undefined uses it finds
+/// while being solved, hence, it does not support persisted summaries. The
+/// summary tests only compare the facts the solver computes and opt in
+/// regardless.
+class PersistableUninitializedVariables : public IFDSUninitializedVariables {
+public:
+  using IFDSUninitializedVariables::IFDSUninitializedVariables;
+
+  [[nodiscard]] bool canPersistSummaries() const override { return true; }
+};
+
+/// Does not opt into persisted summaries, like problems whose side effects
+/// would be missing for the summarized functions, regardless of whether the
+/// analysis it extends does.
+class UninitializedVariablesWithoutSummaries
+    : public IFDSUninitializedVariables {
+public:
+  using IFDSUninitializedVariables::IFDSUninitializedVariables;
+
+  [[nodiscard]] bool canPersistSummaries() const override { return false; }
+};
+
+} // namespace psr::unittest
+
+#endif
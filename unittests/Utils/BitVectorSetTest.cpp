@@ -3,9 +3,13 @@
 #include "phasar/Utils/BitVectorSet.h"
 
 #include "llvm/ADT/BitVector.h"
+#include "llvm/Support/MathExtras.h"
 
 #include <set>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 using namespace psr;
 using namespace std;
@@ -395,6 +399,103 @@ TEST(BitVectorSet, lessThan) {
   EXPECT_FALSE(A < A);
 }
 
+TEST(BitVectorSet, ownedDomain) {
+  BitVectorSetDomain<std::string> Domain;
+  BitVectorSet<std::string> A(Domain, {"x", "y"});
+  BitVectorSet<std::string> B(Domain);
+  B.insert("y");
+  B.insert("z");
+
+  EXPECT_EQ(Domain.size(), 3U);
+  EXPECT_EQ(Domain.getIndex("x"), 0U);
+  EXPECT_EQ(Domain.getIndex("z"), 2U);
+  EXPECT_FALSE(Domain.getIndex("w").has_value());
+  EXPECT_EQ(A.getDomain(), &Domain);
+  EXPECT_EQ(BitVectorSetDomain<std::string>::getDefault().getIndex("x"),
+            std::nullopt);
+
+  BitVectorSet<std::string> C;
+  C.insert(A);
+  EXPECT_EQ(C.getDomain(), &Domain);
+  EXPECT_EQ(C.setUnion(B), BitVectorSet<std::string>(Domain, {"x", "y", "z"}));
+  EXPECT_EQ(C.count("x"), 1U);
+  EXPECT_EQ(C.count("w"), 0U);
+}
+
+TEST(BitVectorSet, bulkOperations) {
+  BitVectorSetDomain<int> Domain;
+  std::vector<int> Values;
+  for (int I = 0; I < 300; ++I) {
+    Values.push_back(I);
+  }
+  BitVectorSet<int> All(Domain, Values.begin(), Values.end());
+  BitVectorSet<int> Even(Domain);
+  for (int I = 0; I < 300; I += 2) {
+    Even.insert(I);
+  }
+  EXPECT_EQ(All.size(), 300U);
+  EXPECT_EQ(Even.size(), 150U);
+
+  auto Odd = All.setDifference(Even);
+  EXPECT_EQ(Odd.size(), 150U);
+  EXPECT_EQ(Odd.count(1), 1U);
+  EXPECT_EQ(Odd.count(2), 0U);
+  EXPECT_EQ(Odd.setUnion(Even), All);
+  EXPECT_TRUE(Odd.setIntersect(Even).empty());
+
+  size_t PopCount = 0;
+  for (auto Word : Odd.getWords()) {
+    PopCount += llvm::countPopulation(Word);
+  }
+  EXPECT_EQ(PopCount, Odd.size());
+
+  All.setDifferenceWith(Odd);
+  EXPECT_EQ(All, Even);
+}
+
+TEST(BitVectorSet, concurrentInsertion) {
+  BitVectorSetDomain<int> Domain(/*Concurrent*/ true);
+  std::vector<BitVectorSet<int>> Sets(4, BitVectorSet<int>(Domain));
+  std::vector<std::thread> Threads;
+  for (size_t T = 0; T < Sets.size(); ++T) {
+    Threads.emplace_back([&Sets, T] {
+      for (int I = 0; I < 1000; ++I) {
+        Sets[T].insert(I);
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  EXPECT_EQ(Domain.size(), 1000U);
+  for (const auto &Set : Sets) {
+    EXPECT_EQ(Set, Sets.front());
+    EXPECT_EQ(Set.size(), 1000U);
+  }
+  std::set<int> Elements(Sets.back().begin(), Sets.back().end());
+  EXPECT_EQ(Elements.size(), 1000U);
+}
+
+TEST(BitVectorSet, differentDomains) {
+  EXPECT_FALSE(BitVectorSetDomain<std::string>::getDefault().isConcurrent());
+  BitVectorSetDomain<std::string> Domain1;
+  BitVectorSetDomain<std::string> Domain2;
+  // "y" has index 1 in Domain1, but index 0 in Domain2
+  BitVectorSet<std::string> A(Domain1, {"x", "y"});
+  BitVectorSet<std::string> B(Domain2, {"y"});
+  BitVectorSet<std::string> C(Domain2, {"x"});
+  A.erase("x");
+  EXPECT_EQ(A, B);
+  EXPECT_NE(A, C);
+  EXPECT_NE(C, B);
+  B.insert("x");
+  EXPECT_NE(A, B);
+  A.insert("x");
+  EXPECT_EQ(A, B);
+  EXPECT_EQ(BitVectorSet<std::string>(Domain1),
+            BitVectorSet<std::string>(Domain2));
+}
+
 //===----------------------------------------------------------------------===//
 // llvm::BitVector
 
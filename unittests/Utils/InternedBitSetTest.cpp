@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+
+#include "phasar/Utils/InternedBitSet.h"
+#include "phasar/Utils/Interner.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace psr;
+
+TEST(Interner, stableIds) {
+  Interner<std::string> I;
+  auto A = I.intern("a");
+  auto B = I.intern("b");
+  EXPECT_EQ(A.getId(), 0U);
+  EXPECT_EQ(B.getId(), 1U);
+  EXPECT_EQ(I.intern("a"), A);
+  EXPECT_EQ(I.size(), 2U);
+  // rehashing must not invalidate the side table
+  for (unsigned Idx = 0; Idx < 1000; ++Idx) {
+    (void)I.intern(std::to_string(Idx));
+  }
+  EXPECT_EQ(*A, "a");
+  EXPECT_EQ(B.get(), "b");
+  EXPECT_EQ(I.getValue(2), "0");
+  ASSERT_TRUE(I.find("999").has_value());
+  EXPECT_EQ(I.find("999")->getId(), 1001U);
+  EXPECT_FALSE(I.find("1000").has_value());
+}
+
+TEST(InternedBitSet, insertAndCount) {
+  Interner<std::string> I;
+  std::vector<Interned<std::string>> Facts;
+  for (unsigned Idx = 0; Idx < 200; ++Idx) {
+    Facts.push_back(I.intern(std::to_string(Idx)));
+  }
+  InternedBitSet<std::string> B({Facts[3], Facts[64], Facts[130]});
+  EXPECT_EQ(B.size(), 3U);
+  EXPECT_EQ(B.count(Facts[3]), 1U);
+  EXPECT_EQ(B.count(Facts[64]), 1U);
+  EXPECT_EQ(B.count(Facts[130]), 1U);
+  EXPECT_EQ(B.count(Facts[4]), 0U);
+  EXPECT_EQ(B.count(Facts[199]), 0U);
+  EXPECT_EQ(B.getInterner(), &I);
+
+  B.erase(Facts[130]);
+  EXPECT_EQ(B.size(), 2U);
+  EXPECT_EQ(B.getWords().size(), 2U);
+  B.erase(Facts[64]);
+  B.erase(Facts[3]);
+  EXPECT_TRUE(B.empty());
+  EXPECT_EQ(B, InternedBitSet<std::string>());
+}
+
+TEST(InternedBitSet, setAlgebra) {
+  Interner<std::string> I;
+  std::vector<Interned<std::string>> Facts;
+  for (unsigned Idx = 0; Idx < 200; ++Idx) {
+    Facts.push_back(I.intern(std::to_string(Idx)));
+  }
+  InternedBitSet<std::string> A({Facts[1], Facts[70]});
+  InternedBitSet<std::string> B({Facts[1], Facts[150]});
+
+  auto U = A.setUnion(B);
+  EXPECT_EQ(U, InternedBitSet<std::string>({Facts[1], Facts[70], Facts[150]}));
+  EXPECT_TRUE(U.includes(A));
+  EXPECT_TRUE(U.includes(B));
+  EXPECT_FALSE(A.includes(B));
+  EXPECT_EQ(B.setUnion(A), U);
+  EXPECT_EQ(InternedBitSet<std::string>().setUnion(A), A);
+
+  auto S = A.setIntersect(B);
+  EXPECT_EQ(S, InternedBitSet<std::string>({Facts[1]}));
+  EXPECT_EQ(S.getWords().size(), 1U);
+
+  U.erase(A);
+  EXPECT_EQ(U, InternedBitSet<std::string>({Facts[150]}));
+
+  A.insert(B);
+  EXPECT_EQ(A.size(), 3U);
+  EXPECT_TRUE(B < A);
+  EXPECT_FALSE(A < B);
+  EXPECT_FALSE(A < A);
+}
+
+TEST(InternedBitSet, iterate) {
+  Interner<std::string> I;
+  std::vector<Interned<std::string>> Facts;
+  for (unsigned Idx = 0; Idx < 200; ++Idx) {
+    Facts.push_back(I.intern(std::to_string(Idx)));
+  }
+  std::set<Interned<std::string>> Expected = {Facts[0], Facts[63], Facts[64],
+                                              Facts[128], Facts[199]};
+  InternedBitSet<std::string> B(Expected.begin(), Expected.end());
+  std::set<Interned<std::string>> Actual(B.begin(), B.end());
+  EXPECT_EQ(Expected, Actual);
+
+  std::string Str;
+  llvm::raw_string_ostream OS(Str);
+  OS << InternedBitSet<std::string>({Facts[5], Facts[12]});
+  EXPECT_EQ(OS.str(), "<5, 12>");
+
+  InternedBitSet<std::string> Empty;
+  EXPECT_EQ(Empty.begin(), Empty.end());
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}